@@ -600,6 +600,39 @@ ODE_API bool dWorldGetQuickStepExperimentalRowReordering (dWorldID);
  */
 ODE_API dReal dWorldGetQuickStepWarmStartFactor (dWorldID);
 
+/**
+ * @brief Get the number of dReals needed to store the raw dynamic state
+ * of a world, see dWorldGetRawState.
+ * @ingroup world
+ */
+ODE_API size_t dWorldGetRawStateSize (dWorldID);
+
+/**
+ * @brief Copy the raw dynamic state of all bodies and joints of a world.
+ *
+ * The state includes body positions, orientations (quaternion and rotation
+ * matrix), velocities, accumulated forces and torques, enabled state and
+ * auto-disable counters, as well as the warm start multipliers and
+ * cumulative angles of all joints except contact joints. Restoring it with
+ * dWorldSetRawState into the same world reproduces the following steps
+ * exactly.
+ * @ingroup world
+ * @param state buffer of at least dWorldGetRawStateSize dReals.
+ */
+ODE_API void dWorldGetRawState (dWorldID, dReal *state);
+
+/**
+ * @brief Restore the raw dynamic state copied by dWorldGetRawState.
+ *
+ * The moved callback of every body is called after its state is restored.
+ * @ingroup world
+ * @param state buffer filled by dWorldGetRawState.
+ * @param size number of dReals in the buffer.
+ * @return 1 on success, 0 if the buffer does not match the bodies and
+ * joints of the world.
+ */
+ODE_API int dWorldSetRawState (dWorldID, const dReal *state, size_t size);
+
 /**
  * @brief Get extra friction constraint iterations within each time step.
  * @ingroup world
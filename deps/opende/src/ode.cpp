@@ -2373,6 +2373,147 @@ void dWorldSetQuickStepWarmStartFactor (dWorldID w, dReal warm)
   w->qs.warm_start = warm;
 }
 
+// number of dReals stored per body and per joint by dWorldGetRawState
+static const size_t dBODY_RAW_STATE_SIZE = 34;
+static const size_t dJOINT_RAW_STATE_SIZE = 14;
+
+// contact joints only live for one step and are not part of the raw state
+static bool dJointHasRawState (const dxJoint *j)
+{
+  return j->type() != dJointTypeContact;
+}
+
+static dReal *dJointCumulativeAngle (dxJoint *j, int index)
+{
+  switch (j->type())
+  {
+    case dJointTypeHinge:
+      return index == 0 ? &((dxJointHinge*)j)->cumulative_angle : NULL;
+    case dJointTypeScrew:
+      return index == 0 ? &((dxJointScrew*)j)->cumulative_angle : NULL;
+    case dJointTypeUniversal:
+      return index == 0 ? &((dxJointUniversal*)j)->cumulative_angle1
+                        : &((dxJointUniversal*)j)->cumulative_angle2;
+    case dJointTypeGearbox:
+      return index == 0 ? &((dxJointGearbox*)j)->cumulative_angle1
+                        : &((dxJointGearbox*)j)->cumulative_angle2;
+    default:
+      return NULL;
+  }
+}
+
+size_t dWorldGetRawStateSize (dWorldID w)
+{
+  dAASSERT(w);
+  size_t nj = 0;
+  for (dxJoint *j = w->firstjoint; j; j = (dxJoint*)j->next)
+  {
+    if (dJointHasRawState(j))
+      nj++;
+  }
+  return 2 + w->nb * dBODY_RAW_STATE_SIZE + nj * dJOINT_RAW_STATE_SIZE;
+}
+
+void dWorldGetRawState (dWorldID w, dReal *state)
+{
+  dAASSERT(w && state);
+
+  dReal *header = state;
+  state += 2;
+
+  size_t nb = 0;
+  for (dxBody *b = w->firstbody; b; b = (dxBody*)b->next, nb++)
+  {
+    memcpy(state, b->posr.pos, 3 * sizeof(dReal));
+    memcpy(state + 3, b->q, 4 * sizeof(dReal));
+    memcpy(state + 7, b->posr.R, 12 * sizeof(dReal));
+    memcpy(state + 19, b->lvel, 3 * sizeof(dReal));
+    memcpy(state + 22, b->avel, 3 * sizeof(dReal));
+    memcpy(state + 25, b->facc, 3 * sizeof(dReal));
+    memcpy(state + 28, b->tacc, 3 * sizeof(dReal));
+    state[31] = (b->flags & dxBodyDisabled) ? 1 : 0;
+    state[32] = b->adis_timeleft;
+    state[33] = b->adis_stepsleft;
+    state += dBODY_RAW_STATE_SIZE;
+  }
+
+  size_t nj = 0;
+  for (dxJoint *j = w->firstjoint; j; j = (dxJoint*)j->next)
+  {
+    if (!dJointHasRawState(j))
+      continue;
+
+    memcpy(state, j->lambda, 6 * sizeof(dReal));
+    memcpy(state + 6, j->lambda_erp, 6 * sizeof(dReal));
+    for (int i = 0; i < 2; ++i)
+    {
+      dReal *angle = dJointCumulativeAngle(j, i);
+      state[12 + i] = angle ? *angle : 0;
+    }
+    state += dJOINT_RAW_STATE_SIZE;
+    nj++;
+  }
+
+  header[0] = nb;
+  header[1] = nj;
+}
+
+int dWorldSetRawState (dWorldID w, const dReal *state, size_t size)
+{
+  dAASSERT(w && state);
+
+  if (size != dWorldGetRawStateSize(w) ||
+      (size_t)state[0] != (size_t)w->nb ||
+      size != 2 + (size_t)state[0] * dBODY_RAW_STATE_SIZE +
+              (size_t)state[1] * dJOINT_RAW_STATE_SIZE)
+  {
+    return 0;
+  }
+  state += 2;
+
+  for (dxBody *b = w->firstbody; b; b = (dxBody*)b->next)
+  {
+    memcpy(b->posr.pos, state, 3 * sizeof(dReal));
+    memcpy(b->q, state + 3, 4 * sizeof(dReal));
+    memcpy(b->posr.R, state + 7, 12 * sizeof(dReal));
+    memcpy(b->lvel, state + 19, 3 * sizeof(dReal));
+    memcpy(b->avel, state + 22, 3 * sizeof(dReal));
+    memcpy(b->facc, state + 25, 3 * sizeof(dReal));
+    memcpy(b->tacc, state + 28, 3 * sizeof(dReal));
+    if (state[31] > 0)
+      b->flags |= dxBodyDisabled;
+    else
+      b->flags &= ~dxBodyDisabled;
+    b->adis_timeleft = state[32];
+    b->adis_stepsleft = (int)state[33];
+    state += dBODY_RAW_STATE_SIZE;
+
+    // notify all attached geoms and the user that this body has moved
+    for (dxGeom *geom = b->geom; geom; geom = dGeomGetBodyNext (geom))
+      dGeomMoved (geom);
+    if (b->moved_callback)
+      b->moved_callback(b);
+  }
+
+  for (dxJoint *j = w->firstjoint; j; j = (dxJoint*)j->next)
+  {
+    if (!dJointHasRawState(j))
+      continue;
+
+    memcpy(j->lambda, state, 6 * sizeof(dReal));
+    memcpy(j->lambda_erp, state + 6, 6 * sizeof(dReal));
+    for (int i = 0; i < 2; ++i)
+    {
+      dReal *angle = dJointCumulativeAngle(j, i);
+      if (angle)
+        *angle = state[12 + i];
+    }
+    state += dJOINT_RAW_STATE_SIZE;
+  }
+
+  return 1;
+}
+
 void dWorldSetQuickStepExtraFrictionIterations (dWorldID w, int iters)
 {
   dAASSERT(w);
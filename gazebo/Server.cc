@@ -61,6 +61,7 @@
 
 #include "gazebo/physics/PhysicsFactory.hh"
 #include "gazebo/physics/PhysicsIface.hh"
+#include "gazebo/physics/PhysicsEngine.hh"
 #include "gazebo/physics/PresetManager.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/Base.hh"
@@ -177,6 +178,8 @@ bool Server::ParseArgs(int _argc, char **_argv)
     ("record_resources", "Recording with model meshes and materials.")
     ("seed",  po::value<double>(), "Start with a given random number seed.")
     ("iters",  po::value<unsigned int>(), "Number of iterations to simulate.")
+    ("deterministic", "Reproduce the same trajectory for a given --seed, "
+     "regardless of the physics threading options.")
     ("minimal_comms", "Reduce the TCP/IP traffic output by gzserver")
     ("server-plugin,s", po::value<std::vector<std::string> >(),
      "Load a plugin.")
@@ -376,6 +379,17 @@ bool Server::ParseArgs(int _argc, char **_argv)
               << std::endl;
       }
     }
+
+    // Applied after the profile, which may enable threading options that
+    // are unavailable in deterministic mode.
+    if (this->dataPtr->vm.count("deterministic"))
+    {
+      if (!physics::get_world()->Physics()->SetParam("deterministic", true))
+        gzerr << "Unable to enable deterministic mode." << std::endl;
+      else if (!this->dataPtr->vm.count("seed"))
+        gzwarn << "Deterministic mode without --seed uses a random seed."
+               << std::endl;
+    }
   }
 
   this->ProcessParams();
@@ -18,6 +18,7 @@
 #include <curl/curl.h>
 #include <tinyxml.h>
 #include <math.h>
+#include <list>
 #include <sstream>
 #include <set>
 #include <memory>
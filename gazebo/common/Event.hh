@@ -19,10 +19,11 @@
 
 #include <atomic>
 #include <functional>
-#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <utility>
+#include <vector>
 
 #include "gazebo/gazebo_config.h"
 #include "gazebo/common/Time.hh"
@@ -272,15 +273,14 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        const auto snapshot = this->Snapshot();
+        for (const auto &conn : *snapshot)
         {
-          if (iter.second->on)
+          if (conn->on)
           {
             IGN_PROFILE_BEGIN("callback0");
-            iter.second->callback();
+            conn->callback();
             IGN_PROFILE_END();
           }
         }
@@ -293,15 +293,14 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        const auto snapshot = this->Snapshot();
+        for (const auto &conn : *snapshot)
         {
-          if (iter.second->on)
+          if (conn->on)
           {
             IGN_PROFILE_BEGIN("callback1");
-            iter.second->callback(_p);
+            conn->callback(_p);
             IGN_PROFILE_END();
           }
         }
@@ -315,15 +314,14 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        const auto snapshot = this->Snapshot();
+        for (const auto &conn : *snapshot)
         {
-          if (iter.second->on)
+          if (conn->on)
           {
             IGN_PROFILE_BEGIN("callback2");
-            iter.second->callback(_p1, _p2);
+            conn->callback(_p1, _p2);
             IGN_PROFILE_END();
           }
         }
@@ -338,15 +336,14 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        const auto snapshot = this->Snapshot();
+        for (const auto &conn : *snapshot)
         {
-          if (iter.second->on)
+          if (conn->on)
           {
             IGN_PROFILE_BEGIN("callback3");
-            iter.second->callback(_p1, _p2, _p3);
+            conn->callback(_p1, _p2, _p3);
             IGN_PROFILE_END();
           }
         }
@@ -363,15 +360,14 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        const auto snapshot = this->Snapshot();
+        for (const auto &conn : *snapshot)
         {
-          if (iter.second->on)
+          if (conn->on)
           {
             IGN_PROFILE_BEGIN("callback4");
-            iter.second->callback(_p1, _p2, _p3, _p4);
+            conn->callback(_p1, _p2, _p3, _p4);
             IGN_PROFILE_END();
           }
         }
@@ -390,15 +386,14 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        const auto snapshot = this->Snapshot();
+        for (const auto &conn : *snapshot)
         {
-          if (iter.second->on)
+          if (conn->on)
           {
             IGN_PROFILE_BEGIN("callback5");
-            iter.second->callback(_p1, _p2, _p3, _p4, _p5);
+            conn->callback(_p1, _p2, _p3, _p4, _p5);
             IGN_PROFILE_END();
           }
         }
@@ -418,15 +413,14 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        const auto snapshot = this->Snapshot();
+        for (const auto &conn : *snapshot)
         {
-          if (iter.second->on)
+          if (conn->on)
           {
             IGN_PROFILE_BEGIN("callback6");
-            iter.second->callback(_p1, _p2, _p3, _p4, _p5, _p6);
+            conn->callback(_p1, _p2, _p3, _p4, _p5, _p6);
             IGN_PROFILE_END();
           }
         }
@@ -447,15 +441,14 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        const auto snapshot = this->Snapshot();
+        for (const auto &conn : *snapshot)
         {
-          if (iter.second->on)
+          if (conn->on)
           {
             IGN_PROFILE_BEGIN("callback7");
-            iter.second->callback(_p1, _p2, _p3, _p4, _p5, _p6, _p7);
+            conn->callback(_p1, _p2, _p3, _p4, _p5, _p6, _p7);
             IGN_PROFILE_END();
           }
         }
@@ -478,15 +471,14 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        const auto snapshot = this->Snapshot();
+        for (const auto &conn : *snapshot)
         {
-          if (iter.second->on)
+          if (conn->on)
           {
             IGN_PROFILE_BEGIN("callback8");
-            iter.second->callback(_p1, _p2, _p3, _p4, _p5, _p6, _p7, _p8);
+            conn->callback(_p1, _p2, _p3, _p4, _p5, _p6, _p7, _p8);
             IGN_PROFILE_END();
           }
         }
@@ -511,15 +503,14 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        const auto snapshot = this->Snapshot();
+        for (const auto &conn : *snapshot)
         {
-          if (iter.second->on)
+          if (conn->on)
           {
             IGN_PROFILE_BEGIN("callback9");
-            iter.second->callback(
+            conn->callback(
                 _p1, _p2, _p3, _p4, _p5, _p6, _p7, _p8, _p9);
             IGN_PROFILE_END();
           }
@@ -544,28 +535,22 @@ namespace gazebo
                   const P4 &_p4, const P5 &_p5, const P6 &_p6, const P7 &_p7,
                   const P8 &_p8, const P9 &_p9, const P10 &_p10)
       {
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        const auto snapshot = this->Snapshot();
+        for (const auto &conn : *snapshot)
         {
           IGN_PROFILE("Event::Signal");
 
-          if (iter.second->on)
+          if (conn->on)
           {
             IGN_PROFILE_BEGIN("callback10");
-            iter.second->callback(
+            conn->callback(
                 _p1, _p2, _p3, _p4, _p5, _p6, _p7, _p8, _p9, _p10);
             IGN_PROFILE_END();
           }
         }
       }
 
-      /// \internal
-      /// \brief Removes queued connections.
-      /// We assume that this function is called from a Signal function.
-      private: void Cleanup();
-
       /// \brief A private helper class used in maintaining connections.
       private: class EventConnection
       {
@@ -587,23 +572,48 @@ namespace gazebo
 
       /// \def EvtConnectionMap
       /// \brief Event Connection map typedef.
-      typedef std::map<int, std::unique_ptr<EventConnection>> EvtConnectionMap;
+      typedef std::map<int, std::shared_ptr<EventConnection>> EvtConnectionMap;
+
+      /// \def EvtConnectionList
+      /// \brief Immutable list of connections iterated by Signal.
+      typedef std::vector<std::shared_ptr<EventConnection>> EvtConnectionList;
+
+      /// \internal
+      /// \brief Get the most recently published list of connections.
+      /// The returned list is never modified, so it can be iterated without
+      /// holding the mutex.
+      /// \return Snapshot of the current connections.
+      private: std::shared_ptr<const EvtConnectionList> Snapshot() const;
 
-      /// \brief Array of connection callbacks.
+      /// \internal
+      /// \brief Build a new connection list from the connection map and
+      /// publish it to readers. Must be called with the mutex locked.
+      private: void Publish();
+
+      // EventT is a member of installed classes such as Joint and Sensor,
+      // so the members below keep the order and total size they had before
+      // the connection list became copy-on-write.
+
+      /// \brief Array of connection callbacks, only accessed by writers.
       private: EvtConnectionMap connections;
 
-      /// \brief A thread lock.
+      /// \brief A thread lock, serializes Connect and Disconnect.
       private: std::mutex mutex;
 
-      /// \brief List of connections to remove
-      private: std::list<typename EvtConnectionMap::const_iterator>
-              connectionsToRemove;
+      /// \brief Copy-on-write snapshot of the connections, read by Signal.
+      /// It takes the place of the list of connections to remove.
+      private: std::shared_ptr<const EvtConnectionList> snapshot;
+
+      /// \brief Unused, pads the snapshot to the size of the list it
+      /// replaced.
+      /// TODO added here for ABI compatibility, remove when merging forward
+      private: void *reserved = nullptr;
     };
 
     /// \brief Constructor.
     template<typename T>
     EventT<T>::EventT()
-    : Event()
+    : Event(), snapshot(std::make_shared<const EvtConnectionList>())
     {
     }
 
@@ -619,13 +629,17 @@ namespace gazebo
     template<typename T>
     ConnectionPtr EventT<T>::Connect(const std::function<T> &_subscriber)
     {
+      std::lock_guard<std::mutex> lock(this->mutex);
+
       int index = 0;
       if (!this->connections.empty())
       {
         auto const &iter = this->connections.rbegin();
         index = iter->first + 1;
       }
-      this->connections[index].reset(new EventConnection(true, _subscriber));
+      this->connections[index] =
+          std::make_shared<EventConnection>(true, _subscriber);
+      this->Publish();
       return ConnectionPtr(new Connection(this, index));
     }
 
@@ -634,7 +648,7 @@ namespace gazebo
     template<typename T>
     unsigned int EventT<T>::ConnectionCount() const
     {
-      return this->connections.size();
+      return this->Snapshot()->size();
     }
 
     /// \brief Removes a connection.
@@ -642,25 +656,40 @@ namespace gazebo
     template<typename T>
     void EventT<T>::Disconnect(int _id)
     {
+      std::lock_guard<std::mutex> lock(this->mutex);
+
       // Find the connection
       auto const &it = this->connections.find(_id);
 
       if (it != this->connections.end())
       {
+        // A Signal that is in progress may still hold a snapshot containing
+        // this connection, so turn it off before dropping it.
         it->second->on = false;
-        this->connectionsToRemove.push_back(it);
+        this->connections.erase(it);
+        this->Publish();
       }
     }
 
     /////////////////////////////////////////////
     template<typename T>
-    void EventT<T>::Cleanup()
+    std::shared_ptr<const typename EventT<T>::EvtConnectionList>
+    EventT<T>::Snapshot() const
     {
-      std::lock_guard<std::mutex> lock(this->mutex);
-      // Remove all queue connections.
-      for (auto &conn : this->connectionsToRemove)
-        this->connections.erase(conn);
-      this->connectionsToRemove.clear();
+      return std::atomic_load(&this->snapshot);
+    }
+
+    /////////////////////////////////////////////
+    template<typename T>
+    void EventT<T>::Publish()
+    {
+      auto list = std::make_shared<EvtConnectionList>();
+      list->reserve(this->connections.size());
+      for (const auto &conn : this->connections)
+        list->push_back(conn.second);
+
+      std::atomic_store(&this->snapshot,
+          std::shared_ptr<const EvtConnectionList>(std::move(list)));
     }
     /// \}
   }
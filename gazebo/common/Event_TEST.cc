@@ -15,7 +15,14 @@
  *
 */
 
+#include <atomic>
 #include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include <gtest/gtest.h>
 #include <gazebo/common/Time.hh>
 #include <gazebo/common/Event.hh>
@@ -220,6 +227,78 @@ TEST_F(EventTest, ManyChanges)
   EXPECT_EQ(g_callback1, 2);
 }
 
+/////////////////////////////////////////////////
+// Connections added from within a callback must not be called by the
+// signal that is currently in progress.
+TEST_F(EventTest, ConnectInCallback)
+{
+  g_callback = 0;
+
+  event::EventT<void ()> evt;
+  std::vector<event::ConnectionPtr> conns;
+  conns.push_back(evt.Connect([&]()
+      {
+        conns.push_back(evt.Connect(std::bind(&callback)));
+      }));
+
+  evt();
+  EXPECT_EQ(g_callback, 0);
+  EXPECT_EQ(evt.ConnectionCount(), 2u);
+
+  evt();
+  EXPECT_EQ(g_callback, 1);
+  EXPECT_EQ(evt.ConnectionCount(), 3u);
+}
+
+/////////////////////////////////////////////////
+// Signal while another thread connects and disconnects.
+TEST_F(EventTest, ConcurrentConnect)
+{
+  std::atomic<int> count(0);
+
+  event::EventT<void (int)> evt;
+  event::ConnectionPtr conn = evt.Connect([&](int _i)
+      {
+        count += _i;
+      });
+
+  std::vector<event::ConnectionPtr> conns;
+  std::thread thread([&evt, &conns]()
+      {
+        for (unsigned int i = 0; i < 1000; ++i)
+          conns.push_back(evt.Connect([](int){}));
+        conns.clear();
+      });
+
+  for (unsigned int i = 0; i < 1000; ++i)
+    evt(1);
+
+  thread.join();
+
+  EXPECT_EQ(count, 1000);
+  EXPECT_EQ(evt.ConnectionCount(), 1u);
+}
+
+/////////////////////////////////////////////////
+/// \brief Members of EventT before the connection list became
+/// copy-on-write.
+class EventLayout : public event::Event
+{
+  public: virtual void Disconnect(int) {}
+  public: std::map<int, std::unique_ptr<int>> connections;
+  public: std::mutex mutex;
+  public: std::list<std::map<int, std::unique_ptr<int>>::const_iterator>
+          connectionsToRemove;
+};
+
+/////////////////////////////////////////////////
+// EventT is a member of installed classes, so its size must not change.
+TEST_F(EventTest, Size)
+{
+  EXPECT_EQ(sizeof(EventLayout), sizeof(event::EventT<void ()>));
+  EXPECT_EQ(sizeof(EventLayout), sizeof(event::EventT<void (int)>));
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -0,0 +1,512 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <list>
+#include <map>
+#include <mutex>
+#include <utility>
+
+#include <ignition/math/Helpers.hh>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/HeightmapTileCache.hh"
+
+using namespace gazebo;
+using namespace common;
+
+namespace
+{
+  /// \brief Identifies tiled heightmap files.
+  const char kMagic[4] = {'G', 'Z', 'H', 'T'};
+
+  /// \brief Version of the file layout.
+  const uint32_t kVersion = 1;
+
+  /// \brief Header of a tiled heightmap file.
+  struct Header
+  {
+    /// \brief Samples per side of the terrain.
+    uint32_t size = 0;
+
+    /// \brief Samples per side of a tile.
+    uint32_t tileSize = 0;
+
+    /// \brief Samples per side of the overview.
+    uint32_t overviewSize = 0;
+
+    /// \brief Lowest height.
+    float minElevation = 0;
+
+    /// \brief Highest height.
+    float maxElevation = 0;
+  };
+
+  /// \brief Size of the header in the file.
+  const std::streamoff kHeaderBytes = sizeof(kMagic) + 4 * sizeof(uint32_t) +
+      2 * sizeof(float);
+
+  /// \brief Check that a size is 2^n+1.
+  /// \param[in] _size Size to check.
+  /// \return True if valid.
+  bool ValidSize(const uint32_t _size)
+  {
+    return _size > 1 && ignition::math::isPowerOfTwo(_size - 1);
+  }
+
+  /// \brief Read a header from a stream.
+  /// \param[in] _in Stream at the start of the file.
+  /// \param[out] _header Header read.
+  /// \return True if the header is valid.
+  bool ReadHeader(std::istream &_in, Header &_header)
+  {
+    char magic[sizeof(kMagic)];
+    uint32_t version = 0;
+    _in.read(magic, sizeof(magic));
+    _in.read(reinterpret_cast<char *>(&version), sizeof(version));
+    _in.read(reinterpret_cast<char *>(&_header.size), sizeof(uint32_t));
+    _in.read(reinterpret_cast<char *>(&_header.tileSize), sizeof(uint32_t));
+    _in.read(reinterpret_cast<char *>(&_header.overviewSize),
+        sizeof(uint32_t));
+    _in.read(reinterpret_cast<char *>(&_header.minElevation), sizeof(float));
+    _in.read(reinterpret_cast<char *>(&_header.maxElevation), sizeof(float));
+
+    return _in.good() &&
+        std::memcmp(magic, kMagic, sizeof(kMagic)) == 0 &&
+        version == kVersion &&
+        ValidSize(_header.size) && ValidSize(_header.tileSize) &&
+        ValidSize(_header.overviewSize) &&
+        _header.tileSize <= _header.size &&
+        _header.overviewSize <= _header.size;
+  }
+}
+
+/// \brief Private data for the HeightmapTileCache class
+class gazebo::common::HeightmapTileCachePrivate
+{
+  /// \brief Read a tile from the file, with the mutex locked.
+  /// \param[in] _index Index of the tile.
+  /// \return The tile, null on error.
+  public: HeightmapTileCache::Tile Read(const unsigned int _index)
+  {
+    const std::size_t samples =
+        static_cast<std::size_t>(this->header.tileSize) *
+        this->header.tileSize;
+    const std::streamoff offset = kHeaderBytes +
+        static_cast<std::streamoff>(sizeof(float)) *
+        (static_cast<std::streamoff>(this->header.overviewSize) *
+         this->header.overviewSize +
+         static_cast<std::streamoff>(_index) * samples);
+
+    auto tile = std::make_shared<std::vector<float>>(samples);
+    this->file.clear();
+    this->file.seekg(offset);
+    this->file.read(reinterpret_cast<char *>(tile->data()),
+        samples * sizeof(float));
+    if (!this->file.good())
+    {
+      gzerr << "Unable to read tile [" << _index << "] of heightmap ["
+            << this->filename << "]" << std::endl;
+      return nullptr;
+    }
+
+    ++this->reads;
+    return tile;
+  }
+
+  /// \brief Drop the least recently used tiles beyond the capacity, with
+  /// the mutex locked.
+  public: void Trim()
+  {
+    while (this->lru.size() > this->capacity)
+    {
+      this->lruIndex[this->lru.back().first] = this->lru.end();
+      this->lru.pop_back();
+    }
+  }
+
+  /// \brief Protects the members below.
+  public: mutable std::mutex mutex;
+
+  /// \brief Path of the open file.
+  public: std::string filename;
+
+  /// \brief The open file.
+  public: std::ifstream file;
+
+  /// \brief Header of the open file.
+  public: Header header;
+
+  /// \brief Number of tiles per side.
+  public: unsigned int tileCount = 0;
+
+  /// \brief Overview of the terrain.
+  public: std::vector<float> overview;
+
+  /// \brief Tiles in memory, most recently used first.
+  public: std::list<std::pair<unsigned int, HeightmapTileCache::Tile>> lru;
+
+  /// \brief Position of each tile in the lru list, end() if not in it.
+  public: std::vector<std::list<std::pair<unsigned int,
+          HeightmapTileCache::Tile>>::iterator> lruIndex;
+
+  /// \brief Tiles that may still be held by callers.
+  public: std::vector<std::weak_ptr<const std::vector<float>>> weakTiles;
+
+  /// \brief Maximum number of tiles in the lru list.
+  public: unsigned int capacity = 64;
+
+  /// \brief Number of tiles read from the file.
+  public: unsigned int reads = 0;
+};
+
+//////////////////////////////////////////////////
+HeightmapTileCache::HeightmapTileCache()
+  : dataPtr(new HeightmapTileCachePrivate)
+{
+}
+
+//////////////////////////////////////////////////
+HeightmapTileCache::~HeightmapTileCache()
+{
+}
+
+//////////////////////////////////////////////////
+bool HeightmapTileCache::Load(const std::string &_filename)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  this->dataPtr->lru.clear();
+  this->dataPtr->lruIndex.clear();
+  this->dataPtr->weakTiles.clear();
+  this->dataPtr->overview.clear();
+  this->dataPtr->filename.clear();
+  this->dataPtr->tileCount = 0;
+  if (this->dataPtr->file.is_open())
+    this->dataPtr->file.close();
+
+  this->dataPtr->file.open(_filename, std::ios::in | std::ios::binary);
+  if (!this->dataPtr->file.is_open())
+  {
+    gzerr << "Unable to open tiled heightmap [" << _filename << "]"
+          << std::endl;
+    return false;
+  }
+
+  Header &header = this->dataPtr->header;
+  if (!ReadHeader(this->dataPtr->file, header))
+  {
+    gzerr << "Invalid tiled heightmap [" << _filename << "]" << std::endl;
+    this->dataPtr->file.close();
+    return false;
+  }
+
+  this->dataPtr->overview.resize(
+      static_cast<std::size_t>(header.overviewSize) * header.overviewSize);
+  this->dataPtr->file.read(
+      reinterpret_cast<char *>(this->dataPtr->overview.data()),
+      this->dataPtr->overview.size() * sizeof(float));
+  if (!this->dataPtr->file.good())
+  {
+    gzerr << "Unable to read the overview of tiled heightmap ["
+          << _filename << "]" << std::endl;
+    this->dataPtr->overview.clear();
+    this->dataPtr->file.close();
+    return false;
+  }
+
+  this->dataPtr->filename = _filename;
+  this->dataPtr->tileCount = (header.size - 1) / (header.tileSize - 1);
+  const std::size_t tiles =
+      static_cast<std::size_t>(this->dataPtr->tileCount) *
+      this->dataPtr->tileCount;
+  this->dataPtr->lruIndex.assign(tiles, this->dataPtr->lru.end());
+  this->dataPtr->weakTiles.resize(tiles);
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<HeightmapTileCache> HeightmapTileCache::Acquire(
+    const std::string &_filename)
+{
+  static std::mutex registryMutex;
+  static std::map<std::string, std::weak_ptr<HeightmapTileCache>> registry;
+
+  std::lock_guard<std::mutex> lock(registryMutex);
+  auto cache = registry[_filename].lock();
+  if (cache)
+    return cache;
+
+  cache = std::make_shared<HeightmapTileCache>();
+  if (!cache->Load(_filename))
+  {
+    registry.erase(_filename);
+    return nullptr;
+  }
+
+  registry[_filename] = cache;
+  return cache;
+}
+
+//////////////////////////////////////////////////
+bool HeightmapTileCache::IsTiledFile(const std::string &_filename)
+{
+  std::ifstream in(_filename, std::ios::in | std::ios::binary);
+  Header header;
+  return in.is_open() && ReadHeader(in, header);
+}
+
+//////////////////////////////////////////////////
+bool HeightmapTileCache::Write(const std::string &_filename,
+    const std::vector<float> &_heights, const unsigned int _size,
+    const unsigned int _tileSize, const unsigned int _overviewSize)
+{
+  if (!ValidSize(_size) || !ValidSize(_tileSize) ||
+      !ValidSize(_overviewSize) || _tileSize > _size ||
+      _overviewSize > _size)
+  {
+    gzerr << "Tiled heightmap sizes must be 2^n+1, got terrain [" << _size
+          << "], tile [" << _tileSize << "] and overview [" << _overviewSize
+          << "]" << std::endl;
+    return false;
+  }
+
+  if (_heights.size() != static_cast<std::size_t>(_size) * _size)
+  {
+    gzerr << "Expected [" << _size * _size << "] heights, got ["
+          << _heights.size() << "]" << std::endl;
+    return false;
+  }
+
+  std::ofstream out(_filename, std::ios::out | std::ios::binary);
+  if (!out.is_open())
+  {
+    gzerr << "Unable to write tiled heightmap [" << _filename << "]"
+          << std::endl;
+    return false;
+  }
+
+  auto range = std::minmax_element(_heights.begin(), _heights.end());
+  const float minElevation = *range.first;
+  const float maxElevation = *range.second;
+  const uint32_t size = _size;
+  const uint32_t tileSize = _tileSize;
+  const uint32_t overviewSize = _overviewSize;
+
+  out.write(kMagic, sizeof(kMagic));
+  out.write(reinterpret_cast<const char *>(&kVersion), sizeof(kVersion));
+  out.write(reinterpret_cast<const char *>(&size), sizeof(size));
+  out.write(reinterpret_cast<const char *>(&tileSize), sizeof(tileSize));
+  out.write(reinterpret_cast<const char *>(&overviewSize),
+      sizeof(overviewSize));
+  out.write(reinterpret_cast<const char *>(&minElevation),
+      sizeof(minElevation));
+  out.write(reinterpret_cast<const char *>(&maxElevation),
+      sizeof(maxElevation));
+
+  // Overview, one sample out of step
+  const unsigned int step = (_size - 1) / (_overviewSize - 1);
+  std::vector<float> row(std::max(_overviewSize, _tileSize));
+  for (unsigned int y = 0; y < _overviewSize; ++y)
+  {
+    for (unsigned int x = 0; x < _overviewSize; ++x)
+      row[x] = _heights[static_cast<std::size_t>(y * step) * _size + x * step];
+    out.write(reinterpret_cast<const char *>(row.data()),
+        _overviewSize * sizeof(float));
+  }
+
+  // Tiles, sharing their border samples
+  const unsigned int cells = _tileSize - 1;
+  const unsigned int tileCount = (_size - 1) / cells;
+  for (unsigned int ty = 0; ty < tileCount; ++ty)
+  {
+    for (unsigned int tx = 0; tx < tileCount; ++tx)
+    {
+      for (unsigned int y = 0; y < _tileSize; ++y)
+      {
+        const float *src = _heights.data() +
+            static_cast<std::size_t>(ty * cells + y) * _size + tx * cells;
+        out.write(reinterpret_cast<const char *>(src),
+            _tileSize * sizeof(float));
+      }
+    }
+  }
+
+  return out.good();
+}
+
+//////////////////////////////////////////////////
+std::string HeightmapTileCache::Filename() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->filename;
+}
+
+//////////////////////////////////////////////////
+unsigned int HeightmapTileCache::Size() const
+{
+  return this->dataPtr->filename.empty() ? 0u : this->dataPtr->header.size;
+}
+
+//////////////////////////////////////////////////
+unsigned int HeightmapTileCache::TileSize() const
+{
+  return this->dataPtr->filename.empty() ? 0u :
+      this->dataPtr->header.tileSize;
+}
+
+//////////////////////////////////////////////////
+unsigned int HeightmapTileCache::TileCount() const
+{
+  return this->dataPtr->tileCount;
+}
+
+//////////////////////////////////////////////////
+float HeightmapTileCache::MinElevation() const
+{
+  return this->dataPtr->header.minElevation;
+}
+
+//////////////////////////////////////////////////
+float HeightmapTileCache::MaxElevation() const
+{
+  return this->dataPtr->header.maxElevation;
+}
+
+//////////////////////////////////////////////////
+unsigned int HeightmapTileCache::OverviewSize() const
+{
+  return this->dataPtr->filename.empty() ? 0u :
+      this->dataPtr->header.overviewSize;
+}
+
+//////////////////////////////////////////////////
+const std::vector<float> &HeightmapTileCache::Overview() const
+{
+  return this->dataPtr->overview;
+}
+
+//////////////////////////////////////////////////
+HeightmapTileCache::Tile HeightmapTileCache::TileAt(const unsigned int _x,
+    const unsigned int _y)
+{
+  if (_x >= this->dataPtr->tileCount || _y >= this->dataPtr->tileCount)
+    return nullptr;
+
+  const unsigned int index = _y * this->dataPtr->tileCount + _x;
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  auto &lru = this->dataPtr->lru;
+  auto it = this->dataPtr->lruIndex[index];
+  if (it != lru.end())
+  {
+    lru.splice(lru.begin(), lru, it);
+    return it->second;
+  }
+
+  // Reuse a tile dropped from the cache but still held by a caller
+  Tile tile = this->dataPtr->weakTiles[index].lock();
+  if (!tile)
+  {
+    tile = this->dataPtr->Read(index);
+    if (!tile)
+      return nullptr;
+    this->dataPtr->weakTiles[index] = tile;
+  }
+
+  lru.emplace_front(index, tile);
+  this->dataPtr->lruIndex[index] = lru.begin();
+  this->dataPtr->Trim();
+  return tile;
+}
+
+//////////////////////////////////////////////////
+float HeightmapTileCache::Height(const unsigned int _x, const unsigned int _y)
+{
+  const unsigned int size = this->Size();
+  if (_x >= size || _y >= size)
+    return 0.0f;
+
+  // Samples on a tile border belong to the tile before them, except on the
+  // last row and column
+  const unsigned int cells = this->dataPtr->header.tileSize - 1;
+  const unsigned int tx =
+      std::min(_x / cells, this->dataPtr->tileCount - 1);
+  const unsigned int ty =
+      std::min(_y / cells, this->dataPtr->tileCount - 1);
+
+  Tile tile = this->TileAt(tx, ty);
+  if (!tile)
+    return 0.0f;
+
+  return (*tile)[(_y - ty * cells) * this->dataPtr->header.tileSize +
+      (_x - tx * cells)];
+}
+
+//////////////////////////////////////////////////
+float HeightmapTileCache::OverviewHeight(const unsigned int _x,
+    const unsigned int _y) const
+{
+  const unsigned int size = this->Size();
+  const unsigned int overviewSize = this->OverviewSize();
+  if (_x >= size || _y >= size || this->dataPtr->overview.empty())
+    return 0.0f;
+
+  // Overview samples are one out of step, bilinear in between
+  const unsigned int step = (size - 1) / (overviewSize - 1);
+  const unsigned int ox = std::min(_x / step, overviewSize - 2);
+  const unsigned int oy = std::min(_y / step, overviewSize - 2);
+  const float fx = static_cast<float>(_x - ox * step) / step;
+  const float fy = static_cast<float>(_y - oy * step) / step;
+
+  const float *row = this->dataPtr->overview.data() + oy * overviewSize + ox;
+  const float top = row[0] + (row[1] - row[0]) * fx;
+  const float bottom = row[overviewSize] +
+      (row[overviewSize + 1] - row[overviewSize]) * fx;
+  return top + (bottom - top) * fy;
+}
+
+//////////////////////////////////////////////////
+void HeightmapTileCache::SetCapacity(const unsigned int _capacity)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->capacity = std::max(1u, _capacity);
+  this->dataPtr->Trim();
+}
+
+//////////////////////////////////////////////////
+unsigned int HeightmapTileCache::Capacity() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->capacity;
+}
+
+//////////////////////////////////////////////////
+unsigned int HeightmapTileCache::ResidentTileCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return static_cast<unsigned int>(this->dataPtr->lru.size());
+}
+
+//////////////////////////////////////////////////
+unsigned int HeightmapTileCache::TileReadCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->reads;
+}
@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_HEIGHTMAPTILECACHE_HH_
+#define GAZEBO_COMMON_HEIGHTMAPTILECACHE_HH_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    // Forward declare private data class.
+    class HeightmapTileCachePrivate;
+
+    /// \addtogroup gazebo_common Common
+    /// \{
+
+    /// \class HeightmapTileCache HeightmapTileCache.hh common/common.hh
+    /// \brief Streams the tiles of a tiled heightmap file.
+    ///
+    /// A tiled heightmap stores a square grid of size 2^n+1 samples, in
+    /// meters, split in square tiles of 2^k+1 samples that share their
+    /// border samples. Rows are stored in the order produced by
+    /// HeightmapData::FillHeightMap with _flipY set to false. The file also
+    /// holds a decimated overview of the whole terrain.
+    ///
+    /// Only the overview is kept in memory when the file is opened. Tiles
+    /// are read from the file on demand and the least recently used ones
+    /// are dropped once the capacity is exceeded. Tiles that are still
+    /// referenced by a caller stay valid after they leave the cache.
+    ///
+    /// Use Acquire to share one cache between the physics and rendering
+    /// heightmaps of a process.
+    class GZ_COMMON_VISIBLE HeightmapTileCache
+    {
+      /// \brief Samples of a tile, row by row.
+      public: typedef std::shared_ptr<const std::vector<float>> Tile;
+
+      /// \brief Constructor.
+      public: HeightmapTileCache();
+
+      /// \brief Destructor.
+      public: ~HeightmapTileCache();
+
+      /// \brief Open a tiled heightmap file.
+      /// \param[in] _filename Path to the file.
+      /// \return True on success.
+      public: bool Load(const std::string &_filename);
+
+      /// \brief Get the tile cache of a file, shared with every other
+      /// caller that acquired the same file.
+      /// \param[in] _filename Path to the file.
+      /// \return The cache, null if the file could not be opened.
+      public: static std::shared_ptr<HeightmapTileCache> Acquire(
+                  const std::string &_filename);
+
+      /// \brief Check whether a file is a tiled heightmap.
+      /// \param[in] _filename Path to the file.
+      /// \return True if the file starts with a tiled heightmap header.
+      public: static bool IsTiledFile(const std::string &_filename);
+
+      /// \brief Write a tiled heightmap file.
+      /// \param[in] _filename Path to the file.
+      /// \param[in] _heights Heights in meters, _size by _size samples.
+      /// \param[in] _size Number of samples per side, must be 2^n+1.
+      /// \param[in] _tileSize Number of samples per tile side, must be
+      /// 2^k+1 and not larger than _size.
+      /// \param[in] _overviewSize Number of samples per side of the
+      /// overview, must be 2^m+1 and not larger than _size.
+      /// \return True on success.
+      public: static bool Write(const std::string &_filename,
+                  const std::vector<float> &_heights,
+                  const unsigned int _size, const unsigned int _tileSize,
+                  const unsigned int _overviewSize);
+
+      /// \brief Get the path of the open file.
+      /// \return Path to the file, empty if no file is open.
+      public: std::string Filename() const;
+
+      /// \brief Get the number of samples per side of the terrain.
+      /// \return Number of samples, 2^n+1.
+      public: unsigned int Size() const;
+
+      /// \brief Get the number of samples per side of a tile.
+      /// \return Number of samples, 2^k+1.
+      public: unsigned int TileSize() const;
+
+      /// \brief Get the number of tiles per side of the terrain.
+      /// \return Number of tiles.
+      public: unsigned int TileCount() const;
+
+      /// \brief Get the lowest height of the terrain.
+      /// \return Height in meters.
+      public: float MinElevation() const;
+
+      /// \brief Get the highest height of the terrain.
+      /// \return Height in meters.
+      public: float MaxElevation() const;
+
+      /// \brief Get the number of samples per side of the overview.
+      /// \return Number of samples, 2^m+1.
+      public: unsigned int OverviewSize() const;
+
+      /// \brief Get the overview of the terrain.
+      /// \return OverviewSize() by OverviewSize() heights in meters.
+      public: const std::vector<float> &Overview() const;
+
+      /// \brief Get a tile, reading it from the file if needed.
+      /// \param[in] _x Column of the tile.
+      /// \param[in] _y Row of the tile.
+      /// \return The tile, null if out of range or on read error.
+      public: Tile TileAt(const unsigned int _x, const unsigned int _y);
+
+      /// \brief Get the height of a sample, reading its tile if needed.
+      /// \param[in] _x Column of the sample.
+      /// \param[in] _y Row of the sample.
+      /// \return Height in meters, zero if out of range.
+      public: float Height(const unsigned int _x, const unsigned int _y);
+
+      /// \brief Get the height of a sample interpolated from the overview.
+      /// This never reads from the file.
+      /// \param[in] _x Column of the sample.
+      /// \param[in] _y Row of the sample.
+      /// \return Height in meters, zero if out of range.
+      public: float OverviewHeight(const unsigned int _x,
+                  const unsigned int _y) const;
+
+      /// \brief Set the number of tiles kept in memory.
+      /// \param[in] _capacity Number of tiles, at least one.
+      public: void SetCapacity(const unsigned int _capacity);
+
+      /// \brief Get the number of tiles kept in memory.
+      /// \return Number of tiles.
+      public: unsigned int Capacity() const;
+
+      /// \brief Get the number of tiles currently in memory.
+      /// \return Number of tiles.
+      public: unsigned int ResidentTileCount() const;
+
+      /// \brief Get the number of tiles read from the file so far.
+      /// \return Number of reads.
+      public: unsigned int TileReadCount() const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<HeightmapTileCachePrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <boost/filesystem.hpp>
+#include <gtest/gtest.h>
+
+#include "gazebo/common/HeightmapTileCache.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class HeightmapTileCacheTest : public gazebo::testing::AutoLogFixture
+{
+  /// \brief Write a tiled heightmap with a height equal to 10 * x + y.
+  /// \param[in] _size Samples per side.
+  /// \param[in] _tileSize Samples per tile side.
+  /// \return Path of the file.
+  public: std::string WriteTerrain(const unsigned int _size,
+              const unsigned int _tileSize)
+  {
+    std::vector<float> heights(_size * _size);
+    for (unsigned int y = 0; y < _size; ++y)
+    {
+      for (unsigned int x = 0; x < _size; ++x)
+        heights[y * _size + x] = 10.0f * x + y;
+    }
+
+    this->path = boost::filesystem::temp_directory_path() /
+        boost::filesystem::unique_path("heightmap-%%%%-%%%%.gzt");
+    EXPECT_TRUE(common::HeightmapTileCache::Write(this->path.string(),
+        heights, _size, _tileSize, 5));
+    return this->path.string();
+  }
+
+  /// \brief Remove the file.
+  public: virtual void TearDown()
+  {
+    if (!this->path.empty())
+      boost::filesystem::remove(this->path);
+    AutoLogFixture::TearDown();
+  }
+
+  /// \brief Path of the written file.
+  public: boost::filesystem::path path;
+};
+
+/////////////////////////////////////////////////
+TEST_F(HeightmapTileCacheTest, InvalidFiles)
+{
+  common::HeightmapTileCache cache;
+  EXPECT_FALSE(cache.Load("/file/shouldn/never/exist.gzt"));
+  EXPECT_FALSE(common::HeightmapTileCache::IsTiledFile(
+      "/file/shouldn/never/exist.gzt"));
+  EXPECT_EQ(nullptr,
+      common::HeightmapTileCache::Acquire("/file/shouldn/never/exist.gzt"));
+  EXPECT_EQ(0u, cache.Size());
+  EXPECT_EQ(nullptr, cache.TileAt(0, 0));
+
+  // Sizes must be 2^n+1
+  std::vector<float> heights(16 * 16, 0.0f);
+  EXPECT_FALSE(common::HeightmapTileCache::Write("unused.gzt", heights,
+      16, 5, 5));
+  heights.resize(17 * 17);
+  EXPECT_FALSE(common::HeightmapTileCache::Write("unused.gzt", heights,
+      17, 6, 5));
+  EXPECT_FALSE(common::HeightmapTileCache::Write("unused.gzt", heights,
+      17, 33, 5));
+}
+
+/////////////////////////////////////////////////
+TEST_F(HeightmapTileCacheTest, Tiles)
+{
+  std::string filename = this->WriteTerrain(33, 9);
+  EXPECT_TRUE(common::HeightmapTileCache::IsTiledFile(filename));
+
+  common::HeightmapTileCache cache;
+  ASSERT_TRUE(cache.Load(filename));
+  EXPECT_EQ(filename, cache.Filename());
+  EXPECT_EQ(33u, cache.Size());
+  EXPECT_EQ(9u, cache.TileSize());
+  EXPECT_EQ(4u, cache.TileCount());
+  EXPECT_FLOAT_EQ(0.0f, cache.MinElevation());
+  EXPECT_FLOAT_EQ(352.0f, cache.MaxElevation());
+
+  // The overview keeps one sample out of 8
+  ASSERT_EQ(5u, cache.OverviewSize());
+  ASSERT_EQ(25u, cache.Overview().size());
+  EXPECT_FLOAT_EQ(0.0f, cache.Overview()[0]);
+  EXPECT_FLOAT_EQ(80.0f, cache.Overview()[1]);
+  EXPECT_FLOAT_EQ(8.0f, cache.Overview()[5]);
+  EXPECT_FLOAT_EQ(352.0f, cache.Overview()[24]);
+
+  // Nothing is read until asked for
+  EXPECT_EQ(0u, cache.TileReadCount());
+  EXPECT_EQ(0u, cache.ResidentTileCount());
+
+  // The overview interpolates the linear terrain exactly, without reads
+  for (unsigned int y = 0; y < 33; ++y)
+  {
+    for (unsigned int x = 0; x < 33; ++x)
+    {
+      ASSERT_FLOAT_EQ(10.0f * x + y, cache.OverviewHeight(x, y))
+          << x << " " << y;
+    }
+  }
+  EXPECT_FLOAT_EQ(0.0f, cache.OverviewHeight(0, 33));
+  EXPECT_EQ(0u, cache.TileReadCount());
+
+  // Every sample, including the shared borders
+  for (unsigned int y = 0; y < 33; ++y)
+  {
+    for (unsigned int x = 0; x < 33; ++x)
+      ASSERT_FLOAT_EQ(10.0f * x + y, cache.Height(x, y)) << x << " " << y;
+  }
+  EXPECT_FLOAT_EQ(0.0f, cache.Height(33, 0));
+  EXPECT_EQ(16u, cache.TileReadCount());
+
+  // Neighbouring tiles share their border
+  auto tile = cache.TileAt(1, 2);
+  ASSERT_NE(nullptr, tile);
+  ASSERT_EQ(81u, tile->size());
+  EXPECT_FLOAT_EQ(10.0f * 8 + 16, (*tile)[0]);
+  EXPECT_FLOAT_EQ(10.0f * 16 + 24, (*tile)[80]);
+  EXPECT_EQ(nullptr, cache.TileAt(4, 0));
+}
+
+/////////////////////////////////////////////////
+TEST_F(HeightmapTileCacheTest, Eviction)
+{
+  std::string filename = this->WriteTerrain(33, 9);
+  common::HeightmapTileCache cache;
+  ASSERT_TRUE(cache.Load(filename));
+
+  cache.SetCapacity(0);
+  EXPECT_EQ(1u, cache.Capacity());
+  cache.SetCapacity(2);
+  EXPECT_EQ(2u, cache.Capacity());
+
+  auto held = cache.TileAt(0, 0);
+  cache.TileAt(1, 0);
+  cache.TileAt(2, 0);
+  EXPECT_EQ(2u, cache.ResidentTileCount());
+  EXPECT_EQ(3u, cache.TileReadCount());
+
+  // A tile held by a caller is not read again
+  EXPECT_EQ(held, cache.TileAt(0, 0));
+  EXPECT_EQ(3u, cache.TileReadCount());
+
+  // A dropped tile is read again
+  cache.TileAt(1, 0);
+  cache.TileAt(2, 0);
+  EXPECT_EQ(5u, cache.TileReadCount());
+
+  // Recently used tiles stay
+  cache.TileAt(2, 0);
+  EXPECT_EQ(5u, cache.TileReadCount());
+}
+
+/////////////////////////////////////////////////
+TEST_F(HeightmapTileCacheTest, Acquire)
+{
+  std::string filename = this->WriteTerrain(17, 5);
+
+  auto physicsCache = common::HeightmapTileCache::Acquire(filename);
+  auto renderingCache = common::HeightmapTileCache::Acquire(filename);
+  ASSERT_NE(nullptr, physicsCache);
+  EXPECT_EQ(physicsCache, renderingCache);
+
+  // Released once nobody holds it
+  std::weak_ptr<common::HeightmapTileCache> weak = physicsCache;
+  physicsCache.reset();
+  renderingCache.reset();
+  EXPECT_TRUE(weak.expired());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
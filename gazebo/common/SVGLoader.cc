@@ -19,6 +19,7 @@
 #include <tinyxml.h>
 #include <utility>
 #include <cmath>
+#include <list>
 
 #include <gazebo/common/Console.hh>
 #include <gazebo/common/Assert.hh>
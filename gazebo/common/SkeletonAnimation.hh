@@ -200,6 +200,24 @@ namespace gazebo
                   const double _x, const std::string &_node,
                   const bool _loop = true) const;
 
+      /// \brief Returns the time where a named node transformation's
+      /// translational value along the X axis is equal to _x. This is the
+      /// time at which PoseAtX samples the animation.
+      /// \param[in] _x the value along x. You must ensure that _x is within a
+      /// valid range.
+      /// \param[in] _node the name of the animation node
+      /// \param[in] _loop when true, _x wraps around the distance covered
+      /// by the animation
+      /// \return the time, in seconds
+      public: double TimeAtX(const double _x, const std::string &_node,
+                  const bool _loop = true) const;
+
+      /// \brief Returns the animation of a node. The pointer stays valid
+      /// as long as this skeleton animation exists.
+      /// \param[in] _node the name of the animation node
+      /// \return the node animation, or null if the node is not animated
+      public: const NodeAnimation *NodeAnimationByName(
+                  const std::string &_node) const;
 
       /// \brief Scales every animation in the animations list
       /// \param[in] _scale the scaling factor
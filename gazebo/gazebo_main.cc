@@ -70,6 +70,8 @@ void help()
   << "                                the world file.\n"
   << "  --lockstep                    Lockstep simulation so sensor update "
   <<                                  "rates are respected.\n"
+  << "  --compact-poses               Send poses to the GUI through the "
+  <<                                  "compact pose stream.\n"
   << "\n";
 }
 
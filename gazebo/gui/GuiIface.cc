@@ -36,6 +36,7 @@
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Plugin.hh"
 #include "gazebo/common/CommonTypes.hh"
+#include "gazebo/rendering/RenderingIface.hh"
 #include "gazebo/gui/SplashScreen.hh"
 #include "gazebo/gui/MainWindow.hh"
 #include "gazebo/gui/ModelRightMenu.hh"
@@ -158,7 +159,9 @@ bool parse_args(int _argc, char **_argv)
     ("gui-client-plugin", po::value<std::vector<std::string> >(),
      "Load a GUI plugin.")
     ("gui-plugin,g", po::value<std::vector<std::string> >(),
-     "Load a System plugin (deprecated, backwards compatibility reasons).");
+     "Load a System plugin (deprecated, backwards compatibility reasons).")
+    ("compact-poses", "Receive poses through the compact pose stream, "
+     "which uses less bandwidth but quantizes them.");
 
   po::options_description desc("Options");
   desc.add(v_desc);
@@ -193,6 +196,9 @@ bool parse_args(int _argc, char **_argv)
     gazebo::common::Console::SetQuiet(false);
   }
 
+  if (vm.count("compact-poses"))
+    rendering::set_compact_poses_enabled(true);
+
   /// Load the System plugins specified on the command line
   /// see https://github.com/osrf/gazebo/issues/2279 for details
   if (vm.count("gui-plugin"))
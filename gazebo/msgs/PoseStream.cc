@@ -0,0 +1,435 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/msgs/PoseStream.hh"
+
+using namespace gazebo;
+using namespace msgs;
+
+namespace
+{
+  /// \brief Scale of the quantized quaternion components.
+  const double kOrientationScale = 32767.0;
+
+  /// \brief A quantized pose.
+  struct QuantizedPose
+  {
+    /// \brief Position in units of the stream's position resolution.
+    int64_t pos[3];
+
+    /// \brief Quaternion x, y, z, w in units of 1 / kOrientationScale.
+    int32_t rot[4];
+
+    /// \brief Equality operator.
+    bool operator==(const QuantizedPose &_other) const
+    {
+      return std::equal(this->pos, this->pos + 3, _other.pos) &&
+             std::equal(this->rot, this->rot + 4, _other.rot);
+    }
+  };
+
+  /// \brief Quantize a pose.
+  /// \param[in] _pose Pose to quantize.
+  /// \param[in] _resolution Size of one position unit.
+  /// \return Quantized pose.
+  QuantizedPose Quantize(const ignition::math::Pose3d &_pose,
+      const double _resolution)
+  {
+    QuantizedPose q;
+    q.pos[0] = std::llround(_pose.Pos().X() / _resolution);
+    q.pos[1] = std::llround(_pose.Pos().Y() / _resolution);
+    q.pos[2] = std::llround(_pose.Pos().Z() / _resolution);
+
+    // q and -q are the same rotation, keep w positive so that small
+    // rotations do not show up as large deltas.
+    const double sign = _pose.Rot().W() < 0 ? -1.0 : 1.0;
+    q.rot[0] = std::lround(sign * _pose.Rot().X() * kOrientationScale);
+    q.rot[1] = std::lround(sign * _pose.Rot().Y() * kOrientationScale);
+    q.rot[2] = std::lround(sign * _pose.Rot().Z() * kOrientationScale);
+    q.rot[3] = std::lround(sign * _pose.Rot().W() * kOrientationScale);
+    return q;
+  }
+
+  /// \brief Convert a quantized pose back to a pose.
+  /// \param[in] _q Quantized pose.
+  /// \param[in] _resolution Size of one position unit.
+  /// \return The pose.
+  ignition::math::Pose3d Dequantize(const QuantizedPose &_q,
+      const double _resolution)
+  {
+    ignition::math::Quaterniond rot(
+        _q.rot[3] / kOrientationScale, _q.rot[0] / kOrientationScale,
+        _q.rot[1] / kOrientationScale, _q.rot[2] / kOrientationScale);
+    rot.Normalize();
+    return ignition::math::Pose3d(
+        ignition::math::Vector3d(_q.pos[0] * _resolution,
+          _q.pos[1] * _resolution, _q.pos[2] * _resolution), rot);
+  }
+}
+
+namespace gazebo
+{
+  namespace msgs
+  {
+    /// \internal
+    /// \brief Private data for PoseStreamEncoder.
+    class PoseStreamEncoderPrivate
+    {
+      /// \brief Size of one position unit.
+      public: double resolution;
+
+      /// \brief Number of frames between keyframes.
+      public: unsigned int keyframeInterval;
+
+      /// \brief Latest pose of every entity.
+      public: std::unordered_map<uint32_t, QuantizedPose> current;
+
+      /// \brief Poses sent in the last keyframe.
+      public: std::unordered_map<uint32_t, QuantizedPose> keyframe;
+
+      /// \brief Entities whose current pose differs from the keyframe.
+      /// Ordered, since ids are sent as increasing differences.
+      public: std::set<uint32_t> changed;
+
+      /// \brief Names of the entities.
+      public: std::unordered_map<uint32_t, std::string> names;
+
+      /// \brief Sorted ids of the entities in the last keyframe.
+      public: std::vector<uint32_t> dictionaryIds;
+
+      /// \brief Sequence number of the last keyframe.
+      public: uint32_t keyframeSeq = 0;
+
+      /// \brief Dictionary generation.
+      public: uint32_t generation = 0;
+
+      /// \brief Number of delta frames since the last keyframe.
+      public: unsigned int framesSinceKeyframe = 0;
+
+      /// \brief True if the next frame must be a keyframe.
+      public: bool keyframeRequested = true;
+    };
+
+    /// \internal
+    /// \brief Private data for PoseStreamDecoder.
+    class PoseStreamDecoderPrivate
+    {
+      /// \brief Names of the entities.
+      public: std::unordered_map<uint32_t, std::string> names;
+
+      /// \brief Poses of the last keyframe.
+      public: std::unordered_map<uint32_t, QuantizedPose> keyframe;
+
+      /// \brief Position resolution of the last keyframe.
+      public: double resolution = 1.0;
+
+      /// \brief Sequence number of the last keyframe.
+      public: uint32_t keyframeSeq = 0;
+
+      /// \brief True once a keyframe was received.
+      public: bool haveKeyframe = false;
+
+      /// \brief Sorted ids of the entities in the previous delta frame.
+      public: std::vector<uint32_t> deviated;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+PoseStreamEncoder::PoseStreamEncoder(const double _positionResolution,
+    const unsigned int _keyframeInterval)
+  : dataPtr(new PoseStreamEncoderPrivate)
+{
+  this->dataPtr->resolution = _positionResolution;
+  this->dataPtr->keyframeInterval = _keyframeInterval;
+}
+
+/////////////////////////////////////////////////
+PoseStreamEncoder::~PoseStreamEncoder()
+{
+}
+
+/////////////////////////////////////////////////
+bool PoseStreamEncoder::HasName(const uint32_t _id) const
+{
+  return this->dataPtr->names.find(_id) != this->dataPtr->names.end();
+}
+
+/////////////////////////////////////////////////
+void PoseStreamEncoder::SetName(const uint32_t _id, const std::string &_name)
+{
+  this->dataPtr->names[_id] = _name;
+}
+
+/////////////////////////////////////////////////
+void PoseStreamEncoder::Update(const uint32_t _id,
+    const ignition::math::Pose3d &_pose)
+{
+  const QuantizedPose q = Quantize(_pose, this->dataPtr->resolution);
+  this->dataPtr->current[_id] = q;
+
+  auto iter = this->dataPtr->keyframe.find(_id);
+  if (iter == this->dataPtr->keyframe.end())
+    this->dataPtr->keyframeRequested = true;
+  else if (iter->second == q)
+    this->dataPtr->changed.erase(_id);
+  else
+    this->dataPtr->changed.insert(_id);
+}
+
+/////////////////////////////////////////////////
+void PoseStreamEncoder::Clear()
+{
+  this->dataPtr->current.clear();
+  this->dataPtr->changed.clear();
+  this->dataPtr->keyframeRequested = true;
+}
+
+/////////////////////////////////////////////////
+bool PoseStreamEncoder::KeyframeDue() const
+{
+  return this->dataPtr->keyframeRequested ||
+    this->dataPtr->framesSinceKeyframe + 1 >= this->dataPtr->keyframeInterval;
+}
+
+/////////////////////////////////////////////////
+void PoseStreamEncoder::RequestKeyframe()
+{
+  this->dataPtr->keyframeRequested = true;
+}
+
+/////////////////////////////////////////////////
+void PoseStreamEncoder::Encode(const common::Time &_time, CompactPoses &_msg)
+{
+  _msg.Clear();
+  msgs::Set(_msg.mutable_time(), _time);
+  _msg.set_position_resolution(this->dataPtr->resolution);
+
+  const bool keyframe = this->KeyframeDue();
+  std::vector<uint32_t> ids;
+
+  if (keyframe)
+  {
+    ids.reserve(this->dataPtr->current.size());
+    for (auto const &entity : this->dataPtr->current)
+      ids.push_back(entity.first);
+    std::sort(ids.begin(), ids.end());
+
+    // A new set of entities needs a new dictionary
+    if (ids != this->dataPtr->dictionaryIds)
+    {
+      this->dataPtr->dictionaryIds = ids;
+      this->dataPtr->generation++;
+      for (auto iter = this->dataPtr->names.begin();
+           iter != this->dataPtr->names.end();)
+      {
+        if (this->dataPtr->current.count(iter->first) == 0)
+          iter = this->dataPtr->names.erase(iter);
+        else
+          ++iter;
+      }
+    }
+
+    this->dataPtr->keyframe = this->dataPtr->current;
+    this->dataPtr->changed.clear();
+    this->dataPtr->keyframeSeq++;
+    this->dataPtr->framesSinceKeyframe = 0;
+    this->dataPtr->keyframeRequested = false;
+  }
+  else
+  {
+    ids.assign(this->dataPtr->changed.begin(), this->dataPtr->changed.end());
+    this->dataPtr->framesSinceKeyframe++;
+  }
+
+  _msg.set_keyframe(this->dataPtr->keyframeSeq);
+  _msg.set_is_keyframe(keyframe);
+  _msg.set_dictionary(this->dataPtr->generation);
+
+  _msg.mutable_id()->Reserve(ids.size());
+  _msg.mutable_position()->Reserve(ids.size() * 3);
+  _msg.mutable_orientation()->Reserve(ids.size() * 4);
+
+  uint32_t prevId = 0;
+  for (const uint32_t id : ids)
+  {
+    _msg.add_id(id - prevId);
+    prevId = id;
+
+    const QuantizedPose &q = this->dataPtr->current[id];
+    if (keyframe)
+    {
+      for (int i = 0; i < 3; ++i)
+        _msg.add_position(q.pos[i]);
+      for (int i = 0; i < 4; ++i)
+        _msg.add_orientation(q.rot[i]);
+    }
+    else
+    {
+      const QuantizedPose &k = this->dataPtr->keyframe[id];
+      for (int i = 0; i < 3; ++i)
+        _msg.add_position(q.pos[i] - k.pos[i]);
+      for (int i = 0; i < 4; ++i)
+        _msg.add_orientation(q.rot[i] - k.rot[i]);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+uint32_t PoseStreamEncoder::Generation() const
+{
+  return this->dataPtr->generation;
+}
+
+/////////////////////////////////////////////////
+void PoseStreamEncoder::FillDictionary(PoseDictionary &_msg) const
+{
+  _msg.Clear();
+  _msg.set_generation(this->dataPtr->generation);
+  for (const uint32_t id : this->dataPtr->dictionaryIds)
+  {
+    auto iter = this->dataPtr->names.find(id);
+    _msg.add_id(id);
+    _msg.add_name(iter != this->dataPtr->names.end() ? iter->second : "");
+  }
+}
+
+/////////////////////////////////////////////////
+PoseStreamDecoder::PoseStreamDecoder()
+  : dataPtr(new PoseStreamDecoderPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+PoseStreamDecoder::~PoseStreamDecoder()
+{
+}
+
+/////////////////////////////////////////////////
+void PoseStreamDecoder::SetDictionary(const PoseDictionary &_msg)
+{
+  this->dataPtr->names.clear();
+  const int count = std::min(_msg.id_size(), _msg.name_size());
+  for (int i = 0; i < count; ++i)
+    this->dataPtr->names[_msg.id(i)] = _msg.name(i);
+}
+
+/////////////////////////////////////////////////
+std::string PoseStreamDecoder::Name(const uint32_t _id) const
+{
+  auto iter = this->dataPtr->names.find(_id);
+  if (iter == this->dataPtr->names.end())
+    return "";
+  return iter->second;
+}
+
+/////////////////////////////////////////////////
+bool PoseStreamDecoder::Decode(const CompactPoses &_msg, PosesStamped &_poses)
+{
+  const int count = _msg.id_size();
+  if (_msg.position_size() != count * 3 ||
+      _msg.orientation_size() != count * 4)
+  {
+    return false;
+  }
+
+  if (!_msg.is_keyframe() && (!this->dataPtr->haveKeyframe ||
+        _msg.keyframe() != this->dataPtr->keyframeSeq))
+  {
+    return false;
+  }
+
+  _poses.Clear();
+  _poses.mutable_time()->CopyFrom(_msg.time());
+
+  auto addPose = [&](const uint32_t _id, const QuantizedPose &_q)
+  {
+    msgs::Pose *pose = _poses.add_pose();
+    pose->set_id(_id);
+    auto name = this->dataPtr->names.find(_id);
+    if (name != this->dataPtr->names.end())
+      pose->set_name(name->second);
+    msgs::Set(pose, Dequantize(_q, this->dataPtr->resolution));
+  };
+
+  if (_msg.is_keyframe())
+  {
+    this->dataPtr->keyframe.clear();
+    this->dataPtr->deviated.clear();
+    this->dataPtr->keyframeSeq = _msg.keyframe();
+    this->dataPtr->resolution = _msg.position_resolution();
+    this->dataPtr->haveKeyframe = true;
+  }
+
+  std::vector<uint32_t> ids;
+  ids.reserve(count);
+
+  uint32_t id = 0;
+  for (int i = 0; i < count; ++i)
+  {
+    id += _msg.id(i);
+    ids.push_back(id);
+
+    QuantizedPose q;
+    for (int j = 0; j < 3; ++j)
+      q.pos[j] = _msg.position(i * 3 + j);
+    for (int j = 0; j < 4; ++j)
+      q.rot[j] = _msg.orientation(i * 4 + j);
+
+    if (_msg.is_keyframe())
+    {
+      this->dataPtr->keyframe[id] = q;
+    }
+    else
+    {
+      auto base = this->dataPtr->keyframe.find(id);
+      if (base == this->dataPtr->keyframe.end())
+        continue;
+      for (int j = 0; j < 3; ++j)
+        q.pos[j] += base->second.pos[j];
+      for (int j = 0; j < 4; ++j)
+        q.rot[j] += base->second.rot[j];
+    }
+    addPose(id, q);
+  }
+
+  if (!_msg.is_keyframe())
+  {
+    // Entities missing from this delta are back at their keyframe pose
+    std::vector<uint32_t> reverted;
+    std::set_difference(this->dataPtr->deviated.begin(),
+        this->dataPtr->deviated.end(), ids.begin(), ids.end(),
+        std::back_inserter(reverted));
+    for (const uint32_t r : reverted)
+    {
+      auto base = this->dataPtr->keyframe.find(r);
+      if (base != this->dataPtr->keyframe.end())
+        addPose(r, base->second);
+    }
+    this->dataPtr->deviated.swap(ids);
+  }
+
+  return true;
+}
@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GAZEBO_MSGS_POSESTREAM_HH_
+#define GAZEBO_MSGS_POSESTREAM_HH_
+
+#include <memory>
+#include <string>
+#include <ignition/math/Pose3.hh>
+
+#include "gazebo/msgs/MessageTypes.hh"
+#include "gazebo/common/Time.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace msgs
+  {
+    // Forward declare private data classes
+    class PoseStreamEncoderPrivate;
+    class PoseStreamDecoderPrivate;
+
+    /// \addtogroup gazebo_msgs Messages
+    /// \{
+
+    /// \class PoseStreamEncoder PoseStream.hh msgs/PoseStream.hh
+    /// \brief Produces a stream of CompactPoses frames and the
+    /// PoseDictionary that names their entities.
+    ///
+    /// Feed the latest pose of every entity that moved with Update, then
+    /// call Encode to produce a frame. Every few frames, or when an entity
+    /// was added, the next frame is a keyframe. Before encoding it, call
+    /// Clear and Update every entity, so that removed entities are
+    /// dropped.
+    class GZ_MSGS_VISIBLE PoseStreamEncoder
+    {
+      /// \brief Constructor.
+      /// \param[in] _positionResolution Size of one position unit, in
+      /// meters.
+      /// \param[in] _keyframeInterval Number of frames between keyframes.
+      public: explicit PoseStreamEncoder(
+                  const double _positionResolution = 1e-4,
+                  const unsigned int _keyframeInterval = 60);
+
+      /// \brief Destructor.
+      public: ~PoseStreamEncoder();
+
+      /// \brief Check whether an entity already has a name.
+      /// \param[in] _id Entity id.
+      /// \return True if SetName was called for the entity.
+      public: bool HasName(const uint32_t _id) const;
+
+      /// \brief Set the name of an entity. This only needs to be called
+      /// once per entity, so callers can skip building the name when
+      /// HasName returns true.
+      /// \param[in] _id Entity id.
+      /// \param[in] _name Scoped name of the entity.
+      public: void SetName(const uint32_t _id, const std::string &_name);
+
+      /// \brief Set the current pose of an entity.
+      /// \param[in] _id Entity id.
+      /// \param[in] _pose Pose of the entity.
+      public: void Update(const uint32_t _id,
+                  const ignition::math::Pose3d &_pose);
+
+      /// \brief Forget the pose of every entity. Call this before
+      /// updating every entity in the world for a keyframe.
+      public: void Clear();
+
+      /// \brief Check whether the next frame will be a keyframe.
+      /// \return True if the next call to Encode produces a keyframe.
+      public: bool KeyframeDue() const;
+
+      /// \brief Force the next frame to be a keyframe, for example
+      /// because a new subscriber connected.
+      public: void RequestKeyframe();
+
+      /// \brief Encode the next frame.
+      /// \param[in] _time Time stamp of the frame.
+      /// \param[out] _msg Frame to fill.
+      public: void Encode(const common::Time &_time, CompactPoses &_msg);
+
+      /// \brief Generation of the dictionary. It changes every time a
+      /// keyframe adds or removes entities.
+      /// \return The dictionary generation.
+      public: uint32_t Generation() const;
+
+      /// \brief Fill a dictionary message with the names of the entities
+      /// in the last keyframe.
+      /// \param[out] _msg Dictionary to fill.
+      public: void FillDictionary(PoseDictionary &_msg) const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<PoseStreamEncoderPrivate> dataPtr;
+    };
+
+    /// \class PoseStreamDecoder PoseStream.hh msgs/PoseStream.hh
+    /// \brief Turns a stream of CompactPoses frames back into poses.
+    class GZ_MSGS_VISIBLE PoseStreamDecoder
+    {
+      /// \brief Constructor.
+      public: PoseStreamDecoder();
+
+      /// \brief Destructor.
+      public: ~PoseStreamDecoder();
+
+      /// \brief Set the dictionary used to name decoded poses.
+      /// \param[in] _msg Dictionary message.
+      public: void SetDictionary(const PoseDictionary &_msg);
+
+      /// \brief Get the name of an entity.
+      /// \param[in] _id Entity id.
+      /// \return Scoped name, or an empty string if the id is not in the
+      /// dictionary.
+      public: std::string Name(const uint32_t _id) const;
+
+      /// \brief Decode a frame. The output holds every entity whose pose
+      /// changed since the previous frame: all entities for a keyframe,
+      /// and for a delta frame the entities in the frame plus those that
+      /// went back to their keyframe pose.
+      /// \param[in] _msg Frame to decode.
+      /// \param[out] _poses Decoded poses. Names are filled in when the
+      /// dictionary is known.
+      /// \return False if the frame refers to a keyframe that was not
+      /// received, or is malformed.
+      public: bool Decode(const CompactPoses &_msg, PosesStamped &_poses);
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<PoseStreamDecoderPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
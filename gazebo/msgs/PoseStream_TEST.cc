@@ -0,0 +1,222 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <map>
+
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/msgs/PoseStream.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class PoseStreamTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Apply decoded poses to a map of id to pose.
+void Apply(const msgs::PosesStamped &_msg,
+    std::map<uint32_t, ignition::math::Pose3d> &_poses)
+{
+  for (int i = 0; i < _msg.pose_size(); ++i)
+    _poses[_msg.pose(i).id()] = msgs::ConvertIgn(_msg.pose(i));
+}
+
+/////////////////////////////////////////////////
+/// \brief Check that two poses are equal within the stream's quantization.
+void ExpectNear(const ignition::math::Pose3d &_a,
+    const ignition::math::Pose3d &_b)
+{
+  EXPECT_NEAR(_a.Pos().Distance(_b.Pos()), 0.0, 1e-4);
+  EXPECT_NEAR(std::abs(_a.Rot().Dot(_b.Rot())), 1.0, 1e-6);
+}
+
+/////////////////////////////////////////////////
+TEST_F(PoseStreamTest, KeyframeAndDeltas)
+{
+  msgs::PoseStreamEncoder encoder(1e-4, 4);
+  msgs::PoseStreamDecoder decoder;
+
+  std::map<uint32_t, ignition::math::Pose3d> truth;
+  truth[7] = ignition::math::Pose3d(1, 2, 3, 0.1, 0.2, 0.3);
+  truth[3] = ignition::math::Pose3d(-4, 5, -6, 0, 0, 3.1);
+  truth[12] = ignition::math::Pose3d(0, 0, 0.5, 0, 0, 0);
+
+  for (auto const &t : truth)
+  {
+    EXPECT_FALSE(encoder.HasName(t.first));
+    encoder.SetName(t.first, "model_" + std::to_string(t.first));
+    EXPECT_TRUE(encoder.HasName(t.first));
+    encoder.Update(t.first, t.second);
+  }
+
+  // First frame is always a keyframe
+  EXPECT_TRUE(encoder.KeyframeDue());
+  msgs::CompactPoses frame;
+  encoder.Encode(common::Time(1, 0), frame);
+  EXPECT_TRUE(frame.is_keyframe());
+  EXPECT_EQ(3, frame.id_size());
+  EXPECT_EQ(1u, encoder.Generation());
+
+  msgs::PoseDictionary dictionary;
+  encoder.FillDictionary(dictionary);
+  EXPECT_EQ(3, dictionary.name_size());
+  decoder.SetDictionary(dictionary);
+  EXPECT_EQ("model_12", decoder.Name(12));
+  EXPECT_EQ("", decoder.Name(1));
+
+  msgs::PosesStamped decoded;
+  std::map<uint32_t, ignition::math::Pose3d> result;
+  ASSERT_TRUE(decoder.Decode(frame, decoded));
+  EXPECT_EQ(1, decoded.time().sec());
+  EXPECT_EQ(3, decoded.pose_size());
+  EXPECT_EQ("model_3", decoded.pose(0).name());
+  Apply(decoded, result);
+  for (auto const &t : truth)
+    ExpectNear(t.second, result[t.first]);
+
+  // Nothing moved, the delta is empty
+  EXPECT_FALSE(encoder.KeyframeDue());
+  encoder.Encode(common::Time(2, 0), frame);
+  EXPECT_FALSE(frame.is_keyframe());
+  EXPECT_EQ(0, frame.id_size());
+  ASSERT_TRUE(decoder.Decode(frame, decoded));
+  EXPECT_EQ(0, decoded.pose_size());
+
+  // One entity moves
+  truth[7].Pos().Z() += 0.25;
+  encoder.Update(7, truth[7]);
+  encoder.Encode(common::Time(3, 0), frame);
+  EXPECT_FALSE(frame.is_keyframe());
+  EXPECT_EQ(1, frame.id_size());
+  ASSERT_TRUE(decoder.Decode(frame, decoded));
+  ASSERT_EQ(1, decoded.pose_size());
+  Apply(decoded, result);
+  ExpectNear(truth[7], result[7]);
+
+  // It moves back to its keyframe pose, which the decoder must report
+  truth[7].Pos().Z() -= 0.25;
+  encoder.Update(7, truth[7]);
+  encoder.Encode(common::Time(4, 0), frame);
+  EXPECT_EQ(0, frame.id_size());
+  ASSERT_TRUE(decoder.Decode(frame, decoded));
+  ASSERT_EQ(1, decoded.pose_size());
+  Apply(decoded, result);
+  ExpectNear(truth[7], result[7]);
+
+  // The keyframe interval has elapsed
+  EXPECT_TRUE(encoder.KeyframeDue());
+  encoder.Encode(common::Time(5, 0), frame);
+  EXPECT_TRUE(frame.is_keyframe());
+  EXPECT_EQ(1u, encoder.Generation());
+}
+
+/////////////////////////////////////////////////
+TEST_F(PoseStreamTest, AddRemove)
+{
+  msgs::PoseStreamEncoder encoder(1e-3, 100);
+  msgs::PoseStreamDecoder decoder;
+  msgs::CompactPoses frame;
+  msgs::PosesStamped decoded;
+
+  encoder.SetName(1, "a");
+  encoder.Update(1, ignition::math::Pose3d(1, 0, 0, 0, 0, 0));
+  encoder.Encode(common::Time(1, 0), frame);
+  ASSERT_TRUE(decoder.Decode(frame, decoded));
+  EXPECT_FALSE(encoder.KeyframeDue());
+
+  // A new entity forces a keyframe and a new dictionary
+  encoder.SetName(2, "b");
+  encoder.Update(2, ignition::math::Pose3d(2, 0, 0, 0, 0, 0));
+  EXPECT_TRUE(encoder.KeyframeDue());
+  encoder.Encode(common::Time(2, 0), frame);
+  EXPECT_TRUE(frame.is_keyframe());
+  EXPECT_EQ(2u, encoder.Generation());
+
+  // Removing an entity: clear and update the remaining ones
+  encoder.Clear();
+  encoder.Update(2, ignition::math::Pose3d(2, 0, 0, 0, 0, 0));
+  encoder.Encode(common::Time(3, 0), frame);
+  EXPECT_TRUE(frame.is_keyframe());
+  EXPECT_EQ(1, frame.id_size());
+  EXPECT_EQ(3u, encoder.Generation());
+  EXPECT_FALSE(encoder.HasName(1));
+
+  msgs::PoseDictionary dictionary;
+  encoder.FillDictionary(dictionary);
+  ASSERT_EQ(1, dictionary.id_size());
+  EXPECT_EQ(2u, dictionary.id(0));
+  EXPECT_EQ("b", dictionary.name(0));
+}
+
+/////////////////////////////////////////////////
+TEST_F(PoseStreamTest, MissingKeyframe)
+{
+  msgs::PoseStreamEncoder encoder;
+  msgs::CompactPoses keyframe, delta;
+  msgs::PosesStamped decoded;
+
+  encoder.Update(5, ignition::math::Pose3d(0, 0, 1, 0, 0, 0));
+  encoder.Encode(common::Time(1, 0), keyframe);
+  encoder.Update(5, ignition::math::Pose3d(0, 0, 2, 0, 0, 0));
+  encoder.Encode(common::Time(2, 0), delta);
+  EXPECT_FALSE(delta.is_keyframe());
+
+  // A decoder that joins late waits for the next keyframe
+  msgs::PoseStreamDecoder decoder;
+  EXPECT_FALSE(decoder.Decode(delta, decoded));
+  EXPECT_TRUE(decoder.Decode(keyframe, decoded));
+  EXPECT_TRUE(decoder.Decode(delta, decoded));
+  ASSERT_EQ(1, decoded.pose_size());
+  EXPECT_NEAR(2.0, decoded.pose(0).position().z(), 1e-4);
+
+  // Malformed frames are rejected
+  delta.add_position(1);
+  EXPECT_FALSE(decoder.Decode(delta, decoded));
+}
+
+/////////////////////////////////////////////////
+TEST_F(PoseStreamTest, Size)
+{
+  // The compact frame is much smaller than the equivalent PosesStamped
+  msgs::PoseStreamEncoder encoder;
+  msgs::PosesStamped full;
+  for (uint32_t i = 0; i < 1000; ++i)
+  {
+    ignition::math::Pose3d pose(i * 0.01, 1, 2, 0, 0, i * 0.001);
+    const std::string name = "world::robot_" + std::to_string(i) + "::link";
+    encoder.SetName(i, name);
+    encoder.Update(i, pose);
+
+    msgs::Pose *p = full.add_pose();
+    p->set_name(name);
+    p->set_id(i);
+    msgs::Set(p, pose);
+  }
+  msgs::Set(full.mutable_time(), common::Time(1, 0));
+
+  msgs::CompactPoses frame;
+  encoder.Encode(common::Time(1, 0), frame);
+  EXPECT_LT(frame.ByteSizeLong() * 3, full.ByteSizeLong());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -17,6 +17,7 @@
 #include <sstream>
 #include <limits>
 #include <algorithm>
+#include <vector>
 
 #include "gazebo/common/BVHLoader.hh"
 #include "gazebo/common/Console.hh"
@@ -35,9 +36,42 @@
 
 #include "gazebo/transport/Node.hh"
 
+namespace
+{
+/// \brief Flat form of one skeleton animation, indexed by bone handle.
+class ActorAnimationTable
+{
+  /// \brief Animation of each bone, null for bones the animation doesn't
+  /// move.
+  public: std::vector<const gazebo::common::NodeAnimation *> nodes;
+
+  /// \brief Name of the animation node of the root bone.
+  public: std::string rootNode;
+
+  /// \brief Translation aligner of each bone, for BVH animations.
+  public: std::vector<ignition::math::Matrix4d> translationAligner;
+
+  /// \brief Rotation aligner of each bone, for BVH animations.
+  public: std::vector<ignition::math::Matrix4d> rotationAligner;
+};
+}
+
 /// \brief Private data for Actor class
 class gazebo::physics::ActorPrivate
 {
+  /// \brief What Update should do with the prepared frame.
+  public: enum FrameAction
+  {
+    /// \brief Nothing changed.
+    NONE,
+
+    /// \brief Apply the bone transforms.
+    BONES,
+
+    /// \brief Only set the actor's pose, it has no skeleton animation.
+    MODEL_POSE
+  };
+
   /// \brief True if the animation is loaded from BVH file
   public: bool bvhFile = false;
 
@@ -49,11 +83,42 @@ class gazebo::physics::ActorPrivate
   public: std::map<std::string, ignition::math::Matrix4d>
       rotationAligner;
 
-  /// \brief Last animated frame
-  public: std::map<std::string, ignition::math::Matrix4d> lastFrame;
+  /// \brief Flat skeleton animations, indexed by their names.
+  public: std::map<std::string, ActorAnimationTable> animTables;
+
+  /// \brief Handle of the parent of each bone, -1 for the root.
+  public: std::vector<int> boneParents;
+
+  /// \brief Bone handles, parents before their children.
+  public: std::vector<unsigned int> boneOrder;
+
+  /// \brief Link of each bone.
+  public: std::vector<LinkPtr> boneLinks;
+
+  /// \brief Transform of each bone relative to its parent, in the last
+  /// evaluated frame.
+  public: std::vector<ignition::math::Pose3d> boneLocal;
+
+  /// \brief World transform of each bone in the last evaluated frame.
+  public: std::vector<ignition::math::Matrix4d> boneWorld;
+
+  /// \brief Pose of the root bone in the last evaluated frame.
+  public: ignition::math::Pose3d rootPose;
 
-  /// \brief Last map associating skeleton nodes from skin and animation
-  public: std::map<std::string, std::string> lastSkelMap;
+  /// \brief Actor pose, for actors without skeleton animation.
+  public: ignition::math::Pose3d modelPose;
+
+  /// \brief What Update should do with the prepared frame.
+  public: FrameAction action = NONE;
+
+  /// \brief Simulation time of the prepared frame.
+  public: double frameTime = 0.0;
+
+  /// \brief True if the frame for this iteration was prepared already.
+  public: bool prepared = false;
+
+  /// \brief Maximum animation rate, in Hz of simulation time.
+  public: double animationRate = 30.0;
 };
 
 using namespace gazebo;
@@ -649,6 +714,86 @@ void Actor::Init()
   if (this->autoStart)
     this->Play();
   this->mainLink = this->GetChildLink(this->GetName() + "_pose");
+  this->BuildBoneTables();
+}
+
+//////////////////////////////////////////////////
+void Actor::BuildBoneTables()
+{
+  this->dataPtr->animTables.clear();
+  this->dataPtr->boneParents.clear();
+  this->dataPtr->boneOrder.clear();
+  this->dataPtr->boneLinks.clear();
+  this->dataPtr->action = ActorPrivate::NONE;
+  this->dataPtr->prepared = false;
+
+  if (!this->skeleton)
+    return;
+
+  const unsigned int boneCount = this->skeleton->GetNumNodes();
+  this->dataPtr->boneParents.resize(boneCount, -1);
+  this->dataPtr->boneLinks.resize(boneCount);
+  std::vector<unsigned int> depth(boneCount, 0);
+  for (unsigned int i = 0; i < boneCount; ++i)
+  {
+    SkeletonNode *bone = this->skeleton->GetNodeByHandle(i);
+    if (bone->GetParent())
+      this->dataPtr->boneParents[i] = bone->GetParent()->GetHandle();
+    for (SkeletonNode *p = bone->GetParent(); p; p = p->GetParent())
+      ++depth[i];
+
+    this->dataPtr->boneLinks[i] = this->GetChildLink(bone->GetName());
+    if (!this->dataPtr->boneLinks[i])
+    {
+      gzerr << "Actor [" << this->GetName() << "] has no link for bone ["
+          << bone->GetName() << "]" << std::endl;
+    }
+  }
+
+  // Evaluate parents before their children
+  for (unsigned int i = 0; i < boneCount; ++i)
+    this->dataPtr->boneOrder.push_back(i);
+  std::stable_sort(this->dataPtr->boneOrder.begin(),
+      this->dataPtr->boneOrder.end(),
+      [&depth](const unsigned int _a, const unsigned int _b)
+      {
+        return depth[_a] < depth[_b];
+      });
+
+  const std::string rootName = this->skeleton->GetRootNode()->GetName();
+  for (auto const &anim : this->skelAnimation)
+  {
+    if (!anim.second)
+      continue;
+
+    auto &skelMap = this->skelNodesMap[anim.first];
+    ActorAnimationTable &table = this->dataPtr->animTables[anim.first];
+    table.nodes.resize(boneCount, nullptr);
+    table.translationAligner.resize(boneCount,
+        ignition::math::Matrix4d::Zero);
+    table.rotationAligner.resize(boneCount, ignition::math::Matrix4d::Zero);
+    table.rootNode = skelMap[rootName];
+
+    for (unsigned int i = 0; i < boneCount; ++i)
+    {
+      auto nodeIter = skelMap.find(
+          this->skeleton->GetNodeByHandle(i)->GetName());
+      if (nodeIter == skelMap.end())
+        continue;
+
+      table.nodes[i] = anim.second->NodeAnimationByName(nodeIter->second);
+
+      auto tIter = this->dataPtr->translationAligner.find(nodeIter->second);
+      if (tIter != this->dataPtr->translationAligner.end())
+        table.translationAligner[i] = tIter->second;
+      auto rIter = this->dataPtr->rotationAligner.find(nodeIter->second);
+      if (rIter != this->dataPtr->rotationAligner.end())
+        table.rotationAligner[i] = rIter->second;
+    }
+  }
+
+  // Until the first frame is animated, the skeleton is in its bind pose
+  this->EvaluateBones(std::string(), 0.0, nullptr);
 }
 
 //////////////////////////////////////////////////
@@ -673,20 +818,47 @@ bool Actor::IsActive() const
 ///////////////////////////////////////////////////
 void Actor::Update()
 {
+  if (!this->dataPtr->prepared)
+    this->PrepareFrame(this->dataPtr->animationRate);
+  this->dataPtr->prepared = false;
+
+  switch (this->dataPtr->action)
+  {
+    case ActorPrivate::BONES:
+      this->ApplyBones(this->dataPtr->frameTime);
+      break;
+    case ActorPrivate::MODEL_POSE:
+      this->SetWorldPose(this->dataPtr->modelPose);
+      break;
+    default:
+      break;
+  }
+  this->dataPtr->action = ActorPrivate::NONE;
+}
+
+///////////////////////////////////////////////////
+void Actor::PrepareFrame(const double _rate)
+{
+  this->dataPtr->prepared = true;
+  this->dataPtr->action = ActorPrivate::NONE;
+
   common::Time currentTime = this->world->SimTime();
+  this->dataPtr->frameTime = currentTime.Double();
   if (!this->active)
   {
-    this->SetPose(this->dataPtr->lastFrame, this->dataPtr->lastSkelMap,
-                  currentTime.Double());
+    this->dataPtr->action = ActorPrivate::BONES;
     return;
   }
 
   if (this->skelAnimation.empty() && this->trajectories.empty())
     return;
 
-  // do not refresh animation faster than 30 Hz sim time
-  if ((currentTime - this->prevFrameTime).Double() < (1.0 / 30.0))
+  // do not refresh animation faster than the requested rate
+  if (_rate <= 0.0 ||
+      (currentTime - this->prevFrameTime).Double() < 1.0 / _rate)
+  {
     return;
+  }
 
   // Get trajectory
   TrajectoryInfo *tinfo = nullptr;
@@ -698,8 +870,7 @@ void Actor::Update()
     // waiting for delayed start
     if (this->scriptTime < 0)
     {
-      this->SetPose(this->dataPtr->lastFrame, this->dataPtr->lastSkelMap,
-                    currentTime.Double());
+      this->dataPtr->action = ActorPrivate::BONES;
       return;
     }
 
@@ -774,44 +945,35 @@ void Actor::Update()
     this->lastPos = modelPose.Pos();
   }
 
-  SkeletonAnimation *skelAnim = this->skelAnimation[tinfo->type];
+  SkeletonAnimation *skelAnim = nullptr;
+  auto animIter = this->skelAnimation.find(tinfo->type);
+  if (animIter != this->skelAnimation.end())
+    skelAnim = animIter->second;
 
   // If there's no skeleton animation, we just update the global pose
-  if (!skelAnim)
+  auto tableIter = this->dataPtr->animTables.find(tinfo->type);
+  if (!skelAnim || tableIter == this->dataPtr->animTables.end())
   {
-    this->SetWorldPose(modelPose);
+    this->dataPtr->modelPose = modelPose;
+    this->dataPtr->action = ActorPrivate::MODEL_POSE;
     return;
   }
+  const ActorAnimationTable &table = tableIter->second;
 
-  auto skelMap = this->skelNodesMap[tinfo->type];
-
-  std::map<std::string, ignition::math::Matrix4d> frame;
-  if (!this->customTrajectoryInfo)
-  {
-    if (this->interpolateX[tinfo->type] &&
-          this->trajectories.find(tinfo->id) != this->trajectories.end())
-    {
-      frame = skelAnim->PoseAtX(this->pathLength,
-                skelMap[this->skeleton->GetRootNode()->GetName()]);
-    }
-    else
-    {
-      frame = skelAnim->PoseAt(this->scriptTime);
-    }
-  }
-  else
+  double animTime = this->scriptTime;
+  if (!this->customTrajectoryInfo && this->interpolateX[tinfo->type] &&
+      this->trajectories.find(tinfo->id) != this->trajectories.end())
   {
-    frame = skelAnim->PoseAt(this->scriptTime);
+    animTime = skelAnim->TimeAtX(this->pathLength, table.rootNode);
   }
 
   this->lastTraj = tinfo->id;
 
   ignition::math::Matrix4d rootTrans = ignition::math::Matrix4d::Identity;
-  auto iter = frame.find(skelMap[this->skeleton->GetRootNode()->GetName()]);
-  if (iter != frame.end())
-  {
-    rootTrans = frame[skelMap[this->skeleton->GetRootNode()->GetName()]];
-  }
+  const common::NodeAnimation *rootAnim =
+      table.nodes[this->skeleton->GetRootNode()->GetHandle()];
+  if (rootAnim)
+    rootTrans = rootAnim->FrameAt(animTime);
 
   ignition::math::Vector3d rootPos = rootTrans.Translation();
   ignition::math::Quaterniond rootRot = rootTrans.Rotation();
@@ -852,45 +1014,40 @@ void Actor::Update()
   // workaround for rotation bug
   rootM.SetTranslation(rootM.Translation() * this->skinScale);
 
-  frame[skelMap[this->skeleton->GetRootNode()->GetName()]] = rootM;
-
-  this->dataPtr->lastFrame = frame;
-  this->dataPtr->lastSkelMap = skelMap;
-
-  this->SetPose(frame, skelMap, currentTime.Double());
+  this->EvaluateBones(tinfo->type, animTime, &rootM);
+  this->dataPtr->action = ActorPrivate::BONES;
 }
 
 //////////////////////////////////////////////////
-void Actor::SetPose(std::map<std::string, ignition::math::Matrix4d> _frame,
-    std::map<std::string, std::string> _skelMap, const double _time)
+void Actor::EvaluateBones(const std::string &_anim, const double _time,
+    const ignition::math::Matrix4d *_rootTrans)
 {
-  msgs::PoseAnimation msg;
-  msg.set_model_name(this->visualName);
-  msg.set_model_id(this->visualId);
+  const ActorAnimationTable *table = nullptr;
+  auto tableIter = this->dataPtr->animTables.find(_anim);
+  if (tableIter != this->dataPtr->animTables.end())
+    table = &tableIter->second;
 
-  ignition::math::Matrix4d modelTrans(ignition::math::Matrix4d::Identity);
-  ignition::math::Pose3d mainLinkPose;
-
-  if (this->customTrajectoryInfo)
-  {
-    mainLinkPose.Pos() = this->worldPose.Pos();
-    mainLinkPose.Rot() = this->worldPose.Rot();
-  }
+  const unsigned int boneCount = this->dataPtr->boneParents.size();
+  this->dataPtr->boneLocal.resize(boneCount);
+  this->dataPtr->boneWorld.resize(boneCount);
 
-  for (unsigned int i = 0; i < this->skeleton->GetNumNodes(); ++i)
+  for (const unsigned int i : this->dataPtr->boneOrder)
   {
     SkeletonNode *bone = this->skeleton->GetNodeByHandle(i);
-    SkeletonNode *parentBone = bone->GetParent();
+    const int parent = this->dataPtr->boneParents[i];
     ignition::math::Matrix4d transform(ignition::math::Matrix4d::Identity);
 
-    if (_frame.find(_skelMap[bone->GetName()]) != _frame.end())
+    const common::NodeAnimation *node = table ? table->nodes[i] : nullptr;
+    if ((parent < 0 && _rootTrans) || node)
     {
+      if (parent < 0 && _rootTrans)
+        transform = *_rootTrans;
+      else
+        transform = node->FrameAt(_time);
+
       if (this->dataPtr->bvhFile)
       {
-        std::string tempStr(_skelMap[bone->GetName()]);
-        transform = _frame[tempStr];
-
-        if (bone->GetName() != this->skeleton->GetRootNode()->GetName())
+        if (parent >= 0)
         {
           ignition::math::Vector3d bvhOffset = transform.Translation();
           ignition::math::Vector3d daeOffset = bone->Transform().Translation();
@@ -898,12 +1055,8 @@ void Actor::SetPose(std::map<std::string, ignition::math::Matrix4d> _frame,
           transform.SetTranslation(daeOffset.Length() * bvhOffset.Normalize());
         }
 
-        transform = this->dataPtr->translationAligner[tempStr] * transform *
-            this->dataPtr->rotationAligner[tempStr];
-      }
-      else
-      {
-        transform = _frame[_skelMap[bone->GetName()]];
+        transform = table->translationAligner[i] * transform *
+            table->rotationAligner[i];
       }
     }
     else
@@ -911,7 +1064,6 @@ void Actor::SetPose(std::map<std::string, ignition::math::Matrix4d> _frame,
       transform = bone->Transform();
     }
 
-    LinkPtr currentLink = this->GetChildLink(bone->GetName());
     ignition::math::Pose3d bonePose = transform.Pose();
     if (!bonePose.IsFinite())
     {
@@ -919,64 +1071,129 @@ void Actor::SetPose(std::map<std::string, ignition::math::Matrix4d> _frame,
                 << " " << bonePose << "\n";
       bonePose.Correct();
     }
+    this->dataPtr->boneLocal[i] = bonePose;
 
-    msgs::Pose *bone_pose = msg.add_pose();
-    bone_pose->set_name(bone->GetName());
-
-    if (!parentBone)
+    if (parent < 0)
     {
-      bone_pose->mutable_position()->CopyFrom(
-          msgs::Convert(ignition::math::Vector3d()));
-      bone_pose->mutable_orientation()->CopyFrom(msgs::Convert(
-          ignition::math::Quaterniond()));
-      if (!this->customTrajectoryInfo)
-        mainLinkPose = bonePose;
+      this->dataPtr->rootPose = bonePose;
+      this->dataPtr->boneWorld[i] = transform;
     }
     else
     {
-      bone_pose->mutable_position()->CopyFrom(msgs::Convert(bonePose.Pos()));
-      bone_pose->mutable_orientation()->CopyFrom(msgs::Convert(bonePose.Rot()));
-      LinkPtr parentLink = this->GetChildLink(parentBone->GetName());
-      auto parentPose = parentLink->WorldPose();
-      ignition::math::Matrix4d parentTrans(parentPose);
-      transform = parentTrans * transform;
+      this->dataPtr->boneWorld[i] =
+          this->dataPtr->boneWorld[parent] * transform;
     }
-
-    msgs::Pose *link_pose = msg.add_pose();
-    link_pose->set_name(currentLink->GetScopedName());
-    link_pose->set_id(currentLink->GetId());
-    ignition::math::Pose3d linkPose = transform.Pose() - mainLinkPose;
-    link_pose->mutable_position()->CopyFrom(msgs::Convert(linkPose.Pos()));
-    link_pose->mutable_orientation()->CopyFrom(msgs::Convert(linkPose.Rot()));
-    currentLink->SetWorldPose(transform.Pose(), true, false);
   }
+}
 
-  msgs::Time *stamp = msg.add_time();
-  stamp->CopyFrom(msgs::Convert(_time));
+//////////////////////////////////////////////////
+void Actor::ApplyBones(const double _time)
+{
+  if (!this->skeleton)
+    return;
 
-  msgs::Pose *model_pose = msg.add_pose();
-  model_pose->set_name(this->GetScopedName());
-  model_pose->set_id(this->GetId());
-  if (!this->customTrajectoryInfo)
+  // Only build the skeleton pose message when somebody listens
+  const bool publish = this->bonePosePub &&
+      this->bonePosePub->HasConnections();
+
+  msgs::PoseAnimation msg;
+  if (publish)
   {
-    model_pose->mutable_position()->CopyFrom(msgs::Convert(mainLinkPose.Pos()));
-    model_pose->mutable_orientation()->CopyFrom(
-        msgs::Convert(mainLinkPose.Rot()));
+    msg.set_model_name(this->visualName);
+    msg.set_model_id(this->visualId);
+  }
+
+  ignition::math::Pose3d mainLinkPose;
+  if (this->customTrajectoryInfo)
+  {
+    mainLinkPose.Pos() = this->worldPose.Pos();
+    mainLinkPose.Rot() = this->worldPose.Rot();
   }
   else
   {
+    mainLinkPose = this->dataPtr->rootPose;
+  }
+
+  for (unsigned int i = 0; i < this->dataPtr->boneLinks.size(); ++i)
+  {
+    const LinkPtr &currentLink = this->dataPtr->boneLinks[i];
+    if (!currentLink)
+      continue;
+
+    const ignition::math::Pose3d worldPose =
+        this->dataPtr->boneWorld[i].Pose();
+
+    if (publish)
+    {
+      msgs::Pose *bone_pose = msg.add_pose();
+      bone_pose->set_name(this->skeleton->GetNodeByHandle(i)->GetName());
+
+      if (this->dataPtr->boneParents[i] < 0)
+      {
+        bone_pose->mutable_position()->CopyFrom(
+            msgs::Convert(ignition::math::Vector3d()));
+        bone_pose->mutable_orientation()->CopyFrom(msgs::Convert(
+            ignition::math::Quaterniond()));
+      }
+      else
+      {
+        const ignition::math::Pose3d &bonePose = this->dataPtr->boneLocal[i];
+        bone_pose->mutable_position()->CopyFrom(
+            msgs::Convert(bonePose.Pos()));
+        bone_pose->mutable_orientation()->CopyFrom(
+            msgs::Convert(bonePose.Rot()));
+      }
+
+      msgs::Pose *link_pose = msg.add_pose();
+      link_pose->set_name(currentLink->GetScopedName());
+      link_pose->set_id(currentLink->GetId());
+      ignition::math::Pose3d linkPose = worldPose - mainLinkPose;
+      link_pose->mutable_position()->CopyFrom(msgs::Convert(linkPose.Pos()));
+      link_pose->mutable_orientation()->CopyFrom(
+          msgs::Convert(linkPose.Rot()));
+    }
+
+    currentLink->SetWorldPose(worldPose, true, false);
+  }
+
+  if (publish)
+  {
+    msgs::Time *stamp = msg.add_time();
+    stamp->CopyFrom(msgs::Convert(_time));
+
+    msgs::Pose *model_pose = msg.add_pose();
+    model_pose->set_name(this->GetScopedName());
+    model_pose->set_id(this->GetId());
     model_pose->mutable_position()->CopyFrom(
-        msgs::Convert(this->worldPose.Pos()));
+        msgs::Convert(mainLinkPose.Pos()));
     model_pose->mutable_orientation()->CopyFrom(
-        msgs::Convert(this->worldPose.Rot()));
-  }
+        msgs::Convert(mainLinkPose.Rot()));
 
-  if (this->bonePosePub && this->bonePosePub->HasConnections())
     this->bonePosePub->Publish(msg);
+  }
+
   if (!this->customTrajectoryInfo)
     this->SetWorldPose(mainLinkPose, true, false);
 }
 
+//////////////////////////////////////////////////
+void Actor::SetAnimationRate(const double _rate)
+{
+  if (_rate <= 0.0)
+  {
+    gzerr << "Animation rate must be positive, got [" << _rate << "]"
+        << std::endl;
+    return;
+  }
+  this->dataPtr->animationRate = _rate;
+}
+
+//////////////////////////////////////////////////
+double Actor::AnimationRate() const
+{
+  return this->dataPtr->animationRate;
+}
+
 //////////////////////////////////////////////////
 void Actor::Fini()
 {
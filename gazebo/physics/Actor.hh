@@ -111,9 +111,30 @@ namespace gazebo
       /// \return True if animation is being played.
       public: virtual bool IsActive() const;
 
-      /// \brief Update the actor
+      /// \brief Update the actor. This applies the frame prepared by
+      /// PrepareFrame for this iteration, or prepares one first if that
+      /// wasn't done.
       public: void Update();
 
+      /// \brief Evaluate the animation for the current simulation time,
+      /// without modifying any other entity. The result is applied by the
+      /// next call to Update. Different actors can prepare their frames
+      /// concurrently, which is what ActorCrowd does.
+      /// \param[in] _rate Maximum rate at which new frames are animated,
+      /// in Hz of simulation time.
+      public: void PrepareFrame(const double _rate);
+
+      /// \brief Set the maximum rate at which the actor is animated when
+      /// Update prepares its own frames. The default is 30 Hz.
+      /// \param[in] _rate Rate in Hz of simulation time, must be positive.
+      /// \sa AnimationRate
+      public: void SetAnimationRate(const double _rate);
+
+      /// \brief Get the maximum rate at which the actor is animated.
+      /// \return Rate in Hz of simulation time.
+      /// \sa SetAnimationRate
+      public: double AnimationRate() const;
+
       /// \brief Finalize the actor
       public: virtual void Fini();
 
@@ -277,15 +298,23 @@ namespace gazebo
       /// \param[in] _sdf SDF element containing the trajectory script.
       private: void LoadScript(sdf::ElementPtr _sdf);
 
-      /// \brief Set the actor's pose. This sets the pose for each bone in the
-      /// skeleton and also the actor's pose in the world.
-      /// \param[in] _frame Each frame name and transform.
-      /// \param[in] _skelMap Map of bone relationships.
-      /// \param[in] _time Time over which to animate the set pose.
-      private: void SetPose(
-                   std::map<std::string, ignition::math::Matrix4d> _frame,
-                   std::map<std::string, std::string> _skelMap,
-                   const double _time);
+      /// \brief Build the flat, bone handle indexed tables of the skeleton
+      /// and of every skeleton animation.
+      private: void BuildBoneTables();
+
+      /// \brief Compute the transform of every bone.
+      /// \param[in] _anim Animation to sample, null for the bind pose.
+      /// \param[in] _time Animation time.
+      /// \param[in] _rootTrans Transform of the root bone, null for the
+      /// bind pose.
+      private: void EvaluateBones(const std::string &_anim, const double _time,
+                   const ignition::math::Matrix4d *_rootTrans);
+
+      /// \brief Set the actor's pose from the last evaluated bones. This sets
+      /// the pose for each bone in the skeleton and also the actor's pose in
+      /// the world.
+      /// \param[in] _time Time stamp of the published skeleton pose.
+      private: void ApplyBones(const double _time);
 
       /// \brief Pointer to the actor's mesh.
       protected: const common::Mesh *mesh = nullptr;
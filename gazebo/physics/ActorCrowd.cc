@@ -0,0 +1,196 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+
+#include <algorithm>
+#include <mutex>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/physics/Actor.hh"
+#include "gazebo/physics/ActorCrowd.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+/// \brief Private data for the ActorCrowd class
+class gazebo::physics::ActorCrowdPrivate
+{
+  /// \brief Get the rate of an actor, with the settings locked.
+  /// \param[in] _actor The actor.
+  /// \return Rate in Hz of simulation time.
+  public: double Rate(const Actor &_actor) const
+  {
+    const double rate = _actor.AnimationRate();
+    if (this->lodDistance <= 0.0)
+      return rate;
+
+    const ignition::math::Vector3d &pos = _actor.WorldPose().Pos();
+    const double distanceSq = this->lodDistance * this->lodDistance;
+    for (auto const &point : this->lodFocus)
+    {
+      if (point.SquaredDistance(pos) <= distanceSq)
+        return rate;
+    }
+    return std::min(rate, this->lodRate);
+  }
+
+  /// \brief Protects the settings below.
+  public: mutable std::mutex mutex;
+
+  /// \brief True to prepare the frames in parallel.
+  public: bool parallel = true;
+
+  /// \brief Level of detail focus points.
+  public: std::vector<ignition::math::Vector3d> lodFocus;
+
+  /// \brief Level of detail distance, zero if disabled.
+  public: double lodDistance = 0.0;
+
+  /// \brief Animation rate of distant actors.
+  public: double lodRate = 5.0;
+
+  /// \brief Actors found in the last update, reused between updates.
+  public: std::vector<Actor *> actors;
+
+  /// \brief Rate of each actor in the last update.
+  public: std::vector<double> rates;
+};
+
+//////////////////////////////////////////////////
+ActorCrowd::ActorCrowd()
+  : dataPtr(new ActorCrowdPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+ActorCrowd::~ActorCrowd()
+{
+}
+
+//////////////////////////////////////////////////
+void ActorCrowd::Update(const Model_V &_models)
+{
+  auto &actors = this->dataPtr->actors;
+  auto &rates = this->dataPtr->rates;
+  actors.clear();
+  rates.clear();
+
+  bool parallel;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    for (auto const &model : _models)
+    {
+      if (!model->HasType(Base::ACTOR))
+        continue;
+      Actor *actor = static_cast<Actor *>(model.get());
+      actors.push_back(actor);
+      rates.push_back(this->dataPtr->Rate(*actor));
+    }
+    parallel = this->dataPtr->parallel;
+  }
+
+  if (actors.empty())
+    return;
+
+  // Actors only touch their own state while preparing a frame
+  if (parallel && actors.size() > 1)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, actors.size()),
+        [&actors, &rates](const tbb::blocked_range<size_t> &_r)
+        {
+          for (size_t i = _r.begin(); i != _r.end(); ++i)
+            actors[i]->PrepareFrame(rates[i]);
+        });
+  }
+  else
+  {
+    for (size_t i = 0; i < actors.size(); ++i)
+      actors[i]->PrepareFrame(rates[i]);
+  }
+}
+
+//////////////////////////////////////////////////
+void ActorCrowd::SetParallel(const bool _parallel)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->parallel = _parallel;
+}
+
+//////////////////////////////////////////////////
+bool ActorCrowd::Parallel() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->parallel;
+}
+
+//////////////////////////////////////////////////
+void ActorCrowd::SetLodFocus(
+    const std::vector<ignition::math::Vector3d> &_points)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->lodFocus = _points;
+}
+
+//////////////////////////////////////////////////
+std::vector<ignition::math::Vector3d> ActorCrowd::LodFocus() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->lodFocus;
+}
+
+//////////////////////////////////////////////////
+void ActorCrowd::SetLodDistance(const double _distance)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->lodDistance = std::max(0.0, _distance);
+}
+
+//////////////////////////////////////////////////
+double ActorCrowd::LodDistance() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->lodDistance;
+}
+
+//////////////////////////////////////////////////
+void ActorCrowd::SetLodRate(const double _rate)
+{
+  if (_rate <= 0.0)
+  {
+    gzerr << "Level of detail rate must be positive, got [" << _rate << "]"
+        << std::endl;
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->lodRate = _rate;
+}
+
+//////////////////////////////////////////////////
+double ActorCrowd::LodRate() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->lodRate;
+}
+
+//////////////////////////////////////////////////
+double ActorCrowd::AnimationRate(const Actor &_actor) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->Rate(_actor);
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_ACTORCROWD_HH_
+#define GAZEBO_PHYSICS_ACTORCROWD_HH_
+
+#include <memory>
+#include <vector>
+
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class.
+    class ActorCrowdPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class ActorCrowd ActorCrowd.hh physics/physics.hh
+    /// \brief Animates all the actors of a world.
+    ///
+    /// At the start of every world update, the crowd prepares the frame of
+    /// each actor on a thread pool, see Actor::PrepareFrame. The frames are
+    /// then applied on the world thread when the models update.
+    ///
+    /// An optional level of detail lowers the animation rate of actors
+    /// that are far from every focus point, such as the cameras that
+    /// observe the crowd. It is disabled by default.
+    class GZ_PHYSICS_VISIBLE ActorCrowd
+    {
+      /// \brief Constructor.
+      public: ActorCrowd();
+
+      /// \brief Destructor.
+      public: ~ActorCrowd();
+
+      /// \brief Prepare the frames of the actors among a list of models.
+      /// \param[in] _models Models of the world.
+      public: void Update(const Model_V &_models);
+
+      /// \brief Set whether frames are prepared in parallel.
+      /// \param[in] _parallel True to use the thread pool, false to
+      /// prepare the frames on the calling thread.
+      public: void SetParallel(const bool _parallel);
+
+      /// \brief Get whether frames are prepared in parallel.
+      /// \return True if the thread pool is used.
+      public: bool Parallel() const;
+
+      /// \brief Set the points from which the distance to the actors is
+      /// measured, for the level of detail.
+      /// \param[in] _points Points in the world frame.
+      public: void SetLodFocus(
+                  const std::vector<ignition::math::Vector3d> &_points);
+
+      /// \brief Get the level of detail focus points.
+      /// \return Points in the world frame.
+      public: std::vector<ignition::math::Vector3d> LodFocus() const;
+
+      /// \brief Set the distance beyond which actors are animated at the
+      /// level of detail rate. Actors are also animated at that rate when
+      /// there are no focus points.
+      /// \param[in] _distance Distance in meters, zero disables the level
+      /// of detail.
+      public: void SetLodDistance(const double _distance);
+
+      /// \brief Get the level of detail distance.
+      /// \return Distance in meters, zero if disabled.
+      public: double LodDistance() const;
+
+      /// \brief Set the animation rate of distant actors.
+      /// \param[in] _rate Rate in Hz of simulation time, must be positive.
+      public: void SetLodRate(const double _rate);
+
+      /// \brief Get the animation rate of distant actors.
+      /// \return Rate in Hz of simulation time.
+      public: double LodRate() const;
+
+      /// \brief Get the rate at which an actor is currently animated.
+      /// \param[in] _actor The actor.
+      /// \return Rate in Hz of simulation time.
+      public: double AnimationRate(const Actor &_actor) const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<ActorCrowdPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <vector>
+
+#include "gazebo/test/ServerFixture.hh"
+#include "gazebo/physics/Actor.hh"
+#include "gazebo/physics/ActorCrowd.hh"
+
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class ActorCrowdTest : public ServerFixture
+{
+  /// \brief Get the actors of the world.
+  /// \param[in] _world The world.
+  /// \return All the actors.
+  public: std::vector<physics::ActorPtr> Actors(physics::WorldPtr _world)
+  {
+    std::vector<physics::ActorPtr> actors;
+    for (auto const &model : _world->Models())
+    {
+      auto actor = boost::dynamic_pointer_cast<physics::Actor>(model);
+      if (actor)
+        actors.push_back(actor);
+    }
+    return actors;
+  }
+
+  /// \brief Get the world pose of every link of every actor.
+  /// \param[in] _actors The actors.
+  /// \return Link poses.
+  public: std::vector<ignition::math::Pose3d> LinkPoses(
+              const std::vector<physics::ActorPtr> &_actors)
+  {
+    std::vector<ignition::math::Pose3d> poses;
+    for (auto const &actor : _actors)
+    {
+      for (auto const &link : actor->GetLinks())
+        poses.push_back(link->WorldPose());
+    }
+    return poses;
+  }
+};
+
+//////////////////////////////////////////////////
+TEST_F(ActorCrowdTest, ParallelMatchesSerial)
+{
+  this->Load("test/worlds/actor_crowd.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  auto actors = this->Actors(world);
+  ASSERT_EQ(6u, actors.size());
+
+  physics::ActorCrowd &crowd = world->ActorCrowd();
+  EXPECT_TRUE(crowd.Parallel());
+  crowd.SetParallel(false);
+  EXPECT_FALSE(crowd.Parallel());
+
+  world->Step(1500);
+  auto serial = this->LinkPoses(actors);
+  ASSERT_FALSE(serial.empty());
+
+  // The actors moved
+  EXPECT_GT(actors[0]->WorldPose().Pos().X(), 1.0);
+
+  world->Reset();
+  crowd.SetParallel(true);
+  world->Step(1500);
+  auto parallel = this->LinkPoses(actors);
+  ASSERT_EQ(serial.size(), parallel.size());
+  for (size_t i = 0; i < serial.size(); ++i)
+    EXPECT_EQ(serial[i], parallel[i]) << "link " << i;
+}
+
+//////////////////////////////////////////////////
+TEST_F(ActorCrowdTest, LevelOfDetail)
+{
+  this->Load("test/worlds/actor_crowd.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  auto actors = this->Actors(world);
+  ASSERT_EQ(6u, actors.size());
+  auto actor = actors[0];
+
+  physics::ActorCrowd &crowd = world->ActorCrowd();
+  EXPECT_DOUBLE_EQ(0.0, crowd.LodDistance());
+  EXPECT_DOUBLE_EQ(30.0, actor->AnimationRate());
+  EXPECT_DOUBLE_EQ(30.0, crowd.AnimationRate(*actor));
+
+  // Invalid rates are ignored
+  actor->SetAnimationRate(0.0);
+  EXPECT_DOUBLE_EQ(30.0, actor->AnimationRate());
+  crowd.SetLodRate(-1.0);
+  EXPECT_DOUBLE_EQ(5.0, crowd.LodRate());
+
+  // Without focus points, every actor is distant
+  crowd.SetLodDistance(3.0);
+  crowd.SetLodRate(10.0);
+  EXPECT_DOUBLE_EQ(3.0, crowd.LodDistance());
+  EXPECT_DOUBLE_EQ(10.0, crowd.LodRate());
+  EXPECT_DOUBLE_EQ(10.0, crowd.AnimationRate(*actor));
+
+  // A focus point next to the first actor only
+  crowd.SetLodFocus({actor->WorldPose().Pos()});
+  ASSERT_EQ(1u, crowd.LodFocus().size());
+  EXPECT_DOUBLE_EQ(30.0, crowd.AnimationRate(*actor));
+  EXPECT_DOUBLE_EQ(10.0, crowd.AnimationRate(*actors.back()));
+
+  // Count the frames of a near and a distant actor over one second
+  auto countFrames = [&world](physics::ActorPtr _actor)
+  {
+    unsigned int frames = 0;
+    auto prev = _actor->WorldPose();
+    const unsigned int steps =
+        static_cast<unsigned int>(1.0 / world->Physics()->GetMaxStepSize());
+    for (unsigned int i = 0; i < steps; ++i)
+    {
+      world->Step(1);
+      if (_actor->WorldPose() != prev)
+        ++frames;
+      prev = _actor->WorldPose();
+    }
+    return frames;
+  };
+
+  // Keep the focus on the first actor while it walks
+  actor->SetAnimationRate(30.0);
+  crowd.SetLodDistance(100.0);
+  crowd.SetLodFocus({ignition::math::Vector3d(0, 0, 0)});
+  unsigned int nearFrames = countFrames(actor);
+  EXPECT_GE(nearFrames, 25u);
+  EXPECT_LE(nearFrames, 31u);
+
+  crowd.SetLodFocus({ignition::math::Vector3d(1000, 0, 0)});
+  unsigned int farFrames = countFrames(actor);
+  EXPECT_GE(farFrames, 8u);
+  EXPECT_LE(farFrames, 11u);
+
+  // Disabling the level of detail restores the full rate
+  crowd.SetLodDistance(0.0);
+  EXPECT_DOUBLE_EQ(30.0, crowd.AnimationRate(*actors.back()));
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
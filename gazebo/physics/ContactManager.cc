@@ -14,6 +14,7 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
 #include <boost/algorithm/string.hpp>
 
 #include "gazebo/transport/Node.hh"
@@ -48,7 +49,7 @@ ContactManager::~ContactManager()
     this->node->Fini();
   this->node.reset();
 
-  boost::unordered_map<std::string, ContactPublisher *>::iterator iter;
+  std::map<std::string, ContactPublisher *>::iterator iter;
   for (iter = this->customContactPublishers.begin();
       iter != this->customContactPublishers.end(); ++iter)
   {
@@ -62,6 +63,7 @@ ContactManager::~ContactManager()
     }
   }
   this->customContactPublishers.clear();
+  this->filterIndex.clear();
   delete this->customMutex;
   this->customMutex = NULL;
 
@@ -99,87 +101,48 @@ bool ContactManager::SubscribersConnected(Collision *_collision1,
   if (this->contactPub->HasConnections()) return true;
 
   boost::recursive_mutex::scoped_lock lock(*this->customMutex);
-  boost::unordered_map<std::string, ContactPublisher *>::const_iterator iter;
-  for (iter = this->customContactPublishers.begin();
-       iter != this->customContactPublishers.end(); ++iter)
-  {
-    // A model can simply be loaded later, so check the collisionNames as well.
-    if (!iter->second->collisionNames.empty())
-    {
-      std::vector<std::string>::const_iterator it;
-      for (it = iter->second->collisionNames.begin();
-           it != iter->second->collisionNames.end(); ++it)
-      {
-        BasePtr b = this->world->BaseByName(*it);
-        if (b)
-        {
-          return true;
-        }
-        // We could do the same transformation which is done in
-        // GetCustomPublishers() here (insert collisions which now have been
-        // loaded), but this would remove the const qualifier of this function.
-        // It would however speed up repeated calls of this function without
-        // a call of NewContact() or GetCustomPublishers() in between.
-      }
-    }
+  return this->filterIndex.find(_collision1) != this->filterIndex.end() ||
+      this->filterIndex.find(_collision2) != this->filterIndex.end();
+}
 
-    // only reason _collision1 or _collision1 cannot be const parameters
-    // is that compiler can't find const pointers in unordered set
-    if (iter->second->collisions.find(_collision1) !=
-        iter->second->collisions.end() ||
-        iter->second->collisions.find(_collision2) !=
-        iter->second->collisions.end())
-    {
-      return true;
-    }
-  }
-  return false;
+/////////////////////////////////////////////////
+void ContactManager::IndexFilter(ContactPublisher *_publisher)
+{
+  for (auto const &col : _publisher->collisions)
+    this->filterIndex[col].push_back(_publisher);
 }
 
 /////////////////////////////////////////////////
-void ContactManager::GetCustomPublishers(Collision *_collision1,
-                     Collision *_collision2, const bool _getOnlyConnected,
-                     std::vector<ContactPublisher*> &_publishers)
+void ContactManager::ResolveFilterCollisions()
 {
   boost::recursive_mutex::scoped_lock lock(*this->customMutex);
-  boost::unordered_map<std::string, ContactPublisher *>::iterator iter;
-  for (iter = this->customContactPublishers.begin();
-       iter != this->customContactPublishers.end(); ++iter)
+  if (!this->pendingFilterNames)
+    return;
+
+  this->pendingFilterNames = false;
+  for (auto &iter : this->customContactPublishers)
   {
     // A model can simply be loaded later, so convert ones that are not yet
     // found
-    if (!iter->second->collisionNames.empty())
+    ContactPublisher *contactPublisher = iter.second;
+    std::vector<std::string>::iterator it;
+    for (it = contactPublisher->collisionNames.begin();
+        it != contactPublisher->collisionNames.end();)
     {
-      std::vector<std::string>::iterator it;
-      for (it = iter->second->collisionNames.begin();
-          it != iter->second->collisionNames.end();)
+      Collision *col = boost::dynamic_pointer_cast<Collision>(
+          this->world->BaseByName(*it)).get();
+      if (!col)
       {
-        Collision *col = boost::dynamic_pointer_cast<Collision>(
-            this->world->BaseByName(*it)).get();
-        if (!col)
-        {
-          ++it;
-          continue;
-        }
-        it = iter->second->collisionNames.erase(it);
-        iter->second->collisions.insert(col);
+        ++it;
+        continue;
       }
+      it = contactPublisher->collisionNames.erase(it);
+      if (contactPublisher->collisions.insert(col).second)
+        this->filterIndex[col].push_back(contactPublisher);
     }
 
-    // only reason _collision1 or _collision1 cannot be const parameters
-    // is that compiler can't find const pointers in unordered set
-    if (iter->second->collisions.find(_collision1) !=
-        iter->second->collisions.end() ||
-        iter->second->collisions.find(_collision2) !=
-        iter->second->collisions.end())
-    {
-      GZ_ASSERT(iter->second->publisher != NULL,
-                "ContactPublisher must have a valid publisher");
-      if (!_getOnlyConnected || iter->second->publisher->HasConnections())
-      {
-        _publishers.push_back(iter->second);
-      }
-    }
+    if (!contactPublisher->collisionNames.empty())
+      this->pendingFilterNames = true;
   }
 }
 
@@ -193,41 +156,48 @@ Contact *ContactManager::NewContact(Collision *_collision1,
   if (!_collision1 || !_collision2)
     return result;
 
+  boost::recursive_mutex::scoped_lock lock(*this->customMutex);
+  auto filters1 = this->filterIndex.find(_collision1);
+  auto filters2 = this->filterIndex.find(_collision2);
+
   // If no one is listening to the default topic, or there are no
   // custom contact publishers then don't create any contact information.
   // This is a signal to the Physics engine that it can skip the extra
   // processing necessary to get back contact information.
+  if (filters1 == this->filterIndex.end() &&
+      filters2 == this->filterIndex.end() &&
+      !this->NeverDropContacts() &&
+      !this->contactPub->HasConnections())
+  {
+    return result;
+  }
 
-  std::vector<ContactPublisher *> publishers;
-  bool getOnlyConnected = false;
-  // TODO check: getOnlyConnected set to false to keep same behaviour as before.
-  // But should we not only add publishers which are connected, as is done
-  // for this->contactPub->HasConnections() condition?
-  this->GetCustomPublishers(_collision1, _collision2,
-                            getOnlyConnected, publishers);
-
-  if (this->NeverDropContacts() ||
-      this->contactPub->HasConnections() ||
-      !publishers.empty())
+  // Get or create a contact feedback object.
+  if (this->contactIndex < this->contacts.size())
+    result = this->contacts[this->contactIndex++];
+  else
   {
-    // Get or create a contact feedback object.
-    if (this->contactIndex < this->contacts.size())
-      result = this->contacts[this->contactIndex++];
-    else
-    {
-      result = new Contact();
-      this->contacts.push_back(result);
-      this->contactIndex = this->contacts.size();
-    }
-    for (unsigned int i = 0; i < publishers.size(); ++i)
+    this->contactPool.emplace_back();
+    result = &this->contactPool.back();
+    this->contacts.push_back(result);
+    this->contactIndex = this->contacts.size();
+  }
+
+  if (filters1 != this->filterIndex.end())
+  {
+    for (auto const &publisher : filters1->second)
+      publisher->contacts.push_back(result);
+  }
+  if (filters2 != this->filterIndex.end())
+  {
+    for (auto const &publisher : filters2->second)
     {
-      publishers[i]->contacts.push_back(result);
+      // A filter monitoring both collisions gets the contact once
+      if (publisher->contacts.empty() || publisher->contacts.back() != result)
+        publisher->contacts.push_back(result);
     }
   }
 
-  if (!result)
-    return result;
-
   result->count = 0;
   result->collision1 = _collision1;
   result->collision2 = _collision2;
@@ -247,7 +217,10 @@ unsigned int ContactManager::GetContactCount() const
 Contact *ContactManager::GetContact(unsigned int _index) const
 {
   if (_index < this->contactIndex)
+  {
+    this->UpdateWrenches();
     return this->contacts[_index];
+  }
   else
     return NULL;
 }
@@ -255,6 +228,7 @@ Contact *ContactManager::GetContact(unsigned int _index) const
 /////////////////////////////////////////////////
 const std::vector<Contact*> &ContactManager::GetContacts() const
 {
+  this->UpdateWrenches();
   return this->contacts;
 }
 
@@ -262,18 +236,46 @@ const std::vector<Contact*> &ContactManager::GetContacts() const
 void ContactManager::ResetCount()
 {
   this->contactIndex = 0;
+
+  {
+    std::lock_guard<std::mutex> lock(this->wrenchMutex);
+    this->wrenchUpdate = nullptr;
+  }
+
+  this->ResolveFilterCollisions();
+}
+
+/////////////////////////////////////////////////
+void ContactManager::SetWrenchUpdate(const std::function<void()> &_update)
+{
+  std::lock_guard<std::mutex> lock(this->wrenchMutex);
+  this->wrenchUpdate = _update;
+}
+
+/////////////////////////////////////////////////
+void ContactManager::UpdateWrenches() const
+{
+  std::lock_guard<std::mutex> lock(this->wrenchMutex);
+  if (this->wrenchUpdate)
+  {
+    this->wrenchUpdate();
+    this->wrenchUpdate = nullptr;
+  }
 }
 
 /////////////////////////////////////////////////
 void ContactManager::Clear()
 {
   // Delete all the contacts.
-  for (unsigned int i = 0; i < this->contacts.size(); ++i)
-    delete this->contacts[i];
-
   this->contacts.clear();
+  this->contactPool.clear();
 
-  boost::unordered_map<std::string, ContactPublisher *>::iterator iter;
+  {
+    std::lock_guard<std::mutex> lock(this->wrenchMutex);
+    this->wrenchUpdate = nullptr;
+  }
+
+  std::map<std::string, ContactPublisher *>::iterator iter;
   for (iter = this->customContactPublishers.begin();
       iter != this->customContactPublishers.end(); ++iter)
     iter->second->contacts.clear();
@@ -295,9 +297,11 @@ void ContactManager::PublishContacts()
     return;
   }
 
-  // publish to default topic, ~/physics/contacts
-  if (!transport::getMinimalComms())
+  // publish to default topic, ~/physics/contacts, if anyone listens
+  if (!transport::getMinimalComms() && this->contactPub->HasConnections())
   {
+    this->UpdateWrenches();
+
     msgs::Contacts msg;
     for (unsigned int i = 0; i < this->contactIndex; ++i)
     {
@@ -314,11 +318,14 @@ void ContactManager::PublishContacts()
 
   // publish to other custom topics
   boost::recursive_mutex::scoped_lock lock(*this->customMutex);
-  boost::unordered_map<std::string, ContactPublisher *>::iterator iter;
+  std::map<std::string, ContactPublisher *>::iterator iter;
   for (iter = this->customContactPublishers.begin();
       iter != this->customContactPublishers.end(); ++iter)
   {
     ContactPublisher *contactPublisher = iter->second;
+    if (!contactPublisher->contacts.empty())
+      this->UpdateWrenches();
+
     msgs::Contacts msg2;
     for (unsigned int j = 0;
         j < contactPublisher->contacts.size(); ++j)
@@ -375,6 +382,7 @@ std::string ContactManager::CreateFilter(const std::string &_name,
   {
     boost::recursive_mutex::scoped_lock lock(*this->customMutex);
     this->customContactPublishers[name] = contactPublisher;
+    this->IndexFilter(contactPublisher);
   }
 
   return topic;
@@ -419,6 +427,8 @@ std::string ContactManager::CreateFilter(const std::string &_name,
 
     // Let it know about collisions not yet found.
     this->customContactPublishers[name]->collisionNames = collisionNames;
+    if (!collisionNames.empty())
+      this->pendingFilterNames = true;
   }
 
   return topic;
@@ -431,17 +441,29 @@ void ContactManager::RemoveFilter(const std::string &_name)
   boost::replace_all(name, "::", "/");
 
   boost::recursive_mutex::scoped_lock lock(*this->customMutex);
-  boost::unordered_map<std::string, ContactPublisher *>::iterator iter
+  std::map<std::string, ContactPublisher *>::iterator iter
       = this->customContactPublishers.find(name);
   if (iter != customContactPublishers.end())
   {
     ContactPublisher *contactPublisher = iter->second;
+    for (auto const &col : contactPublisher->collisions)
+    {
+      auto filters = this->filterIndex.find(col);
+      if (filters == this->filterIndex.end())
+        continue;
+      filters->second.erase(std::remove(filters->second.begin(),
+          filters->second.end(), contactPublisher), filters->second.end());
+      if (filters->second.empty())
+        this->filterIndex.erase(filters);
+    }
+
     contactPublisher->contacts.clear();
     contactPublisher->collisionNames.clear();
     contactPublisher->collisions.clear();
     contactPublisher->publisher->Fini();
     contactPublisher->publisher.reset();
     this->customContactPublishers.erase(iter);
+    delete contactPublisher;
   }
 }
 
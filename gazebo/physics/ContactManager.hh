@@ -18,13 +18,16 @@
 #ifndef GAZEBO_PHYSICS_CONTACTMANAGER_HH_
 #define GAZEBO_PHYSICS_CONTACTMANAGER_HH_
 
+#include <deque>
+#include <functional>
 #include <vector>
 #include <string>
 #include <map>
+#include <mutex>
 #include <ignition/transport/Node.hh>
 
-#include <boost/unordered/unordered_set.hpp>
 #include <boost/unordered/unordered_map.hpp>
+#include <boost/unordered/unordered_set.hpp>
 #include <boost/thread/recursive_mutex.hpp>
 
 #include "gazebo/transport/TransportTypes.hh"
@@ -125,12 +128,8 @@ namespace gazebo
       /// there are any subscribers for the contacts, but the test here is
       /// optimized because it returns as soon as one subscriber is found which
       /// listens to either of the collisions.
-      /// Note that this function needs to go through the list of custom
-      /// publishers and check whether \e _collsion1 or \e _collision2
-      /// are part of the custom publishers and whether they have been loaded
-      /// into the world, which comes at a cost.
-      /// Unless there are any benefits in calling this function ahead of
-      /// NewContact, it may be better to just use NewContact() directly.
+      /// The filters of each collision are indexed when the filters are
+      /// created, so this is a constant time lookup.
       /// Also note that in order to exclude that NewContact() returns NULL,
       /// it is advisable to check NeverDropContacts() first (if it returns
       /// true, NewContacts() never returns NULL).
@@ -165,6 +164,13 @@ namespace gazebo
       /// \brief Set the contact count to zero.
       public: void ResetCount();
 
+      /// \brief Set a function that fills Contact::wrench for the current
+      /// contacts. Physics engines that compute wrenches on demand set it
+      /// after each update. It runs at most once, the first time the
+      /// contacts are read or published, and is dropped by ResetCount.
+      /// \param[in] _update Function that fills the wrenches.
+      public: void SetWrenchUpdate(const std::function<void()> &_update);
+
       /// \brief Create a filter for contacts. A new publisher will be created
       /// that publishes contacts associated to the input collisions.
       /// param[in] _name Filter name.
@@ -204,19 +210,36 @@ namespace gazebo
       /// return True if the filter exists.
       public: bool HasFilter(const std::string &_name);
 
-      /// \brief Helper function which gets the custom publishers which publish
-      ///   contacts of either \e _collision1 or \e _collision2.
-      /// \param[in] _collision1 the first collision object
-      /// \param[in] _collision2 the second collision object
-      /// \param[in] _getOnlyConnected return only publishers which currently
-      ///   have subscribers
-      /// \param[out] _publishers the resulting publishers.
-      private: void GetCustomPublishers(Collision *_collision1,
-                       Collision *_collision2, const bool _getOnlyConnected,
-                       std::vector<ContactPublisher*> &_publishers);
+      /// \brief Run the pending wrench update, if any.
+      private: void UpdateWrenches() const;
+
+      /// \brief Add the collisions of a filter to the filter index.
+      /// \param[in] _publisher Publisher of the filter.
+      private: void IndexFilter(ContactPublisher *_publisher);
 
+      /// \brief Look up the collisions of the filters which were not loaded
+      /// yet when the filters were created, and index the ones found.
+      /// Called once per collision pass, from ResetCount.
+      private: void ResolveFilterCollisions();
+
+      /// \brief Contacts handed out by NewContact, which point into
+      /// contactPool.
       private: std::vector<Contact*> contacts;
 
+      /// \brief Storage of the contacts. Grows to the largest number of
+      /// contacts in a collision pass and is reused afterwards. A deque
+      /// keeps the contacts in place while it grows.
+      private: std::deque<Contact> contactPool;
+
+      /// \brief Custom publishers of the filters monitoring each
+      /// collision.
+      private: boost::unordered_map<Collision *,
+               std::vector<ContactPublisher *>> filterIndex;
+
+      /// \brief True if some filters have collisions which were not found
+      /// in the world yet.
+      private: bool pendingFilterNames = false;
+
       private: unsigned int contactIndex;
 
       /// \brief Node for communication.
@@ -229,8 +252,9 @@ namespace gazebo
       private: WorldPtr world;
 
       /// \brief A list of custom publishers that publish filtered contact
-      /// messages to the specified topic
-      private: boost::unordered_map<std::string, ContactPublisher *>
+      /// messages to the specified topic. Ordered by name so contacts are
+      /// handed out and published in the same order on every run.
+      private: std::map<std::string, ContactPublisher *>
           customContactPublishers;
 
       /// \brief Mutex to protect the list of custom publishers.
@@ -249,6 +273,12 @@ namespace gazebo
       /// This takes effect if NewContact() is called if there
       /// are no subscribers. Default is false.
       private: bool neverDropContacts;
+
+      /// \brief Pending wrench update, see SetWrenchUpdate.
+      private: mutable std::function<void()> wrenchUpdate;
+
+      /// \brief Protects wrenchUpdate.
+      private: mutable std::mutex wrenchMutex;
     };
     /// \}
   }
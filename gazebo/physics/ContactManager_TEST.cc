@@ -15,6 +15,8 @@
  *
 */
 
+#include <cmath>
+
 #include "gazebo/physics/ContactManager.hh"
 #include "gazebo/test/ServerFixture.hh"
 
@@ -194,6 +196,177 @@ TEST_F(ContactManagerTest, NeverDropContacts)
   }
 }
 
+/////////////////////////////////////////////////
+TEST_F(ContactManagerTest, WrenchUpdate)
+{
+  Load("test/worlds/box.world", true);
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+
+  physics::ContactManager *manager = physics->GetContactManager();
+  ASSERT_TRUE(manager != nullptr);
+
+  // The update runs once, when contacts are first read
+  int calls = 0;
+  manager->SetWrenchUpdate([&calls]() { ++calls; });
+  manager->GetContactCount();
+  EXPECT_EQ(0, calls);
+  manager->GetContacts();
+  EXPECT_EQ(1, calls);
+  manager->GetContacts();
+  EXPECT_EQ(1, calls);
+
+  // A new collision pass drops it
+  manager->SetWrenchUpdate([&calls]() { ++calls; });
+  manager->ResetCount();
+  manager->GetContacts();
+  EXPECT_EQ(1, calls);
+
+  // Wrenches filled by the physics engine are there when read
+  manager->SetNeverDropContacts(true);
+  world->Step(100);
+  ASSERT_GT(manager->GetContactCount(), 0u);
+
+  double force = 0;
+  for (unsigned int i = 0; i < manager->GetContactCount(); ++i)
+  {
+    physics::Contact *contact = manager->GetContact(i);
+    ASSERT_TRUE(contact != nullptr);
+    for (int j = 0; j < contact->count; ++j)
+    {
+      force += contact->wrench[j].body1Force.Length() +
+          contact->wrench[j].body2Force.Length();
+    }
+  }
+  EXPECT_GT(force, 0.0);
+}
+
+/////////////////////////////////////////////////
+TEST_F(ContactManagerTest, WrenchRotatingLink)
+{
+  Load("worlds/empty.world", true);
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+
+  physics::ContactManager *manager = physics->GetContactManager();
+  ASSERT_TRUE(manager != nullptr);
+  manager->SetNeverDropContacts(true);
+
+  // A frictionless sphere resting on the ground, so the only contact force
+  // is the normal force, along the world Z axis.
+  SpawnSphere("sphere", ignition::math::Vector3d(0, 0, 0.5),
+      ignition::math::Vector3d::Zero);
+  physics::ModelPtr model = world->ModelByName("sphere");
+  ASSERT_TRUE(model != nullptr);
+  model->SetAutoDisable(false);
+  physics::LinkPtr link = model->GetLink();
+  ASSERT_TRUE(link != nullptr);
+  physics::CollisionPtr collision = link->GetCollision(0u);
+  ASSERT_TRUE(collision != nullptr);
+  collision->GetSurface()->FrictionPyramid()->SetMuPrimary(0.0);
+  collision->GetSurface()->FrictionPyramid()->SetMuSecondary(0.0);
+  world->Step(200);
+
+  // Spin it in place about the world Y axis, so its orientation changes
+  // noticeably within a step.
+  link->SetAngularVel(ignition::math::Vector3d(0, 50, 0));
+  world->Step(10);
+
+  const ignition::math::Quaterniond preRot = link->WorldPose().Rot();
+  world->Step(1);
+  const ignition::math::Quaterniond postRot = link->WorldPose().Rot();
+  EXPECT_GT((preRot.Inverse() * postRot).Euler().Length(), 0.01);
+
+  // Wrenches are expressed in the link frame at the end of the step
+  ASSERT_GT(manager->GetContactCount(), 0u);
+  ignition::math::Vector3d force;
+  for (unsigned int i = 0; i < manager->GetContactCount(); ++i)
+  {
+    physics::Contact *contact = manager->GetContact(i);
+    ASSERT_TRUE(contact != nullptr);
+    for (int j = 0; j < contact->count; ++j)
+    {
+      if (contact->collision1->GetLink() == link)
+        force += contact->wrench[j].body1Force;
+      else if (contact->collision2->GetLink() == link)
+        force += contact->wrench[j].body2Force;
+    }
+  }
+  ASSERT_GT(force.Length(), 1.0);
+
+  const ignition::math::Vector3d worldForce = postRot.RotateVector(force);
+  EXPECT_NEAR(worldForce.X(), 0.0, 1e-3 * worldForce.Z());
+  EXPECT_NEAR(worldForce.Y(), 0.0, 1e-3 * worldForce.Z());
+
+  // The orientation at the start of the step tilts the normal force
+  const ignition::math::Vector3d preForce = preRot.RotateVector(force);
+  EXPECT_GT(std::abs(preForce.X()), 1e-3 * worldForce.Z());
+}
+
+/////////////////////////////////////////////////
+TEST_F(ContactManagerTest, FilterIndex)
+{
+  Load("test/worlds/box.world", true);
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+
+  physics::ContactManager *manager = physics->GetContactManager();
+  ASSERT_TRUE(manager != nullptr);
+
+  physics::CollisionPtr box = boost::dynamic_pointer_cast<physics::Collision>(
+      world->BaseByName("box::link::collision"));
+  physics::CollisionPtr ground =
+      boost::dynamic_pointer_cast<physics::Collision>(
+      world->BaseByName("ground_plane::link::collision"));
+  ASSERT_TRUE(box != nullptr);
+  ASSERT_TRUE(ground != nullptr);
+  EXPECT_FALSE(manager->SubscribersConnected(box.get(), ground.get()));
+
+  // Both orders of the pair are routed to the filter
+  manager->CreateFilter("box_filter", "box::link::collision");
+  EXPECT_TRUE(manager->SubscribersConnected(box.get(), ground.get()));
+  EXPECT_TRUE(manager->SubscribersConnected(ground.get(), box.get()));
+
+  // Contacts are created for the filter only
+  world->Step(1);
+  EXPECT_GT(manager->GetContactCount(), 0u);
+
+  // A filter on a collision which is not loaded yet is indexed once
+  // the collision appears
+  manager->CreateFilter("sphere_filter", "sphere::link::collision");
+  SpawnSphere("sphere", ignition::math::Vector3d(5, 0, 0.5),
+      ignition::math::Vector3d::Zero);
+  physics::CollisionPtr sphere =
+      boost::dynamic_pointer_cast<physics::Collision>(
+      world->BaseByName("sphere::link::collision"));
+  ASSERT_TRUE(sphere != nullptr);
+  world->Step(1);
+  EXPECT_TRUE(manager->SubscribersConnected(ground.get(), sphere.get()));
+
+  // Removing a filter removes it from the index
+  manager->RemoveFilter("box_filter");
+  EXPECT_FALSE(manager->SubscribersConnected(box.get(), ground.get()));
+  EXPECT_TRUE(manager->SubscribersConnected(ground.get(), sphere.get()));
+  manager->RemoveFilter("sphere_filter");
+  EXPECT_FALSE(manager->SubscribersConnected(ground.get(), sphere.get()));
+
+  world->Step(1);
+  EXPECT_EQ(0u, manager->GetContactCount());
+}
+
+/////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -16,7 +16,10 @@
 */
 #include <algorithm>
 #include <cmath>
+#include <functional>
+#include <memory>
 #include <string>
+#include <vector>
 #include <ignition/math/Helpers.hh>
 #include <gazebo/gazebo_config.h>
 
@@ -25,8 +28,12 @@
 #include "gazebo/common/Image.hh"
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/SphericalCoordinates.hh"
+#include "gazebo/physics/Collision.hh"
 #include "gazebo/physics/HeightmapShape.hh"
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/Model.hh"
 #include "gazebo/physics/World.hh"
+#include "gazebo/event/Events.hh"
 #include "gazebo/transport/transport.hh"
 
 using namespace gazebo;
@@ -42,12 +49,14 @@ HeightmapShape::HeightmapShape(CollisionPtr _parent)
       std::is_same<HeightType, double>::value,
       "Height field needs to be double or float");
   this->vertSize = 0;
+  this->heightmapData = nullptr;
   this->AddType(Base::HEIGHTMAP_SHAPE);
 }
 
 //////////////////////////////////////////////////
 HeightmapShape::~HeightmapShape()
 {
+  this->updateConnection.reset();
   this->requestSub.reset();
   this->responsePub.reset();
   if (this->node)
@@ -170,6 +179,23 @@ void HeightmapShape::Load(sdf::ElementPtr _sdf)
     return;
   }
 
+  // Tiled heightmaps are streamed, and hold heights in meters
+  if (common::HeightmapTileCache::IsTiledFile(filename))
+  {
+    this->tileCache = common::HeightmapTileCache::Acquire(filename);
+    if (!this->tileCache)
+    {
+      gzerr << "Unable to load tiled heightmap[" << filename << "]\n";
+      return;
+    }
+
+    this->subSampling = 1;
+    this->heightmapSize = this->sdf->Get<ignition::math::Vector3d>("size");
+    this->heightmapSize.Z() =
+        this->tileCache->MaxElevation() - this->tileCache->MinElevation();
+    return;
+  }
+
   if (this->LoadTerrainFile(filename) != 0)
   {
     gzerr << "Heightmap data size must be square, with a size of 2^n+1\n";
@@ -210,6 +236,29 @@ int HeightmapShape::GetSubSampling() const
 //////////////////////////////////////////////////
 void HeightmapShape::FillHeightfield(std::vector<float>& _heights)
 {
+  if (this->tileCache)
+  {
+    // The file rows are in the order of HeightmapData::FillHeightMap
+    // without flipY, so they are flipped the same way for engines that
+    // set it.
+    const std::vector<float> &overview = this->tileCache->Overview();
+    if (!this->flipY)
+    {
+      _heights = overview;
+      return;
+    }
+
+    const unsigned int size = this->tileCache->OverviewSize();
+    _heights.resize(overview.size());
+    for (unsigned int y = 0; y < size; ++y)
+    {
+      std::copy(overview.begin() + (size - 1 - y) * size,
+          overview.begin() + (size - y) * size,
+          _heights.begin() + y * size);
+    }
+    return;
+  }
+
   this->heightmapData->FillHeightMap(this->subSampling, this->vertSize,
       this->Size(), this->scale, this->flipY, _heights);
 }
@@ -218,8 +267,7 @@ void HeightmapShape::FillHeightfield(std::vector<float>& _heights)
 void HeightmapShape::FillHeightfield(std::vector<double>& _heights)
 {
   std::vector<float> fHeights;
-  this->heightmapData->FillHeightMap(this->subSampling, this->vertSize,
-      this->Size(), this->scale, this->flipY, fHeights);
+  this->FillHeightfield(fHeights);
   _heights = std::vector<double>(fHeights.begin(), fHeights.end());
 }
 
@@ -235,6 +283,22 @@ void HeightmapShape::Init()
 
   ignition::math::Vector3d terrainSize = this->Size();
 
+  if (this->tileCache)
+  {
+    this->vertSize = this->tileCache->OverviewSize();
+    this->scale.X() = terrainSize.X() / this->vertSize;
+    this->scale.Y() = terrainSize.Y() / this->vertSize;
+    this->scale.Z() = 1.0;
+    this->FillHeightfield(this->heights);
+
+    this->activeTiles.assign(
+        this->tileCache->TileCount() * this->tileCache->TileCount(), nullptr);
+    this->updateConnection = event::Events::ConnectWorldUpdateBegin(
+        std::bind(&HeightmapShape::OnWorldUpdateBegin, this,
+        std::placeholders::_1));
+    return;
+  }
+
   // sampling size along image width and height
   this->vertSize = (this->heightmapData->GetWidth() * this->subSampling)
       - this->subSampling + 1;
@@ -414,3 +478,179 @@ double HeightmapShape::ComputeVolume() const
 {
   return 0;
 }
+
+//////////////////////////////////////////////////
+bool HeightmapShape::Tiled() const
+{
+  return this->tileCache != nullptr;
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<common::HeightmapTileCache> HeightmapShape::TileCache() const
+{
+  return this->tileCache;
+}
+
+//////////////////////////////////////////////////
+void HeightmapShape::SetTileRadius(const double _radius)
+{
+  this->tileRadius = std::max(0.0, _radius);
+}
+
+//////////////////////////////////////////////////
+double HeightmapShape::TileRadius() const
+{
+  if (this->tileRadius >= 0.0 || !this->tileCache)
+    return std::max(0.0, this->tileRadius);
+
+  return this->Size().X() * (this->tileCache->TileSize() - 1) /
+      (this->tileCache->Size() - 1);
+}
+
+//////////////////////////////////////////////////
+void HeightmapShape::OnWorldUpdateBegin(const common::UpdateInfo &_info)
+{
+  // World Update events are global, and the tiles must not change while
+  // another world steps and reads them.
+  if (_info.worldName != this->world->Name())
+    return;
+
+  this->tilePoints.clear();
+
+  std::function<void(const ModelPtr &)> addLinks =
+      [this, &addLinks](const ModelPtr &_model)
+      {
+        if (_model->IsStatic())
+          return;
+        for (auto const &link : _model->GetLinks())
+          this->tilePoints.push_back(link->WorldPose().Pos());
+        for (auto const &nested : _model->NestedModels())
+          addLinks(nested);
+      };
+
+  for (auto const &model : this->world->Models())
+    addLinks(model);
+
+  this->UpdateTiles(this->tilePoints);
+}
+
+//////////////////////////////////////////////////
+void HeightmapShape::UpdateTiles(
+    const std::vector<ignition::math::Vector3d> &_points)
+{
+  if (!this->tileCache || this->activeTiles.empty())
+    return;
+
+  const int tileCount = static_cast<int>(this->tileCache->TileCount());
+  const double cells = this->tileCache->Size() - 1;
+  const double tileCells = this->tileCache->TileSize() - 1;
+  const ignition::math::Vector3d size = this->Size();
+  const ignition::math::Pose3d pose =
+      this->collisionParent->WorldPose() * ignition::math::Pose3d(
+      this->Pos(), ignition::math::Quaterniond::Identity);
+  const double radius = this->TileRadius();
+
+  // Tiles within the radius of a point, in the heightmap frame. Rows of
+  // the file start on the +Y side.
+  // The tiles are read here, before the world update, so that the
+  // collision step never waits on the file.
+  std::vector<unsigned int> indices;
+  for (auto const &point : _points)
+  {
+    ignition::math::Vector3d local = pose.Rot().RotateVectorReverse(
+        point - pose.Pos());
+    const double x = (local.X() + 0.5 * size.X()) / size.X() * cells;
+    const double y = (0.5 * size.Y() - local.Y()) / size.Y() * cells;
+    const double rx = radius / size.X() * cells;
+    const double ry = radius / size.Y() * cells;
+
+    const int minX = std::max(0, static_cast<int>(
+        std::floor((x - rx) / tileCells)));
+    const int maxX = std::min(tileCount - 1, static_cast<int>(
+        std::floor((x + rx) / tileCells)));
+    const int minY = std::max(0, static_cast<int>(
+        std::floor((y - ry) / tileCells)));
+    const int maxY = std::min(tileCount - 1, static_cast<int>(
+        std::floor((y + ry) / tileCells)));
+
+    for (int ty = minY; ty <= maxY; ++ty)
+    {
+      for (int tx = minX; tx <= maxX; ++tx)
+        indices.push_back(ty * tileCount + tx);
+    }
+  }
+  std::sort(indices.begin(), indices.end());
+  indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+
+  if (indices == this->activeTileIndices)
+    return;
+
+  // Release the tiles left behind, then load the new ones
+  for (auto const index : this->activeTileIndices)
+  {
+    if (!std::binary_search(indices.begin(), indices.end(), index))
+      this->activeTiles[index].reset();
+  }
+  for (auto const index : indices)
+  {
+    if (!this->activeTiles[index])
+    {
+      this->activeTiles[index] = this->tileCache->TileAt(
+          index % tileCount, index / tileCount);
+    }
+  }
+  this->activeTileIndices.swap(indices);
+}
+
+//////////////////////////////////////////////////
+std::vector<ignition::math::Vector2i> HeightmapShape::ActiveTiles() const
+{
+  std::vector<ignition::math::Vector2i> result;
+  if (!this->tileCache)
+    return result;
+
+  const unsigned int tileCount = this->tileCache->TileCount();
+  for (auto const index : this->activeTileIndices)
+    result.emplace_back(index % tileCount, index / tileCount);
+  return result;
+}
+
+//////////////////////////////////////////////////
+ignition::math::Vector2i HeightmapShape::TiledVertexCount() const
+{
+  if (!this->tileCache)
+    return ignition::math::Vector2i::Zero;
+
+  const int size = static_cast<int>(this->tileCache->Size());
+  return ignition::math::Vector2i(size, size);
+}
+
+//////////////////////////////////////////////////
+HeightmapShape::HeightType HeightmapShape::TiledHeight(int _x, int _y) const
+{
+  if (!this->tileCache || _x < 0 || _y < 0)
+    return 0.0;
+
+  const int size = static_cast<int>(this->tileCache->Size());
+  if (_x >= size || _y >= size)
+    return 0.0;
+
+  // Same row order as FillHeightfield
+  if (this->flipY)
+    _y = size - 1 - _y;
+
+  const int tileSize = static_cast<int>(this->tileCache->TileSize());
+  const int tileCount = static_cast<int>(this->tileCache->TileCount());
+  const int tx = std::min(_x / (tileSize - 1), tileCount - 1);
+  const int ty = std::min(_y / (tileSize - 1), tileCount - 1);
+
+  const std::size_t index = ty * tileCount + tx;
+  // This is called from the collision step, which must not read the file.
+  // Away from the links, the overview is enough.
+  if (index >= this->activeTiles.size() || !this->activeTiles[index])
+    return this->tileCache->OverviewHeight(_x, _y);
+
+  auto const &tile = this->activeTiles[index];
+  return (*tile)[(_y - ty * (tileSize - 1)) * tileSize +
+      (_x - tx * (tileSize - 1))];
+}
@@ -17,15 +17,19 @@
 #ifndef GAZEBO_PHYSICS_HEIGHTMAPSHAPE_HH_
 #define GAZEBO_PHYSICS_HEIGHTMAPSHAPE_HH_
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <ignition/transport/Node.hh>
 
 #include <ignition/math/Vector2.hh>
 
+#include "gazebo/common/CommonTypes.hh"
 #include "gazebo/common/ImageHeightmap.hh"
 #include "gazebo/common/HeightmapData.hh"
+#include "gazebo/common/HeightmapTileCache.hh"
 #include "gazebo/common/Dem.hh"
+#include "gazebo/common/UpdateInfo.hh"
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/physics/Shape.hh"
@@ -42,6 +46,14 @@ namespace gazebo
     /// \brief HeightmapShape collision shape builds a heightmap from
     /// an image.  The supplied image must be square with
     /// N*N+1 pixels per side, where N is an integer.
+    ///
+    /// The uri may also point to a tiled heightmap file, see
+    /// common::HeightmapTileCache, for terrains too large to be held in
+    /// memory. The heights, in meters, are then used as they are, and only
+    /// the size along X and Y is read from the SDF. The height lookup table
+    /// holds the overview of the terrain, while the full resolution tiles
+    /// around the links of non static models are kept in memory and
+    /// exposed through TiledHeight.
     class GZ_PHYSICS_VISIBLE HeightmapShape : public Shape
     {
       /// \brief height field type, float or double
@@ -140,6 +152,52 @@ namespace gazebo
       /// \param[in] _msg The request message.
       private: void OnRequest(ConstRequestPtr &_msg);
 
+      /// \brief Update the active tiles before a world update.
+      /// \param[in] _info Update information.
+      private: void OnWorldUpdateBegin(const common::UpdateInfo &_info);
+
+      /// \brief Get whether the heightmap is loaded from a tiled file.
+      /// \return True if tiled.
+      public: bool Tiled() const;
+
+      /// \brief Get the tile cache of a tiled heightmap.
+      /// \return The cache, null if the heightmap is not tiled.
+      public: std::shared_ptr<common::HeightmapTileCache> TileCache() const;
+
+      /// \brief Set the distance around the links of non static models
+      /// within which full resolution tiles are kept in memory.
+      /// \param[in] _radius Distance in meters.
+      public: void SetTileRadius(const double _radius);
+
+      /// \brief Get the distance within which tiles are kept in memory.
+      /// \return Distance in meters. Defaults to the size of a tile.
+      public: double TileRadius() const;
+
+      /// \brief Keep in memory the tiles around a set of points, and
+      /// release the others. Called before every world update with the
+      /// positions of the links of non static models.
+      /// \param[in] _points Points in the world frame.
+      public: void UpdateTiles(
+                  const std::vector<ignition::math::Vector3d> &_points);
+
+      /// \brief Get the tiles currently kept in memory.
+      /// \return Column and row of each tile.
+      public: std::vector<ignition::math::Vector2i> ActiveTiles() const;
+
+      /// \brief Get the number of full resolution vertices of a tiled
+      /// heightmap.
+      /// \return Number of vertices along X and Y, zero if not tiled.
+      public: ignition::math::Vector2i TiledVertexCount() const;
+
+      /// \brief Get a full resolution height of a tiled heightmap. Rows
+      /// are ordered as in the height lookup table. Heights outside the
+      /// active tiles are interpolated from the overview, so the file is
+      /// never read.
+      /// \param[in] _x Column of the vertex.
+      /// \param[in] _y Row of the vertex.
+      /// \return Height in meters, zero if out of range or not tiled.
+      public: HeightType TiledHeight(int _x, int _y) const;
+
       /// \brief Fills the heightmap data (float) into the vector
       /// by calling HeightmapData::FillHeightMap with \e heights
       /// \param[in] heights height field to fill with data.
@@ -181,6 +239,27 @@ namespace gazebo
       /// \brief Terrain size
       private: ignition::math::Vector3d heightmapSize;
 
+      /// \brief Tile cache of a tiled heightmap, shared with the other
+      /// users of the file.
+      private: std::shared_ptr<common::HeightmapTileCache> tileCache;
+
+      /// \brief Tiles kept in memory, by tile index, null if inactive.
+      private: std::vector<common::HeightmapTileCache::Tile> activeTiles;
+
+      /// \brief Indices of the tiles kept in memory, sorted.
+      private: std::vector<unsigned int> activeTileIndices;
+
+      /// \brief Distance within which tiles are kept in memory, negative
+      /// to use the size of a tile.
+      private: double tileRadius = -1.0;
+
+      /// \brief Points of the links of non static models, reused between
+      /// updates.
+      private: std::vector<ignition::math::Vector3d> tilePoints;
+
+      /// \brief Connection to the world update event of a tiled heightmap.
+      private: event::ConnectionPtr updateConnection;
+
       #ifdef HAVE_GDAL
       /// \brief DEM used to generate the heights.
       private: common::Dem dem;
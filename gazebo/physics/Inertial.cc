@@ -14,12 +14,15 @@
  * limitations under the License.
  *
 */
+#include <atomic>
 #include <functional>
 #include "gazebo/physics/Inertial.hh"
 
 using namespace gazebo;
 using namespace physics;
 
+/// \brief Source of Inertial revisions, shared by all objects.
+static std::atomic<uint64_t> g_inertialRevision(0);
 
 /// \internal
 /// \brief Private Inertial data
@@ -48,6 +51,15 @@ class gazebo::physics::InertialPrivate
   /// \brief An SDF pointer that allows us to only read the inertial.sdf
   /// file once, which in turns limits disk reads.
   public: static sdf::ElementPtr sdfInertial;
+
+  /// \brief Mark the mass properties as changed.
+  public: void Modified()
+  {
+    this->revision = ++g_inertialRevision;
+  }
+
+  /// \brief Revision of the mass properties, see Inertial::Revision.
+  public: std::atomic<uint64_t> revision{++g_inertialRevision};
 };
 
 sdf::ElementPtr gazebo::physics::InertialPrivate::sdfInertial;
@@ -206,12 +218,14 @@ void Inertial::Reset()
         inertiaElem->Get<double>("ixy"),
         inertiaElem->Get<double>("ixz"),
         inertiaElem->Get<double>("iyz"));
+  this->dataPtr->Modified();
 }
 
 //////////////////////////////////////////////////
 void Inertial::SetMass(const double _m)
 {
   this->dataPtr->mass = _m;
+  this->dataPtr->Modified();
 }
 
 //////////////////////////////////////////////////
@@ -224,6 +238,7 @@ double Inertial::Mass() const
 void Inertial::SetCoG(const double _cx, const double _cy, const double _cz)
 {
   this->dataPtr->cog.Pos().Set(_cx, _cy, _cz);
+  this->dataPtr->Modified();
 }
 
 //////////////////////////////////////////////////
@@ -231,6 +246,7 @@ void Inertial::SetCoG(const ignition::math::Vector3d &_c)
 
 {
   this->dataPtr->cog.Pos() = _c;
+  this->dataPtr->Modified();
 }
 
 //////////////////////////////////////////////////
@@ -238,12 +254,14 @@ void Inertial::SetCoG(const double _cx, const double _cy, const double _cz,
                       const double _rx, const double _ry, const double _rz)
 {
   this->dataPtr->cog.Set(_cx, _cy, _cz, _rx, _ry, _rz);
+  this->dataPtr->Modified();
 }
 
 //////////////////////////////////////////////////
 void Inertial::SetCoG(const ignition::math::Pose3d &_c)
 {
   this->dataPtr->cog = _c;
+  this->dataPtr->Modified();
 }
 
 //////////////////////////////////////////////////
@@ -253,6 +271,7 @@ void Inertial::SetInertiaMatrix(
 {
   this->dataPtr->principals.Set(ixx, iyy, izz);
   this->dataPtr->products.Set(ixy, ixz, iyz);
+  this->dataPtr->Modified();
 }
 
 //////////////////////////////////////////////////
@@ -273,6 +292,7 @@ void Inertial::SetMOI(const ignition::math::Matrix3d &_moi)
   /// \TODO: check symmetry of incoming _moi matrix
   this->dataPtr->principals.Set(_moi(0, 0), _moi(1, 1), _moi(2, 2));
   this->dataPtr->products.Set(_moi(0, 1), _moi(0, 2), _moi(1, 2));
+  this->dataPtr->Modified();
 }
 
 //////////////////////////////////////////////////
@@ -293,6 +313,7 @@ void Inertial::Rotate(const ignition::math::Quaterniond &_rot)
   /// \TODO: double check what this does, if needed
   this->dataPtr->cog.Pos() = _rot.RotateVector(this->dataPtr->cog.Pos());
   this->dataPtr->cog.Rot() = _rot * this->dataPtr->cog.Rot();
+  this->dataPtr->Modified();
 }
 
 //////////////////////////////////////////////////
@@ -302,6 +323,7 @@ Inertial &Inertial::operator=(const Inertial &_inertial)
   this->dataPtr->cog = _inertial.dataPtr->cog;
   this->dataPtr->principals = _inertial.dataPtr->principals;
   this->dataPtr->products = _inertial.dataPtr->products;
+  this->dataPtr->Modified();
 
   return *this;
 }
@@ -416,36 +438,42 @@ double Inertial::IYZ() const
 void Inertial::SetIXX(const double _v)
 {
   this->dataPtr->principals.X(_v);
+  this->dataPtr->Modified();
 }
 
 //////////////////////////////////////////////////
 void Inertial::SetIYY(const double _v)
 {
   this->dataPtr->principals.Y(_v);
+  this->dataPtr->Modified();
 }
 
 //////////////////////////////////////////////////
 void Inertial::SetIZZ(const double _v)
 {
   this->dataPtr->principals.Z(_v);
+  this->dataPtr->Modified();
 }
 
 //////////////////////////////////////////////////
 void Inertial::SetIXY(const double _v)
 {
   this->dataPtr->products.X(_v);
+  this->dataPtr->Modified();
 }
 
 //////////////////////////////////////////////////
 void Inertial::SetIXZ(const double _v)
 {
   this->dataPtr->products.Y(_v);
+  this->dataPtr->Modified();
 }
 
 //////////////////////////////////////////////////
 void Inertial::SetIYZ(const double _v)
 {
   this->dataPtr->products.Z(_v);
+  this->dataPtr->Modified();
 }
 
 //////////////////////////////////////////////////
@@ -483,6 +511,12 @@ ignition::math::Pose3d Inertial::Pose() const
   return ignition::math::Pose3d(this->dataPtr->cog);
 }
 
+//////////////////////////////////////////////////
+uint64_t Inertial::Revision() const
+{
+  return this->dataPtr->revision;
+}
+
 //////////////////////////////////////////////////
 ignition::math::Inertiald Inertial::Ign() const
 {
@@ -501,6 +535,7 @@ Inertial &Inertial::operator=(const ignition::math::Inertiald &_inertial)
   this->dataPtr->cog = _inertial.Pose();
   this->dataPtr->principals = _inertial.MassMatrix().DiagonalMoments();
   this->dataPtr->products = _inertial.MassMatrix().OffDiagonalMoments();
+  this->dataPtr->Modified();
 
   return *this;
 }
@@ -17,6 +17,7 @@
 #ifndef GAZEBO_PHYSICS_INERTIAL_HH_
 #define GAZEBO_PHYSICS_INERTIAL_HH_
 
+#include <cstdint>
 #include <string>
 #include <memory>
 
@@ -270,6 +271,13 @@ namespace gazebo
       /// \param[in] _moi Moments of Inertia as a Matrix3
       public: void SetMOI(const ignition::math::Matrix3d &_moi);
 
+      /// \brief Get a number that changes every time the mass, center of
+      /// gravity or moments of inertia change. No two Inertial objects
+      /// share a value, so it also tells copies and replacements apart.
+      /// It may be read from any thread.
+      /// \return Revision of the mass properties.
+      public: uint64_t Revision() const;
+
       /// \internal
       /// \brief Private data pointer.
       private: std::unique_ptr<InertialPrivate> dataPtr;
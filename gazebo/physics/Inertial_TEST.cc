@@ -100,6 +100,43 @@ TEST_F(Inertial_TEST, InertialOperators)
   EXPECT_NEAR(i2.IZZ(), 3, TOL);
 }
 
+/////////////////////////////////////////////////
+TEST_F(Inertial_TEST, Revision)
+{
+  physics::Inertial i1(2.0);
+  physics::Inertial i2(2.0);
+  EXPECT_NE(i1.Revision(), i2.Revision());
+
+  // Every setter changes the revision
+  uint64_t revision = i1.Revision();
+  auto expectChanged = [&]()
+  {
+    EXPECT_NE(revision, i1.Revision());
+    revision = i1.Revision();
+  };
+  i1.SetMass(3.0);
+  expectChanged();
+  i1.SetCoG(ignition::math::Vector3d(1, 0, 0));
+  expectChanged();
+  i1.SetCoG(ignition::math::Pose3d(0, 1, 0, 0, 0, 0));
+  expectChanged();
+  i1.SetInertiaMatrix(1, 2, 3, 0, 0, 0);
+  expectChanged();
+  i1.SetIXY(0.1);
+  expectChanged();
+  i1.SetMOI(i1.MOI());
+  expectChanged();
+  i1.Rotate(ignition::math::Quaterniond(0, 0, 0.5*IGN_PI));
+  expectChanged();
+  i1 = i2;
+  expectChanged();
+
+  // Getters do not
+  i1.Mass();
+  i1.MOI();
+  EXPECT_EQ(revision, i1.Revision());
+}
+
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -16,6 +16,7 @@
 */
 
 #include <boost/algorithm/string.hpp>
+#include <atomic>
 #include <functional>
 #include <mutex>
 #include <sstream>
@@ -117,8 +118,89 @@ class gazebo::physics::LinkPrivate
 
   /// \brief SDF Link DOM object
   public: const sdf::Link *linkSDFDom = nullptr;
+
+  /// \brief World kinematics derived from the link pose and inertial.
+  public: class WorldKinematics
+  {
+    /// \brief Link world pose the values were computed from.
+    public: ignition::math::Pose3d pose;
+
+    /// \brief Inertial::Revision the values were computed from.
+    public: uint64_t inertialRevision = 0;
+
+    /// \brief True once the values have been computed.
+    public: bool valid = false;
+
+    /// \brief Pose of the center of gravity in the world frame.
+    public: ignition::math::Pose3d cogPose;
+
+    /// \brief Pose of the inertial frame in the world frame.
+    public: ignition::math::Pose3d inertialPose;
+
+    /// \brief Inertia matrix in the world frame.
+    public: ignition::math::Matrix3d inertiaMatrix;
+  };
+
+  /// \brief Cached world kinematics, written by CacheWorldKinematics and
+  /// read without a lock through kinematicsSeq.
+  public: WorldKinematics kinematics;
+
+  /// \brief Sequence counter of kinematics. It is odd while kinematics
+  /// is being written, and readers retry or compute the values themselves
+  /// if it is odd or changed while they copied.
+  public: std::atomic<uint32_t> kinematicsSeq{0};
+
+  /// \brief Serializes writers of kinematics.
+  public: std::mutex kinematicsMutex;
 };
 
+/// \brief Compute the world kinematics of a link.
+/// \param[in] _pose World pose of the link.
+/// \param[in] _inertial Inertial of the link.
+/// \param[out] _kinematics Values computed from _pose and _inertial.
+static void ComputeWorldKinematics(const ignition::math::Pose3d &_pose,
+    const gazebo::physics::Inertial &_inertial,
+    gazebo::physics::LinkPrivate::WorldKinematics &_kinematics)
+{
+  _kinematics.pose = _pose;
+  _kinematics.inertialRevision = _inertial.Revision();
+  _kinematics.valid = true;
+
+  _kinematics.cogPose = _pose;
+  _kinematics.cogPose.Pos() += _pose.Rot().RotateVector(_inertial.CoG());
+
+  _kinematics.inertialPose = _inertial.Pose() + _pose;
+
+  _kinematics.inertiaMatrix = _inertial.MOI(ignition::math::Pose3d(
+      _inertial.Pose().Pos(), _pose.Rot().Inverse()));
+}
+
+/// \brief Read the cached world kinematics of a link.
+/// \param[in] _data Private data of the link.
+/// \param[in] _pose Current world pose of the link.
+/// \param[in] _inertial Current inertial of the link.
+/// \param[out] _kinematics Cached values.
+/// \return True if the cached values were computed from _pose and the
+/// current revision of _inertial.
+static bool ReadWorldKinematics(const gazebo::physics::LinkPrivate &_data,
+    const ignition::math::Pose3d &_pose,
+    const gazebo::physics::Inertial &_inertial,
+    gazebo::physics::LinkPrivate::WorldKinematics &_kinematics)
+{
+  const uint32_t seq = _data.kinematicsSeq.load(std::memory_order_acquire);
+  if (seq & 1u)
+    return false;
+
+  _kinematics = _data.kinematics;
+
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (_data.kinematicsSeq.load(std::memory_order_relaxed) != seq)
+    return false;
+
+  return _kinematics.valid && _kinematics.pose == _pose &&
+      _kinematics.inertialRevision == _inertial.Revision();
+}
+
 using namespace gazebo;
 using namespace physics;
 
@@ -742,6 +824,11 @@ CollisionPtr Link::GetCollision(unsigned int _index) const
 ignition::math::Pose3d Link::WorldCoGPose() const
 {
   ignition::math::Pose3d pose = this->WorldPose();
+
+  LinkPrivate::WorldKinematics kinematics;
+  if (ReadWorldKinematics(*this->dataPtr, pose, *this->inertial, kinematics))
+    return kinematics.cogPose;
+
   pose.Pos() += pose.Rot().RotateVector(this->inertial->CoG());
   return pose;
 }
@@ -896,23 +983,61 @@ void Link::SetInertial(const InertialPtr &/*_inertial*/)
 //////////////////////////////////////////////////
 ignition::math::Pose3d Link::WorldInertialPose() const
 {
-  ignition::math::Pose3d inertialPose;
-  if (this->inertial)
-    inertialPose = this->inertial->Pose();
-  return inertialPose + this->WorldPose();
+  if (!this->inertial)
+    return this->WorldPose();
+
+  const ignition::math::Pose3d pose = this->WorldPose();
+
+  LinkPrivate::WorldKinematics kinematics;
+  if (ReadWorldKinematics(*this->dataPtr, pose, *this->inertial, kinematics))
+    return kinematics.inertialPose;
+
+  return this->inertial->Pose() + pose;
 }
 
 //////////////////////////////////////////////////
 ignition::math::Matrix3d Link::WorldInertiaMatrix() const
 {
-  ignition::math::Matrix3d moi;
-  if (this->inertial)
+  if (!this->inertial)
+    return ignition::math::Matrix3d();
+
+  const ignition::math::Pose3d pose = this->WorldPose();
+
+  LinkPrivate::WorldKinematics kinematics;
+  if (ReadWorldKinematics(*this->dataPtr, pose, *this->inertial, kinematics))
+    return kinematics.inertiaMatrix;
+
+  ignition::math::Vector3d pos = this->inertial->Pose().Pos();
+  ignition::math::Quaterniond rot = pose.Rot().Inverse();
+  return this->inertial->MOI(ignition::math::Pose3d(pos, rot));
+}
+
+//////////////////////////////////////////////////
+void Link::CacheWorldKinematics()
+{
+  if (!this->inertial)
+    return;
+
+  const ignition::math::Pose3d pose = this->WorldPose();
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->kinematicsMutex);
+
+  // Writers hold the lock, so the values can be read directly.
+  LinkPrivate::WorldKinematics &kinematics = this->dataPtr->kinematics;
+  if (kinematics.valid && kinematics.pose == pose &&
+      kinematics.inertialRevision == this->inertial->Revision())
   {
-    ignition::math::Vector3d pos = this->inertial->Pose().Pos();
-    ignition::math::Quaterniond rot = this->WorldPose().Rot().Inverse();
-    moi = this->inertial->MOI(ignition::math::Pose3d(pos, rot));
+    return;
   }
-  return moi;
+
+  const uint32_t seq =
+      this->dataPtr->kinematicsSeq.load(std::memory_order_relaxed);
+  this->dataPtr->kinematicsSeq.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  ComputeWorldKinematics(pose, *this->inertial, kinematics);
+
+  this->dataPtr->kinematicsSeq.store(seq + 2, std::memory_order_release);
 }
 
 //////////////////////////////////////////////////
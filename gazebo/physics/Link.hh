@@ -332,6 +332,14 @@ namespace gazebo
       /// of zeros if link has no inertia.
       public: ignition::math::Matrix3d WorldInertiaMatrix() const;
 
+      /// \brief Store WorldCoGPose, WorldInertialPose and
+      /// WorldInertiaMatrix for the current pose and inertial, so later
+      /// calls from any thread return them without recomputing. Calls made
+      /// after the pose or the inertial change compute their value again
+      /// until the next call to this function. World::Update calls it for
+      /// every link after each physics update.
+      public: void CacheWorldKinematics();
+
       /// \cond
       /// This is an internal function
       /// \brief Get a collision by id.
@@ -15,6 +15,10 @@
  *
 */
 
+#include <map>
+#include <memory>
+#include <mutex>
+
 #include <boost/lexical_cast.hpp>
 
 #include <sdf/sdf.hh>
@@ -33,10 +37,44 @@
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/PhysicsEngine.hh"
 #include "gazebo/physics/PresetManager.hh"
+#include "gazebo/physics/ode/ODEPhysics.hh"
 
 using namespace gazebo;
 using namespace physics;
 
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief Private data for the PhysicsEngine class.
+    class PhysicsEnginePrivate
+    {
+      /// \brief True when the physics update must be reproducible, see the
+      /// "deterministic" parameter of PhysicsEngine::SetParam.
+      public: bool deterministic = false;
+    };
+  }
+}
+
+// TODO added here for ABI compatibility
+// move to a dataPtr member when merging forward.
+static std::mutex g_enginePrivateMutex;
+static std::map<const PhysicsEngine *,
+    std::unique_ptr<PhysicsEnginePrivate>> g_enginePrivate;
+
+/// \brief Get the private data of an engine, created on first use.
+/// \param[in] _engine The physics engine.
+/// \return Private data of the engine.
+static PhysicsEnginePrivate &EnginePrivate(const PhysicsEngine *_engine)
+{
+  std::lock_guard<std::mutex> lock(g_enginePrivateMutex);
+  auto &data = g_enginePrivate[_engine];
+  if (!data)
+    data.reset(new PhysicsEnginePrivate);
+  return *data;
+}
+
 //////////////////////////////////////////////////
 PhysicsEngine::PhysicsEngine(WorldPtr _world)
   : world(_world)
@@ -118,6 +156,11 @@ void PhysicsEngine::Fini()
 PhysicsEngine::~PhysicsEngine()
 {
   this->Fini();
+
+  {
+    std::lock_guard<std::mutex> lock(g_enginePrivateMutex);
+    g_enginePrivate.erase(this);
+  }
 }
 
 //////////////////////////////////////////////////
@@ -243,6 +286,8 @@ bool PhysicsEngine::SetParam(const std::string &_key,
       this->world->SetMagneticField(
           any_cast<ignition::math::Vector3d>(copy));
     }
+    else if (_key == "deterministic")
+      EnginePrivate(this).deterministic = any_cast<bool>(_value);
     else
     {
       gzwarn << "SetParam failed for [" << _key << "] in physics engine "
@@ -271,6 +316,37 @@ bool PhysicsEngine::SetParam(const std::string &_key,
   return true;
 }
 
+//////////////////////////////////////////////////
+bool PhysicsEngine::SaveSnapshot(std::vector<uint8_t> &_buffer) const
+{
+  // Dispatched here rather than through a virtual function to keep the
+  // vtable of the engines unchanged.
+  if (auto ode = dynamic_cast<const ODEPhysics *>(this))
+    return ode->SaveSnapshot(_buffer);
+
+  gzerr << "Snapshots are not supported by the ["
+        << this->GetType() << "] physics engine\n";
+  return false;
+}
+
+//////////////////////////////////////////////////
+bool PhysicsEngine::RestoreSnapshot(const uint8_t *_data,
+    const size_t _size)
+{
+  if (auto ode = dynamic_cast<ODEPhysics *>(this))
+    return ode->RestoreSnapshot(_data, _size);
+
+  gzerr << "Snapshots are not supported by the ["
+        << this->GetType() << "] physics engine\n";
+  return false;
+}
+
+//////////////////////////////////////////////////
+bool PhysicsEngine::Deterministic() const
+{
+  return EnginePrivate(this).deterministic;
+}
+
 //////////////////////////////////////////////////
 boost::any PhysicsEngine::GetParam(const std::string &_key) const
 {
@@ -295,6 +371,8 @@ bool PhysicsEngine::GetParam(const std::string &_key,
     _value = this->world->Gravity();
   else if (_key == "magnetic_field")
     _value = this->world->MagneticField();
+  else if (_key == "deterministic")
+    _value = this->Deterministic();
   else
   {
     gzwarn << "GetParam failed for [" << _key << "] in physics engine "
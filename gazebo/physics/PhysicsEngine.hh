@@ -20,6 +20,7 @@
 #include <boost/thread/recursive_mutex.hpp>
 #include <boost/any.hpp>
 #include <string>
+#include <vector>
 #include <ignition/transport/Node.hh>
 
 #include "gazebo/transport/TransportTypes.hh"
@@ -215,6 +216,17 @@ namespace gazebo
       ///          (defined but not used in ode).
       ///       -# "max_step_size" (double) - maximum physics step size when
       ///          physics update step must return.
+      ///       -# "deterministic" (bool) - make the physics update
+      ///          bit-identical for a given seed, regardless of the engine
+      ///          threading options. The engine disables any of its parallel
+      ///          paths whose result depends on thread scheduling. This only
+      ///          covers the physics engine: sensors, plugins and log
+      ///          recording run in their own threads and are not affected.
+      ///          (ODE/Bullet)
+      ///       -# "integrator_type" (string) - "rk_merson", "rk3", "rk2" or
+      ///          "semi_explicit_euler". (Simbody)
+      ///       -# "fixed_step" (bool) - step by max_step_size without error
+      ///          control. (Simbody)
       ///
       /// \param[in] _value The value to set to
       /// \return true if SetParam is successful, false if operation fails.
@@ -238,6 +250,25 @@ namespace gazebo
       /// \brief Debug print out of the physic engine state.
       public: virtual void DebugPrint() const = 0;
 
+      /// \brief Append the complete dynamic state of the engine to a binary
+      /// buffer, see World::SaveSnapshot. Only ODE supports snapshots.
+      /// \param[out] _buffer Buffer to append the state to.
+      /// \return True if the engine supports snapshots.
+      public: bool SaveSnapshot(std::vector<uint8_t> &_buffer) const;
+
+      /// \brief Restore the dynamic state saved by SaveSnapshot.
+      /// The engine must contain the same bodies and joints as when the
+      /// snapshot was saved.
+      /// \param[in] _data Start of the engine state.
+      /// \param[in] _size Size of the engine state in bytes.
+      /// \return True if the state was restored.
+      public: bool RestoreSnapshot(const uint8_t *_data, const size_t _size);
+
+      /// \brief Get whether the "deterministic" parameter is set.
+      /// \return True when the physics update must be reproducible.
+      /// \sa SetParam
+      public: bool Deterministic() const;
+
       /// \brief Get a pointer to the world.
       /// \return Pointer to the world.
       public: WorldPtr World() const;
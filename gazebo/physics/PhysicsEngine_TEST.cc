@@ -224,15 +224,75 @@ void PhysicsEngineTest::PhysicsEngineGetParamBool
   }
   else if (_physicsEngine == "dart")
   {
-    gzwarn << "DARTPhysics::GetParam not yet implemented." << std::endl;
-    return;
+    EXPECT_TRUE(physics->GetParam("iters", value));
+    EXPECT_EQ(boost::any_cast<int>(value), 30);
+    EXPECT_TRUE(physics->GetParam("collision_detector", value));
+    EXPECT_FALSE(boost::any_cast<std::string>(value).empty());
+
+    // Tune the pgs solver
+    EXPECT_TRUE(physics->SetParam("solver_type", std::string("pgs")));
+    EXPECT_TRUE(physics->SetParam("iters", 12));
+    EXPECT_TRUE(physics->GetParam("iters", value));
+    EXPECT_EQ(boost::any_cast<int>(value), 12);
+    EXPECT_FALSE(physics->SetParam("iters", 0));
+
+    // Select collision detectors
+    EXPECT_TRUE(physics->SetParam("collision_detector", std::string("dart")));
+    EXPECT_TRUE(physics->GetParam("collision_detector", value));
+    EXPECT_EQ(boost::any_cast<std::string>(value), "dart");
+
+    EXPECT_TRUE(physics->SetParam("fcl_primitive_shape",
+        std::string("primitive")));
+    EXPECT_TRUE(physics->SetParam("fcl_contact_points", std::string("fcl")));
+    EXPECT_FALSE(physics->SetParam("fcl_contact_points",
+        std::string("bogus")));
+    EXPECT_TRUE(physics->SetParam("collision_detector", std::string("fcl")));
+    EXPECT_TRUE(physics->GetParam("collision_detector", value));
+    EXPECT_EQ(boost::any_cast<std::string>(value), "fcl");
+    EXPECT_TRUE(physics->GetParam("fcl_primitive_shape", value));
+    EXPECT_EQ(boost::any_cast<std::string>(value), "primitive");
+    EXPECT_TRUE(physics->GetParam("fcl_contact_points", value));
+    EXPECT_EQ(boost::any_cast<std::string>(value), "fcl");
+
+    // The ODE detector is disabled, the current one is kept
+    EXPECT_FALSE(physics->SetParam("collision_detector", std::string("ode")));
+    EXPECT_TRUE(physics->GetParam("collision_detector", value));
+    EXPECT_EQ(boost::any_cast<std::string>(value), "fcl");
   }
   else if (_physicsEngine == "simbody")
   {
     EXPECT_TRUE(physics->GetParam("accuracy", value));
     EXPECT_NEAR(boost::any_cast<double>(value), 1e-3, 1e-6);
+    EXPECT_TRUE(physics->GetParam("fixed_step", value));
+    EXPECT_FALSE(boost::any_cast<bool>(value));
+
+    // Switching to fixed step replaces the integrator and keeps its settings
+    EXPECT_TRUE(physics->SetParam("fixed_step", true));
+    EXPECT_TRUE(physics->GetParam("fixed_step", value));
+    EXPECT_TRUE(boost::any_cast<bool>(value));
+    EXPECT_TRUE(physics->GetParam("integrator_type", value));
+    EXPECT_EQ(boost::any_cast<std::string>(value), "semi_explicit_euler");
+    EXPECT_TRUE(physics->GetParam("accuracy", value));
+    EXPECT_NEAR(boost::any_cast<double>(value), 1e-3, 1e-6);
+
+    EXPECT_TRUE(physics->SetParam("integrator_type", std::string("rk3")));
+    EXPECT_TRUE(physics->GetParam("integrator_type", value));
+    EXPECT_EQ(boost::any_cast<std::string>(value), "rk3");
+
+    // Unknown integrators are rejected and leave the current one in place
+    EXPECT_FALSE(physics->SetParam("integrator_type", std::string("bogus")));
+    EXPECT_TRUE(physics->GetParam("integrator_type", value));
+    EXPECT_EQ(boost::any_cast<std::string>(value), "rk3");
   }
 
+  // Only some engines implement deterministic mode
+  const bool deterministic =
+      _physicsEngine == "ode" || _physicsEngine == "bullet";
+  EXPECT_EQ(deterministic, physics->SetParam("deterministic", true));
+  EXPECT_TRUE(physics->GetParam("deterministic", value));
+  EXPECT_EQ(deterministic, boost::any_cast<bool>(value));
+  EXPECT_EQ(deterministic, physics->Deterministic());
+
   EXPECT_FALSE(physics->GetParam("param_does_not_exist", value));
 }
 
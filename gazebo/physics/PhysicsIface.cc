@@ -15,6 +15,7 @@
  *
 */
 
+#include <algorithm>
 #include <boost/thread/mutex.hpp>
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
@@ -185,6 +186,19 @@ void physics::remove_worlds()
   g_worlds.clear();
 }
 
+/////////////////////////////////////////////////
+void physics::remove_world(WorldPtr _world)
+{
+  if (!_world)
+    return;
+
+  auto iter = std::find(g_worlds.begin(), g_worlds.end(), _world);
+  if (iter != g_worlds.end())
+    g_worlds.erase(iter);
+
+  _world->Fini();
+}
+
 /////////////////////////////////////////////////
 bool physics::worlds_running()
 {
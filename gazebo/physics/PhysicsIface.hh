@@ -137,6 +137,12 @@ namespace gazebo
     GZ_PHYSICS_VISIBLE
     void remove_worlds();
 
+    /// \brief Finalize a world and remove it from the static variable
+    /// gazebo::g_worlds
+    /// \param[in] _world World to remove.
+    GZ_PHYSICS_VISIBLE
+    void remove_world(WorldPtr _world);
+
     /// \brief Return true if any world is running.
     /// \return True if any world is running.
     GZ_PHYSICS_VISIBLE
@@ -39,6 +39,7 @@ namespace gazebo
     class World;
     class Model;
     class Actor;
+    class ActorCrowd;
     class Light;
     class Link;
     class Collision;
@@ -16,6 +16,9 @@
 */
 
 #include <time.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 
 #include <tbb/parallel_for.h>
 #include <tbb/blocked_range.h>
@@ -78,6 +81,7 @@
 #include "gazebo/physics/Model.hh"
 #include "gazebo/physics/Light.hh"
 #include "gazebo/physics/Actor.hh"
+#include "gazebo/physics/ActorCrowd.hh"
 #include "gazebo/physics/Wind.hh"
 #include "gazebo/physics/WorldPrivate.hh"
 #include "gazebo/physics/World.hh"
@@ -108,6 +112,43 @@ class ModelUpdate_TBB
   private: Model_V *models;
 };
 
+/// \brief Fixed size header of the buffers written by
+/// World::SaveSnapshot. The physics engine state follows it.
+struct WorldSnapshotHeader
+{
+  /// \brief Identifies a world snapshot, "GZSS".
+  uint32_t magic = 0x5353575a;
+
+  /// \brief Version of the snapshot layout.
+  uint32_t version = 1;
+
+  /// \brief Simulation time, seconds.
+  int32_t simSec = 0;
+
+  /// \brief Simulation time, nanoseconds.
+  int32_t simNsec = 0;
+
+  /// \brief Pause time, seconds.
+  int32_t pauseSec = 0;
+
+  /// \brief Pause time, nanoseconds.
+  int32_t pauseNsec = 0;
+
+  /// \brief Number of iterations.
+  uint64_t iterations = 0;
+};
+
+/// \brief Cache the world kinematics of the links of a model and of its
+/// nested models.
+/// \param[in] _model Model to cache.
+static void CacheWorldKinematics(const ModelPtr &_model)
+{
+  for (const auto &link : _model->GetLinks())
+    link->CacheWorldKinematics();
+  for (const auto &nested : _model->NestedModels())
+    CacheWorldKinematics(nested);
+}
+
 //////////////////////////////////////////////////
 World::World(const std::string &_name)
   : dataPtr(new WorldPrivate)
@@ -127,6 +168,7 @@ World::World(const std::string &_name)
   this->dataPtr->initialized = false;
   this->dataPtr->loaded = false;
   this->dataPtr->stepInc = 0;
+  this->dataPtr->batchStepping = false;
   this->dataPtr->pause = false;
   this->dataPtr->thread = nullptr;
   this->dataPtr->logThread = nullptr;
@@ -234,6 +276,15 @@ void World::Load(sdf::ElementPtr _sdf)
   this->dataPtr->posePub = this->dataPtr->node->Advertise<msgs::PosesStamped>(
     "~/pose/info", 10, 60);
 
+  // compact pose stream for clients, rate limited in PublishCompactPoses
+  // since dropping a keyframe would stall every decoder.
+  this->dataPtr->poseCompactPub =
+    this->dataPtr->node->Advertise<msgs::CompactPoses>(
+        "~/pose/compact/info", 10);
+  this->dataPtr->poseDictionaryPub =
+    this->dataPtr->node->Advertise<msgs::PoseDictionary>(
+        "~/pose/compact/dictionary", 1);
+
   this->dataPtr->guiPub = this->dataPtr->node->Advertise<msgs::GUI>("~/gui", 5);
   if (this->dataPtr->sdf->HasElement("gui"))
   {
@@ -307,6 +358,8 @@ void World::Load(sdf::ElementPtr _sdf)
 
   this->dataPtr->wind->Load(windElem);
 
+  this->dataPtr->actorCrowd.reset(new physics::ActorCrowd());
+
   // This should come after loading physics engine
   sdf::ElementPtr atmosphereElem = this->dataPtr->sdf->GetElement("atmosphere");
 
@@ -760,7 +813,11 @@ void World::Step()
       DIAG_TIMER_LAP("World::Step", "update");
 
       if (this->IsPaused() && this->dataPtr->stepInc > 0)
+      {
         this->dataPtr->stepInc--;
+        if (this->dataPtr->stepInc == 0)
+          this->dataPtr->stepCondition.notify_all();
+      }
     }
     else
     {
@@ -799,14 +856,100 @@ void World::Step(const unsigned int _steps)
     this->dataPtr->stepInc = _steps;
   }
 
-  // block on completion
-  bool wait = true;
-  while (wait)
+  // block on completion. The timeout guards against stepInc being reset
+  // or the world being stopped by paths that do not notify.
+  std::unique_lock<std::recursive_mutex> lock(
+      this->dataPtr->worldUpdateMutex);
+  while (this->dataPtr->stepInc != 0 && !this->dataPtr->stop)
   {
-    common::Time::NSleep(1);
-    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
-    if (this->dataPtr->stepInc == 0 || this->dataPtr->stop)
-      wait = false;
+    this->dataPtr->stepCondition.wait_for(lock,
+        std::chrono::milliseconds(10));
+  }
+}
+
+//////////////////////////////////////////////////
+void World::StepBatch(const unsigned int _steps,
+    const unsigned int _serviceInterval)
+{
+  IGN_PROFILE("World::StepBatch");
+
+  // Pausing here would leave the world frozen and count the batch as
+  // pause time, so the caller has to pause it.
+  if (!this->IsPaused())
+  {
+    gzerr << "World::StepBatch(steps) requires a paused world\n";
+    return;
+  }
+
+  // The batch runs while the world is paused, but it is simulation time,
+  // not pause time. The update thread keeps counting pause time between
+  // batches, and real time stays frozen at the start of the pause.
+  common::Time batchPauseTime;
+  common::Time batchWallTime;
+  {
+    std::lock_guard<std::recursive_mutex> lock(
+        this->dataPtr->worldUpdateMutex);
+    batchPauseTime = this->dataPtr->pauseTime;
+    batchWallTime = common::Time::GetWallTime();
+  }
+
+  unsigned int stepsDone = 0;
+  while (stepsDone < _steps && !this->dataPtr->stop)
+  {
+    unsigned int batchSize = _steps - stepsDone;
+    if (_serviceInterval > 0)
+      batchSize = std::min(batchSize, _serviceInterval);
+
+    {
+      std::lock_guard<std::recursive_mutex> lock(
+          this->dataPtr->worldUpdateMutex);
+
+      // See World::Step, plugins need one iteration of the physics engine.
+      if (!this->dataPtr->pluginsLoaded && this->SensorsInitialized())
+      {
+        this->LoadPlugins();
+        this->dataPtr->pluginsLoaded = true;
+      }
+
+      this->dataPtr->batchStepping = true;
+      for (unsigned int i = 0; i < batchSize && !this->dataPtr->stop; ++i)
+      {
+        // Lockstep sensors still need to be waited on every iteration.
+        if (this->dataPtr->waitForSensors)
+        {
+          this->dataPtr->waitForSensors(this->dataPtr->simTime.Double(),
+              this->dataPtr->physicsEngine->GetMaxStepSize());
+        }
+
+        // query timestep to allow dynamic time step size updates
+        this->dataPtr->simTime +=
+            this->dataPtr->physicsEngine->GetMaxStepSize();
+        this->dataPtr->iterations++;
+        this->Update();
+      }
+      this->dataPtr->batchStepping = false;
+
+      // Keep World::Step from sleeping to catch up with the batch.
+      const common::Time wallTime = common::Time::GetWallTime();
+      this->dataPtr->prevStepWallTime = wallTime;
+
+      // Count the batch as real time and drop the pause time the update
+      // thread added meanwhile, so the real time factor stays meaningful.
+      if (this->dataPtr->pause)
+      {
+        this->dataPtr->pauseStartTime += wallTime - batchWallTime;
+        this->dataPtr->pauseTime = batchPauseTime;
+      }
+      batchWallTime = wallTime;
+    }
+
+    stepsDone += batchSize;
+
+    // World statistics are only published by the update thread, since
+    // worldStatsMsg is not guarded.
+    gazebo::util::IntrospectionManager::Instance()->Update();
+    gazebo::util::IntrospectionManager::Instance()->NotifyUpdates();
+    this->ProcessMessages();
   }
 }
 
@@ -887,22 +1030,19 @@ void World::Update()
     // do this after physics update as
     //   ode --> MoveCallback sets the dirtyPoses
     //           and we need to propagate it into Entity::worldPose
-    {
-      IGN_PROFILE_BEGIN("SetWorldPose(dirtyPoses)");
-      // block any other pose updates (e.g. Joint::SetPosition)
-      boost::recursive_mutex::scoped_lock plock(
-          *this->Physics()->GetPhysicsUpdateMutex());
-
-      for (auto &dirtyEntity : this->dataPtr->dirtyPoses)
-      {
-        dirtyEntity->SetWorldPose(dirtyEntity->DirtyPose(), false);
-      }
-
-      this->dataPtr->dirtyPoses.clear();
-      IGN_PROFILE_END();
-    }
+    IGN_PROFILE_BEGIN("SetWorldPose(dirtyPoses)");
+    this->ProcessDirtyPoses();
+    IGN_PROFILE_END();
 
     DIAG_TIMER_LAP("World::Update", "SetWorldPose(dirtyPoses)");
+
+    // Store the pose derived kinematics of the links, so they are not
+    // recomputed by every sensor and plugin that reads them during the
+    // rest of the step.
+    IGN_PROFILE_BEGIN("CacheWorldKinematics");
+    for (const auto &model : this->dataPtr->models)
+      CacheWorldKinematics(model);
+    IGN_PROFILE_END();
   }
 
   IGN_PROFILE_BEGIN("LogRecordNotify");
@@ -921,11 +1061,28 @@ void World::Update()
 
   event::Events::worldUpdateEnd();
 
-  gazebo::util::IntrospectionManager::Instance()->Update();
+  // World::StepBatch updates introspection once per batch.
+  if (!this->dataPtr->batchStepping)
+    gazebo::util::IntrospectionManager::Instance()->Update();
 
   DIAG_TIMER_STOP("World::Update");
 }
 
+//////////////////////////////////////////////////
+void World::ProcessDirtyPoses()
+{
+  // block any other pose updates (e.g. Joint::SetPosition)
+  boost::recursive_mutex::scoped_lock plock(
+      *this->Physics()->GetPhysicsUpdateMutex());
+
+  for (auto &dirtyEntity : this->dataPtr->dirtyPoses)
+  {
+    dirtyEntity->SetWorldPose(dirtyEntity->DirtyPose(), false);
+  }
+
+  this->dataPtr->dirtyPoses.clear();
+}
+
 //////////////////////////////////////////////////
 void World::Fini()
 {
@@ -948,6 +1105,8 @@ void World::Fini()
 
     this->dataPtr->poseLocalPub.reset();
     this->dataPtr->posePub.reset();
+    this->dataPtr->poseCompactPub.reset();
+    this->dataPtr->poseDictionaryPub.reset();
     this->dataPtr->guiPub.reset();
     this->dataPtr->responsePub.reset();
     this->dataPtr->statPub.reset();
@@ -1020,6 +1179,7 @@ void World::Fini()
 
   this->dataPtr->atmosphere.reset();
   this->dataPtr->wind.reset();
+  this->dataPtr->actorCrowd.reset();
 
   // Engine shouldn't outlive world
   if (this->dataPtr->physicsEngine)
@@ -1089,6 +1249,12 @@ Wind &World::Wind() const
   return *this->dataPtr->wind;
 }
 
+//////////////////////////////////////////////////
+ActorCrowd &World::ActorCrowd() const
+{
+  return *this->dataPtr->actorCrowd;
+}
+
 //////////////////////////////////////////////////
 Atmosphere &World::Atmosphere() const
 {
@@ -1692,6 +1858,10 @@ void World::BuildSceneMsg(msgs::Scene &_scene, BasePtr _entity)
 //////////////////////////////////////////////////
 void World::ModelUpdateSingleLoop()
 {
+  // Animate the actors in parallel, the models apply their frames below
+  if (this->dataPtr->actorCrowd)
+    this->dataPtr->actorCrowd->Update(this->dataPtr->models);
+
   // Update all the models
   for (unsigned int i = 0; i < this->dataPtr->rootElement->GetChildCount(); ++i)
     this->dataPtr->rootElement->GetChild(i)->Update();
@@ -2464,6 +2634,72 @@ void World::SetState(const WorldState &_state)
   }
 }
 
+//////////////////////////////////////////////////
+bool World::SaveSnapshot(std::vector<uint8_t> &_buffer)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
+
+  WorldSnapshotHeader header;
+  header.simSec = this->dataPtr->simTime.sec;
+  header.simNsec = this->dataPtr->simTime.nsec;
+  header.pauseSec = this->dataPtr->pauseTime.sec;
+  header.pauseNsec = this->dataPtr->pauseTime.nsec;
+  header.iterations = this->dataPtr->iterations;
+
+  _buffer.resize(sizeof(header));
+  memcpy(_buffer.data(), &header, sizeof(header));
+
+  boost::recursive_mutex::scoped_lock plock(
+      *this->dataPtr->physicsEngine->GetPhysicsUpdateMutex());
+  if (!this->dataPtr->physicsEngine->SaveSnapshot(_buffer))
+  {
+    // Don't leave a header that claims a snapshot follows.
+    _buffer.clear();
+    return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool World::RestoreSnapshot(const std::vector<uint8_t> &_buffer)
+{
+  WorldSnapshotHeader header;
+  if (_buffer.size() < sizeof(header))
+  {
+    gzerr << "World snapshot is too small\n";
+    return false;
+  }
+
+  memcpy(&header, _buffer.data(), sizeof(header));
+  if (header.magic != WorldSnapshotHeader().magic ||
+      header.version != WorldSnapshotHeader().version)
+  {
+    gzerr << "Invalid world snapshot\n";
+    return false;
+  }
+
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
+
+  {
+    boost::recursive_mutex::scoped_lock plock(
+        *this->dataPtr->physicsEngine->GetPhysicsUpdateMutex());
+    if (!this->dataPtr->physicsEngine->RestoreSnapshot(
+          _buffer.data() + sizeof(header), _buffer.size() - sizeof(header)))
+    {
+      return false;
+    }
+  }
+
+  this->dataPtr->simTime.Set(header.simSec, header.simNsec);
+  this->dataPtr->pauseTime.Set(header.pauseSec, header.pauseNsec);
+  this->dataPtr->iterations = header.iterations;
+
+  // The engine marks every restored link dirty.
+  this->ProcessDirtyPoses();
+
+  return true;
+}
+
 //////////////////////////////////////////////////
 void World::InsertModelFile(const std::string &_sdfFilename)
 {
@@ -2780,6 +3016,8 @@ void World::ProcessMessages()
       }
     }
 
+    this->PublishCompactPoses();
+
     this->dataPtr->publishModelPoses.clear();
     this->dataPtr->publishLightPoses.clear();
   }
@@ -2866,6 +3104,93 @@ void World::ProcessMessages()
   }
 }
 
+//////////////////////////////////////////////////
+void World::PublishCompactPoses()
+{
+  if (!this->dataPtr->poseCompactPub ||
+      !this->dataPtr->poseCompactPub->HasConnections())
+  {
+    this->dataPtr->poseCompactActive = false;
+    return;
+  }
+
+  msgs::PoseStreamEncoder &encoder = this->dataPtr->poseEncoder;
+
+  // Start with a keyframe when the first subscriber connects
+  if (!this->dataPtr->poseCompactActive)
+  {
+    encoder.RequestKeyframe();
+    this->dataPtr->poseCompactActive = true;
+  }
+
+  // Names are built once per entity, the encoder remembers them
+  auto updateModel = [&encoder](const ModelPtr &_model)
+  {
+    std::vector<Model *> stack(1, _model.get());
+    while (!stack.empty())
+    {
+      Model *m = stack.back();
+      stack.pop_back();
+
+      if (!encoder.HasName(m->GetId()))
+        encoder.SetName(m->GetId(), m->GetScopedName());
+      encoder.Update(m->GetId(), m->RelativePose());
+
+      for (auto const &link : m->GetLinks())
+      {
+        if (!encoder.HasName(link->GetId()))
+          encoder.SetName(link->GetId(), link->GetScopedName());
+        encoder.Update(link->GetId(), link->RelativePose());
+      }
+
+      for (auto const &nested : m->NestedModels())
+        stack.push_back(nested.get());
+    }
+  };
+
+  auto updateLight = [&encoder](const LightPtr &_light)
+  {
+    if (!encoder.HasName(_light->GetId()))
+      encoder.SetName(_light->GetId(), _light->GetScopedName());
+    encoder.Update(_light->GetId(), _light->RelativePose());
+  };
+
+  for (auto const &model : this->dataPtr->publishModelPoses)
+    updateModel(model);
+  for (auto const &light : this->dataPtr->publishLightPoses)
+    updateLight(light);
+
+  // Same rate cap as ~/pose/info
+  const common::Time wallTime = common::Time::GetWallTime();
+  if (wallTime - this->dataPtr->prevPoseCompactTime < common::Time(1.0 / 60.0))
+    return;
+  this->dataPtr->prevPoseCompactTime = wallTime;
+
+  // A keyframe must hold every entity, and only those that still exist
+  if (encoder.KeyframeDue())
+  {
+    encoder.Clear();
+    for (auto const &model : this->dataPtr->models)
+      updateModel(model);
+    for (auto const &light : this->dataPtr->lights)
+      updateLight(light);
+  }
+
+  msgs::CompactPoses msg;
+  encoder.Encode(this->SimTime(), msg);
+
+  // The dictionary goes out first so decoders can name the new entities
+  if (encoder.Generation() != this->dataPtr->poseDictionaryGeneration)
+  {
+    msgs::PoseDictionary dictionary;
+    encoder.FillDictionary(dictionary);
+    this->dataPtr->poseDictionaryPub->Publish(dictionary);
+    this->dataPtr->poseDictionaryGeneration = encoder.Generation();
+  }
+
+  this->dataPtr->poseCompactPub->Publish(msg);
+}
+
 //////////////////////////////////////////////////
 void World::PublishWorldStats()
 {
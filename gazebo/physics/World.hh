@@ -155,6 +155,11 @@ namespace gazebo
       /// \return Reference to the wind.
       public: physics::Wind &Wind() const;
 
+      /// \brief Get a reference to the crowd that animates the actors of
+      /// the world.
+      /// \return Reference to the actor crowd.
+      public: physics::ActorCrowd &ActorCrowd() const;
+
       /// \brief Return the spherical coordinates converter.
       /// \return Pointer to the spherical coordinates converter.
       public: common::SphericalCoordinatesPtr SphericalCoords() const;
@@ -297,6 +302,22 @@ namespace gazebo
       /// \param _state The state to set the World to.
       public: void SetState(const WorldState &_state);
 
+      /// \brief Save the complete dynamic state of the world into a flat
+      /// binary buffer. Unlike WorldState, this includes the physics
+      /// engine's internal state, such as solver warm start data, so that
+      /// restoring it with RestoreSnapshot continues the simulation
+      /// bit-exactly. A snapshot can only be restored into the world that
+      /// saved it, and only while the same models exist.
+      /// \param[out] _buffer Buffer that receives the snapshot. Its
+      /// previous content is replaced, and it is left empty on failure.
+      /// \return False if the physics engine does not support snapshots.
+      public: bool SaveSnapshot(std::vector<uint8_t> &_buffer);
+
+      /// \brief Restore a snapshot saved with SaveSnapshot.
+      /// \param[in] _buffer Snapshot to restore.
+      /// \return True if the snapshot was restored.
+      public: bool RestoreSnapshot(const std::vector<uint8_t> &_buffer);
+
       /// \brief Insert a model from an SDF file.
       /// Spawns a model into the world base on and SDF file.
       /// \param[in] _sdfFilename The name of the SDF file (including path).
@@ -331,6 +352,22 @@ namespace gazebo
       /// \param[in] _steps The number of steps the World should take.
       public: void Step(const unsigned int _steps);
 
+      /// \brief Step the world forward in time on the calling thread as
+      /// fast as possible. Unlike Step(const unsigned int), the iterations
+      /// are not handed to the world update thread and are not throttled
+      /// by the real time update rate. Introspection and incoming messages
+      /// are only serviced every _serviceInterval iterations, and once after
+      /// the last iteration. World statistics are published by the update
+      /// thread. The world must be paused, so the update thread stays idle;
+      /// nothing is stepped otherwise. The wall time spent in the batch
+      /// counts as real time, not as pause time.
+      /// \param[in] _steps The number of steps the World should take.
+      /// \param[in] _serviceInterval Number of steps between servicing
+      /// introspection and messages. Zero services them only after the last
+      /// step.
+      public: void StepBatch(const unsigned int _steps,
+                             const unsigned int _serviceInterval = 0);
+
       /// \brief Load a plugin
       /// \param[in] _filename The filename of the plugin.
       /// \param[in] _name A unique name for the plugin.
@@ -520,6 +557,10 @@ namespace gazebo
       /// \brief Update the world.
       private: void Update();
 
+      /// \brief Copy the poses of entities moved by the physics engine into
+      /// the entities.
+      private: void ProcessDirtyPoses();
+
       /// \brief Pause callback.
       /// \param[in] _p True if paused.
       private: void OnPause(bool _p);
@@ -610,6 +651,11 @@ namespace gazebo
       /// \brief Process all incoming messages.
       private: void ProcessMessages();
 
+      /// \brief Feed the entities that moved to the compact pose stream
+      /// encoder and publish a frame on ~/pose/compact/info when one is due.
+      /// Must only be called from the World::ProcessMessages function.
+      private: void PublishCompactPoses();
+
       /// \brief Publish the world stats message.
       private: void PublishWorldStats();
 
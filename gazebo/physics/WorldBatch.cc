@@ -0,0 +1,299 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+
+#include "ignition/common/Profiler.hh"
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/physics/Joint.hh"
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/PhysicsEngine.hh"
+#include "gazebo/physics/PhysicsIface.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/physics/WorldBatchPrivate.hh"
+#include "gazebo/physics/WorldBatch.hh"
+#include "gazebo/util/LogRecord.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+/// \brief Find the first sensor in an SDF element tree.
+/// \param[in] _elem Element to search.
+/// \return The first <sensor> element, null if there is none.
+static sdf::ElementPtr FindSensor(const sdf::ElementPtr &_elem)
+{
+  if (_elem->GetName() == "sensor")
+    return _elem;
+
+  for (sdf::ElementPtr child = _elem->GetFirstElement(); child;
+       child = child->GetNextElement())
+  {
+    sdf::ElementPtr sensor = FindSensor(child);
+    if (sensor)
+      return sensor;
+  }
+  return sdf::ElementPtr();
+}
+
+//////////////////////////////////////////////////
+WorldBatch::WorldBatch()
+  : dataPtr(new WorldBatchPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+WorldBatch::~WorldBatch()
+{
+  this->Fini();
+}
+
+//////////////////////////////////////////////////
+bool WorldBatch::Load(sdf::ElementPtr _sdf, const unsigned int _count)
+{
+  if (!_sdf || _sdf->GetName() != "world")
+  {
+    gzerr << "WorldBatch requires a <world> SDF element\n";
+    return false;
+  }
+
+  if (!this->dataPtr->worlds.empty())
+  {
+    gzerr << "WorldBatch is already loaded\n";
+    return false;
+  }
+
+  if (util::LogRecord::Instance()->Running())
+  {
+    gzerr << "WorldBatch can't be loaded while log recording is on\n";
+    return false;
+  }
+
+  sdf::ElementPtr sensor = FindSensor(_sdf);
+  if (sensor)
+  {
+    gzerr << "WorldBatch doesn't support sensors, found sensor ["
+          << sensor->Get<std::string>("name") << "]\n";
+    return false;
+  }
+
+  const std::string baseName = _sdf->Get<std::string>("name");
+
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    // Each copy needs its own element tree, since the world keeps and
+    // modifies it, but the source is only parsed once.
+    sdf::ElementPtr worldElem = _sdf->Clone();
+    worldElem->GetAttribute("name")->Set(baseName + "_" + std::to_string(i));
+
+    WorldPtr world = create_world();
+    load_world(world, worldElem);
+    init_world(world, nullptr);
+    world->SetPaused(true);
+
+    this->dataPtr->worlds.push_back(world);
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+void WorldBatch::Fini()
+{
+  this->dataPtr->joints.clear();
+  this->dataPtr->links.clear();
+
+  for (auto &world : this->dataPtr->worlds)
+    remove_world(world);
+  this->dataPtr->worlds.clear();
+}
+
+//////////////////////////////////////////////////
+unsigned int WorldBatch::WorldCount() const
+{
+  return this->dataPtr->worlds.size();
+}
+
+//////////////////////////////////////////////////
+WorldPtr WorldBatch::WorldByIndex(const unsigned int _index) const
+{
+  if (_index >= this->dataPtr->worlds.size())
+    return WorldPtr();
+  return this->dataPtr->worlds[_index];
+}
+
+//////////////////////////////////////////////////
+bool WorldBatch::Step(const unsigned int _steps)
+{
+  IGN_PROFILE("WorldBatch::Step");
+
+  // World::Update would wait for a log worker that batched worlds don't
+  // run.
+  if (util::LogRecord::Instance()->Running())
+  {
+    gzerr << "WorldBatch can't step while log recording is on\n";
+    return false;
+  }
+
+  auto &worlds = this->dataPtr->worlds;
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, worlds.size()),
+      [&worlds, _steps](const tbb::blocked_range<size_t> &_r)
+      {
+        for (size_t i = _r.begin(); i != _r.end(); ++i)
+        {
+          // Pool threads are not the world's update thread, so the engine
+          // has to set up its thread local data first.
+          worlds[i]->Physics()->InitForThread();
+          worlds[i]->StepBatch(_steps);
+        }
+      });
+  return true;
+}
+
+//////////////////////////////////////////////////
+void WorldBatch::Reset()
+{
+  auto &worlds = this->dataPtr->worlds;
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, worlds.size()),
+      [&worlds](const tbb::blocked_range<size_t> &_r)
+      {
+        for (size_t i = _r.begin(); i != _r.end(); ++i)
+        {
+          worlds[i]->Physics()->InitForThread();
+          worlds[i]->Reset();
+        }
+      });
+}
+
+//////////////////////////////////////////////////
+int WorldBatch::AddJoint(const std::string &_scopedName)
+{
+  Joint_V joints;
+  for (const auto &world : this->dataPtr->worlds)
+  {
+    JointPtr joint =
+        boost::dynamic_pointer_cast<Joint>(world->BaseByName(_scopedName));
+    if (!joint)
+    {
+      gzerr << "Unable to find joint [" << _scopedName << "] in world ["
+            << world->Name() << "]\n";
+      return -1;
+    }
+    joints.push_back(joint);
+  }
+
+  this->dataPtr->joints.push_back(joints);
+  return static_cast<int>(this->dataPtr->joints.size()) - 1;
+}
+
+//////////////////////////////////////////////////
+int WorldBatch::AddLink(const std::string &_scopedName)
+{
+  Link_V links;
+  for (const auto &world : this->dataPtr->worlds)
+  {
+    LinkPtr link =
+        boost::dynamic_pointer_cast<Link>(world->BaseByName(_scopedName));
+    if (!link)
+    {
+      gzerr << "Unable to find link [" << _scopedName << "] in world ["
+            << world->Name() << "]\n";
+      return -1;
+    }
+    links.push_back(link);
+  }
+
+  this->dataPtr->links.push_back(links);
+  return static_cast<int>(this->dataPtr->links.size()) - 1;
+}
+
+//////////////////////////////////////////////////
+unsigned int WorldBatch::JointCount() const
+{
+  return this->dataPtr->joints.size();
+}
+
+//////////////////////////////////////////////////
+unsigned int WorldBatch::LinkCount() const
+{
+  return this->dataPtr->links.size();
+}
+
+//////////////////////////////////////////////////
+bool WorldBatch::SetJointForces(const std::vector<double> &_forces)
+{
+  const size_t jointCount = this->dataPtr->joints.size();
+  if (_forces.size() != this->dataPtr->worlds.size() * jointCount)
+  {
+    gzerr << "Expected [" << this->dataPtr->worlds.size() * jointCount
+          << "] joint forces, got [" << _forces.size() << "]\n";
+    return false;
+  }
+
+  for (size_t w = 0; w < this->dataPtr->worlds.size(); ++w)
+  {
+    for (size_t j = 0; j < jointCount; ++j)
+      this->dataPtr->joints[j][w]->SetForce(0, _forces[w * jointCount + j]);
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+void WorldBatch::JointPositions(std::vector<double> &_positions) const
+{
+  const size_t jointCount = this->dataPtr->joints.size();
+  _positions.resize(this->dataPtr->worlds.size() * jointCount);
+
+  for (size_t w = 0; w < this->dataPtr->worlds.size(); ++w)
+  {
+    for (size_t j = 0; j < jointCount; ++j)
+    {
+      _positions[w * jointCount + j] =
+          this->dataPtr->joints[j][w]->Position(0);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void WorldBatch::JointVelocities(std::vector<double> &_velocities) const
+{
+  const size_t jointCount = this->dataPtr->joints.size();
+  _velocities.resize(this->dataPtr->worlds.size() * jointCount);
+
+  for (size_t w = 0; w < this->dataPtr->worlds.size(); ++w)
+  {
+    for (size_t j = 0; j < jointCount; ++j)
+    {
+      _velocities[w * jointCount + j] =
+          this->dataPtr->joints[j][w]->GetVelocity(0);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void WorldBatch::LinkWorldPoses(
+    std::vector<ignition::math::Pose3d> &_poses) const
+{
+  const size_t linkCount = this->dataPtr->links.size();
+  _poses.resize(this->dataPtr->worlds.size() * linkCount);
+
+  for (size_t w = 0; w < this->dataPtr->worlds.size(); ++w)
+  {
+    for (size_t l = 0; l < linkCount; ++l)
+      _poses[w * linkCount + l] = this->dataPtr->links[l][w]->WorldPose();
+  }
+}
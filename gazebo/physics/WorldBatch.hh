@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_WORLDBATCH_HH_
+#define GAZEBO_PHYSICS_WORLDBATCH_HH_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ignition/math/Pose3.hh>
+#include <sdf/sdf.hh>
+
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class
+    class WorldBatchPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class WorldBatch WorldBatch.hh physics/physics.hh
+    /// \brief A set of independent copies of one world, stepped in
+    /// parallel within a single process.
+    ///
+    /// All copies are created from the same parsed SDF description and
+    /// named <world_name>_<index>. Meshes and other resources are shared
+    /// through the common managers. The worlds are not run by their own
+    /// update thread. Instead, Step steps every copy on a thread pool and
+    /// returns once all of them are done.
+    ///
+    /// Joints and links are registered once by scoped name, and actions and
+    /// observations for every copy are exchanged through flat, world-major
+    /// arrays: element [w * N + i] belongs to world w and handle i, where N
+    /// is the number of registered joints or links.
+    ///
+    /// Worlds in a batch update concurrently, on pool threads. Global
+    /// events such as event::Events::worldUpdateBegin are therefore
+    /// signaled from several threads at once, once per world. Plugins in
+    /// batched worlds must be thread safe, and must only act on updates of
+    /// their own world, by comparing common::UpdateInfo::worldName.
+    ///
+    /// Sensors and log recording are not supported. The SensorManager and
+    /// util::LogRecord serve every world of the process from a single
+    /// thread, and they wait on a world's update thread, which batched
+    /// worlds do not have. Load refuses worlds that contain sensors, and
+    /// Load and Step refuse to run while log recording is on.
+    class GZ_PHYSICS_VISIBLE WorldBatch
+    {
+      /// \brief Constructor.
+      public: WorldBatch();
+
+      /// \brief Destructor.
+      public: virtual ~WorldBatch();
+
+      /// \brief Create, load and initialize copies of a world.
+      /// The worlds are paused and ready to be stepped.
+      /// \param[in] _sdf The <world> SDF element to copy.
+      /// \param[in] _count Number of copies to create.
+      /// \return True on success, false if the world contains sensors or
+      /// log recording is on.
+      public: bool Load(sdf::ElementPtr _sdf, const unsigned int _count);
+
+      /// \brief Finalize and remove all the worlds of the batch.
+      public: void Fini();
+
+      /// \brief Get the number of worlds in the batch.
+      /// \return Number of worlds.
+      public: unsigned int WorldCount() const;
+
+      /// \brief Get a world in the batch.
+      /// \param[in] _index Index of the world.
+      /// \return Pointer to the world, null if the index is out of range.
+      public: WorldPtr WorldByIndex(const unsigned int _index) const;
+
+      /// \brief Step all worlds in parallel.
+      /// \param[in] _steps Number of iterations each world takes.
+      /// \return False if the worlds were not stepped because log
+      /// recording is on.
+      public: bool Step(const unsigned int _steps);
+
+      /// \brief Reset all worlds in parallel.
+      public: void Reset();
+
+      /// \brief Register a joint, by scoped name, in every world.
+      /// \param[in] _scopedName Scoped name of the joint, such as
+      /// "model::joint".
+      /// \return Handle of the joint, -1 if it was not found in every world.
+      public: int AddJoint(const std::string &_scopedName);
+
+      /// \brief Register a link, by scoped name, in every world.
+      /// \param[in] _scopedName Scoped name of the link, such as
+      /// "model::link".
+      /// \return Handle of the link, -1 if it was not found in every world.
+      public: int AddLink(const std::string &_scopedName);
+
+      /// \brief Get the number of registered joints.
+      /// \return Number of joints per world.
+      public: unsigned int JointCount() const;
+
+      /// \brief Get the number of registered links.
+      /// \return Number of links per world.
+      public: unsigned int LinkCount() const;
+
+      /// \brief Set the force of axis 0 of all registered joints.
+      /// \param[in] _forces World-major forces, of size
+      /// WorldCount() * JointCount().
+      /// \return False if the size of _forces does not match.
+      public: bool SetJointForces(const std::vector<double> &_forces);
+
+      /// \brief Get the position of axis 0 of all registered joints.
+      /// \param[out] _positions World-major positions, resized to
+      /// WorldCount() * JointCount().
+      public: void JointPositions(std::vector<double> &_positions) const;
+
+      /// \brief Get the velocity of axis 0 of all registered joints.
+      /// \param[out] _velocities World-major velocities, resized to
+      /// WorldCount() * JointCount().
+      public: void JointVelocities(std::vector<double> &_velocities) const;
+
+      /// \brief Get the world pose of all registered links.
+      /// \param[out] _poses World-major poses, resized to
+      /// WorldCount() * LinkCount().
+      public: void LinkWorldPoses(
+                  std::vector<ignition::math::Pose3d> &_poses) const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<WorldBatchPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
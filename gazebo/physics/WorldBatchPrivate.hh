@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_WORLDBATCHPRIVATE_HH_
+#define GAZEBO_PHYSICS_WORLDBATCHPRIVATE_HH_
+
+#include <vector>
+
+#include "gazebo/physics/PhysicsTypes.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief Private data for the WorldBatch class
+    class WorldBatchPrivate
+    {
+      /// \brief Worlds of the batch.
+      public: std::vector<WorldPtr> worlds;
+
+      /// \brief Registered joints, indexed by handle then by world.
+      public: std::vector<Joint_V> joints;
+
+      /// \brief Registered links, indexed by handle then by world.
+      public: std::vector<Link_V> links;
+    };
+  }
+}
+#endif
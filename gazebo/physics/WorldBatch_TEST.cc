@@ -0,0 +1,244 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "gazebo/physics/PhysicsIface.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/physics/WorldBatch.hh"
+#include "gazebo/test/ServerFixture.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class WorldBatchTest : public ServerFixture { };
+
+//////////////////////////////////////////////////
+/// \brief Get a world with a free box and a pendulum.
+sdf::ElementPtr PendulumWorld()
+{
+  std::ostringstream sdfStr;
+  sdfStr << "<sdf version ='" << SDF_VERSION << "'>"
+    << "<world name='batch'>"
+    << "  <model name='box'>"
+    << "    <pose>0 0 5 0 0 0</pose>"
+    << "    <link name='link'>"
+    << "      <collision name='collision'>"
+    << "        <geometry><box><size>1 1 1</size></box></geometry>"
+    << "      </collision>"
+    << "    </link>"
+    << "  </model>"
+    << "  <model name='pendulum'>"
+    << "    <pose>10 0 2 0 0 0</pose>"
+    << "    <link name='arm'>"
+    << "      <pose>0.5 0 0 0 0 0</pose>"
+    << "    </link>"
+    << "    <joint name='pivot' type='revolute'>"
+    << "      <parent>world</parent>"
+    << "      <child>arm</child>"
+    << "      <pose>-0.5 0 0 0 0 0</pose>"
+    << "      <axis><xyz>0 1 0</xyz></axis>"
+    << "    </joint>"
+    << "  </model>"
+    << "</world>"
+    << "</sdf>";
+
+  sdf::SDFPtr worldSDF(new sdf::SDF());
+  worldSDF->SetFromString(sdfStr.str());
+  return worldSDF->Root()->GetElement("world");
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldBatchTest, Load)
+{
+  this->Load("worlds/blank.world", true);
+
+  physics::WorldBatch batch;
+  EXPECT_FALSE(batch.Load(sdf::ElementPtr(), 2));
+  ASSERT_TRUE(batch.Load(PendulumWorld(), 4));
+  EXPECT_EQ(batch.WorldCount(), 4u);
+
+  // A batch can only be loaded once
+  EXPECT_FALSE(batch.Load(PendulumWorld(), 4));
+
+  for (unsigned int i = 0; i < batch.WorldCount(); ++i)
+  {
+    auto world = batch.WorldByIndex(i);
+    ASSERT_NE(nullptr, world);
+    EXPECT_EQ(world->Name(), "batch_" + std::to_string(i));
+    EXPECT_TRUE(world->IsPaused());
+    EXPECT_TRUE(physics::has_world(world->Name()));
+  }
+  EXPECT_EQ(nullptr, batch.WorldByIndex(4));
+
+  EXPECT_EQ(batch.AddJoint("pendulum::pivot"), 0);
+  EXPECT_EQ(batch.AddJoint("pendulum::missing"), -1);
+  EXPECT_EQ(batch.AddLink("box::link"), 0);
+  EXPECT_EQ(batch.AddLink("pendulum::arm"), 1);
+  EXPECT_EQ(batch.JointCount(), 1u);
+  EXPECT_EQ(batch.LinkCount(), 2u);
+
+  batch.Fini();
+  EXPECT_EQ(batch.WorldCount(), 0u);
+  EXPECT_FALSE(physics::has_world("batch_0"));
+  EXPECT_TRUE(physics::has_world("default"));
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldBatchTest, Step)
+{
+  this->Load("worlds/blank.world", true);
+
+  physics::WorldBatch batch;
+  ASSERT_TRUE(batch.Load(PendulumWorld(), 8));
+  ASSERT_EQ(batch.AddJoint("pendulum::pivot"), 0);
+  ASSERT_EQ(batch.AddLink("box::link"), 0);
+
+  // Wrong number of actions
+  EXPECT_FALSE(batch.SetJointForces({1.0}));
+
+  // Push every pendulum with a different force
+  std::vector<double> forces;
+  for (unsigned int i = 0; i < batch.WorldCount(); ++i)
+    forces.push_back(i * 10.0);
+  EXPECT_TRUE(batch.SetJointForces(forces));
+
+  EXPECT_TRUE(batch.Step(100));
+
+  for (unsigned int i = 0; i < batch.WorldCount(); ++i)
+    EXPECT_EQ(batch.WorldByIndex(i)->Iterations(), 100u);
+
+  std::vector<ignition::math::Pose3d> poses;
+  batch.LinkWorldPoses(poses);
+  ASSERT_EQ(poses.size(), batch.WorldCount());
+
+  std::vector<double> positions;
+  batch.JointPositions(positions);
+  ASSERT_EQ(positions.size(), batch.WorldCount());
+
+  std::vector<double> velocities;
+  batch.JointVelocities(velocities);
+  ASSERT_EQ(velocities.size(), batch.WorldCount());
+
+  // The boxes are identical and fall the same way in every world
+  for (unsigned int i = 0; i < batch.WorldCount(); ++i)
+  {
+    EXPECT_LT(poses[i].Pos().Z(), 5.0);
+    EXPECT_DOUBLE_EQ(poses[i].Pos().Z(), poses[0].Pos().Z());
+  }
+
+  // The pendulums received different actions
+  for (unsigned int i = 1; i < batch.WorldCount(); ++i)
+    EXPECT_NE(positions[i], positions[i-1]);
+
+  // Reset all worlds
+  batch.Reset();
+  batch.LinkWorldPoses(poses);
+  for (unsigned int i = 0; i < batch.WorldCount(); ++i)
+    EXPECT_DOUBLE_EQ(poses[i].Pos().Z(), 5.0);
+}
+
+//////////////////////////////////////////////////
+/// \brief Get a world with a box floating thanks to a world plugin.
+sdf::ElementPtr FloatingWorld()
+{
+  std::ostringstream sdfStr;
+  sdfStr << "<sdf version ='" << SDF_VERSION << "'>"
+    << "<world name='float'>"
+    << "  <model name='box'>"
+    << "    <pose>0 0 1 0 0 0</pose>"
+    << "    <link name='link'>"
+    << "      <inertial>"
+    << "        <mass>500</mass>"
+    << "        <inertia><ixx>83.33</ixx><iyy>83.33</iyy><izz>83.33</izz>"
+    << "        </inertia>"
+    << "      </inertial>"
+    << "      <collision name='collision'>"
+    << "        <geometry><box><size>1 1 1</size></box></geometry>"
+    << "      </collision>"
+    << "    </link>"
+    << "  </model>"
+    << "  <plugin name='hydrostatics' filename='libHydrostaticsPlugin.so'>"
+    << "    <fluid_density>1000</fluid_density>"
+    << "    <linear_drag>500</linear_drag>"
+    << "    <quadratic_drag>500</quadratic_drag>"
+    << "    <model>box</model>"
+    << "  </plugin>"
+    << "</world>"
+    << "</sdf>";
+
+  sdf::SDFPtr worldSDF(new sdf::SDF());
+  worldSDF->SetFromString(sdfStr.str());
+  return worldSDF->Root()->GetElement("world");
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldBatchTest, WorldPlugin)
+{
+  this->Load("worlds/blank.world", true);
+
+  physics::WorldBatch batch;
+  ASSERT_TRUE(batch.Load(FloatingWorld(), 4));
+  ASSERT_EQ(batch.AddLink("box::link"), 0);
+
+  // Every world runs its own copy of the plugin, which must only act on
+  // its own world although World Update events are global and signaled
+  // concurrently.
+  EXPECT_TRUE(batch.Step(5000));
+
+  std::vector<ignition::math::Pose3d> poses;
+  batch.LinkWorldPoses(poses);
+  ASSERT_EQ(poses.size(), batch.WorldCount());
+
+  // The box is half as dense as water and floats half submerged
+  for (unsigned int i = 0; i < batch.WorldCount(); ++i)
+  {
+    EXPECT_NEAR(poses[i].Pos().Z(), 0.0, 0.05);
+    EXPECT_DOUBLE_EQ(poses[i].Pos().Z(), poses[0].Pos().Z());
+  }
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldBatchTest, Sensors)
+{
+  this->Load("worlds/blank.world", true);
+
+  std::ostringstream sdfStr;
+  sdfStr << "<sdf version ='" << SDF_VERSION << "'>"
+    << "<world name='sensors'>"
+    << "  <model name='model'>"
+    << "    <link name='link'>"
+    << "      <sensor name='imu' type='imu'/>"
+    << "    </link>"
+    << "  </model>"
+    << "</world>"
+    << "</sdf>";
+  sdf::SDFPtr worldSDF(new sdf::SDF());
+  worldSDF->SetFromString(sdfStr.str());
+
+  // Sensors are not supported in batched worlds
+  physics::WorldBatch batch;
+  EXPECT_FALSE(batch.Load(worldSDF->Root()->GetElement("world"), 2));
+  EXPECT_EQ(batch.WorldCount(), 0u);
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -36,6 +36,7 @@
 #include "gazebo/common/URI.hh"
 
 #include "gazebo/msgs/msgs.hh"
+#include "gazebo/msgs/PoseStream.hh"
 
 #include "gazebo/transport/TransportTypes.hh"
 
@@ -58,6 +59,9 @@ namespace gazebo
       /// \brief Unique pointer the wind. The world owns this pointer.
       public: std::unique_ptr<Wind> wind;
 
+      /// \brief Animates the actors. The world owns this pointer.
+      public: std::unique_ptr<physics::ActorCrowd> actorCrowd;
+
       /// \brief Unique pointer the atmosphere model.
       /// The world owns this pointer.
       public: std::unique_ptr<Atmosphere> atmosphere;
@@ -122,6 +126,25 @@ namespace gazebo
       /// \brief Publisher for local pose messages.
       public: transport::PublisherPtr poseLocalPub;
 
+      /// \brief Publisher for compact, delta compressed pose frames.
+      public: transport::PublisherPtr poseCompactPub;
+
+      /// \brief Publisher for the names of the entities in the compact
+      /// pose stream.
+      public: transport::PublisherPtr poseDictionaryPub;
+
+      /// \brief Encoder for the compact pose stream.
+      public: msgs::PoseStreamEncoder poseEncoder;
+
+      /// \brief Wall time of the last compact pose frame.
+      public: common::Time prevPoseCompactTime;
+
+      /// \brief Dictionary generation last published.
+      public: uint32_t poseDictionaryGeneration = 0;
+
+      /// \brief True while the compact pose stream has subscribers.
+      public: bool poseCompactActive = false;
+
       /// \brief Subscriber to world control messages.
       public: transport::SubscriberPtr controlSub;
 
@@ -190,6 +213,14 @@ namespace gazebo
       /// World::SetPaused to assign world::pause
       public: std::recursive_mutex worldUpdateMutex;
 
+      /// \brief Notified when stepInc reaches zero, used by
+      /// World::Step(const unsigned int) to wait for completion.
+      public: std::condition_variable_any stepCondition;
+
+      /// \brief True while World::StepBatch is running. Per iteration
+      /// introspection updates are skipped and done once per batch instead.
+      public: bool batchStepping;
+
       /// \brief The world's current SDF description.
       public: sdf::ElementPtr sdf;
 
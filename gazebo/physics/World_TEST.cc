@@ -15,6 +15,8 @@
  *
 */
 
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/PhysicsEngine.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/test/ServerFixture.hh"
@@ -216,6 +218,103 @@ TEST_F(WorldTest, Stop)
   EXPECT_TRUE(world->Running());
 }
 
+//////////////////////////////////////////////////
+TEST_F(WorldTest, StepBatch)
+{
+  // Load a paused world
+  this->Load("worlds/shapes.world", true);
+
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+  EXPECT_TRUE(world->IsPaused());
+
+  auto model = world->ModelByName("sphere");
+  ASSERT_NE(nullptr, model);
+  model->SetWorldPose(ignition::math::Pose3d(0, 0, 10, 0, 0, 0));
+
+  const double dt = world->Physics()->GetMaxStepSize();
+  const uint32_t iterations = world->Iterations();
+  const common::Time simTime = world->SimTime();
+  const common::Time realTime = world->RealTime();
+  const common::Time pauseTime = world->PauseTime();
+
+  // Service messages every 100 steps
+  world->StepBatch(1000, 100);
+  EXPECT_EQ(world->Iterations(), iterations + 1000u);
+  EXPECT_NEAR((world->SimTime() - simTime).Double(), 1000 * dt, 1e-6);
+  EXPECT_TRUE(world->IsPaused());
+
+  // The batch counts as real time, not as pause time. The update thread
+  // may still add a few paused iterations around the batch.
+  EXPECT_GT(world->RealTime(), realTime);
+  EXPECT_NEAR(world->PauseTime().Double(), pauseTime.Double(), 0.1);
+
+  // The sphere should have fallen
+  EXPECT_LT(model->WorldPose().Pos().Z(), 10.0);
+
+  // Only service at the end
+  world->StepBatch(500);
+  EXPECT_EQ(world->Iterations(), iterations + 1500u);
+
+  // The regular blocking step still works after batch stepping
+  world->Step(10);
+  EXPECT_EQ(world->Iterations(), iterations + 1510u);
+
+  // Running worlds are left alone
+  world->SetPaused(false);
+  const uint32_t runningIterations = world->Iterations();
+  world->StepBatch(1000000);
+  EXPECT_FALSE(world->IsPaused());
+  EXPECT_LT(world->Iterations(), runningIterations + 1000000u);
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldTest, Snapshot)
+{
+  this->Load("worlds/shapes.world", true);
+
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  auto model = world->ModelByName("box");
+  ASSERT_NE(nullptr, model);
+
+  // Get the box moving so the snapshot has non trivial velocities
+  model->SetWorldPose(ignition::math::Pose3d(0, 0, 2, 0.3, 0.2, 0.1));
+  model->SetLinearVel(ignition::math::Vector3d(1, 0, 0));
+  world->StepBatch(100);
+
+  std::vector<uint8_t> snapshot;
+  ASSERT_TRUE(world->SaveSnapshot(snapshot));
+  EXPECT_FALSE(snapshot.empty());
+
+  const uint32_t iterations = world->Iterations();
+  const common::Time simTime = world->SimTime();
+
+  // Run through the landing
+  world->StepBatch(500);
+  const ignition::math::Pose3d pose = model->WorldPose();
+  const ignition::math::Vector3d vel = model->WorldLinearVel();
+  EXPECT_NE(iterations, world->Iterations());
+
+  // Restore and run again, the result must be identical
+  for (int i = 0; i < 3; ++i)
+  {
+    ASSERT_TRUE(world->RestoreSnapshot(snapshot));
+    EXPECT_EQ(iterations, world->Iterations());
+    EXPECT_EQ(simTime, world->SimTime());
+
+    world->StepBatch(500);
+    EXPECT_EQ(pose, model->WorldPose());
+    EXPECT_EQ(vel, model->WorldLinearVel());
+  }
+
+  // Invalid snapshots are rejected
+  EXPECT_FALSE(world->RestoreSnapshot(std::vector<uint8_t>()));
+  std::vector<uint8_t> truncated(snapshot.begin(), snapshot.end() - 8);
+  EXPECT_FALSE(world->RestoreSnapshot(truncated));
+}
+
 //////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -16,6 +16,7 @@
 */
 
 #include <algorithm>
+#include <atomic>
 #include <string>
 
 #include <ignition/common/Profiler.hh>
@@ -132,8 +133,16 @@ struct CollisionFilter : public btOverlapFilterCallback
 // Gets the contact information in the current state of
 // the world, updates the contact manager and
 // and sets the contact feedback information.
+// This runs on the stepping thread once the collision and solver stages,
+// which may be spread over worker threads, are done.
 void UpdateContacts(btDynamicsWorld *_world, btScalar _timeStep)
 {
+  BulletPhysics *bulletPhysics =
+      static_cast<BulletPhysics *>(_world->getWorldUserInfo());
+  GZ_ASSERT(bulletPhysics != nullptr, "Bullet world user info is null");
+  ContactManager *contactManager = bulletPhysics->GetContactManager();
+  const common::Time simTime = bulletPhysics->World()->SimTime();
+
   int numManifolds = _world->getDispatcher()->getNumManifolds();
   for (int i = 0; i < numManifolds; ++i)
   {
@@ -167,15 +176,10 @@ void UpdateContacts(btDynamicsWorld *_world, btScalar _timeStep)
     if (!collisionPtr1 || !collisionPtr2)
       continue;
 
-    PhysicsEnginePtr engine = collisionPtr1->GetWorld()->Physics();
-    BulletPhysicsPtr bulletPhysics =
-          boost::static_pointer_cast<BulletPhysics>(engine);
-
     // Add a new contact to the manager. This will return nullptr if no one is
     // listening for contact information.
-    Contact *contactFeedback = bulletPhysics->GetContactManager()->NewContact(
-        collisionPtr1.get(), collisionPtr2.get(),
-        collisionPtr1->GetWorld()->SimTime());
+    Contact *contactFeedback = contactManager->NewContact(
+        collisionPtr1.get(), collisionPtr2.get(), simTime);
 
     if (!contactFeedback)
       continue;
@@ -239,6 +243,8 @@ void InternalTickCallback(btDynamicsWorld *_world, btScalar _timeStep)
 }
 
 //////////////////////////////////////////////////
+// Called during narrowphase, from worker threads in a multithreaded world.
+// It only writes to the contact point it is given.
 bool ContactCallback(btManifoldPoint &_cp,
     const btCollisionObjectWrapper *_obj0, int /*_partId0*/, int /*_index0*/,
     const btCollisionObjectWrapper *_obj1, int /*_partId1*/, int /*_index1*/)
@@ -258,18 +264,56 @@ bool ContactProcessed(btManifoldPoint &/*_cp*/, void * /*_body0*/,
   return true;
 }
 
+/// \brief Number of multithreaded dynamics worlds in the process. They all
+/// share the task scheduler, so its number of threads can only be changed
+/// while there is a single one.
+static std::atomic<int> g_multithreadedWorlds(0);
+
+#if BT_BULLET_VERSION >= 287
+//////////////////////////////////////////////////
+// Get the task scheduler of the multithreaded dynamics worlds. Bullet uses
+// a single scheduler per process, shared by every world.
+static btITaskScheduler *TaskScheduler()
+{
+  static btITaskScheduler *scheduler = []()
+  {
+    btITaskScheduler *result = btCreateDefaultTaskScheduler();
+    if (!result)
+    {
+      gzwarn << "Bullet was built without multithreading support, "
+             << "the multithreaded dynamics world will use a single thread."
+             << std::endl;
+      result = btGetSequentialTaskScheduler();
+    }
+    return result;
+  }();
+  return scheduler;
+}
+#endif
+
 //////////////////////////////////////////////////
 BulletPhysics::BulletPhysics(WorldPtr _world)
     : PhysicsEngine(_world)
+{
+  this->CreateDynamicsWorld(false);
+
+  // TODO: Enable this to do custom contact setting
+  gContactAddedCallback = ContactCallback;
+  gContactProcessedCallback = ContactProcessed;
+
+  // Set random seed for physics engine based on gazebo's random seed.
+  // Note: this was moved from physics::PhysicsEngine constructor.
+  this->SetSeed(ignition::math::Rand::Seed());
+}
+
+//////////////////////////////////////////////////
+void BulletPhysics::CreateDynamicsWorld(const bool _multithreaded)
 {
   // This function currently follows the pattern of bullet/Demos/HelloWorld
 
   // Default setup for memory and collisions
   this->collisionConfig = new btDefaultCollisionConfiguration();
 
-  // Default collision dispatcher, a multi-threaded dispatcher may be available
-  this->dispatcher = new btCollisionDispatcher(this->collisionConfig);
-
   // Broadphase collision detection uses axis-aligned bounding boxes (AABB)
   // to detect pairs of objects that may be in contact.
   // The narrow-phase collision detection evaluates each pair generated by the
@@ -282,34 +326,141 @@ BulletPhysics::BulletPhysics(WorldPtr _world)
   // Here we are using btDbvtBroadphase.
   this->broadPhase = new btDbvtBroadphase();
 
-  // Create btSequentialImpulseConstraintSolver, the default constraint solver.
-  // Note that a multi-threaded solver may be available.
-  this->solver = new btSequentialImpulseConstraintSolver;
-
-  // Create a btDiscreteDynamicsWorld, which is used for discrete rigid bodies.
-  // An alternative is btSoftRigidDynamicsWorld, which handles both soft and
-  // rigid bodies.
-  this->dynamicsWorld = new btDiscreteDynamicsWorld(this->dispatcher,
-      this->broadPhase, this->solver, this->collisionConfig);
+#if BT_BULLET_VERSION >= 287
+  if (_multithreaded)
+  {
+    btITaskScheduler *scheduler = TaskScheduler();
+    if (this->Deterministic())
+      scheduler->setNumThreads(1);
+    btSetTaskScheduler(scheduler);
+    ++g_multithreadedWorlds;
+
+    // Narrow-phase collision detection of the broadphase pairs is split
+    // over the threads of the task scheduler.
+    this->dispatcher = new btCollisionDispatcherMt(this->collisionConfig);
+
+    // A pool of btSequentialImpulseConstraintSolver, simulation islands
+    // are solved in parallel, each by one solver of the pool.
+    btConstraintSolverPoolMt *solverPool =
+        new btConstraintSolverPoolMt(scheduler->getMaxNumThreads());
+    this->solver = solverPool;
+
+#if BT_BULLET_VERSION >= 288
+    this->dynamicsWorld = new btDiscreteDynamicsWorldMt(this->dispatcher,
+        this->broadPhase, solverPool, nullptr, this->collisionConfig);
+#else
+    this->dynamicsWorld = new btDiscreteDynamicsWorldMt(this->dispatcher,
+        this->broadPhase, solverPool, this->collisionConfig);
+#endif
+  }
+  else
+#endif
+  {
+    // Default collision dispatcher
+    this->dispatcher = new btCollisionDispatcher(this->collisionConfig);
+
+    // Create btSequentialImpulseConstraintSolver, the default constraint
+    // solver.
+    this->solver = new btSequentialImpulseConstraintSolver;
+
+    // Create a btDiscreteDynamicsWorld, which is used for discrete rigid
+    // bodies. An alternative is btSoftRigidDynamicsWorld, which handles both
+    // soft and rigid bodies.
+    this->dynamicsWorld = new btDiscreteDynamicsWorld(this->dispatcher,
+        this->broadPhase, this->solver, this->collisionConfig);
+  }
+  this->multithreaded = _multithreaded;
 
-  btOverlapFilterCallback *filterCallback = new CollisionFilter();
+  this->filterCallback = new CollisionFilter();
   btOverlappingPairCache* pairCache = this->dynamicsWorld->getPairCache();
   GZ_ASSERT(pairCache != nullptr,
       "Bullet broadphase overlapping pair cache is null");
-  pairCache->setOverlapFilterCallback(filterCallback);
-
-  // TODO: Enable this to do custom contact setting
-  gContactAddedCallback = ContactCallback;
-  gContactProcessedCallback = ContactProcessed;
+  pairCache->setOverlapFilterCallback(this->filterCallback);
 
   this->dynamicsWorld->setInternalTickCallback(
       InternalTickCallback, static_cast<void *>(this));
 
-  // Set random seed for physics engine based on gazebo's random seed.
-  // Note: this was moved from physics::PhysicsEngine constructor.
-  this->SetSeed(ignition::math::Rand::Seed());
+  btGImpactCollisionAlgorithm::registerAlgorithm(this->dispatcher);
+}
+
+//////////////////////////////////////////////////
+void BulletPhysics::DestroyDynamicsWorld()
+{
+  if (this->dynamicsWorld && this->multithreaded)
+    --g_multithreadedWorlds;
+
+  // Delete in reverse-order of creation
+  if (this->dynamicsWorld)
+    delete this->dynamicsWorld;
+  this->dynamicsWorld = nullptr;
+
+  if (this->filterCallback)
+    delete this->filterCallback;
+  this->filterCallback = nullptr;
+
+  if (this->solver)
+    delete this->solver;
+  this->solver = nullptr;
+
+  if (this->dispatcher)
+    delete this->dispatcher;
+  this->dispatcher = nullptr;
+
+  if (this->broadPhase)
+    delete this->broadPhase;
+  this->broadPhase = nullptr;
+
+  if (this->collisionConfig)
+    delete this->collisionConfig;
+  this->collisionConfig = nullptr;
+}
+
+//////////////////////////////////////////////////
+bool BulletPhysics::SetMultithreaded(const bool _multithreaded)
+{
+  if (_multithreaded == this->multithreaded)
+    return true;
+
+#if BT_BULLET_VERSION < 287
+  if (_multithreaded)
+  {
+    gzerr << "The multithreaded Bullet dynamics world requires Bullet 2.87 "
+          << "or later." << std::endl;
+    return false;
+  }
+#endif
+
+  // Deterministic mode runs the shared task scheduler on a single thread,
+  // which would slow down the other multithreaded worlds.
+  if (_multithreaded && this->Deterministic() && g_multithreadedWorlds > 0)
+  {
+    gzerr << "A deterministic Bullet world can't use the "
+          << "'sequential_impulse_mt' solver type while other worlds do."
+          << std::endl;
+    return false;
+  }
+
+  // Links and joints keep a pointer to the dynamics world, so it can only
+  // be replaced while it is empty.
+  if (this->dynamicsWorld->getNumCollisionObjects() > 0 ||
+      this->dynamicsWorld->getNumConstraints() > 0)
+  {
+    gzerr << "The Bullet solver type can only be changed before models are "
+          << "added to the world." << std::endl;
+    return false;
+  }
+
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+
+  btContactSolverInfo info = this->dynamicsWorld->getSolverInfo();
+  btVector3 gravity = this->dynamicsWorld->getGravity();
+
+  this->DestroyDynamicsWorld();
+  this->CreateDynamicsWorld(_multithreaded);
 
-  btGImpactCollisionAlgorithm::registerAlgorithm(dispatcher);
+  this->dynamicsWorld->getSolverInfo() = info;
+  this->dynamicsWorld->setGravity(gravity);
+  return true;
 }
 
 //////////////////////////////////////////////////
@@ -325,6 +476,14 @@ void BulletPhysics::Load(sdf::ElementPtr _sdf)
 
   sdf::ElementPtr bulletElem = this->sdf->GetElement("bullet");
 
+  // The multithreaded solver type needs a different dynamics world, which
+  // is created now that the world is still empty.
+  if (!this->SetParam("solver_type",
+      bulletElem->GetElement("solver")->Get<std::string>("type")))
+  {
+    this->SetParam("solver_type", std::string("sequential_impulse"));
+  }
+
   auto g = this->world->Gravity();
   // ODEPhysics checks this, so we will too.
   if (g == ignition::math::Vector3d::Zero)
@@ -533,26 +692,7 @@ void BulletPhysics::UpdatePhysics()
 //////////////////////////////////////////////////
 void BulletPhysics::Fini()
 {
-  // Delete in reverse-order of creation
-  if (this->dynamicsWorld)
-    delete this->dynamicsWorld;
-  this->dynamicsWorld = nullptr;
-
-  if (this->solver)
-    delete this->solver;
-  this->solver = nullptr;
-
-  if (this->broadPhase)
-    delete this->broadPhase;
-  this->broadPhase = nullptr;
-
-  if (this->dispatcher)
-    delete this->dispatcher;
-  this->dispatcher = nullptr;
-
-  if (this->collisionConfig)
-    delete this->collisionConfig;
-  this->collisionConfig = nullptr;
+  this->DestroyDynamicsWorld();
 
   PhysicsEngine::Fini();
 }
@@ -593,18 +733,75 @@ bool BulletPhysics::SetParam(const std::string &_key, const boost::any &_value)
     if (_key == "solver_type")
     {
       std::string value = any_cast<std::string>(_value);
-      if (value == "sequential_impulse")
+      if (value == "sequential_impulse" || value == "sequential_impulse_mt")
       {
+        if (!this->SetMultithreaded(value == "sequential_impulse_mt"))
+          return false;
         bulletElem->GetElement("solver")->GetElement("type")->Set(value);
         this->solverType = value;
       }
       else
       {
-        gzwarn << "Currently only 'sequential_impulse' solver is supported"
+        gzwarn << "Currently only 'sequential_impulse' and "
+               << "'sequential_impulse_mt' solvers are supported"
                << std::endl;
         return false;
       }
     }
+    else if (_key == "threads")
+    {
+      int value = any_cast<int>(_value);
+      if (value < 1)
+      {
+        gzerr << "Bullet threads must be at least 1" << std::endl;
+        return false;
+      }
+      if (value > 1 && this->Deterministic())
+      {
+        gzwarn << "Bullet threads are not available while deterministic is "
+               << "set." << std::endl;
+        return false;
+      }
+      if (!this->multithreaded)
+      {
+        if (value > 1)
+        {
+          gzwarn << "Bullet threads require the 'sequential_impulse_mt' "
+                 << "solver type." << std::endl;
+        }
+        return value == 1;
+      }
+      if (g_multithreadedWorlds > 1)
+      {
+        gzerr << "Bullet threads are shared by every multithreaded world, "
+              << "they can't be changed while there is more than one."
+              << std::endl;
+        return false;
+      }
+#if BT_BULLET_VERSION >= 287
+      btITaskScheduler *scheduler = TaskScheduler();
+      scheduler->setNumThreads(std::min(value,
+          scheduler->getMaxNumThreads()));
+#endif
+    }
+    else if (_key == "deterministic")
+    {
+      bool value = any_cast<bool>(_value);
+      // Contact manifolds are gathered per thread, so the order in which
+      // contacts are solved depends on how the threads are scheduled.
+      if (value && this->multithreaded && g_multithreadedWorlds > 1)
+      {
+        gzerr << "Deterministic mode sets the Bullet threads, which are "
+              << "shared by every multithreaded world. It can't be enabled "
+              << "while there is more than one." << std::endl;
+        return false;
+      }
+#if BT_BULLET_VERSION >= 287
+      if (value && this->multithreaded)
+        TaskScheduler()->setNumThreads(1);
+#endif
+      return PhysicsEngine::SetParam(_key, value);
+    }
     else if (_key == "cfm")
     {
       double value = any_cast<double>(_value);
@@ -721,6 +918,15 @@ bool BulletPhysics::GetParam(const std::string &_key, boost::any &_value) const
     _value = this->sdf->GetElement("max_contacts")->Get<int>();
   else if (_key == "min_step_size")
     _value = bulletElem->GetElement("solver")->Get<double>("min_step_size");
+  else if (_key == "threads")
+  {
+    int threads = 1;
+#if BT_BULLET_VERSION >= 287
+    if (this->multithreaded)
+      threads = TaskScheduler()->getNumThreads();
+#endif
+    _value = threads;
+  }
   else
   {
     return PhysicsEngine::GetParam(_key, _value);
@@ -46,6 +46,15 @@ namespace gazebo
     /// \{
 
     /// \brief Bullet physics engine
+    ///
+    /// With the "sequential_impulse_mt" solver type, the dynamics world is a
+    /// btDiscreteDynamicsWorldMt, available with Bullet 2.87 or later, and
+    /// the number of threads it uses is set with the "threads" parameter.
+    /// The solver type can only be changed before models are added.
+    /// Bullet has a single task scheduler per process, so the "threads"
+    /// parameter applies to every multithreaded world. It, and the
+    /// "deterministic" parameter of a multithreaded world, can't be set
+    /// while more than one multithreaded world exists.
     class GZ_PHYSICS_VISIBLE BulletPhysics : public PhysicsEngine
     {
       /// \enum BulletParam
@@ -172,12 +181,35 @@ namespace gazebo
       // Documentation inherited
       public: virtual void SetSORPGSIters(unsigned int iters);
 
+      /// \brief Create the dynamics world and its collision and solver
+      /// objects.
+      /// \param[in] _multithreaded True to create a
+      /// btDiscreteDynamicsWorldMt, which runs narrow-phase collision
+      /// detection and the constraint solver on a task scheduler.
+      private: void CreateDynamicsWorld(const bool _multithreaded);
+
+      /// \brief Delete the dynamics world and its collision and solver
+      /// objects.
+      private: void DestroyDynamicsWorld();
+
+      /// \brief Replace the dynamics world with a single or multithreaded
+      /// one. Only possible while no link or joint was added to it.
+      /// \param[in] _multithreaded True for a multithreaded world.
+      /// \return True if the world has the requested type.
+      private: bool SetMultithreaded(const bool _multithreaded);
+
       private: btBroadphaseInterface *broadPhase;
       private: btDefaultCollisionConfiguration *collisionConfig;
       private: btCollisionDispatcher *dispatcher;
-      private: btSequentialImpulseConstraintSolver *solver;
+      private: btConstraintSolver *solver;
       private: btDiscreteDynamicsWorld *dynamicsWorld;
 
+      /// \brief Filter of the broadphase pairs.
+      private: btOverlapFilterCallback *filterCallback = nullptr;
+
+      /// \brief True if dynamicsWorld is a btDiscreteDynamicsWorldMt.
+      private: bool multithreaded = false;
+
       private: common::Time lastUpdateTime;
 
       /// \brief The type of the solver.
@@ -180,6 +180,65 @@ TEST_F(BulletPhysics_TEST, PhysicsParam)
   EXPECT_DOUBLE_EQ(maxStepSize, maxStepSizeRet);
 }
 
+/////////////////////////////////////////////////
+/// Test the multithreaded dynamics world
+TEST_F(BulletPhysics_TEST, Multithreaded)
+{
+  Load("test/worlds/bullet_multithreaded.world", true, "bullet");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+  EXPECT_EQ(physics->GetType(), "bullet");
+
+#if BT_BULLET_VERSION >= 287
+  EXPECT_EQ("sequential_impulse_mt",
+      boost::any_cast<std::string>(physics->GetParam("solver_type")));
+
+  EXPECT_TRUE(physics->SetParam("threads", 2));
+  EXPECT_FALSE(physics->SetParam("threads", 0));
+  EXPECT_LE(boost::any_cast<int>(physics->GetParam("threads")), 2);
+
+  // Links were added, so the world can't be replaced anymore
+  EXPECT_FALSE(physics->SetParam("solver_type",
+      std::string("sequential_impulse")));
+  EXPECT_EQ("sequential_impulse_mt",
+      boost::any_cast<std::string>(physics->GetParam("solver_type")));
+
+  // The boxes land on the ground
+  world->Step(2000);
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    ModelPtr model = world->ModelByName("box_" + std::to_string(i));
+    ASSERT_TRUE(model != nullptr);
+    EXPECT_NEAR(0.5, model->WorldPose().Pos().Z(), 0.01);
+    EXPECT_NEAR(0.0, model->WorldLinearVel().Length(), 0.01);
+  }
+
+  // While a second multithreaded world shares the task scheduler, neither
+  // world can change its threads
+  {
+    PhysicsEnginePtr other(new BulletPhysics(world));
+    EXPECT_TRUE(other->SetParam("solver_type",
+        std::string("sequential_impulse_mt")));
+    EXPECT_FALSE(physics->SetParam("threads", 1));
+    EXPECT_FALSE(other->SetParam("threads", 1));
+    EXPECT_FALSE(other->SetParam("deterministic", true));
+    other->Fini();
+  }
+  EXPECT_TRUE(physics->SetParam("threads", 2));
+
+  // Deterministic mode runs on a single thread
+  EXPECT_TRUE(physics->SetParam("deterministic", true));
+  EXPECT_EQ(1, boost::any_cast<int>(physics->GetParam("threads")));
+  EXPECT_FALSE(physics->SetParam("threads", 2));
+#else
+  EXPECT_EQ(1, boost::any_cast<int>(physics->GetParam("threads")));
+  EXPECT_FALSE(physics->SetParam("threads", 2));
+#endif
+}
+
 /////////////////////////////////////////////////
 void BulletPhysics_TEST::OnPhysicsMsgResponse(ConstResponsePtr &_msg)
 {
@@ -15,6 +15,9 @@
  *
 */
 
+#include <memory>
+#include <string>
+
 // required for HAVE_DART_BULLET define
 #include <gazebo/gazebo_config.h>
 
@@ -97,6 +100,25 @@ void DARTPhysics::Load(sdf::ElementPtr _sdf)
   if (g == ignition::math::Vector3d::Zero)
     gzwarn << "Gravity vector is (0, 0, 0). Objects will float.\n";
   this->dataPtr->dtWorld->setGravity(Eigen::Vector3d(g.X(), g.Y(), g.Z()));
+
+  if (this->sdf->HasElement("dart"))
+  {
+    sdf::ElementPtr dartElem = this->sdf->GetElement("dart");
+    if (dartElem->HasElement("collision_detector"))
+    {
+      this->SetCollisionDetector(
+          dartElem->Get<std::string>("collision_detector"));
+    }
+
+    if (dartElem->HasElement("solver"))
+    {
+      // The number of pgs iterations is not in the SDF schema, it is set
+      // with SetParam("iters").
+      sdf::ElementPtr solverElem = dartElem->GetElement("solver");
+      if (solverElem->HasElement("solver_type"))
+        this->SetSolverType(solverElem->Get<std::string>("solver_type"));
+    }
+  }
 }
 
 //////////////////////////////////////////////////
@@ -108,6 +130,92 @@ std::string DARTPhysics::CollisionDetectorInUse() const
   return cd->getType();
 }
 
+//////////////////////////////////////////////////
+bool DARTPhysics::SetCollisionDetector(const std::string &_name)
+{
+  std::shared_ptr<dart::collision::CollisionDetector> cd;
+  if (_name == "bullet")
+  {
+    gzdbg << "Using BULLET collision detector" << std::endl;
+#ifdef HAVE_DART_BULLET
+    cd = dart::collision::BulletCollisionDetector::create();
+#else
+    gzerr << "Required DART bullet collision package not in use. Please "
+        << "install libdart<version>-collision-bullet-dev." << std::endl;
+#endif
+  }
+  else if (_name == "fcl")
+  {
+    gzdbg << "Using FCL collision detector" << std::endl;
+    auto fcl = dart::collision::FCLCollisionDetector::create();
+    fcl->setPrimitiveShapeType(this->dataPtr->fclPrimitiveShapes ?
+        dart::collision::FCLCollisionDetector::PRIMITIVE :
+        dart::collision::FCLCollisionDetector::MESH);
+    fcl->setContactPointComputationMethod(this->dataPtr->fclContactPoints ?
+        dart::collision::FCLCollisionDetector::FCL :
+        dart::collision::FCLCollisionDetector::DART);
+    cd = fcl;
+  }
+  else if (_name == "ode")
+  {
+    // ODE collision detectors have to be disabled because it causes
+    // conflicts with the version of the internally compiled ODE library.
+    // See also discussion in the PR:
+    // https://osrf-migration.github.io/gazebo-gh-pages/#!/osrf/gazebo/pull-requests/2956/
+    //   dart-heightmap-with-bullet-and-ode/diff#comment-81389484
+    gzerr << "The use of the ODE collision detector with DART is disabled "
+        << "because it causes conflicts with the version of ODE used in "
+        << "Gazebo." << std::endl;
+  }
+  else if (_name == "dart")
+  {
+    gzdbg << "Using DART collision detector" << std::endl;
+    cd = dart::collision::DARTCollisionDetector::create();
+  }
+
+  if (!cd)
+  {
+    gzwarn << "Collision detector [" << _name << "] not supported. "
+           << "Keeping the one in use." << std::endl;
+    return false;
+  }
+
+  // The constraint solver moves the existing shapes to the new detector.
+  this->dataPtr->dtWorld->getConstraintSolver()->setCollisionDetector(cd);
+  return true;
+}
+
+//////////////////////////////////////////////////
+void DARTPhysics::ApplySolverIterations()
+{
+  // DART constraint solver refactored in 6.7, see issue 2605
+  // https://github.com/osrf/gazebo/issues/2605
+#if DART_MAJOR_MINOR_VERSION_AT_MOST(6, 6)
+  if (this->GetSolverType() == "pgs")
+  {
+    gzwarn << "Setting the iterations of the pgs solver requires DART 6.7 "
+           << "or later.\n";
+  }
+#else
+  auto boxedLCPSolver =
+      dynamic_cast<dart::constraint::BoxedLcpConstraintSolver*>(
+      this->dataPtr->dtWorld->getConstraintSolver());
+  if (!boxedLCPSolver || !std::dynamic_pointer_cast<
+      const dart::constraint::PgsBoxedLcpSolver>(
+      boxedLCPSolver->getBoxedLcpSolver()))
+  {
+    return;
+  }
+
+  // The solver in use can't be modified, so replace it.
+  dart::constraint::PgsBoxedLcpSolver::Option option;
+  option.mMaxIteration = this->dataPtr->solverIterations;
+  auto pgs = std::make_shared<dart::constraint::PgsBoxedLcpSolver>();
+  pgs->setOption(option);
+  boxedLCPSolver->setBoxedLcpSolver(pgs);
+#endif
+}
+
 //////////////////////////////////////////////////
 void DARTPhysics::Init()
 {
@@ -642,6 +750,7 @@ void DARTPhysics::SetSolverType(const std::string &_type)
           std::make_shared<dart::constraint::PgsBoxedLcpSolver>());
     }
 #endif
+    this->ApplySolverIterations();
   }
   else
   {
@@ -685,6 +794,28 @@ boost::any DARTPhysics::GetParam(const std::string &_key) const
 //////////////////////////////////////////////////
 bool DARTPhysics::GetParam(const std::string &_key, boost::any &_value) const
 {
+  if (_key == "iters")
+  {
+    _value = this->dataPtr->solverIterations;
+    return true;
+  }
+  else if (_key == "collision_detector")
+  {
+    _value = this->CollisionDetectorInUse();
+    return true;
+  }
+  else if (_key == "fcl_primitive_shape")
+  {
+    _value = std::string(
+        this->dataPtr->fclPrimitiveShapes ? "primitive" : "mesh");
+    return true;
+  }
+  else if (_key == "fcl_contact_points")
+  {
+    _value = std::string(this->dataPtr->fclContactPoints ? "fcl" : "dart");
+    return true;
+  }
+
   if (!this->sdf->HasElement("dart"))
   {
     return PhysicsEngine::GetParam(_key, _value);
@@ -743,51 +874,48 @@ bool DARTPhysics::SetParam(const std::string &_key, const boost::any &_value)
     }
     else if (_key == "collision_detector")
     {
-      // set collision detector
-      std::string useCollisionDetector = any_cast<std::string>(_value);
-      std::shared_ptr<dart::collision::CollisionDetector> cd;
-      if (useCollisionDetector == "bullet")
-      {
-        gzdbg << "Using BULLET collision detector" << std::endl;
-#ifdef HAVE_DART_BULLET
-        cd = dart::collision::BulletCollisionDetector::create();
-#else
-        gzerr << "Required DART bullet collision package not in use. Please "
-            << "install libdart<version>-collision-bullet-dev." << std::endl;
-#endif
-      }
-      else if (useCollisionDetector == "fcl")
-      {
-        gzdbg << "Using FCL collision detector" << std::endl;
-        cd = dart::collision::FCLCollisionDetector::create();
-      }
-      else if (useCollisionDetector == "ode")
+      if (!this->SetCollisionDetector(any_cast<std::string>(_value)))
+        return false;
+    }
+    else if (_key == "iters")
+    {
+      int value = any_cast<int>(_value);
+      if (value < 1)
       {
-        // ODE collision detectors have to be disabled because it causes
-        // conflicts with the version of the internally compiled ODE library.
-        // See also discussion in the PR:
-        // https://osrf-migration.github.io/gazebo-gh-pages/#!/osrf/gazebo/pull-requests/2956/
-        //   dart-heightmap-with-bullet-and-ode/diff#comment-81389484
-        gzerr << "The use of the ODE collision detector with DART is disabled "
-            << "because it causes conflicts with the version of ODE used in "
-            << "Gazebo." << std::endl;
+        gzerr << "Invalid [" << _key << "] value [" << value << "]\n";
+        return false;
       }
-      else if (useCollisionDetector == "dart")
+      this->dataPtr->solverIterations = value;
+      this->ApplySolverIterations();
+    }
+    else if (_key == "fcl_primitive_shape" || _key == "fcl_contact_points")
+    {
+      std::string value = any_cast<std::string>(_value);
+      if (_key == "fcl_primitive_shape" &&
+          (value == "primitive" || value == "mesh"))
       {
-        gzdbg << "Using DART collision detector" << std::endl;
-        cd = dart::collision::DARTCollisionDetector::create();
+        this->dataPtr->fclPrimitiveShapes = value == "primitive";
       }
-
-      if (cd)
+      else if (_key == "fcl_contact_points" &&
+          (value == "fcl" || value == "dart"))
       {
-        this->dataPtr->dtWorld->getConstraintSolver()->setCollisionDetector(cd);
+        this->dataPtr->fclContactPoints = value == "fcl";
       }
       else
       {
-        gzwarn << "collision_detector element set in SDF, but no valid "
-               << "collision detector specified (" << useCollisionDetector
-               << " not supported. Using default." << std::endl;
+        gzerr << "Invalid [" << _key << "] value [" << value << "]\n";
+        return false;
       }
+
+      // Shapes are converted when they are added to the detector, so it is
+      // rebuilt to apply the option.
+      if (this->CollisionDetectorInUse() == "fcl")
+        this->SetCollisionDetector("fcl");
+    }
+    else if (_key == "deterministic")
+    {
+      gzwarn << "Deterministic mode is not supported by DART\n";
+      return false;
     }
     else
     {
@@ -844,6 +972,9 @@ void DARTPhysics::OnRequest(ConstRequestPtr &_msg)
     physicsMsg.set_real_time_update_rate(this->realTimeUpdateRate);
     physicsMsg.set_real_time_factor(this->targetRealTimeFactor);
     physicsMsg.set_max_step_size(this->maxStepSize);
+    physicsMsg.set_solver_type(this->GetSolverType());
+    physicsMsg.set_iters(this->dataPtr->solverIterations);
+    physicsMsg.set_collision_detector(this->CollisionDetectorInUse());
 
     response.set_type(physicsMsg.GetTypeName());
     physicsMsg.SerializeToString(serializedData);
@@ -859,9 +990,15 @@ void DARTPhysics::OnPhysicsMsg(ConstPhysicsPtr& _msg)
   // can be over-ridden by other message parameters.
   PhysicsEngine::OnPhysicsMsg(_msg);
 
+  if (_msg->has_iters())
+    this->SetParam("iters", _msg->iters());
+
   if (_msg->has_solver_type())
     this->SetSolverType(_msg->solver_type());
 
+  if (_msg->has_collision_detector())
+    this->SetCollisionDetector(_msg->collision_detector());
+
   if (_msg->has_enable_physics())
     this->world->SetPhysicsEnabled(_msg->enable_physics());
 
@@ -146,7 +146,20 @@ namespace gazebo
       public: virtual bool GetParam(const std::string &_key,
                   boost::any &_value) const;
 
-      // Documentation inherited
+      /// \brief Set a parameter of the engine. Besides the generic ones:
+      /// - "solver_type" (string): "dantzig" or "pgs".
+      /// - "iters" (int): Maximum iterations of the pgs solver.
+      /// - "collision_detector" (string): "fcl", "bullet" or "dart".
+      /// - "fcl_primitive_shape" (string): "mesh" to collide boxes,
+      ///   spheres and cylinders as meshes, as DART does by default, or
+      ///   "primitive" to use the analytic shapes of FCL.
+      /// - "fcl_contact_points" (string): "dart" to compute contact points
+      ///   with DART, as it does by default, or "fcl" to use FCL's.
+      /// The FCL options rebuild the FCL collision detector if it is in
+      /// use, and apply whenever it is selected afterwards.
+      /// \param[in] _key Name of the parameter.
+      /// \param[in] _value Value of the parameter.
+      /// \return True if the parameter was set.
       public: virtual bool SetParam(const std::string &_key,
                   const boost::any &_value);
 
@@ -159,6 +172,15 @@ namespace gazebo
       /// detector has been loaded yet, the empty string is returned.
       public: std::string CollisionDetectorInUse() const;
 
+      /// \brief Select the collision detector.
+      /// \param[in] _name "fcl", "bullet" or "dart".
+      /// \return True if the collision detector is available.
+      private: bool SetCollisionDetector(const std::string &_name);
+
+      /// \brief Apply the maximum number of iterations to the pgs solver,
+      /// if it is in use.
+      private: void ApplySolverIterations();
+
       // Documentation inherited
       protected: virtual void OnRequest(ConstRequestPtr &_msg);
 
@@ -18,6 +18,8 @@
 #ifndef _GAZEBO_DARTPHYSICS_PRIVATE_HH_
 #define _GAZEBO_DARTPHYSICS_PRIVATE_HH_
 
+#include <string>
+
 #include "gazebo/physics/dart/dart_inc.h"
 
 namespace gazebo
@@ -50,6 +52,16 @@ namespace gazebo
       /// and torques (both internal and external) after completing a simulation
       /// step. Default value is true.
       public: bool resetAllForcesAfterSimulationStep;
+
+      /// \brief Maximum number of iterations of the pgs solver.
+      public: int solverIterations = 30;
+
+      /// \brief True to collide primitive shapes analytically with FCL,
+      /// rather than as meshes.
+      public: bool fclPrimitiveShapes = false;
+
+      /// \brief True to compute contact points with FCL rather than DART.
+      public: bool fclContactPoints = false;
     };
   }
 }
@@ -37,7 +37,7 @@ ODEHeightmapShape::~ODEHeightmapShape()
 dReal ODEHeightmapShape::GetHeightCallback(void *_data, int _x, int _y)
 {
   // Return the height at a specific vertex
-  return static_cast<ODEHeightmapShape*>(_data)->GetHeight(_x, _y);
+  return static_cast<ODEHeightmapShape*>(_data)->TiledHeight(_x, _y);
 }
 
 
@@ -110,23 +110,56 @@ void ODEHeightmapShape::Init()
 
 
   // Step 3: Setup a callback method for ODE
-  setOdeHeightfieldDetails(
-      this->odeData,
-      this->heights.data(),
-      // in meters
-      this->Size().X(),
-      // in meters
-      this->Size().Y(),
-      // number of vertices
-      this->vertSize,
-      // vertical (z-axis) offset
-      this->Pos().Z(),
-      // vertical thickness for closing the height map mesh
-      1.0);
+  if (this->Tiled())
+  {
+    // Tiled heightmaps are sampled at full resolution through the tiles
+    // kept in memory around the moving links
+    const int samples = this->TiledVertexCount().X();
+    dGeomHeightfieldDataBuildCallback(
+        this->odeData,
+        this,
+        &ODEHeightmapShape::GetHeightCallback,
+        // in meters
+        this->Size().X(),
+        this->Size().Y(),
+        // number of vertices
+        samples,
+        samples,
+        // vertical scale, offset and thickness
+        1.0,
+        this->Pos().Z(),
+        1.0,
+        // wrap mode
+        0);
+  }
+  else
+  {
+    setOdeHeightfieldDetails(
+        this->odeData,
+        this->heights.data(),
+        // in meters
+        this->Size().X(),
+        // in meters
+        this->Size().Y(),
+        // number of vertices
+        this->vertSize,
+        // vertical (z-axis) offset
+        this->Pos().Z(),
+        // vertical thickness for closing the height map mesh
+        1.0);
+  }
 
   // Step 4: Restrict the bounds of the AABB to improve efficiency
-  dGeomHeightfieldDataSetBounds(this->odeData, this->GetMinHeight(),
-      this->GetMaxHeight());
+  if (this->Tiled())
+  {
+    dGeomHeightfieldDataSetBounds(this->odeData,
+        this->TileCache()->MinElevation(), this->TileCache()->MaxElevation());
+  }
+  else
+  {
+    dGeomHeightfieldDataSetBounds(this->odeData, this->GetMinHeight(),
+        this->GetMaxHeight());
+  }
 
   oParent->SetCollision(dCreateHeightfield(0, this->odeData, 1), false);
   oParent->SetStatic(true);
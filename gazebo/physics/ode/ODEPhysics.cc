@@ -21,6 +21,7 @@
 #include <sdf/sdf.hh>
 
 #include <algorithm>
+#include <cstring>
 #include <map>
 #include <string>
 #include <utility>
@@ -420,42 +421,72 @@ void ODEPhysics::UpdatePhysics()
     (*(this->dataPtr->physicsStepFunc))
       (this->dataPtr->worldId, this->maxStepSize);
 
-    ignition::math::Vector3d f1, f2, t1, t2;
-
-    // Set the joint contact feedback for each contact.
+    // Contact wrenches are expressed in the link frames at the end of the
+    // step, but are only computed if the contacts are read. Keep the
+    // rotations of the bodies; static links do not move.
     for (unsigned int i = 0; i < this->dataPtr->jointFeedbackIndex; ++i)
     {
-      Contact *contactFeedback = this->dataPtr->jointFeedbacks[i]->contact;
-      Collision *col1 = contactFeedback->collision1;
-      Collision *col2 = contactFeedback->collision2;
-
-      GZ_ASSERT(col1 != nullptr, "Collision 1 is null");
-      GZ_ASSERT(col2 != nullptr, "Collision 2 is null");
-
-      for (int j = 0; j < this->dataPtr->jointFeedbacks[i]->count; ++j)
+      ODEJointFeedback &feedback = this->dataPtr->jointFeedbacks[i];
+      if (feedback.body1)
       {
-        dJointFeedback fb = this->dataPtr->jointFeedbacks[i]->feedbacks[j];
-        f1.Set(fb.f1[0], fb.f1[1], fb.f1[2]);
-        f2.Set(fb.f2[0], fb.f2[1], fb.f2[2]);
-        t1.Set(fb.t1[0], fb.t1[1], fb.t1[2]);
-        t2.Set(fb.t2[0], fb.t2[1], fb.t2[2]);
-
-        // set force torque in link frame
-        this->dataPtr->jointFeedbacks[i]->contact->wrench[j].body1Force =
-             col1->GetLink()->WorldPose().Rot().RotateVectorReverse(f1);
-        this->dataPtr->jointFeedbacks[i]->contact->wrench[j].body2Force =
-             col2->GetLink()->WorldPose().Rot().RotateVectorReverse(f2);
-        this->dataPtr->jointFeedbacks[i]->contact->wrench[j].body1Torque =
-             col1->GetLink()->WorldPose().Rot().RotateVectorReverse(t1);
-        this->dataPtr->jointFeedbacks[i]->contact->wrench[j].body2Torque =
-             col2->GetLink()->WorldPose().Rot().RotateVectorReverse(t2);
+        const dReal *q = dBodyGetQuaternion(feedback.body1);
+        feedback.rot1.Set(q[0], q[1], q[2], q[3]);
       }
+      if (feedback.body2)
+      {
+        const dReal *q = dBodyGetQuaternion(feedback.body2);
+        feedback.rot2.Set(q[0], q[1], q[2], q[3]);
+      }
+    }
+
+    if (this->dataPtr->jointFeedbackIndex > 0)
+    {
+      this->contactManager->SetWrenchUpdate([this]()
+          {
+            for (unsigned int i = 0; i < this->dataPtr->jointFeedbackIndex;
+                 ++i)
+            {
+              this->ProcessJointFeedback(&this->dataPtr->jointFeedbacks[i]);
+            }
+          });
     }
   }
 
   DIAG_TIMER_STOP("ODEPhysics::UpdatePhysics");
 }
 
+//////////////////////////////////////////////////
+void ODEPhysics::ProcessJointFeedback(ODEJointFeedback *_feedback)
+{
+  Contact *contactFeedback = _feedback->contact;
+  Collision *col1 = contactFeedback->collision1;
+  Collision *col2 = contactFeedback->collision2;
+
+  GZ_ASSERT(col1 != nullptr, "Collision 1 is null");
+  GZ_ASSERT(col2 != nullptr, "Collision 2 is null");
+
+  const ignition::math::Quaterniond rot1 = _feedback->body1 ?
+      _feedback->rot1 : col1->GetLink()->WorldPose().Rot();
+  const ignition::math::Quaterniond rot2 = _feedback->body2 ?
+      _feedback->rot2 : col2->GetLink()->WorldPose().Rot();
+
+  ignition::math::Vector3d f1, f2, t1, t2;
+  for (int j = 0; j < _feedback->count; ++j)
+  {
+    const dJointFeedback &fb = _feedback->feedbacks[j];
+    f1.Set(fb.f1[0], fb.f1[1], fb.f1[2]);
+    f2.Set(fb.f2[0], fb.f2[1], fb.f2[2]);
+    t1.Set(fb.t1[0], fb.t1[1], fb.t1[2]);
+    t2.Set(fb.t2[0], fb.t2[1], fb.t2[2]);
+
+    // set force torque in link frame
+    contactFeedback->wrench[j].body1Force = rot1.RotateVectorReverse(f1);
+    contactFeedback->wrench[j].body2Force = rot2.RotateVectorReverse(f2);
+    contactFeedback->wrench[j].body1Torque = rot1.RotateVectorReverse(t1);
+    contactFeedback->wrench[j].body2Torque = rot2.RotateVectorReverse(t2);
+  }
+}
+
 //////////////////////////////////////////////////
 void ODEPhysics::Fini()
 {
@@ -465,12 +496,9 @@ void ODEPhysics::Fini()
     dJointGroupDestroy(this->dataPtr->contactGroup);
   this->dataPtr->contactGroup = nullptr;
 
-  // Delete all the joint feedbacks.
-  for (auto iter = this->dataPtr->jointFeedbacks.begin();
-      iter != this->dataPtr->jointFeedbacks.end(); ++iter)
-  {
-    delete *iter;
-  }
+  // Delete all the joint feedbacks, and the pending update that uses them.
+  if (this->contactManager)
+    this->contactManager->SetWrenchUpdate(nullptr);
   this->dataPtr->jointFeedbacks.clear();
 
   if (this->dataPtr->spaceId)
@@ -1272,19 +1300,19 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
   // Create a joint feedback mechanism
   if (contactFeedback)
   {
-    if (this->dataPtr->jointFeedbackIndex <
+    if (this->dataPtr->jointFeedbackIndex >=
         this->dataPtr->jointFeedbacks.size())
-      jointFeedback =
-          this->dataPtr->jointFeedbacks[this->dataPtr->jointFeedbackIndex];
-    else
     {
-      jointFeedback = new ODEJointFeedback();
-      this->dataPtr->jointFeedbacks.push_back(jointFeedback);
+      this->dataPtr->jointFeedbacks.emplace_back();
     }
+    jointFeedback =
+        &this->dataPtr->jointFeedbacks[this->dataPtr->jointFeedbackIndex];
 
     this->dataPtr->jointFeedbackIndex++;
     jointFeedback->count = 0;
     jointFeedback->contact = contactFeedback;
+    jointFeedback->body1 = b1;
+    jointFeedback->body2 = b2;
   }
 
   // Create a joint for each contact
@@ -1417,6 +1445,59 @@ void ODEPhysics::SetSeed(uint32_t _seed)
   dRandSetSeed(_seed);
 }
 
+//////////////////////////////////////////////////
+bool ODEPhysics::SaveSnapshot(std::vector<uint8_t> &_buffer) const
+{
+  // Layout: number of dReals, raw ODE world state.
+  // The ODE random generator is not saved: it is shared by every world in
+  // the process, and stepping does not draw from it since the random
+  // reordering of constraints is compiled out of quickstep.
+  const uint64_t count = dWorldGetRawStateSize(this->dataPtr->worldId);
+
+  const size_t offset = _buffer.size();
+  _buffer.resize(offset + sizeof(count) + count * sizeof(dReal));
+
+  uint8_t *data = _buffer.data() + offset;
+  memcpy(data, &count, sizeof(count));
+  dWorldGetRawState(this->dataPtr->worldId,
+      reinterpret_cast<dReal *>(data + sizeof(count)));
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool ODEPhysics::RestoreSnapshot(const uint8_t *_data, const size_t _size)
+{
+  uint64_t count = 0;
+  if (_size < sizeof(count))
+  {
+    gzerr << "ODE snapshot is too small\n";
+    return false;
+  }
+
+  memcpy(&count, _data, sizeof(count));
+  if (_size != sizeof(count) + count * sizeof(dReal))
+  {
+    gzerr << "ODE snapshot size does not match its header\n";
+    return false;
+  }
+
+  // The buffer may not be aligned for dReal.
+  std::vector<dReal> state(count);
+  memcpy(state.data(), _data + sizeof(count), count * sizeof(dReal));
+
+  // This calls ODELink::MoveCallback for every body, so the links pick up
+  // the restored poses the same way they do after a physics update.
+  if (!dWorldSetRawState(this->dataPtr->worldId, state.data(), count))
+  {
+    gzerr << "ODE snapshot does not match the bodies and joints "
+          << "of the world\n";
+    return false;
+  }
+
+  return true;
+}
+
 //////////////////////////////////////////////////
 bool ODEPhysics::SetParam(const std::string &_key, const boost::any &_value)
 {
@@ -1523,8 +1604,18 @@ bool ODEPhysics::SetParam(const std::string &_key, const boost::any &_value)
     }
     else if (_key == "thread_position_correction")
     {
+      bool value = any_cast<bool>(_value);
+      // The position correction thread shares the row order and the
+      // friction bounds with the velocity solve, so its result depends on
+      // how the two threads interleave.
+      if (value && this->Deterministic())
+      {
+        gzwarn << "thread_position_correction is not available while "
+               << "deterministic is set.\n";
+        return false;
+      }
       dWorldSetQuickStepThreadPositionCorrection(this->dataPtr->worldId,
-        any_cast<bool>(_value));
+        value);
     }
     else if (_key == "experimental_row_reordering")
     {
@@ -1555,6 +1646,18 @@ bool ODEPhysics::SetParam(const std::string &_key, const boost::any &_value)
       }
       dWorldSetIslandThreads(this->dataPtr->worldId, value);
     }
+    else if (_key == "deterministic")
+    {
+      bool value = any_cast<bool>(_value);
+      // Islands are solved independently of each other, so island threads
+      // are kept. Only the threaded position correction has to go.
+      if (value)
+      {
+        dWorldSetQuickStepThreadPositionCorrection(this->dataPtr->worldId,
+            false);
+      }
+      return PhysicsEngine::SetParam(_key, value);
+    }
     else if (_key == "ode_quiet")
     {
       bool odeQuiet = any_cast<bool>(_value);
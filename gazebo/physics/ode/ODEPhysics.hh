@@ -21,6 +21,7 @@
 #include <tbb/concurrent_vector.h>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <boost/thread/thread.hpp>
 
@@ -213,6 +214,21 @@ namespace gazebo
       // Documentation inherited
       public: virtual void SetSeed(uint32_t _seed);
 
+      /// \brief Append the raw ODE world state to a binary buffer.
+      /// The ODE random generator is shared by every world in the process
+      /// and is not saved.
+      /// \param[out] _buffer Buffer to append the state to.
+      /// \return True on success.
+      /// \sa PhysicsEngine::SaveSnapshot
+      public: bool SaveSnapshot(std::vector<uint8_t> &_buffer) const;
+
+      /// \brief Restore the raw ODE world state saved by SaveSnapshot.
+      /// \param[in] _data Start of the engine state.
+      /// \param[in] _size Size of the engine state in bytes.
+      /// \return True if the state was restored.
+      /// \sa PhysicsEngine::RestoreSnapshot
+      public: bool RestoreSnapshot(const uint8_t *_data, const size_t _size);
+
       /// Documentation inherited
       public: virtual bool SetParam(const std::string &_key,
                   const boost::any &_value);
@@ -287,7 +303,8 @@ namespace gazebo
       public: void Collide(ODECollision *_collision1, ODECollision *_collision2,
                            dContactGeom *_contactCollisions);
 
-      /// \brief process joint feedbacks.
+      /// \brief Process joint feedbacks: express the contact wrenches in
+      /// the link frames and store them in the contact.
       /// \param[in] _feedback ODE Joint Contact feedback information.
       public: void ProcessJointFeedback(ODEJointFeedback *_feedback);
 
@@ -18,11 +18,14 @@
 #ifndef _ODEPHYSICS_PRIVATE_HH_
 #define _ODEPHYSICS_PRIVATE_HH_
 
+#include <deque>
 #include <map>
 #include <string>
 #include <vector>
 #include <utility>
 
+#include <ignition/math/Quaternion.hh>
+
 #include "gazebo/physics/Contact.hh"
 #include "gazebo/physics/ode/ODETypes.hh"
 
@@ -41,6 +44,18 @@ namespace gazebo
       /// \brief Number of elements in feedbacks array.
       public: int count;
 
+      /// \brief ODE body of the first collision, null if static.
+      public: dBodyID body1 = nullptr;
+
+      /// \brief ODE body of the second collision, null if static.
+      public: dBodyID body2 = nullptr;
+
+      /// \brief Rotation of the first body at the end of the step.
+      public: ignition::math::Quaterniond rot1;
+
+      /// \brief Rotation of the second body at the end of the step.
+      public: ignition::math::Quaterniond rot2;
+
       /// \brief Contact joint feedback information.
       public: dJointFeedback feedbacks[MAX_CONTACT_JOINTS];
     };
@@ -59,8 +74,10 @@ namespace gazebo
       /// \brief The type of the solver.
       public: std::string stepType;
 
-      /// \brief Buffer of contact feedback information.
-      public: std::vector<ODEJointFeedback*> jointFeedbacks;
+      /// \brief Pool of contact feedback information. It grows to the
+      /// largest number of contacts seen in a step and is reused; a deque
+      /// keeps the addresses handed to ODE valid while it grows.
+      public: std::deque<ODEJointFeedback> jointFeedbacks;
 
       /// \brief Physics step function.
       public: int (*physicsStepFunc)(dxWorld*, dReal);
@@ -159,8 +159,9 @@ void SimbodyJoint::CacheForceTorque()
 {
   const SimTK::State &state = this->simbodyPhysics->integ->getAdvancedState();
 
-  // force calculation of reaction forces
-  this->simbodyPhysics->system.realize(state);
+  // force calculation of reaction forces, which need no stage past
+  // acceleration. The first joint realizes the state, the others reuse it.
+  this->simbodyPhysics->system.realize(state, SimTK::Stage::Acceleration);
 
   // In simbody, parent is always inboard (closer to ground in the tree),
   //   child is always outboard (further away from ground in the tree).
@@ -60,6 +60,7 @@
 #include "gazebo/transport/Publisher.hh"
 
 #include "gazebo/physics/simbody/SimbodyPhysics.hh"
+#include "gazebo/physics/simbody/SimbodyPhysicsPrivate.hh"
 
 typedef boost::shared_ptr<gazebo::physics::SimbodyJoint> SimbodyJointPtr;
 
@@ -86,6 +87,7 @@ SimbodyPhysics::SimbodyPhysics(WorldPtr _world)
       , contactStictionTransitionVelocity(0.0)
       , dynamicsWorld(nullptr)
       , stepTimeDouble(0.0)
+      , dataPtr(new SimbodyPhysicsPrivate)
 {
   // Instantiate the Multibody System
   // Instantiate the Simbody Matter Subsystem
@@ -98,6 +100,7 @@ SimbodyPhysics::SimbodyPhysics(WorldPtr _world)
 //////////////////////////////////////////////////
 SimbodyPhysics::~SimbodyPhysics()
 {
+  delete this->integ;
 }
 
 //////////////////////////////////////////////////
@@ -121,30 +124,16 @@ void SimbodyPhysics::Load(sdf::ElementPtr _sdf)
   /// \TODO: use this when pgs rigid body solver is implemented
   this->solverType = "elastic_foundation";
 
-  /// \TODO: get from sdf for simbody physics
   this->integratorType = "semi_explicit_euler";
 
-  if (this->integratorType == "rk_merson")
-    this->integ = new SimTK::RungeKuttaMersonIntegrator(system);
-  else if (this->integratorType == "rk3")
-    this->integ = new SimTK::RungeKutta3Integrator(system);
-  else if (this->integratorType == "rk2")
-    this->integ = new SimTK::RungeKutta2Integrator(system);
-  else if (this->integratorType == "semi_explicit_euler")
-    this->integ = new SimTK::SemiExplicitEuler2Integrator(system);
-  else
-  {
-    gzerr << "type not specified, using SemiExplicitEuler2Integrator.\n";
-    this->integ = new SimTK::SemiExplicitEuler2Integrator(system);
-  }
-
   this->stepTimeDouble = this->GetMaxStepSize();
 
   sdf::ElementPtr simbodyElem = this->sdf->GetElement("simbody");
 
-  // Set integrator accuracy (measured with Richardson Extrapolation)
-  this->integ->setAccuracy(
-    simbodyElem->Get<double>("accuracy"));
+  // Integrator accuracy (measured with Richardson Extrapolation)
+  this->dataPtr->accuracy = simbodyElem->Get<double>("accuracy");
+
+  this->CreateIntegrator();
 
   // Set stiction max slip velocity to make it less stiff.
   this->contact.setTransitionVelocity(
@@ -175,6 +164,58 @@ void SimbodyPhysics::Load(sdf::ElementPtr _sdf)
     simbodyContactElem->Get<double>("override_stiction_transition_velocity");
 }
 
+//////////////////////////////////////////////////
+void SimbodyPhysics::CreateIntegrator()
+{
+  SimTK::Integrator *integrator = nullptr;
+  if (this->integratorType == "rk_merson")
+    integrator = new SimTK::RungeKuttaMersonIntegrator(system);
+  else if (this->integratorType == "rk3")
+    integrator = new SimTK::RungeKutta3Integrator(system);
+  else if (this->integratorType == "rk2")
+    integrator = new SimTK::RungeKutta2Integrator(system);
+  else if (this->integratorType == "semi_explicit_euler")
+  {
+    // The first order variant has no error estimate, so each step costs a
+    // single evaluation instead of the three used for extrapolation.
+    if (this->dataPtr->fixedStep)
+    {
+      integrator = new SimTK::SemiExplicitEulerIntegrator(system,
+          this->stepTimeDouble);
+    }
+    else
+      integrator = new SimTK::SemiExplicitEuler2Integrator(system);
+  }
+  else
+  {
+    gzerr << "type not specified, using SemiExplicitEuler2Integrator.\n";
+    this->integratorType = "semi_explicit_euler";
+    integrator = new SimTK::SemiExplicitEuler2Integrator(system);
+  }
+
+  integrator->setAccuracy(this->dataPtr->accuracy);
+
+  if (this->dataPtr->fixedStep)
+  {
+    // Equal minimum and maximum step sizes turn off error control. Every
+    // stepTo() then lands on the requested time in one step, so there is
+    // no interpolated state to realize and project.
+    integrator->setFixedStepSize(this->stepTimeDouble);
+    integrator->setAllowInterpolation(false);
+    integrator->setProjectInterpolatedStates(false);
+  }
+
+  // Carry the state over when the integrator is replaced at run time.
+  if (this->integ)
+  {
+    const SimTK::State &state = this->integ->getState();
+    if (state.getNumSubsystems() > 0)
+      integrator->initialize(state);
+    delete this->integ;
+  }
+  this->integ = integrator;
+}
+
 /////////////////////////////////////////////////
 void SimbodyPhysics::OnRequest(ConstRequestPtr &_msg)
 {
@@ -656,6 +697,14 @@ void SimbodyPhysics::UpdatePhysics()
   if (s.getNumSubsystems() == 0)
     return;
 
+  // Follow changes of the step size, which don't go through this class.
+  if (this->dataPtr->fixedStep &&
+      this->stepTimeDouble != this->GetMaxStepSize())
+  {
+    this->stepTimeDouble = this->GetMaxStepSize();
+    this->integ->setFixedStepSize(this->stepTimeDouble);
+  }
+
   bool trying = true;
   while (trying && integ->getTime() < this->world->SimTime().Double())
   {
@@ -1641,6 +1690,10 @@ bool SimbodyPhysics::GetParam(const std::string &_key, boost::any &_value) const
   {
     _value = this->integratorType;
   }
+  else if (_key == "fixed_step")
+  {
+    _value = this->dataPtr->fixedStep;
+  }
   else if (_key == "accuracy")
   {
     if (this->integ)
@@ -1666,7 +1719,28 @@ bool SimbodyPhysics::SetParam(const std::string &_key, const boost::any &_value)
   {
     if (_key == "accuracy")
     {
-      this->integ->setAccuracy(any_cast<double>(_value));
+      this->dataPtr->accuracy = any_cast<double>(_value);
+      this->integ->setAccuracy(this->dataPtr->accuracy);
+    }
+    else if (_key == "integrator_type")
+    {
+      const std::string value = any_cast<std::string>(_value);
+      if (value != "rk_merson" && value != "rk3" && value != "rk2" &&
+          value != "semi_explicit_euler")
+      {
+        gzerr << "Unknown Simbody integrator type [" << value << "]\n";
+        return false;
+      }
+      boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+      this->integratorType = value;
+      this->CreateIntegrator();
+    }
+    else if (_key == "fixed_step")
+    {
+      boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+      this->dataPtr->fixedStep = any_cast<bool>(_value);
+      this->stepTimeDouble = this->GetMaxStepSize();
+      this->CreateIntegrator();
     }
     else if (_key == "max_transient_velocity")
     {
@@ -1711,6 +1785,11 @@ bool SimbodyPhysics::SetParam(const std::string &_key, const boost::any &_value)
     {
       this->contactImpactCaptureVelocity = any_cast<double>(_value);
     }
+    else if (_key == "deterministic")
+    {
+      gzwarn << "Deterministic mode is not supported by Simbody\n";
+      return false;
+    }
     else
     {
       return PhysicsEngine::SetParam(_key, _value);
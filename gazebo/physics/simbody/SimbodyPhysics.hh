@@ -17,6 +17,7 @@
 
 #ifndef GAZEBO_PHYSICS_SIMBODY_SIMBODYPHYSICS_HH
 #define GAZEBO_PHYSICS_SIMBODY_SIMBODYPHYSICS_HH
+#include <memory>
 #include <string>
 
 #include <boost/thread/thread.hpp>
@@ -34,6 +35,9 @@ namespace gazebo
 {
   namespace physics
   {
+    // Forward declare private data class
+    class SimbodyPhysicsPrivate;
+
     /// \ingroup gazebo_physics
     /// \addtogroup gazebo_physics_simbody Simbody Physics
     /// \{
@@ -191,6 +195,12 @@ namespace gazebo
       /// since it does its own visualization.
       private: void InitSimbodySystem();
 
+      /// \brief Create the integrator from integratorType and the
+      /// "fixed_step" parameter.
+      /// An integrator that is already initialized is replaced, and its
+      /// state carries over to the new one.
+      private: void CreateIntegrator();
+
       /// \brief Add a static Model to simbody system, and reinitialize state
       /// \param[in] _model the incoming static Gazebo physics::Model.
       private: void AddStaticModelToSimbodySystem(
@@ -281,7 +291,13 @@ namespace gazebo
       ///   SimTK::RungeKutta3Integrator(system)
       ///   SimTK::RungeKutta2Integrator(system)
       ///   SimTK::SemiExplicitEuler2Integrator(system)
+      /// or SimTK::SemiExplicitEulerIntegrator(system, step) in fixed step
+      /// mode.
       private: std::string integratorType;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<SimbodyPhysicsPrivate> dataPtr;
     };
   /// \}
   }
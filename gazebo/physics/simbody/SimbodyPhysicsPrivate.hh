@@ -0,0 +1,38 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef _SIMBODYPHYSICS_PRIVATE_HH_
+#define _SIMBODYPHYSICS_PRIVATE_HH_
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief Private data for the SimbodyPhysics class.
+    class SimbodyPhysicsPrivate
+    {
+      /// \brief Integrator accuracy, used when error control is on.
+      public: double accuracy = 0.0;
+
+      /// \brief True to step by max_step_size without error control, which
+      /// makes the cost of a step predictable.
+      public: bool fixedStep = false;
+    };
+  }
+}
+#endif
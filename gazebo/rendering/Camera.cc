@@ -46,6 +46,7 @@
 #include "gazebo/rendering/Conversions.hh"
 #include "gazebo/rendering/Scene.hh"
 #include "gazebo/rendering/Distortion.hh"
+#include "gazebo/rendering/FrameWriter.hh"
 #include "gazebo/rendering/CameraPrivate.hh"
 #include "gazebo/rendering/Camera.hh"
 #include "gazebo/rendering/RenderEvents.hh"
@@ -354,6 +355,13 @@ void Camera::Fini()
 {
   this->dataPtr->videoEncoder.Reset();
 
+  // Make sure the frames saved by this camera are on disk.
+  if (this->dataPtr->frameWriter)
+  {
+    this->dataPtr->frameWriter->Flush();
+    this->dataPtr->frameWriter.reset();
+  }
+
   if (this->saveFrameBuffer)
     delete [] this->saveFrameBuffer;
   this->saveFrameBuffer = NULL;
@@ -688,10 +696,13 @@ void Camera::PostRender()
       this->dataPtr->videoEncoder.AddFrame(buffer, width, height);
     }
 
+    // Continuous saving is done on the writer threads, so that encoding
+    // doesn't hold up the render thread.
     if (this->sdf->HasElement("save") &&
         this->sdf->GetElement("save")->Get<bool>("enabled"))
     {
-      this->SaveFrame(this->FrameFilename());
+      this->SaveFrameWriter()->Write(buffer, width, height,
+          this->ImageDepth(), this->ImageFormat(), this->FrameFilename());
     }
 
     // do last minute conversion if Bayer pattern is requested, go from R8G8B8
@@ -1185,6 +1196,41 @@ bool Camera::SaveFrame(const std::string &_filename)
                           this->ImageFormat(), _filename);
 }
 
+//////////////////////////////////////////////////
+void Camera::SetFrameWriter(std::shared_ptr<FrameWriter> _writer)
+{
+  this->dataPtr->frameWriter = _writer;
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<FrameWriter> Camera::SaveFrameWriter()
+{
+  if (!this->dataPtr->frameWriter)
+    this->dataPtr->frameWriter = FrameWriter::Shared();
+  return this->dataPtr->frameWriter;
+}
+
+//////////////////////////////////////////////////
+void Camera::SetSaveFrameFormat(const std::string &_format)
+{
+  std::string format = boost::to_lower_copy(_format);
+  if (!format.empty() && format[0] == '.')
+    format.erase(0, 1);
+
+  if (format.empty())
+  {
+    gzerr << "Empty save frame format\n";
+    return;
+  }
+  this->dataPtr->saveFrameFormat = format;
+}
+
+//////////////////////////////////////////////////
+std::string Camera::SaveFrameFormat() const
+{
+  return this->dataPtr->saveFrameFormat;
+}
+
 //////////////////////////////////////////////////
 std::string Camera::FrameFilename()
 {
@@ -1207,8 +1253,9 @@ std::string Camera::FrameFilename()
   else
   {
     pathToFile = (path.empty()) ? "." : path;
-    pathToFile /= str(boost::format("%s-%04d.jpg")
-        % friendlyName.c_str() % this->saveCount);
+    pathToFile /= str(boost::format("%s-%04d.%s")
+        % friendlyName.c_str() % this->saveCount
+        % this->dataPtr->saveFrameFormat);
     this->saveCount++;
   }
 
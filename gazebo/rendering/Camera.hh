@@ -72,6 +72,7 @@ namespace gazebo
     class ViewController;
     class Scene;
     class CameraPrivate;
+    class FrameWriter;
 
     /// \addtogroup gazebo_rendering Rendering
     /// \brief A set of rendering related class, functions, and definitions
@@ -410,6 +411,25 @@ namespace gazebo
       /// \return True if saving was successful
       public: bool SaveFrame(const std::string &_filename);
 
+      /// \brief Set the writer of the frames saved while save is enabled.
+      /// Several cameras may share a writer.
+      /// \param[in] _writer The writer, or null to use the shared writer.
+      /// \sa FrameWriter::Shared
+      public: void SetFrameWriter(std::shared_ptr<FrameWriter> _writer);
+
+      /// \brief Get the writer of the frames saved while save is enabled.
+      /// \return The writer set with SetFrameWriter, or the shared writer.
+      public: std::shared_ptr<FrameWriter> SaveFrameWriter();
+
+      /// \brief Set the format of the frames saved while save is enabled.
+      /// \param[in] _format File extension, such as "jpg", "png", or "raw"
+      /// to write the pixels without encoding.
+      public: void SetSaveFrameFormat(const std::string &_format);
+
+      /// \brief Get the format of the frames saved while save is enabled.
+      /// \return File extension, "jpg" by default.
+      public: std::string SaveFrameFormat() const;
+
       /// \brief Get a pointer to the ogre camera
       /// \return Pointer to the OGRE camera
       public: Ogre::Camera *OgreCamera() const;
@@ -21,10 +21,13 @@
 #include <mutex>
 #include <utility>
 #include <list>
+#include <memory>
+#include <string>
 #include <ignition/math/Pose3.hh>
 
 #include "gazebo/common/PID.hh"
 #include "gazebo/common/VideoEncoder.hh"
+#include "gazebo/rendering/FrameWriter.hh"
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/util/system.hh"
 
@@ -112,6 +115,12 @@ namespace gazebo
       /// \brief Video encoder.
       public: common::VideoEncoder videoEncoder;
 
+      /// \brief Writes the frames saved while save is enabled.
+      public: std::shared_ptr<FrameWriter> frameWriter;
+
+      /// \brief Extension of the frames saved while save is enabled.
+      public: std::string saveFrameFormat = "jpg";
+
       /// \brief If set to true, the camera yaws around a fixed axis.
       public: bool yawFixed;
 
@@ -0,0 +1,362 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/rendering/Camera.hh"
+#include "gazebo/rendering/FrameWriter.hh"
+
+using namespace gazebo;
+using namespace rendering;
+
+/// \brief A frame waiting to be written.
+struct PendingFrame
+{
+  /// \brief Pixels of the frame.
+  std::vector<unsigned char> data;
+
+  /// \brief Width of the image.
+  unsigned int width = 0;
+
+  /// \brief Height of the image.
+  unsigned int height = 0;
+
+  /// \brief Depth of the image data.
+  int depth = 0;
+
+  /// \brief Format of the image data.
+  std::string format;
+
+  /// \brief File in which to write the frame.
+  std::string filename;
+};
+
+/// \brief Private data for the FrameWriter class.
+class gazebo::rendering::FrameWriterPrivate
+{
+  /// \brief Worker threads.
+  public: std::vector<std::thread> workers;
+
+  /// \brief Frames waiting to be written, oldest first.
+  public: std::deque<std::unique_ptr<PendingFrame>> queue;
+
+  /// \brief Buffers that are not in use.
+  public: std::vector<std::unique_ptr<PendingFrame>> pool;
+
+  /// \brief Number of buffers.
+  public: unsigned int capacity = 1;
+
+  /// \brief Number of buffers allocated so far.
+  public: unsigned int allocated = 0;
+
+  /// \brief Number of frames being written by the workers.
+  public: unsigned int busy = 0;
+
+  /// \brief Backpressure policy.
+  public: FrameWriter::BackpressurePolicy policy = FrameWriter::BLOCK;
+
+  /// \brief True when the workers must exit.
+  public: bool stop = false;
+
+  /// \brief Number of frames written.
+  public: uint64_t written = 0;
+
+  /// \brief Number of frames dropped.
+  public: uint64_t dropped = 0;
+
+  /// \brief Number of frames that failed to be written.
+  public: uint64_t failed = 0;
+
+  /// \brief Total time spent writing frames.
+  public: common::Time writeTime;
+
+  /// \brief Wall time of the first frame.
+  public: common::Time startTime;
+
+  /// \brief Protects all the members.
+  public: mutable std::mutex mutex;
+
+  /// \brief Signaled when a frame is queued or the workers must stop.
+  public: std::condition_variable frameQueued;
+
+  /// \brief Signaled when a frame has been written.
+  public: std::condition_variable frameDone;
+};
+
+//////////////////////////////////////////////////
+FrameWriter::FrameWriter(const unsigned int _threads,
+    const unsigned int _capacity)
+  : dataPtr(new FrameWriterPrivate)
+{
+  this->dataPtr->capacity = std::max(1u, _capacity);
+  for (unsigned int i = 0; i < std::max(1u, _threads); ++i)
+    this->dataPtr->workers.emplace_back(&FrameWriter::Run, this);
+}
+
+//////////////////////////////////////////////////
+FrameWriter::~FrameWriter()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->stop = true;
+  }
+  this->dataPtr->frameQueued.notify_all();
+
+  for (auto &worker : this->dataPtr->workers)
+    worker.join();
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<FrameWriter> FrameWriter::Shared()
+{
+  static std::mutex sharedMutex;
+  static std::weak_ptr<FrameWriter> shared;
+
+  std::lock_guard<std::mutex> lock(sharedMutex);
+  auto writer = shared.lock();
+  if (!writer)
+  {
+    writer = std::make_shared<FrameWriter>(
+        std::max(2u, std::thread::hardware_concurrency() / 2));
+    shared = writer;
+  }
+  return writer;
+}
+
+//////////////////////////////////////////////////
+bool FrameWriter::Write(const unsigned char *_image,
+    const unsigned int _width, const unsigned int _height,
+    const int _depth, const std::string &_format,
+    const std::string &_filename)
+{
+  if (!_image)
+  {
+    gzerr << "Can't save an empty image\n";
+    return false;
+  }
+
+  std::unique_ptr<PendingFrame> frame;
+  {
+    std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+
+    if (this->dataPtr->startTime == common::Time::Zero)
+      this->dataPtr->startTime = common::Time::GetWallTime();
+
+    // Take a buffer from the pool, allocate one if the pool is not full, or
+    // apply the backpressure policy.
+    while (this->dataPtr->pool.empty() &&
+        this->dataPtr->allocated >= this->dataPtr->capacity)
+    {
+      if (this->dataPtr->policy == DROP)
+      {
+        ++this->dataPtr->dropped;
+        return false;
+      }
+      this->dataPtr->frameDone.wait(lock);
+    }
+
+    if (this->dataPtr->pool.empty())
+    {
+      frame.reset(new PendingFrame);
+      ++this->dataPtr->allocated;
+    }
+    else
+    {
+      frame = std::move(this->dataPtr->pool.back());
+      this->dataPtr->pool.pop_back();
+    }
+  }
+
+  // Copy the pixels without holding the lock. The buffer keeps its
+  // capacity, so frames of the same size don't allocate.
+  const size_t size = Camera::ImageByteSize(_width, _height, _format);
+  frame->data.resize(size);
+  std::memcpy(frame->data.data(), _image, size);
+  frame->width = _width;
+  frame->height = _height;
+  frame->depth = _depth;
+  frame->format = _format;
+  frame->filename = _filename;
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->queue.push_back(std::move(frame));
+  }
+  this->dataPtr->frameQueued.notify_one();
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+void FrameWriter::Run()
+{
+  std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+  while (true)
+  {
+    this->dataPtr->frameQueued.wait(lock, [this]
+    {
+      return this->dataPtr->stop || !this->dataPtr->queue.empty();
+    });
+
+    // Pending frames are written before exiting.
+    if (this->dataPtr->queue.empty())
+      break;
+
+    auto frame = std::move(this->dataPtr->queue.front());
+    this->dataPtr->queue.pop_front();
+    ++this->dataPtr->busy;
+    lock.unlock();
+
+    common::Time start = common::Time::GetWallTime();
+
+    bool result;
+    std::string extension =
+        boost::filesystem::path(frame->filename).extension().string();
+    boost::to_lower(extension);
+    if (extension == ".raw")
+    {
+      std::ofstream file(frame->filename, std::ios::out | std::ios::binary);
+      file.write(reinterpret_cast<const char *>(frame->data.data()),
+          frame->data.size());
+      result = file.good();
+    }
+    else
+    {
+      try
+      {
+        result = Camera::SaveFrame(frame->data.data(), frame->width,
+            frame->height, frame->depth, frame->format, frame->filename);
+      }
+      catch(...)
+      {
+        result = false;
+      }
+    }
+
+    if (!result)
+      gzerr << "Unable to write frame[" << frame->filename << "]\n";
+
+    common::Time elapsed = common::Time::GetWallTime() - start;
+
+    lock.lock();
+    --this->dataPtr->busy;
+    if (result)
+      ++this->dataPtr->written;
+    else
+      ++this->dataPtr->failed;
+    this->dataPtr->writeTime += elapsed;
+    this->dataPtr->pool.push_back(std::move(frame));
+    this->dataPtr->frameDone.notify_all();
+  }
+}
+
+//////////////////////////////////////////////////
+void FrameWriter::Flush()
+{
+  std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->frameDone.wait(lock, [this]
+  {
+    return this->dataPtr->queue.empty() && this->dataPtr->busy == 0;
+  });
+}
+
+//////////////////////////////////////////////////
+void FrameWriter::SetPolicy(const BackpressurePolicy _policy)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->policy = _policy;
+}
+
+//////////////////////////////////////////////////
+FrameWriter::BackpressurePolicy FrameWriter::Policy() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->policy;
+}
+
+//////////////////////////////////////////////////
+unsigned int FrameWriter::ThreadCount() const
+{
+  return this->dataPtr->workers.size();
+}
+
+//////////////////////////////////////////////////
+unsigned int FrameWriter::Capacity() const
+{
+  return this->dataPtr->capacity;
+}
+
+//////////////////////////////////////////////////
+unsigned int FrameWriter::PendingCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->queue.size() + this->dataPtr->busy;
+}
+
+//////////////////////////////////////////////////
+uint64_t FrameWriter::WrittenCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->written;
+}
+
+//////////////////////////////////////////////////
+uint64_t FrameWriter::DroppedCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->dropped;
+}
+
+//////////////////////////////////////////////////
+uint64_t FrameWriter::FailedCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->failed;
+}
+
+//////////////////////////////////////////////////
+double FrameWriter::WriteRate() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->startTime == common::Time::Zero)
+    return 0.0;
+
+  double elapsed =
+      (common::Time::GetWallTime() - this->dataPtr->startTime).Double();
+  return elapsed > 0.0 ? this->dataPtr->written / elapsed : 0.0;
+}
+
+//////////////////////////////////////////////////
+common::Time FrameWriter::AverageWriteTime() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  uint64_t count = this->dataPtr->written + this->dataPtr->failed;
+  if (count == 0)
+    return common::Time::Zero;
+  return common::Time(this->dataPtr->writeTime.Double() / count);
+}
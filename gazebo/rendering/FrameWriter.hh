@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_RENDERING_FRAMEWRITER_HH_
+#define GAZEBO_RENDERING_FRAMEWRITER_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    // Forward declare private data class.
+    class FrameWriterPrivate;
+
+    /// \addtogroup gazebo_rendering
+    /// \{
+
+    /// \class FrameWriter FrameWriter.hh rendering/rendering.hh
+    /// \brief Write image frames to disk on a pool of worker threads.
+    ///
+    /// Write copies the frame into a buffer taken from a bounded pool and
+    /// returns, so the render thread doesn't wait for the encoding. The
+    /// format is chosen from the extension of the filename: anything
+    /// supported by Camera::SaveFrame, such as png or jpg, or raw to write
+    /// the pixels without encoding.
+    ///
+    /// When all the buffers are in use, Write either waits for a buffer
+    /// (BLOCK, the default) or drops the frame (DROP).
+    class GZ_RENDERING_VISIBLE FrameWriter
+    {
+      /// \brief What to do with a frame when all the buffers are in use.
+      public: enum BackpressurePolicy
+              {
+                /// \brief Wait until a buffer is released.
+                BLOCK,
+
+                /// \brief Drop the frame.
+                DROP
+              };
+
+      /// \brief Constructor.
+      /// \param[in] _threads Number of worker threads, at least 1.
+      /// \param[in] _capacity Number of frame buffers, at least 1.
+      public: explicit FrameWriter(const unsigned int _threads = 2,
+                                   const unsigned int _capacity = 8);
+
+      /// \brief Destructor. Waits for the pending frames to be written.
+      public: virtual ~FrameWriter();
+
+      /// \brief Get the writer shared by the cameras that don't have their
+      /// own. It is created when needed, and destroyed when nobody holds it.
+      /// \return The shared writer.
+      public: static std::shared_ptr<FrameWriter> Shared();
+
+      /// \brief Queue a frame to be written.
+      /// \param[in] _image The raw image buffer.
+      /// \param[in] _width Width of the image.
+      /// \param[in] _height Height of the image.
+      /// \param[in] _depth Depth of the image data.
+      /// \param[in] _format Format the image data is in.
+      /// \param[in] _filename Name of the file in which to write the frame.
+      /// \return False if the frame was dropped or is empty.
+      public: bool Write(const unsigned char *_image,
+                  const unsigned int _width, const unsigned int _height,
+                  const int _depth, const std::string &_format,
+                  const std::string &_filename);
+
+      /// \brief Wait until all the queued frames are written.
+      public: void Flush();
+
+      /// \brief Set the policy used when all the buffers are in use.
+      /// \param[in] _policy The policy.
+      public: void SetPolicy(const BackpressurePolicy _policy);
+
+      /// \brief Get the policy used when all the buffers are in use.
+      /// \return The policy.
+      public: BackpressurePolicy Policy() const;
+
+      /// \brief Get the number of worker threads.
+      /// \return Number of threads.
+      public: unsigned int ThreadCount() const;
+
+      /// \brief Get the number of frame buffers.
+      /// \return Number of buffers.
+      public: unsigned int Capacity() const;
+
+      /// \brief Get the number of frames queued or being written.
+      /// \return Number of frames.
+      public: unsigned int PendingCount() const;
+
+      /// \brief Get the number of frames written.
+      /// \return Number of frames.
+      public: uint64_t WrittenCount() const;
+
+      /// \brief Get the number of frames dropped because all the buffers
+      /// were in use.
+      /// \return Number of frames.
+      public: uint64_t DroppedCount() const;
+
+      /// \brief Get the number of frames that could not be written.
+      /// \return Number of frames.
+      public: uint64_t FailedCount() const;
+
+      /// \brief Get the number of frames written per second of wall time,
+      /// since the first frame was queued.
+      /// \return Frames per second.
+      public: double WriteRate() const;
+
+      /// \brief Get the average time taken by a worker to write a frame.
+      /// \return Average time.
+      public: common::Time AverageWriteTime() const;
+
+      /// \brief Worker thread.
+      private: void Run();
+
+      /// \internal
+      /// \brief Pointer to private data.
+      private: std::unique_ptr<FrameWriterPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "test/util.hh"
+
+#include "gazebo/rendering/FrameWriter.hh"
+
+using namespace gazebo;
+
+class FrameWriter_TEST : public gazebo::testing::AutoLogFixture
+{
+  /// \brief Create a temporary directory for the frames.
+  protected: void SetUp() override
+  {
+    gazebo::testing::AutoLogFixture::SetUp();
+    this->path = boost::filesystem::temp_directory_path() /
+        boost::filesystem::unique_path("gazebo_frame_writer_%%%%-%%%%");
+    boost::filesystem::create_directories(this->path);
+  }
+
+  /// \brief Remove the temporary directory.
+  protected: void TearDown() override
+  {
+    boost::filesystem::remove_all(this->path);
+    gazebo::testing::AutoLogFixture::TearDown();
+  }
+
+  /// \brief Get the name of a frame file.
+  /// \param[in] _index Index of the frame.
+  /// \return Full path of the file.
+  protected: std::string Filename(const unsigned int _index) const
+  {
+    return (this->path / ("frame-" + std::to_string(_index) + ".raw"))
+        .string();
+  }
+
+  /// \brief Directory in which frames are written.
+  protected: boost::filesystem::path path;
+};
+
+/////////////////////////////////////////////////
+TEST_F(FrameWriter_TEST, Construct)
+{
+  rendering::FrameWriter writer(3, 5);
+  EXPECT_EQ(writer.ThreadCount(), 3u);
+  EXPECT_EQ(writer.Capacity(), 5u);
+  EXPECT_EQ(writer.Policy(), rendering::FrameWriter::BLOCK);
+  EXPECT_EQ(writer.PendingCount(), 0u);
+  EXPECT_EQ(writer.WrittenCount(), 0u);
+  EXPECT_DOUBLE_EQ(writer.WriteRate(), 0.0);
+  EXPECT_EQ(writer.AverageWriteTime(), common::Time::Zero);
+
+  // Zero threads or buffers are raised to one
+  rendering::FrameWriter minimal(0, 0);
+  EXPECT_EQ(minimal.ThreadCount(), 1u);
+  EXPECT_EQ(minimal.Capacity(), 1u);
+
+  // The shared writer lives as long as someone holds it
+  auto shared = rendering::FrameWriter::Shared();
+  ASSERT_NE(shared, nullptr);
+  EXPECT_EQ(shared, rendering::FrameWriter::Shared());
+}
+
+/////////////////////////////////////////////////
+TEST_F(FrameWriter_TEST, WriteRaw)
+{
+  const unsigned int width = 32;
+  const unsigned int height = 24;
+  const unsigned int count = 20;
+  std::vector<unsigned char> image(width * height * 3);
+
+  rendering::FrameWriter writer(2, 2);
+  EXPECT_FALSE(writer.Write(nullptr, width, height, 3, "R8G8B8",
+      this->Filename(0)));
+
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    std::fill(image.begin(), image.end(), static_cast<unsigned char>(i));
+    EXPECT_TRUE(writer.Write(image.data(), width, height, 3, "R8G8B8",
+        this->Filename(i)));
+  }
+  writer.Flush();
+
+  // Blocking never drops frames
+  EXPECT_EQ(writer.PendingCount(), 0u);
+  EXPECT_EQ(writer.WrittenCount(), count);
+  EXPECT_EQ(writer.DroppedCount(), 0u);
+  EXPECT_EQ(writer.FailedCount(), 0u);
+  EXPECT_GT(writer.AverageWriteTime(), common::Time::Zero);
+
+  // Each file holds a copy of the frame at the time it was queued
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    ASSERT_TRUE(boost::filesystem::exists(this->Filename(i)));
+    EXPECT_EQ(boost::filesystem::file_size(this->Filename(i)), image.size());
+
+    std::ifstream file(this->Filename(i), std::ios::binary);
+    std::vector<char> data(image.size());
+    file.read(data.data(), data.size());
+    EXPECT_EQ(static_cast<unsigned char>(data.front()), i);
+    EXPECT_EQ(static_cast<unsigned char>(data.back()), i);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(FrameWriter_TEST, Drop)
+{
+  const unsigned int width = 320;
+  const unsigned int height = 240;
+  const unsigned int count = 100;
+  std::vector<unsigned char> image(width * height * 3, 128);
+
+  rendering::FrameWriter writer(1, 1);
+  writer.SetPolicy(rendering::FrameWriter::DROP);
+  EXPECT_EQ(writer.Policy(), rendering::FrameWriter::DROP);
+
+  unsigned int accepted = 0;
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    if (writer.Write(image.data(), width, height, 3, "R8G8B8",
+        this->Filename(i)))
+    {
+      ++accepted;
+    }
+  }
+  writer.Flush();
+
+  // Every frame is either written or dropped
+  EXPECT_GT(accepted, 0u);
+  EXPECT_EQ(writer.WrittenCount(), accepted);
+  EXPECT_EQ(writer.WrittenCount() + writer.DroppedCount(), count);
+  EXPECT_EQ(writer.PendingCount(), 0u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(FrameWriter_TEST, Failed)
+{
+  std::vector<unsigned char> image(4 * 4 * 3);
+
+  rendering::FrameWriter writer;
+  EXPECT_TRUE(writer.Write(image.data(), 4, 4, 3, "R8G8B8",
+      (this->path / "missing" / "frame.raw").string()));
+  writer.Flush();
+
+  EXPECT_EQ(writer.WrittenCount(), 0u);
+  EXPECT_EQ(writer.FailedCount(), 1u);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
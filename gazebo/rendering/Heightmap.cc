@@ -31,6 +31,7 @@
 #include "gazebo/common/Dem.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/HeightmapData.hh"
+#include "gazebo/common/HeightmapTileCache.hh"
 #include "gazebo/common/SystemPaths.hh"
 #include "gazebo/transport/TransportIface.hh"
 #include "gazebo/rendering/ogre_gazebo.h"
@@ -392,8 +393,32 @@ void Heightmap::Load()
   // ogre. It is later translated back by the setOrigin call.
   double minElevation = 0.0;
 
+  // Height lookup table in the row order of physics/HeightmapShape.cc, and
+  // its number of vertices per side
+  std::vector<float> lookup;
+  unsigned int vertSize = 0;
+
+  // Tiled heightmaps are rendered from their overview, which is the only
+  // part of the file kept in memory
+  if (!this->dataPtr->filename.empty() &&
+      common::HeightmapTileCache::IsTiledFile(this->dataPtr->filename))
+  {
+    this->dataPtr->tileCache =
+        common::HeightmapTileCache::Acquire(this->dataPtr->filename);
+  }
+
+  if (this->dataPtr->tileCache)
+  {
+    auto &cache = this->dataPtr->tileCache;
+    minElevation = cache->MinElevation();
+    this->dataPtr->terrainSize.Z(cache->MaxElevation() - minElevation);
+
+    // The file rows are in the lookup table order
+    lookup = cache->Overview();
+    vertSize = cache->OverviewSize();
+  }
   // try loading heightmap data locally
-  if (!this->dataPtr->filename.empty())
+  else if (!this->dataPtr->filename.empty())
   {
     this->dataPtr->heightmapData = common::HeightmapDataLoader::LoadTerrainFile(
         this->dataPtr->filename);
@@ -423,7 +448,7 @@ void Heightmap::Load()
       // in order to generate consistent height data
       bool flipY = false;
       // sampling size along image width and height
-      unsigned int vertSize = (this->dataPtr->heightmapData->GetWidth() *
+      vertSize = (this->dataPtr->heightmapData->GetWidth() *
           this->dataPtr->sampling) - this->dataPtr->sampling + 1;
       ignition::math::Vector3d scale;
       scale.X(this->dataPtr->terrainSize.X() / vertSize);
@@ -435,21 +460,25 @@ void Heightmap::Load()
         scale.Z(fabs(this->dataPtr->terrainSize.Z()) / heightmapSizeZ);
 
       // Construct the heightmap lookup table
-      std::vector<float> lookup;
       this->dataPtr->heightmapData->FillHeightMap(this->dataPtr->sampling,
           vertSize, this->dataPtr->terrainSize, scale, flipY, lookup);
+    }
+  }
 
-      for (unsigned int y = 0; y < vertSize; ++y)
+  // Ogre terrain rows run the other way along Y
+  if (!lookup.empty())
+  {
+    this->dataPtr->heights.reserve(lookup.size());
+    for (unsigned int y = 0; y < vertSize; ++y)
+    {
+      for (unsigned int x = 0; x < vertSize; ++x)
       {
-        for (unsigned int x = 0; x < vertSize; ++x)
-        {
-          int index = (vertSize - y - 1) * vertSize + x;
-          this->dataPtr->heights.push_back(lookup[index] - minElevation);
-        }
+        int index = (vertSize - y - 1) * vertSize + x;
+        this->dataPtr->heights.push_back(lookup[index] - minElevation);
       }
-
-      this->dataPtr->dataSize = vertSize;
     }
+
+    this->dataPtr->dataSize = vertSize;
   }
 
   // if heightmap fails to load locally, get the data from the server side
@@ -17,12 +17,14 @@
 #ifndef _GAZEBO_RENDERING_HEIGHTMAPPRIVATE_HH_
 #define _GAZEBO_RENDERING_HEIGHTMAPPRIVATE_HH_
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <boost/filesystem.hpp>
 
 #include <ignition/math/Vector3.hh>
 
+#include "gazebo/common/HeightmapTileCache.hh"
 #include "gazebo/rendering/RenderTypes.hh"
 
 #if OGRE_VERSION_MAJOR == 1 && OGRE_VERSION_MINOR >= 11
@@ -463,6 +465,10 @@ namespace gazebo
       /// \brief Pointer to heightmap data
       public: common::HeightmapData *heightmapData = nullptr;
 
+      /// \brief Tile cache of a tiled heightmap, shared with the physics
+      /// heightmap of the same file.
+      public: std::shared_ptr<common::HeightmapTileCache> tileCache;
+
       /// \brief Number of samples per heightmap datum
       public: unsigned int sampling = 2u;
 
@@ -17,6 +17,7 @@
 #include <string>
 #include <iostream>
 #include <functional>
+#include <list>
 #include <boost/filesystem.hpp>
 #include <sys/types.h>
 
@@ -25,6 +25,7 @@
 using namespace gazebo;
 
 bool g_lockstep = false;
+bool g_compactPoses = false;
 
 //////////////////////////////////////////////////
 bool rendering::load()
@@ -148,3 +149,15 @@ bool rendering::lockstep_enabled()
 {
   return g_lockstep;
 }
+
+//////////////////////////////////////////////////
+void rendering::set_compact_poses_enabled(bool _enable)
+{
+  g_compactPoses = _enable;
+}
+
+//////////////////////////////////////////////////
+bool rendering::compact_poses_enabled()
+{
+  return g_compactPoses;
+}
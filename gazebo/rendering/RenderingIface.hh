@@ -71,6 +71,23 @@ namespace gazebo
     GZ_RENDERING_VISIBLE
     bool lockstep_enabled();
 
+    /// \brief Set whether client scenes receive poses through the compact
+    /// pose stream, ~/pose/compact/info, instead of ~/pose/info. The
+    /// compact stream uses less bandwidth, but quantizes poses and skips
+    /// frames until the next keyframe when one can't be decoded.
+    /// Disabled by default. Must be set before scenes are created.
+    /// \param[in] _enable True to use the compact pose stream.
+    /// \sa compact_poses_enabled
+    GZ_RENDERING_VISIBLE
+    void set_compact_poses_enabled(bool _enable);
+
+    /// \brief Get whether client scenes receive poses through the compact
+    /// pose stream.
+    /// \return True if the compact pose stream is used.
+    /// \sa set_compact_poses_enabled
+    GZ_RENDERING_VISIBLE
+    bool compact_poses_enabled();
+
     /// \brief wait until a render request occurs
     /// \param[in] _name Name of the scene to retrieve
     /// \param[in] _timeoutsec timeout expressed in seconds
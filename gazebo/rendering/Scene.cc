@@ -170,8 +170,16 @@ Scene::Scene(const std::string &_name, const bool _enableVisualizations,
   // uncomment the following line and delete the if and else directly above
   if (!_isServer)
   {
-    this->dataPtr->poseSub = this->dataPtr->node->Subscribe("~/pose/info",
-        &Scene::OnPoseMsg, this);
+    if (rendering::compact_poses_enabled())
+    {
+      this->dataPtr->poseSub = this->dataPtr->node->Subscribe(
+          "~/pose/compact/info", &Scene::OnCompactPoseMsg, this);
+    }
+    else
+    {
+      this->dataPtr->poseSub = this->dataPtr->node->Subscribe("~/pose/info",
+          &Scene::OnPoseMsg, this);
+    }
   }
 
   this->dataPtr->jointSub =
@@ -250,7 +258,9 @@ void Scene::Clear()
 
   {
     std::lock_guard<std::recursive_mutex> lock(this->dataPtr->poseMsgMutex);
-    this->dataPtr->poseMsgs.clear();
+    this->dataPtr->pendingPoses.Clear();
+    this->dataPtr->incomingPoses.Clear();
+    this->dataPtr->heldPoses.Clear();
   }
 
   this->dataPtr->joints.clear();
@@ -261,7 +271,7 @@ void Scene::Clear()
   while (!this->dataPtr->visuals.empty())
     this->RemoveVisual(this->dataPtr->visuals.begin()->first);
 
-  this->dataPtr->visuals.clear();
+  this->dataPtr->poseVisuals.Clear(this->dataPtr->visuals);
 
   if (this->dataPtr->originVisual)
   {
@@ -361,7 +371,8 @@ void Scene::Init()
   this->dataPtr->worldVisual.reset(new Visual("__world_node__",
       shared_from_this()));
   this->dataPtr->worldVisual->SetId(0);
-  this->dataPtr->visuals[0] = this->dataPtr->worldVisual;
+  this->dataPtr->poseVisuals.Insert(this->dataPtr->visuals, 0,
+      this->dataPtr->worldVisual);
 
   // RTShader system self-enables if the render path type is FORWARD,
   RTShaderSystem::Instance()->AddScene(shared_from_this());
@@ -1536,17 +1547,8 @@ bool Scene::ProcessSceneMsg(ConstScenePtr &_msg)
     std::lock_guard<std::recursive_mutex> lock(this->dataPtr->poseMsgMutex);
     for (int i = 0; i < _msg->model_size(); ++i)
     {
-      PoseMsgs_M::iterator iter =
-          this->dataPtr->poseMsgs.find(_msg->model(i).id());
-      if (iter != this->dataPtr->poseMsgs.end())
-        iter->second.CopyFrom(_msg->model(i).pose());
-      else
-        this->dataPtr->poseMsgs.insert(
-            std::make_pair(_msg->model(i).id(), _msg->model(i).pose()));
-
-      this->dataPtr->poseMsgs[_msg->model(i).id()].set_name(
-          _msg->model(i).name());
-      this->dataPtr->poseMsgs[_msg->model(i).id()].set_id(_msg->model(i).id());
+      this->dataPtr->pendingPoses.Set(_msg->model(i).id(),
+          msgs::ConvertIgn(_msg->model(i).pose()));
 
       this->ProcessModelMsg(_msg->model(i));
     }
@@ -1630,9 +1632,6 @@ bool Scene::ProcessSceneMsg(ConstScenePtr &_msg)
 //////////////////////////////////////////////////
 bool Scene::ProcessModelMsg(const msgs::Model &_msg)
 {
-  std::string modelName, linkName;
-
-  modelName = _msg.name() + "::";
   for (int j = 0; j < _msg.visual_size(); ++j)
   {
     boost::shared_ptr<msgs::Visual> vm(new msgs::Visual(
@@ -1671,22 +1670,12 @@ bool Scene::ProcessModelMsg(const msgs::Model &_msg)
 
   for (int j = 0; j < _msg.link_size(); ++j)
   {
-    linkName = modelName + _msg.link(j).name();
-
     {
       std::lock_guard<std::recursive_mutex> lock(this->dataPtr->poseMsgMutex);
       if (_msg.link(j).has_pose())
       {
-        PoseMsgs_M::iterator iter =
-            this->dataPtr->poseMsgs.find(_msg.link(j).id());
-        if (iter != this->dataPtr->poseMsgs.end())
-          iter->second.CopyFrom(_msg.link(j).pose());
-        else
-          this->dataPtr->poseMsgs.insert(
-              std::make_pair(_msg.link(j).id(), _msg.link(j).pose()));
-
-        this->dataPtr->poseMsgs[_msg.link(j).id()].set_name(linkName);
-        this->dataPtr->poseMsgs[_msg.link(j).id()].set_id(_msg.link(j).id());
+        this->dataPtr->pendingPoses.Set(_msg.link(j).id(),
+            msgs::ConvertIgn(_msg.link(j).pose()));
       }
     }
 
@@ -1813,7 +1802,6 @@ void Scene::PreRender()
   static ModelMsgs_L::iterator modelIter;
   static VisualMsgs_L::iterator visualIter;
   static LightMsgs_L::iterator lightIter;
-  static PoseMsgs_M::iterator pIter;
   static SkeletonPoseMsgs_L::iterator spIter;
   static JointMsgs_L::iterator jointIter;
   static SensorMsgs_L::iterator sensorIter;
@@ -2054,50 +2042,61 @@ void Scene::PreRender()
   // update the rt shader
   RTShaderSystem::Instance()->Update();
 
+  // Take the latest pose of every entity. The transport threads only
+  // contend with this swap, the poses are applied without the lock.
+  common::Time posesReceived;
   {
     std::lock_guard<std::recursive_mutex> lock(this->dataPtr->poseMsgMutex);
+    this->dataPtr->incomingPoses.Swap(this->dataPtr->pendingPoses);
+    posesReceived = this->dataPtr->sceneSimTimePosesReceived;
+  }
+
+  // Poses received in this frame replace the ones held back earlier
+  if (this->dataPtr->heldPoses.Empty())
+  {
+    this->dataPtr->heldPoses.Swap(this->dataPtr->incomingPoses);
+  }
+  else
+  {
+    this->dataPtr->heldPoses.Merge(this->dataPtr->incomingPoses);
+    this->dataPtr->incomingPoses.Clear();
+  }
 
-    // Process all the model messages last. Remove pose message from the list
-    // only when a corresponding visual exits. We may receive pose updates
-    // over the wire before  we recieve the visual
-    pIter = this->dataPtr->poseMsgs.begin();
-    while (pIter != this->dataPtr->poseMsgs.end())
+  // Apply all the poses in one pass. A pose is held back until its visual
+  // exists, since we may receive pose updates over the wire before we
+  // receive the visual.
+  this->dataPtr->heldPoses.RemoveIf([this](const PoseBuffer::Entry &_entry)
+  {
+    VisualPtr vis =
+        this->dataPtr->poseVisuals.Find(this->dataPtr->visuals, _entry.first);
+    if (vis)
     {
-      Visual_M::iterator iter = this->dataPtr->visuals.find(pIter->first);
-      if (iter != this->dataPtr->visuals.end() && iter->second)
+      // If an object is selected, don't let the physics engine move it.
+      if (this->dataPtr->selectedVis &&
+          this->dataPtr->selectionMode == "move" &&
+          (_entry.first == this->dataPtr->selectedVis->GetId() ||
+          this->dataPtr->selectedVis->IsAncestorOf(vis)))
       {
-        // If an object is selected, don't let the physics engine move it.
-        if (!this->dataPtr->selectedVis
-            || this->dataPtr->selectionMode != "move" ||
-            (iter->first != this->dataPtr->selectedVis->GetId() &&
-            !this->dataPtr->selectedVis->IsAncestorOf(iter->second)))
-        {
-          ignition::math::Pose3d pose = msgs::ConvertIgn(pIter->second);
-          GZ_ASSERT(iter->second, "Visual pointer is NULL");
-          iter->second->SetPose(pose);
-          PoseMsgs_M::iterator prev = pIter++;
-          this->dataPtr->poseMsgs.erase(prev);
-        }
-        else
-          ++pIter;
-      }
-      else
-      {
-        // process light pose messages
-        auto lIter = this->dataPtr->lights.find(pIter->first);
-        if (lIter != this->dataPtr->lights.end())
-        {
-          ignition::math::Pose3d pose = msgs::ConvertIgn(pIter->second);
-          lIter->second->SetPosition(pose.Pos());
-          lIter->second->SetRotation(pose.Rot());
-          auto prev = pIter++;
-          this->dataPtr->poseMsgs.erase(prev);
-        }
-        else
-          ++pIter;
+        return false;
       }
+      vis->SetPose(_entry.second);
+      return true;
     }
 
+    // process light poses
+    auto lIter = this->dataPtr->lights.find(_entry.first);
+    if (lIter != this->dataPtr->lights.end())
+    {
+      lIter->second->SetPosition(_entry.second.Pos());
+      lIter->second->SetRotation(_entry.second.Rot());
+      return true;
+    }
+    return false;
+  });
+
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->poseMsgMutex);
+
     // process skeleton pose msgs
     spIter = this->dataPtr->skeletonPoseMsgs.begin();
     while (spIter != this->dataPtr->skeletonPoseMsgs.end())
@@ -2153,13 +2152,13 @@ void Scene::PreRender()
       {
         Road2dPtr road(new Road2d(msg->name(), this->dataPtr->worldVisual));
         road->Load(*msg);
-        this->dataPtr->visuals[road->GetId()] = road;
+        this->dataPtr->poseVisuals.Insert(this->dataPtr->visuals,
+            road->GetId(), road);
       }
     }
 
     // official time stamp of approval
-    this->dataPtr->sceneSimTimePosesApplied =
-        this->dataPtr->sceneSimTimePosesReceived;
+    this->dataPtr->sceneSimTimePosesApplied = posesReceived;
   }
 }
 
@@ -2191,7 +2190,8 @@ bool Scene::ProcessSensorMsg(ConstSensorPtr &_msg)
             rayVisualName+"_GUIONLY_laser_vis", parentVis, _msg->topic()));
       laserVis->Load();
       laserVis->SetId(_msg->id());
-      this->dataPtr->visuals[_msg->id()] = laserVis;
+      this->dataPtr->poseVisuals.Insert(this->dataPtr->visuals,
+          _msg->id(), laserVis);
     }
   }
   else if ((_msg->type() == "sonar") && _msg->visualize()
@@ -2208,7 +2208,8 @@ bool Scene::ProcessSensorMsg(ConstSensorPtr &_msg)
             sonarVisualName+"_GUIONLY_sonar_vis", parentVis, _msg->topic()));
       sonarVis->Load();
       sonarVis->SetId(_msg->id());
-      this->dataPtr->visuals[_msg->id()] = sonarVis;
+      this->dataPtr->poseVisuals.Insert(this->dataPtr->visuals,
+          _msg->id(), sonarVis);
     }
   }
   else if ((_msg->type() == "force_torque") && _msg->visualize()
@@ -2238,7 +2239,8 @@ bool Scene::ProcessSensorMsg(ConstSensorPtr &_msg)
             _msg->topic()));
       wrenchVis->Load(jointMsg);
       wrenchVis->SetId(_msg->id());
-      this->dataPtr->visuals[_msg->id()] = wrenchVis;
+      this->dataPtr->poseVisuals.Insert(this->dataPtr->visuals,
+          _msg->id(), wrenchVis);
     }
   }
   else if (_msg->type() == "camera" && _msg->visualize())
@@ -2264,7 +2266,8 @@ bool Scene::ProcessSensorMsg(ConstSensorPtr &_msg)
         cameraVis->SetPose(msgs::ConvertIgn(_msg->pose()));
         cameraVis->SetId(_msg->id());
         cameraVis->Load(_msg->camera());
-        this->dataPtr->visuals[cameraVis->GetId()] = cameraVis;
+        this->dataPtr->poseVisuals.Insert(this->dataPtr->visuals,
+            cameraVis->GetId(), cameraVis);
       }
     }
   }
@@ -2287,7 +2290,8 @@ bool Scene::ProcessSensorMsg(ConstSensorPtr &_msg)
       cameraVis->SetPose(msgs::ConvertIgn(_msg->pose()));
       cameraVis->SetId(_msg->id());
       cameraVis->Load(_msg->logical_camera());
-      this->dataPtr->visuals[cameraVis->GetId()] = cameraVis;
+      this->dataPtr->poseVisuals.Insert(this->dataPtr->visuals,
+          cameraVis->GetId(), cameraVis);
     }
     else if (_msg->has_pose())
     {
@@ -2303,7 +2307,8 @@ bool Scene::ProcessSensorMsg(ConstSensorPtr &_msg)
     contactVis->SetId(_msg->id());
 
     this->dataPtr->contactVisId = _msg->id();
-    this->dataPtr->visuals[contactVis->GetId()] = contactVis;
+    this->dataPtr->poseVisuals.Insert(this->dataPtr->visuals,
+        contactVis->GetId(), contactVis);
   }
   else if (_msg->type() == "rfidtag" && _msg->visualize() &&
            !_msg->topic().empty())
@@ -2316,7 +2321,8 @@ bool Scene::ProcessSensorMsg(ConstSensorPtr &_msg)
           _msg->name() + "_GUIONLY_rfidtag_vis", parentVis, _msg->topic()));
     rfidVis->SetId(_msg->id());
 
-    this->dataPtr->visuals[rfidVis->GetId()] = rfidVis;
+    this->dataPtr->poseVisuals.Insert(this->dataPtr->visuals,
+        rfidVis->GetId(), rfidVis);
   }
   else if (_msg->type() == "rfid" && _msg->visualize() &&
            !_msg->topic().empty())
@@ -2328,7 +2334,8 @@ bool Scene::ProcessSensorMsg(ConstSensorPtr &_msg)
     RFIDVisualPtr rfidVis(new RFIDVisual(
           _msg->name() + "_GUIONLY_rfid_vis", parentVis, _msg->topic()));
     rfidVis->SetId(_msg->id());
-    this->dataPtr->visuals[rfidVis->GetId()] = rfidVis;
+    this->dataPtr->poseVisuals.Insert(this->dataPtr->visuals,
+        rfidVis->GetId(), rfidVis);
   }
   else if (_msg->type() == "wireless_transmitter" && _msg->visualize() &&
            !_msg->topic().empty())
@@ -2339,7 +2346,8 @@ bool Scene::ProcessSensorMsg(ConstSensorPtr &_msg)
 
     VisualPtr transmitterVis(new TransmitterVisual(
           _msg->name() + "_GUIONLY_transmitter_vis", parentVis, _msg->topic()));
-    this->dataPtr->visuals[transmitterVis->GetId()] = transmitterVis;
+    this->dataPtr->poseVisuals.Insert(this->dataPtr->visuals,
+        transmitterVis->GetId(), transmitterVis);
     transmitterVis->Load();
   }
 
@@ -2727,7 +2735,7 @@ bool Scene::ProcessVisualMsg(ConstVisualPtr &_msg, Visual::VisualType _type)
   {
     if (iter != this->dataPtr->visuals.end())
     {
-      this->dataPtr->visuals.erase(iter);
+      this->dataPtr->poseVisuals.Erase(this->dataPtr->visuals, iter->first);
       return true;
     }
     else
@@ -2843,7 +2851,8 @@ bool Scene::ProcessVisualMsg(ConstVisualPtr &_msg, Visual::VisualType _type)
   visual->LoadFromMsg(_msg);
   visual->SetType(_type);
 
-  this->dataPtr->visuals[visual->GetId()] = visual;
+  this->dataPtr->poseVisuals.Insert(this->dataPtr->visuals,
+      visual->GetId(), visual);
   if (visual->Name().find("__SKELETON_VISUAL__") != std::string::npos)
   {
     visual->SetVisible(false);
@@ -2871,15 +2880,11 @@ void Scene::OnPoseMsg(ConstPosesStampedPtr &_msg)
   this->dataPtr->sceneSimTimePosesReceived =
     common::Time(_msg->time().sec(), _msg->time().nsec());
 
+  // Only the latest pose of each entity is kept until the next frame
   for (int i = 0; i < _msg->pose_size(); ++i)
   {
-    auto p = _msg->pose(i);
-    PoseMsgs_M::iterator iter =
-        this->dataPtr->poseMsgs.find(p.id());
-    if (iter != this->dataPtr->poseMsgs.end())
-      iter->second.CopyFrom(p);
-    else
-      this->dataPtr->poseMsgs.insert(std::make_pair(p.id(), p));
+    const msgs::Pose &p = _msg->pose(i);
+    this->dataPtr->pendingPoses.Set(p.id(), msgs::ConvertIgn(p));
   }
 }
 
@@ -2894,6 +2899,39 @@ void Scene::UpdatePoses(const msgs::PosesStamped &_msg)
   this->dataPtr->newPoseCondition.notify_all();
 }
 
+/////////////////////////////////////////////////
+void Scene::UpdatePoses(const msgs::CompactPoses &_msg)
+{
+  if (!this->ProcessCompactPoses(_msg))
+    return;
+
+  std::unique_lock<std::mutex> lck(this->dataPtr->newPoseMutex);
+  this->dataPtr->newPoseAvailable = true;
+  this->dataPtr->newPoseCondition.notify_all();
+}
+
+/////////////////////////////////////////////////
+void Scene::OnCompactPoseMsg(ConstCompactPosesPtr &_msg)
+{
+  this->ProcessCompactPoses(*_msg);
+}
+
+/////////////////////////////////////////////////
+bool Scene::ProcessCompactPoses(const msgs::CompactPoses &_msg)
+{
+  auto poses = boost::make_shared<msgs::PosesStamped>();
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->poseMsgMutex);
+    // Frames before the first keyframe can't be decoded
+    if (!this->dataPtr->poseDecoder.Decode(_msg, *poses))
+      return false;
+  }
+
+  ConstPosesStampedPtr msgptr = poses;
+  this->OnPoseMsg(msgptr);
+  return true;
+}
+
 /////////////////////////////////////////////////
 bool Scene::WaitForRenderRequest(double _timeoutsec)
 {
@@ -3294,7 +3332,8 @@ void Scene::AddVisual(VisualPtr _vis)
     gzwarn << "Duplicate visuals detected[" << _vis->Name() << "]\n";
   }
 
-  this->dataPtr->visuals[_vis->GetId()] = _vis;
+  this->dataPtr->poseVisuals.Insert(this->dataPtr->visuals, _vis->GetId(),
+      _vis);
 }
 
 /////////////////////////////////////////////////
@@ -3320,7 +3359,7 @@ void Scene::RemoveVisual(uint32_t _id)
       else
         ++piter;
     }
-    this->dataPtr->visuals.erase(iter);
+    this->dataPtr->poseVisuals.Erase(this->dataPtr->visuals, _id);
 
     this->RemoveVisualizations(vis);
     vis->Fini();
@@ -3346,8 +3385,8 @@ void Scene::SetVisualId(VisualPtr _vis, uint32_t _id)
   auto iter = this->dataPtr->visuals.find(_vis->GetId());
   if (iter != this->dataPtr->visuals.end())
   {
-    this->dataPtr->visuals.erase(_vis->GetId());
-    this->dataPtr->visuals[_id] = _vis;
+    this->dataPtr->poseVisuals.Erase(this->dataPtr->visuals, _vis->GetId());
+    this->dataPtr->poseVisuals.Insert(this->dataPtr->visuals, _id, _vis);
     _vis->SetId(_id);
   }
 }
@@ -3454,7 +3493,8 @@ void Scene::CreateCOMVisual(ConstLinkPtr &_msg, VisualPtr _linkVisual)
                                     _linkVisual));
   comVis->Load(_msg);
   comVis->SetVisible(this->dataPtr->showCOMs);
-  this->dataPtr->visuals[comVis->GetId()] = comVis;
+  this->dataPtr->poseVisuals.Insert(this->dataPtr->visuals,
+      comVis->GetId(), comVis);
 }
 
 /////////////////////////////////////////////////
@@ -3464,7 +3504,8 @@ void Scene::CreateCOMVisual(sdf::ElementPtr _elem, VisualPtr _linkVisual)
                                     _linkVisual));
   comVis->Load(_elem);
   comVis->SetVisible(false);
-  this->dataPtr->visuals[comVis->GetId()] = comVis;
+  this->dataPtr->poseVisuals.Insert(this->dataPtr->visuals,
+      comVis->GetId(), comVis);
 }
 
 /////////////////////////////////////////////////
@@ -3474,7 +3515,8 @@ void Scene::CreateInertiaVisual(ConstLinkPtr &_msg, VisualPtr _linkVisual)
       "_INERTIA_VISUAL__", _linkVisual));
   inertiaVis->Load(_msg);
   inertiaVis->SetVisible(this->dataPtr->showInertias);
-  this->dataPtr->visuals[inertiaVis->GetId()] = inertiaVis;
+  this->dataPtr->poseVisuals.Insert(this->dataPtr->visuals,
+      inertiaVis->GetId(), inertiaVis);
 }
 
 /////////////////////////////////////////////////
@@ -3484,7 +3526,8 @@ void Scene::CreateInertiaVisual(sdf::ElementPtr _elem, VisualPtr _linkVisual)
       "_INERTIA_VISUAL__", _linkVisual));
   inertiaVis->Load(_elem);
   inertiaVis->SetVisible(false);
-  this->dataPtr->visuals[inertiaVis->GetId()] = inertiaVis;
+  this->dataPtr->poseVisuals.Insert(this->dataPtr->visuals,
+      inertiaVis->GetId(), inertiaVis);
 }
 
 /////////////////////////////////////////////////
@@ -3494,7 +3537,8 @@ void Scene::CreateLinkFrameVisual(ConstLinkPtr &/*_msg*/, VisualPtr _linkVisual)
       "_LINK_FRAME_VISUAL__", _linkVisual));
   linkFrameVis->Load();
   linkFrameVis->SetVisible(this->dataPtr->showLinkFrames);
-  this->dataPtr->visuals[linkFrameVis->GetId()] = linkFrameVis;
+  this->dataPtr->poseVisuals.Insert(this->dataPtr->visuals,
+      linkFrameVis->GetId(), linkFrameVis);
 }
 
 /////////////////////////////////////////////////
@@ -3614,11 +3658,15 @@ void Scene::ShowContacts(const bool _show)
               this->dataPtr->worldVisual, "~/physics/contacts"));
     vis->SetEnabled(_show);
     this->dataPtr->contactVisId = vis->GetId();
-    this->dataPtr->visuals[this->dataPtr->contactVisId] = vis;
+    this->dataPtr->poseVisuals.Insert(this->dataPtr->visuals,
+        this->dataPtr->contactVisId, vis);
   }
   else
+  {
     vis = std::dynamic_pointer_cast<ContactVisual>(
-        this->dataPtr->visuals[this->dataPtr->contactVisId]);
+        this->dataPtr->poseVisuals.Find(this->dataPtr->visuals,
+        this->dataPtr->contactVisId));
+  }
 
   if (vis)
     vis->SetEnabled(_show);
@@ -568,6 +568,12 @@ namespace gazebo
       /// \param[in] _msg The message data.
       public: void UpdatePoses(const msgs::PosesStamped& _msg);
 
+      /// \brief Update Poses of objects in the scene from a frame of the
+      /// compact pose stream, see msgs::PoseStreamDecoder. Frames must be
+      /// passed in the order they were produced.
+      /// \param[in] _msg The message data.
+      public: void UpdatePoses(const msgs::CompactPoses &_msg);
+
       /// \brief Get the number of visuals.
       /// \return The number of visuals in the Scene.
       public: uint32_t VisualCount() const;
@@ -730,6 +736,15 @@ namespace gazebo
       /// \param[in] _msg The message data.
       private: void OnPoseMsg(ConstPosesStampedPtr &_msg);
 
+      /// \brief Compact pose stream callback.
+      /// \param[in] _msg The message data.
+      private: void OnCompactPoseMsg(ConstCompactPosesPtr &_msg);
+
+      /// \brief Decode a compact pose frame and queue the poses it holds.
+      /// \param[in] _msg The message data.
+      /// \return False if the frame could not be decoded yet.
+      private: bool ProcessCompactPoses(const msgs::CompactPoses &_msg);
+
       /// \brief Skeleton animation callback.
       /// \param[in] _msg The message data.
       private: void OnSkeletonPoseMsg(ConstPoseAnimationPtr &_msg);
@@ -20,6 +20,8 @@
 #include <list>
 #include <map>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 #include <mutex>
 #include <condition_variable>
@@ -31,6 +33,7 @@
 #include "gazebo/common/Events.hh"
 #include "gazebo/gazebo_config.h"
 #include "gazebo/msgs/msgs.hh"
+#include "gazebo/msgs/PoseStream.hh"
 #include "gazebo/rendering/MarkerManager.hh"
 #include "gazebo/rendering/RenderTypes.hh"
 #include "gazebo/transport/TransportTypes.hh"
@@ -68,10 +71,6 @@ namespace gazebo
     /// \brief List of light messages.
     typedef std::list<boost::shared_ptr<msgs::Light const> > LightMsgs_L;
 
-    /// \typedef PoseMsgs_M.
-    /// \brief List of messages.
-    typedef std::map<uint32_t, msgs::Pose> PoseMsgs_M;
-
     /// \typedef LightPoseMsgs_M.
     /// \brief List of messages.
     typedef std::map<std::string, msgs::Pose> LightPoseMsgs_M;
@@ -118,6 +117,163 @@ namespace gazebo
     /// \brief List of road messages
     typedef std::list<boost::shared_ptr<msgs::Road const> > RoadMsgs_L;
 
+    /// \brief Latest pose of each entity, in arrival order. Setting the
+    /// pose of an entity that is already in the buffer replaces it, so a
+    /// renderer that falls behind the pose stream only applies the newest
+    /// pose of each entity.
+    class PoseBuffer
+    {
+      /// \brief A pose and the id of the entity it belongs to.
+      public: typedef std::pair<uint32_t, ignition::math::Pose3d> Entry;
+
+      /// \brief Set the latest pose of an entity.
+      /// \param[in] _id Entity id.
+      /// \param[in] _pose Pose of the entity.
+      public: void Set(const uint32_t _id,
+                  const ignition::math::Pose3d &_pose)
+      {
+        auto result = this->index.emplace(_id, this->entries.size());
+        if (result.second)
+          this->entries.emplace_back(_id, _pose);
+        else
+          this->entries[result.first->second].second = _pose;
+      }
+
+      /// \brief Set the poses of another buffer, which are newer than the
+      /// ones in this buffer.
+      /// \param[in] _other Buffer with the newer poses.
+      public: void Merge(const PoseBuffer &_other)
+      {
+        for (auto const &entry : _other.entries)
+          this->Set(entry.first, entry.second);
+      }
+
+      /// \brief Remove the entries for which a predicate returns true,
+      /// keeping the order of the others.
+      /// \param[in] _pred Predicate called once with every entry.
+      public: template<typename Pred>
+              void RemoveIf(Pred _pred)
+      {
+        size_t kept = 0;
+        for (auto &entry : this->entries)
+        {
+          if (!_pred(entry))
+            this->entries[kept++] = entry;
+        }
+        if (kept == this->entries.size())
+          return;
+
+        this->entries.resize(kept);
+        this->index.clear();
+        for (size_t i = 0; i < kept; ++i)
+          this->index[this->entries[i].first] = i;
+      }
+
+      /// \brief Exchange the contents of two buffers. Their storage is
+      /// exchanged too, so buffers that are swapped back and forth stop
+      /// allocating once they are large enough.
+      /// \param[in] _other Buffer to swap with.
+      public: void Swap(PoseBuffer &_other)
+      {
+        this->entries.swap(_other.entries);
+        this->index.swap(_other.index);
+      }
+
+      /// \brief Remove all entries.
+      public: void Clear()
+      {
+        this->entries.clear();
+        this->index.clear();
+      }
+
+      /// \brief Check whether the buffer is empty.
+      /// \return True if no entity has a pose in the buffer.
+      public: bool Empty() const
+      {
+        return this->entries.empty();
+      }
+
+      /// \brief Poses in arrival order.
+      private: std::vector<Entry> entries;
+
+      /// \brief Index of each entity's pose in entries.
+      private: std::unordered_map<uint32_t, size_t> index;
+    };
+
+    /// \brief Flat, id indexed table of the visuals that receive poses,
+    /// in front of the Visual_M map. Entity ids assigned by physics are
+    /// small and dense, so looking them up here avoids a tree walk per
+    /// pose. Ids beyond the table size, such as those of rendering-only
+    /// visuals, are looked up in the map. Visuals must be added to and
+    /// removed from the map through this class, so the table never holds
+    /// a visual the map no longer has.
+    class VisualTable
+    {
+      /// \brief Find a visual.
+      /// \param[in] _visuals Map of all the visuals, used on a miss.
+      /// \param[in] _id Id of the visual.
+      /// \return The visual, or null if it doesn't exist.
+      public: VisualPtr Find(const Visual_M &_visuals, const uint32_t _id)
+      {
+        if (_id < this->table.size() && this->table[_id])
+          return this->table[_id];
+
+        auto iter = _visuals.find(_id);
+        if (iter == _visuals.end())
+          return VisualPtr();
+
+        // Keep the table small when ids are sparse
+        const uint32_t maxId = 1u << 20;
+        if (_id < maxId)
+        {
+          if (_id >= this->table.size())
+            this->table.resize(_id + 1);
+          this->table[_id] = iter->second;
+        }
+        return iter->second;
+      }
+
+      /// \brief Add or replace a visual in the map.
+      /// \param[in,out] _visuals Map of all the visuals.
+      /// \param[in] _id Id of the visual.
+      /// \param[in] _vis The visual.
+      public: void Insert(Visual_M &_visuals, const uint32_t _id,
+                          const VisualPtr &_vis)
+      {
+        this->Forget(_id);
+        _visuals[_id] = _vis;
+      }
+
+      /// \brief Remove a visual from the map.
+      /// \param[in,out] _visuals Map of all the visuals.
+      /// \param[in] _id Id of the visual.
+      public: void Erase(Visual_M &_visuals, const uint32_t _id)
+      {
+        this->Forget(_id);
+        _visuals.erase(_id);
+      }
+
+      /// \brief Remove all the visuals from the map.
+      /// \param[in,out] _visuals Map of all the visuals.
+      public: void Clear(Visual_M &_visuals)
+      {
+        this->table.clear();
+        _visuals.clear();
+      }
+
+      /// \brief Forget a visual that is removed from, or replaced in, the
+      /// map.
+      /// \param[in] _id Id of the visual.
+      private: void Forget(const uint32_t _id)
+      {
+        if (_id < this->table.size())
+          this->table[_id].reset();
+      }
+
+      /// \brief Visuals indexed by id.
+      private: std::vector<VisualPtr> table;
+    };
+
     /// \brief Private data for the Visual class
     class ScenePrivate
     {
@@ -181,8 +337,22 @@ namespace gazebo
       /// \brief List of light modify message to process.
       public: LightMsgs_L lightModifyMsgs;
 
-      /// \brief List of pose message to process.
-      public: PoseMsgs_M poseMsgs;
+      /// \brief Latest poses received from the transport threads, not yet
+      /// taken by PreRender. Protected by poseMsgMutex.
+      public: PoseBuffer pendingPoses;
+
+      /// \brief Poses taken from pendingPoses in the current frame. Only
+      /// used by the rendering thread.
+      public: PoseBuffer incomingPoses;
+
+      /// \brief Poses that could not be applied yet, because their visual
+      /// doesn't exist yet or is being moved by the user. Only used by the
+      /// rendering thread.
+      public: PoseBuffer heldPoses;
+
+      /// \brief Id indexed cache of the visuals, which updates the visuals
+      /// map. Only used by the rendering thread.
+      public: VisualTable poseVisuals;
 
       /// \brief List of pose message to process.
       public: LightPoseMsgs_M lightPoseMsgs;
@@ -256,6 +426,10 @@ namespace gazebo
       /// \brief Subscribe to pose updates
       public: transport::SubscriberPtr poseSub;
 
+      /// \brief Decoder for the compact pose stream. Protected by
+      /// poseMsgMutex.
+      public: msgs::PoseStreamDecoder poseDecoder;
+
       /// \brief Subscribe to joint updates.
       public: transport::SubscriberPtr jointSub;
 
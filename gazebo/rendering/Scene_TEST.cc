@@ -403,6 +403,78 @@ TEST_F(Scene_TEST, AddRemoveLights)
 }
 
 
+/////////////////////////////////////////////////
+/// \brief Add a pose to a pose message.
+void AddPose(msgs::PosesStamped &_msg, const uint32_t _id,
+    const ignition::math::Pose3d &_pose)
+{
+  msgs::Pose *p = _msg.add_pose();
+  p->set_id(_id);
+  msgs::Set(p, _pose);
+}
+
+/////////////////////////////////////////////////
+TEST_F(Scene_TEST, PoseUpdates)
+{
+  Load("worlds/empty.world");
+
+  gazebo::rendering::ScenePtr scene = gazebo::rendering::get_scene();
+  ASSERT_TRUE(scene != nullptr);
+
+  // A visual with an id in the range used by physics
+  rendering::VisualPtr visual1;
+  visual1.reset(new rendering::Visual("visual1", scene));
+  visual1->Load();
+  scene->AddVisual(visual1);
+  scene->SetVisualId(visual1, 5000u);
+  EXPECT_EQ(visual1, scene->GetVisual(5000u));
+
+  // A visual that doesn't exist yet, with an id from the rendering range
+  rendering::VisualPtr visual2;
+  visual2.reset(new rendering::Visual("visual2", scene));
+  visual2->Load();
+
+  // Several frames arrive before the next render, only the latest wins
+  const ignition::math::Pose3d latest(1, 2, 3, 0, 0, 0.5);
+  const ignition::math::Pose3d early(4, 5, 6, 0, 0, 0);
+  for (int i = 0; i < 10; ++i)
+  {
+    msgs::PosesStamped msg;
+    AddPose(msg, visual1->GetId(), ignition::math::Pose3d(i, 0, 0, 0, 0, 0));
+    AddPose(msg, visual2->GetId(), early);
+    scene->UpdatePoses(msg);
+  }
+  msgs::PosesStamped msg;
+  AddPose(msg, visual1->GetId(), latest);
+  scene->UpdatePoses(msg);
+
+  event::Events::preRender();
+  EXPECT_EQ(latest, visual1->Pose());
+
+  // The pose of the missing visual is held until the visual is added
+  EXPECT_NE(early, visual2->Pose());
+  scene->AddVisual(visual2);
+  event::Events::preRender();
+  EXPECT_EQ(early, visual2->Pose());
+
+  // A visual whose id changed is looked up under its new id
+  scene->SetVisualId(visual1, 6000u);
+  msg.Clear();
+  AddPose(msg, 6000u, early);
+  scene->UpdatePoses(msg);
+  event::Events::preRender();
+  EXPECT_EQ(early, visual1->Pose());
+
+  // Poses for a removed visual are held, not applied to the old visual
+  scene->RemoveVisual(visual1);
+  EXPECT_TRUE(scene->GetVisual(6000u) == nullptr);
+  msg.Clear();
+  AddPose(msg, 6000u, latest);
+  scene->UpdatePoses(msg);
+  event::Events::preRender();
+  EXPECT_TRUE(scene->GetVisual(6000u) == nullptr);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -16,6 +16,7 @@
 */
 #include <boost/algorithm/string.hpp>
 #include <functional>
+#include <vector>
 #include <ignition/common/Profiler.hh>
 #include <ignition/msgs/Utility.hh>
 
@@ -47,6 +48,30 @@ using namespace sensors;
 
 GZ_REGISTER_STATIC_SENSOR("camera", CameraSensor)
 
+/// \brief Maximum number of image messages kept for reuse.
+static const size_t g_imagePoolSize = 4;
+
+//////////////////////////////////////////////////
+/// \brief Get an image message that nobody else holds.
+/// \param[in,out] _pool Messages kept for reuse.
+/// \return A message from the pool if one is free, a new one otherwise.
+static boost::shared_ptr<msgs::ImageStamped> AcquireImageMessage(
+    std::vector<boost::shared_ptr<msgs::ImageStamped>> &_pool)
+{
+  // A message held only by the pool has been sent and released by all the
+  // subscribers, and can't be shared again meanwhile.
+  for (auto &msg : _pool)
+  {
+    if (msg.use_count() == 1)
+      return msg;
+  }
+
+  boost::shared_ptr<msgs::ImageStamped> msg(new msgs::ImageStamped);
+  if (_pool.size() < g_imagePoolSize)
+    _pool.push_back(msg);
+  return msg;
+}
+
 //////////////////////////////////////////////////
 CameraSensor::CameraSensor()
 : Sensor(sensors::IMAGE),
@@ -343,43 +368,45 @@ bool CameraSensor::UpdateImpl(const bool /*_force*/)
       this->imagePubIgn.HasConnections())
   {
     auto simTime = this->scene->SimTime();
-    if (this->imagePub && this->imagePub->HasConnections())
-    {
-      msgs::ImageStamped msg;
-      msgs::Set(msg.mutable_time(), simTime);
-      msg.mutable_image()->set_width(this->camera->ImageWidth());
-      msg.mutable_image()->set_height(this->camera->ImageHeight());
-      msg.mutable_image()->set_pixel_format(common::Image::ConvertPixelFormat(
-            this->camera->ImageFormat()));
-
-      msg.mutable_image()->set_step(this->camera->ImageWidth() *
-          this->camera->ImageDepth());
-      msg.mutable_image()->set_data(this->camera->ImageData(),
-          msg.image().width() * this->camera->ImageDepth() *
-          msg.image().height());
-
-      this->imagePub->Publish(msg);
-    }
 
+    // Copy the frame once, into a pooled message that the gazebo transport
+    // publishes without copying it again.
+    auto msg = AcquireImageMessage(this->dataPtr->imagePool);
+    msgs::Set(msg->mutable_time(), simTime);
+    msg->mutable_image()->set_width(this->camera->ImageWidth());
+    msg->mutable_image()->set_height(this->camera->ImageHeight());
+    msg->mutable_image()->set_pixel_format(common::Image::ConvertPixelFormat(
+          this->camera->ImageFormat()));
+
+    msg->mutable_image()->set_step(this->camera->ImageWidth() *
+        this->camera->ImageDepth());
+    msg->mutable_image()->mutable_data()->assign(
+        reinterpret_cast<const char *>(this->camera->ImageData()),
+        msg->image().width() * this->camera->ImageDepth() *
+        msg->image().height());
+
+    // The ignition transport doesn't keep the message after Publish
+    // returns, so it borrows the pixels of the gazebo message. This must be
+    // done before the gazebo message is shared.
     if (this->imagePubIgn.HasConnections())
     {
-      ignition::msgs::Image msg;
-      msg.mutable_header()->mutable_stamp()->set_sec(simTime.sec);
-      msg.mutable_header()->mutable_stamp()->set_nsec(simTime.nsec);
+      ignition::msgs::Image &msgIgn = this->dataPtr->imageMsgIgn;
+      msgIgn.mutable_header()->mutable_stamp()->set_sec(simTime.sec);
+      msgIgn.mutable_header()->mutable_stamp()->set_nsec(simTime.nsec);
 
-      msg.set_width(this->camera->ImageWidth());
-      msg.set_height(this->camera->ImageHeight());
-      msg.set_pixel_format_type(ignition::msgs::ConvertPixelFormatType(
+      msgIgn.set_width(msg->image().width());
+      msgIgn.set_height(msg->image().height());
+      msgIgn.set_pixel_format_type(ignition::msgs::ConvertPixelFormatType(
             this->camera->ImageFormat()));
 
-      msg.set_step(this->camera->ImageWidth() *
-          this->camera->ImageDepth());
-      msg.set_data(this->camera->ImageData(),
-          msg.width() * this->camera->ImageDepth() *
-          msg.height());
-
-      this->imagePubIgn.Publish(msg);
+      msgIgn.set_step(msg->image().step());
+      msgIgn.mutable_data()->swap(*msg->mutable_image()->mutable_data());
+      this->imagePubIgn.Publish(msgIgn);
+      msgIgn.mutable_data()->swap(*msg->mutable_image()->mutable_data());
     }
+
+    if (this->imagePub && this->imagePub->HasConnections())
+      this->imagePub->PublishShared(msg);
   }
 
   this->dataPtr->rendered = false;
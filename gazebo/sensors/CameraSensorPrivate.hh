@@ -18,6 +18,12 @@
 #define GAZEBO_SENSORS_CAMERASENSOR_PRIVATE_HH_
 
 #include <limits>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+#include <ignition/msgs/image.pb.h>
+
+#include "gazebo/msgs/msgs.hh"
 
 namespace gazebo
 {
@@ -36,6 +42,14 @@ namespace gazebo
       /// \brief Timestamp of the forthcoming rendering
       public: double nextRenderingTime
                            = std::numeric_limits<double>::quiet_NaN();
+
+      /// \brief Image messages published on the gazebo transport. A message
+      /// is reused, along with its pixel buffer, once no subscriber holds it.
+      public: std::vector<boost::shared_ptr<msgs::ImageStamped>> imagePool;
+
+      /// \brief Image message published on the ignition transport. Its
+      /// pixels are borrowed from the gazebo message while publishing.
+      public: ignition::msgs::Image imageMsgIgn;
     };
   }
 }
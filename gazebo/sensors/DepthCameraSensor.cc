@@ -14,10 +14,14 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
 #include <functional>
+#include <string>
+#include <vector>
 
 #include "ignition/common/Profiler.hh"
 
+#include "gazebo/common/CommonIface.hh"
 #include "gazebo/physics/World.hh"
 
 #include "gazebo/rendering/DepthCamera.hh"
@@ -37,6 +41,30 @@ using namespace sensors;
 
 GZ_REGISTER_STATIC_SENSOR("depth", DepthCameraSensor)
 
+/// \brief Maximum number of point cloud messages kept for reuse.
+static const size_t g_pointCloudPoolSize = 4;
+
+//////////////////////////////////////////////////
+/// \brief Get a point cloud message that nobody else holds.
+/// \param[in,out] _pool Messages kept for reuse.
+/// \return A message from the pool if one is free, a new one otherwise.
+static boost::shared_ptr<msgs::PointCloudPacked> AcquirePointCloudMessage(
+    std::vector<boost::shared_ptr<msgs::PointCloudPacked>> &_pool)
+{
+  // The publisher keeps the last message it sent, so the pool rotates
+  // through the messages that only it holds.
+  for (auto &msg : _pool)
+  {
+    if (msg.use_count() == 1)
+      return msg;
+  }
+
+  boost::shared_ptr<msgs::PointCloudPacked> msg(new msgs::PointCloudPacked);
+  if (_pool.size() < g_pointCloudPoolSize)
+    _pool.push_back(msg);
+  return msg;
+}
+
 //////////////////////////////////////////////////
 DepthCameraSensor::DepthCameraSensor()
     : CameraSensor(),
@@ -47,6 +75,8 @@ DepthCameraSensor::DepthCameraSensor()
 //////////////////////////////////////////////////
 DepthCameraSensor::~DepthCameraSensor()
 {
+  this->StopPointCloud();
+
   if (this->dataPtr->depthBuffer)
     delete [] this->dataPtr->depthBuffer;
 }
@@ -55,6 +85,10 @@ DepthCameraSensor::~DepthCameraSensor()
 void DepthCameraSensor::Load(const std::string &_worldName)
 {
   CameraSensor::Load(_worldName);
+
+  this->dataPtr->pointCloudPub =
+      this->node->Advertise<msgs::PointCloudPacked>(this->PointCloudTopic(),
+      50);
 }
 
 //////////////////////////////////////////////////
@@ -118,6 +152,21 @@ void DepthCameraSensor::Init()
         this->dataPtr->depthCamera);
 
     GZ_ASSERT(this->camera, "Unable to cast depth camera to camera");
+
+    this->dataPtr->pointCloud.SetCamera(this->camera->ImageWidth(),
+        this->camera->ImageHeight(), this->camera->HFOV().Radian());
+    this->dataPtr->pointCloud.SetClip(this->camera->NearClip(),
+        this->camera->FarClip());
+
+    // The sensor may be initialized again after Fini stopped the thread.
+    this->StopPointCloud();
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->pointCloudMutex);
+      this->dataPtr->pointCloudStop = false;
+      this->dataPtr->depthPending = false;
+    }
+    this->dataPtr->pointCloudThread =
+        std::thread(&DepthCameraSensor::RunPointCloud, this);
   }
   else
   {
@@ -188,6 +237,23 @@ bool DepthCameraSensor::UpdateImpl(const bool /*_force*/)
     this->imagePub->Publish(msg);
   }
 
+  // Hand the depth image over to the point cloud thread, replacing the
+  // previous one if it hasn't been converted yet.
+  if (this->dataPtr->pointCloudPub &&
+      this->dataPtr->pointCloudPub->HasConnections() &&
+      this->dataPtr->depthCamera->DepthData())
+  {
+    const float *depth = this->dataPtr->depthCamera->DepthData();
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->pointCloudMutex);
+      this->dataPtr->pendingDepth.assign(depth,
+          depth + this->camera->ImageWidth() * this->camera->ImageHeight());
+      this->dataPtr->pendingTime = this->scene->SimTime();
+      this->dataPtr->depthPending = true;
+    }
+    this->dataPtr->pointCloudCondition.notify_one();
+  }
+
   this->SetRendered(false);
   IGN_PROFILE_END();
   return true;
@@ -204,3 +270,88 @@ rendering::DepthCameraPtr DepthCameraSensor::DepthCamera() const
 {
   return this->dataPtr->depthCamera;
 }
+
+//////////////////////////////////////////////////
+void DepthCameraSensor::Fini()
+{
+  this->StopPointCloud();
+  this->dataPtr->pointCloudPub.reset();
+
+  CameraSensor::Fini();
+}
+
+//////////////////////////////////////////////////
+std::string DepthCameraSensor::PointCloudTopic() const
+{
+  std::string topicName = "~/";
+  topicName += this->ParentName() + "/" + this->Name() + "/points";
+  common::replaceAll(topicName, topicName, "::", "/");
+
+  return topicName;
+}
+
+//////////////////////////////////////////////////
+void DepthCameraSensor::SetPointCloudVoxelSize(const double _size)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->pointCloudMutex);
+  this->dataPtr->voxelSize = std::max(0.0, _size);
+}
+
+//////////////////////////////////////////////////
+double DepthCameraSensor::PointCloudVoxelSize() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->pointCloudMutex);
+  return this->dataPtr->voxelSize;
+}
+
+//////////////////////////////////////////////////
+void DepthCameraSensor::RunPointCloud()
+{
+  std::vector<float> depth;
+  common::Time time;
+
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(this->dataPtr->pointCloudMutex);
+      this->dataPtr->pointCloudCondition.wait(lock, [this]
+      {
+        return this->dataPtr->pointCloudStop || this->dataPtr->depthPending;
+      });
+
+      if (this->dataPtr->pointCloudStop)
+        break;
+
+      // Swap the buffers, so that neither thread allocates.
+      depth.swap(this->dataPtr->pendingDepth);
+      time = this->dataPtr->pendingTime;
+      this->dataPtr->depthPending = false;
+      this->dataPtr->pointCloud.SetVoxelSize(this->dataPtr->voxelSize);
+    }
+
+    if (depth.size() != static_cast<size_t>(
+        this->dataPtr->pointCloud.Width() * this->dataPtr->pointCloud.Height()))
+    {
+      continue;
+    }
+
+    // Reuse a message, and its buffer, once subscribers released it.
+    auto msg = AcquirePointCloudMessage(this->dataPtr->pointCloudPool);
+    this->dataPtr->pointCloud.Project(depth.data(), *msg);
+    msgs::Set(msg->mutable_time(), time);
+    this->dataPtr->pointCloudPub->PublishShared(msg);
+  }
+}
+
+//////////////////////////////////////////////////
+void DepthCameraSensor::StopPointCloud()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->pointCloudMutex);
+    this->dataPtr->pointCloudStop = true;
+  }
+  this->dataPtr->pointCloudCondition.notify_all();
+
+  if (this->dataPtr->pointCloudThread.joinable())
+    this->dataPtr->pointCloudThread.join();
+}
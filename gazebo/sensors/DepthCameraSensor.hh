@@ -59,6 +59,23 @@ namespace gazebo
       /// \return Depth Camera pointer
       public: virtual rendering::DepthCameraPtr DepthCamera() const;
 
+      /// \brief Get the topic on which point clouds are published, as
+      /// msgs::PointCloudPacked in the camera frame. Point clouds are only
+      /// computed while this topic has subscribers, on a thread of their
+      /// own.
+      /// \return Name of the topic.
+      public: std::string PointCloudTopic() const;
+
+      /// \brief Set the size of the voxels used to downsample the point
+      /// clouds. Each occupied voxel yields the centroid of its points.
+      /// \param[in] _size Size in meters, zero to disable downsampling.
+      public: void SetPointCloudVoxelSize(const double _size);
+
+      /// \brief Get the size of the voxels used to downsample the point
+      /// clouds.
+      /// \return Size in meters, zero if downsampling is disabled.
+      public: double PointCloudVoxelSize() const;
+
       /// \brief Load the sensor with default parameters
       /// \param[in] _worldName Name of world to load from
       protected: virtual void Load(const std::string &_worldName);
@@ -66,6 +83,16 @@ namespace gazebo
       // Documentation inherited
       protected: virtual bool UpdateImpl(const bool _force);
 
+      // Documentation inherited
+      protected: virtual void Fini();
+
+      /// \brief Convert the pending depth images into point clouds and
+      /// publish them, until stopped.
+      private: void RunPointCloud();
+
+      /// \brief Stop the point cloud thread.
+      private: void StopPointCloud();
+
       /// \internal
       /// \brief Private data pointer
       private: std::unique_ptr<DepthCameraSensorPrivate> dataPtr;
@@ -17,7 +17,18 @@
 #ifndef _GAZEBO_SENSORS_DEPTHCAMERASENSOR_PRIVATE_HH_
 #define _GAZEBO_SENSORS_DEPTHCAMERASENSOR_PRIVATE_HH_
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/msgs/msgs.hh"
 #include "gazebo/rendering/RenderTypes.hh"
+#include "gazebo/sensors/DepthPointCloud.hh"
+#include "gazebo/transport/TransportTypes.hh"
 
 namespace gazebo
 {
@@ -32,6 +43,42 @@ namespace gazebo
 
       /// \brief Local pointer to the depthCamera.
       public: rendering::DepthCameraPtr depthCamera;
+
+      /// \brief Publisher of point clouds.
+      public: transport::PublisherPtr pointCloudPub;
+
+      /// \brief Converts depth images into point clouds, on pointCloudThread.
+      public: DepthPointCloud pointCloud;
+
+      /// \brief Thread that produces and publishes the point clouds.
+      public: std::thread pointCloudThread;
+
+      /// \brief Protects the members shared with pointCloudThread.
+      public: std::mutex pointCloudMutex;
+
+      /// \brief Signaled when a depth image is pending or the thread must
+      /// stop.
+      public: std::condition_variable pointCloudCondition;
+
+      /// \brief Latest depth image not yet converted. A newer image
+      /// replaces it.
+      public: std::vector<float> pendingDepth;
+
+      /// \brief Time of the pending depth image.
+      public: common::Time pendingTime;
+
+      /// \brief True if pendingDepth holds an image.
+      public: bool depthPending = false;
+
+      /// \brief True when pointCloudThread must stop.
+      public: bool pointCloudStop = false;
+
+      /// \brief Size of the voxels used to downsample the point clouds.
+      public: double voxelSize = 0;
+
+      /// \brief Point cloud messages, reused once subscribers release them.
+      public: std::vector<boost::shared_ptr<msgs::PointCloudPacked>>
+              pointCloudPool;
     };
   }
 }
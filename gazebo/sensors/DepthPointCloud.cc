@@ -0,0 +1,277 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <ignition/math/Helpers.hh>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/sensors/DepthPointCloud.hh"
+
+using namespace gazebo;
+using namespace sensors;
+
+/// \brief Sum of the points that fall in a voxel.
+struct VoxelSum
+{
+  /// \brief Sum of the X coordinates.
+  double x = 0;
+
+  /// \brief Sum of the Y coordinates.
+  double y = 0;
+
+  /// \brief Sum of the Z coordinates.
+  double z = 0;
+
+  /// \brief Number of points.
+  unsigned int count = 0;
+};
+
+/// \brief Private data for the DepthPointCloud class.
+class gazebo::sensors::DepthPointCloudPrivate
+{
+  /// \brief Image width.
+  public: unsigned int width = 0;
+
+  /// \brief Image height.
+  public: unsigned int height = 0;
+
+  /// \brief Y coordinate of the ray of each pixel, whose X is 1.
+  public: std::vector<float> rayY;
+
+  /// \brief Z coordinate of the ray of each pixel, whose X is 1.
+  public: std::vector<float> rayZ;
+
+  /// \brief Smallest valid depth.
+  public: float nearClip = 0;
+
+  /// \brief Largest valid depth.
+  public: float farClip = std::numeric_limits<float>::max();
+
+  /// \brief Size of the voxels, zero if downsampling is disabled.
+  public: double voxelSize = 0;
+
+  /// \brief Index in voxelSums of each occupied voxel. Kept between frames
+  /// to reuse its buckets.
+  public: std::unordered_map<uint64_t, unsigned int> voxelIndex;
+
+  /// \brief Sums of the occupied voxels.
+  public: std::vector<VoxelSum> voxelSums;
+};
+
+//////////////////////////////////////////////////
+/// \brief Get the key of the voxel containing a point.
+/// \param[in] _x X coordinate, in voxels.
+/// \param[in] _y Y coordinate, in voxels.
+/// \param[in] _z Z coordinate, in voxels.
+/// \return 21 bits per coordinate, enough for a million voxels each way.
+static uint64_t VoxelKey(const double _x, const double _y, const double _z)
+{
+  const int64_t offset = 1 << 20;
+  const uint64_t mask = (1 << 21) - 1;
+  return
+      (static_cast<uint64_t>(static_cast<int64_t>(std::floor(_x)) + offset)
+       & mask) << 42 |
+      (static_cast<uint64_t>(static_cast<int64_t>(std::floor(_y)) + offset)
+       & mask) << 21 |
+      (static_cast<uint64_t>(static_cast<int64_t>(std::floor(_z)) + offset)
+       & mask);
+}
+
+//////////////////////////////////////////////////
+DepthPointCloud::DepthPointCloud()
+  : dataPtr(new DepthPointCloudPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+DepthPointCloud::~DepthPointCloud()
+{
+}
+
+//////////////////////////////////////////////////
+void DepthPointCloud::SetCamera(const unsigned int _width,
+    const unsigned int _height, const double _hfov)
+{
+  if (_width == 0 || _height == 0 || _hfov <= 0 || _hfov >= IGN_PI)
+  {
+    gzerr << "Invalid camera [" << _width << "x" << _height
+          << ", hfov " << _hfov << "]\n";
+    return;
+  }
+
+  this->dataPtr->width = _width;
+  this->dataPtr->height = _height;
+
+  // Rays through the center of each pixel, at unit distance along the
+  // optical axis. Columns go right and rows go down, while Y is left and Z
+  // is up.
+  const double focal = 0.5 * _width / std::tan(0.5 * _hfov);
+  const double cx = 0.5 * _width;
+  const double cy = 0.5 * _height;
+
+  this->dataPtr->rayY.resize(_width * _height);
+  this->dataPtr->rayZ.resize(_width * _height);
+  for (unsigned int v = 0; v < _height; ++v)
+  {
+    const float z = static_cast<float>((cy - (v + 0.5)) / focal);
+    for (unsigned int u = 0; u < _width; ++u)
+    {
+      this->dataPtr->rayY[v * _width + u] =
+          static_cast<float>((cx - (u + 0.5)) / focal);
+      this->dataPtr->rayZ[v * _width + u] = z;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+unsigned int DepthPointCloud::Width() const
+{
+  return this->dataPtr->width;
+}
+
+//////////////////////////////////////////////////
+unsigned int DepthPointCloud::Height() const
+{
+  return this->dataPtr->height;
+}
+
+//////////////////////////////////////////////////
+void DepthPointCloud::SetClip(const double _near, const double _far)
+{
+  this->dataPtr->nearClip = static_cast<float>(_near);
+  this->dataPtr->farClip = static_cast<float>(
+      std::min(_far, static_cast<double>(std::numeric_limits<float>::max())));
+}
+
+//////////////////////////////////////////////////
+void DepthPointCloud::SetVoxelSize(const double _size)
+{
+  this->dataPtr->voxelSize = std::max(0.0, _size);
+}
+
+//////////////////////////////////////////////////
+double DepthPointCloud::VoxelSize() const
+{
+  return this->dataPtr->voxelSize;
+}
+
+//////////////////////////////////////////////////
+unsigned int DepthPointCloud::Project(const float *_depth,
+    msgs::PointCloudPacked &_msg)
+{
+  const unsigned int pixelCount = this->dataPtr->width * this->dataPtr->height;
+  const unsigned int pointStep = 3 * sizeof(float);
+
+  if (_msg.field_size() != 3)
+  {
+    _msg.clear_field();
+    const char *names[] = {"x", "y", "z"};
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      auto field = _msg.add_field();
+      field->set_name(names[i]);
+      field->set_offset(i * sizeof(float));
+      field->set_datatype(msgs::PointCloudPacked::Field::FLOAT32);
+      field->set_count(1);
+    }
+  }
+  _msg.set_height(1);
+  _msg.set_point_step(pointStep);
+  _msg.set_is_bigendian(false);
+  _msg.set_is_dense(true);
+
+  std::string *data = _msg.mutable_data();
+  data->resize(static_cast<size_t>(pixelCount) * pointStep);
+
+  unsigned int count = 0;
+  if (_depth && pixelCount > 0)
+  {
+    const float nearClip = this->dataPtr->nearClip;
+    const float farClip = this->dataPtr->farClip;
+    const float *rayY = this->dataPtr->rayY.data();
+    const float *rayZ = this->dataPtr->rayZ.data();
+    float *out = reinterpret_cast<float *>(&(*data)[0]);
+
+    if (this->dataPtr->voxelSize <= 0)
+    {
+      // NaN fails both comparisons, and infinite depths fail one of them.
+      for (unsigned int i = 0; i < pixelCount; ++i)
+      {
+        const float d = _depth[i];
+        if (!(d > nearClip && d < farClip))
+          continue;
+
+        out[0] = d;
+        out[1] = d * rayY[i];
+        out[2] = d * rayZ[i];
+        out += 3;
+        ++count;
+      }
+    }
+    else
+    {
+      const double scale = 1.0 / this->dataPtr->voxelSize;
+      auto &voxelIndex = this->dataPtr->voxelIndex;
+      auto &voxelSums = this->dataPtr->voxelSums;
+      voxelIndex.clear();
+      voxelSums.clear();
+
+      for (unsigned int i = 0; i < pixelCount; ++i)
+      {
+        const float d = _depth[i];
+        if (!(d > nearClip && d < farClip))
+          continue;
+
+        const float y = d * rayY[i];
+        const float z = d * rayZ[i];
+        auto inserted = voxelIndex.emplace(
+            VoxelKey(d * scale, y * scale, z * scale), voxelSums.size());
+        if (inserted.second)
+          voxelSums.emplace_back();
+
+        VoxelSum &sum = voxelSums[inserted.first->second];
+        sum.x += d;
+        sum.y += y;
+        sum.z += z;
+        ++sum.count;
+      }
+
+      for (const auto &sum : voxelSums)
+      {
+        out[0] = static_cast<float>(sum.x / sum.count);
+        out[1] = static_cast<float>(sum.y / sum.count);
+        out[2] = static_cast<float>(sum.z / sum.count);
+        out += 3;
+      }
+      count = voxelSums.size();
+    }
+  }
+
+  // Shrinking keeps the capacity of the buffer for the next frame.
+  data->resize(static_cast<size_t>(count) * pointStep);
+  _msg.set_width(count);
+  _msg.set_row_step(count * pointStep);
+
+  return count;
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_SENSORS_DEPTHPOINTCLOUD_HH_
+#define GAZEBO_SENSORS_DEPTHPOINTCLOUD_HH_
+
+#include <memory>
+
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace sensors
+  {
+    // Forward declare private data class
+    class DepthPointCloudPrivate;
+
+    /// \addtogroup gazebo_sensors
+    /// \{
+
+    /// \class DepthPointCloud DepthPointCloud.hh sensors/sensors.hh
+    /// \brief Convert depth images into point clouds.
+    ///
+    /// The ray of each pixel of a pinhole camera is computed once, when the
+    /// camera is set, so projecting a depth image is a multiplication per
+    /// coordinate. Depths are distances along the optical axis, as produced
+    /// by rendering::DepthCamera. Points are expressed in the camera frame,
+    /// with X forward, Y left and Z up, and are packed as three FLOAT32
+    /// fields named x, y and z.
+    ///
+    /// Depths outside of the clip range, infinite or NaN are skipped. The
+    /// points may be downsampled by keeping the centroid of the points that
+    /// fall in each cell of a voxel grid.
+    class GZ_SENSORS_VISIBLE DepthPointCloud
+    {
+      /// \brief Constructor.
+      public: DepthPointCloud();
+
+      /// \brief Destructor.
+      public: virtual ~DepthPointCloud();
+
+      /// \brief Set the camera model.
+      /// \param[in] _width Image width in pixels.
+      /// \param[in] _height Image height in pixels.
+      /// \param[in] _hfov Horizontal field of view in radians. The pixels
+      /// are square.
+      public: void SetCamera(const unsigned int _width,
+                             const unsigned int _height, const double _hfov);
+
+      /// \brief Get the image width.
+      /// \return Width in pixels.
+      public: unsigned int Width() const;
+
+      /// \brief Get the image height.
+      /// \return Height in pixels.
+      public: unsigned int Height() const;
+
+      /// \brief Set the range of valid depths.
+      /// \param[in] _near Depths below this value are skipped.
+      /// \param[in] _far Depths above this value are skipped.
+      public: void SetClip(const double _near, const double _far);
+
+      /// \brief Set the size of the cells of the downsampling grid.
+      /// \param[in] _size Size in meters, zero to disable downsampling.
+      public: void SetVoxelSize(const double _size);
+
+      /// \brief Get the size of the cells of the downsampling grid.
+      /// \return Size in meters, zero if downsampling is disabled.
+      public: double VoxelSize() const;
+
+      /// \brief Project a depth image.
+      /// \param[in] _depth Width() * Height() depths, row by row.
+      /// \param[out] _msg Unorganized point cloud. Its buffer is reused.
+      /// \return Number of points.
+      public: unsigned int Project(const float *_depth,
+                                   msgs::PointCloudPacked &_msg);
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<DepthPointCloudPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
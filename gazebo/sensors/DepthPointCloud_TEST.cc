@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <ignition/math/Helpers.hh>
+
+#include "gazebo/sensors/DepthPointCloud.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class DepthPointCloudTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Get a point of a packed point cloud.
+/// \param[in] _msg Point cloud.
+/// \param[in] _index Index of the point.
+/// \return Pointer to the x, y and z coordinates.
+const float *Point(const msgs::PointCloudPacked &_msg,
+    const unsigned int _index)
+{
+  return reinterpret_cast<const float *>(_msg.data().data()) + 3 * _index;
+}
+
+/////////////////////////////////////////////////
+TEST_F(DepthPointCloudTest, Project)
+{
+  sensors::DepthPointCloud pointCloud;
+  pointCloud.SetCamera(4, 2, IGN_PI * 0.5);
+  pointCloud.SetClip(0.1, 10);
+  EXPECT_EQ(pointCloud.Width(), 4u);
+  EXPECT_EQ(pointCloud.Height(), 2u);
+  EXPECT_DOUBLE_EQ(pointCloud.VoxelSize(), 0.0);
+
+  // Pixels outside of the clip range are skipped
+  std::vector<float> depth(8, 2.0f);
+  depth[0] = std::numeric_limits<float>::quiet_NaN();
+  depth[1] = std::numeric_limits<float>::infinity();
+  depth[2] = 0.05f;
+  depth[3] = 20.0f;
+
+  msgs::PointCloudPacked msg;
+  EXPECT_EQ(pointCloud.Project(depth.data(), msg), 4u);
+
+  ASSERT_EQ(msg.field_size(), 3);
+  EXPECT_EQ(msg.field(0).name(), "x");
+  EXPECT_EQ(msg.field(1).offset(), 4u);
+  EXPECT_EQ(msg.field(2).datatype(), msgs::PointCloudPacked::Field::FLOAT32);
+  EXPECT_EQ(msg.height(), 1u);
+  EXPECT_EQ(msg.width(), 4u);
+  EXPECT_EQ(msg.point_step(), 12u);
+  EXPECT_EQ(msg.row_step(), 48u);
+  ASSERT_EQ(msg.data().size(), 48u);
+
+  // The second row is below the optical axis, and columns go from left to
+  // right. With a 90 degrees field of view, the focal length is 2 pixels.
+  const float expectedY[] = {1.5f, 0.5f, -0.5f, -1.5f};
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    EXPECT_FLOAT_EQ(Point(msg, i)[0], 2.0f);
+    EXPECT_FLOAT_EQ(Point(msg, i)[1], expectedY[i]);
+    EXPECT_FLOAT_EQ(Point(msg, i)[2], -0.5f);
+  }
+
+  // A missing image yields an empty cloud
+  EXPECT_EQ(pointCloud.Project(nullptr, msg), 0u);
+  EXPECT_EQ(msg.width(), 0u);
+  EXPECT_TRUE(msg.data().empty());
+}
+
+/////////////////////////////////////////////////
+TEST_F(DepthPointCloudTest, VoxelGrid)
+{
+  sensors::DepthPointCloud pointCloud;
+  pointCloud.SetCamera(64, 48, 1.047);
+  pointCloud.SetClip(0.1, 100);
+
+  // A wall parallel to the image plane
+  std::vector<float> depth(64 * 48, 5.0f);
+  msgs::PointCloudPacked msg;
+  EXPECT_EQ(pointCloud.Project(depth.data(), msg), 64u * 48u);
+
+  // Larger voxels keep fewer points
+  pointCloud.SetVoxelSize(0.5);
+  EXPECT_DOUBLE_EQ(pointCloud.VoxelSize(), 0.5);
+  unsigned int count = pointCloud.Project(depth.data(), msg);
+  EXPECT_GT(count, 0u);
+  EXPECT_LT(count, 64u * 48u);
+
+  pointCloud.SetVoxelSize(2.0);
+  unsigned int coarseCount = pointCloud.Project(depth.data(), msg);
+  EXPECT_GT(coarseCount, 0u);
+  EXPECT_LT(coarseCount, count);
+
+  // Centroids stay on the wall
+  for (unsigned int i = 0; i < coarseCount; ++i)
+    EXPECT_FLOAT_EQ(Point(msg, i)[0], 5.0f);
+
+  // Negative sizes disable downsampling
+  pointCloud.SetVoxelSize(-1);
+  EXPECT_DOUBLE_EQ(pointCloud.VoxelSize(), 0.0);
+  EXPECT_EQ(pointCloud.Project(depth.data(), msg), 64u * 48u);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
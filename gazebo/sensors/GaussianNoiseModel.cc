@@ -148,9 +148,42 @@ void GaussianNoiseModel::Fini()
 double GaussianNoiseModel::ApplyImpl(double _in, double _dt)
 {
   // Add independent (uncorrelated) Gaussian noise to each input value.
-  double whiteNoise = ignition::math::Rand::DblNormal(this->mean, this->stdDev);
+  double whiteNoise = this->SampleNormal(this->mean, this->stdDev);
 
   // Generate varying (correlated) bias for each input value.
+  this->UpdateDynamicBias(_dt);
+
+  double output = _in + this->bias + whiteNoise;
+  if (this->quantized)
+  {
+    // Apply this->precision
+    if (!ignition::math::equal(this->precision, 0.0, 1e-6))
+    {
+      output = std::round(output / this->precision) * this->precision;
+    }
+  }
+  return output;
+}
+
+//////////////////////////////////////////////////
+void GaussianNoiseModel::ApplyBatch(double *_data, const size_t _count,
+    const double _dt)
+{
+  // The values are sampled at the same time, they share the bias
+  this->UpdateDynamicBias(_dt);
+  this->AddNormal(_data, _count, this->mean + this->bias, this->stdDev);
+
+  if (this->quantized &&
+      !ignition::math::equal(this->precision, 0.0, 1e-6))
+  {
+    for (size_t i = 0; i < _count; ++i)
+      _data[i] = std::round(_data[i] / this->precision) * this->precision;
+  }
+}
+
+//////////////////////////////////////////////////
+void GaussianNoiseModel::UpdateDynamicBias(const double _dt)
+{
   // This implementation is based on the one available in Rotors:
   // https://github.com/ethz-asl/rotors_simulator/blob/master/rotors_gazebo_plugins/src/gazebo_imu_plugin.cpp
   //
@@ -168,20 +201,8 @@ double GaussianNoiseModel::ApplyImpl(double _in, double _dt)
         tau / 2 * expm1(-2 * _dt / tau));
 
     const double phiD = exp(-_dt / tau);
-    this->bias = phiD * this->bias +
-      ignition::math::Rand::DblNormal(0, sigmaBD);
-  }
-
-  double output = _in + this->bias + whiteNoise;
-  if (this->quantized)
-  {
-    // Apply this->precision
-    if (!ignition::math::equal(this->precision, 0.0, 1e-6))
-    {
-      output = std::round(output / this->precision) * this->precision;
-    }
+    this->bias = phiD * this->bias + this->SampleNormal(0, sigmaBD);
   }
-  return output;
 }
 
 //////////////////////////////////////////////////
@@ -219,12 +240,11 @@ double GaussianNoiseModel::GetBias() const
 //////////////////////////////////////////////////
 void GaussianNoiseModel::SampleBias()
 {
-  this->bias =
-      ignition::math::Rand::DblNormal(this->biasMean, this->biasStdDev);
+  this->bias = this->SampleNormal(this->biasMean, this->biasStdDev);
   // With equal probability, we pick a negative bias (by convention,
   // rateBiasMean should be positive, though it would work fine if
   // negative).
-  if (ignition::math::Rand::DblUniform() < 0.5)
+  if (this->SampleUniform() < 0.5)
     this->bias = -this->bias;
 }
 
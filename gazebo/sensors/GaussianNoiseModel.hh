@@ -99,6 +99,18 @@ namespace gazebo
         /// \brief Sample the bias.
         private: void SampleBias();
 
+        /// \brief Apply noise to a batch of values sampled at the same
+        /// time, called by Noise::Apply. The values share the bias.
+        /// \param[in,out] _data Values.
+        /// \param[in] _count Number of values.
+        /// \param[in] _dt Time since the previous batch, in seconds.
+        private: void ApplyBatch(double *_data, const size_t _count,
+                     const double _dt);
+
+        /// \brief Advance the dynamic bias by a time step.
+        /// \param[in] _dt Time step in seconds.
+        private: void UpdateDynamicBias(const double _dt);
+
         /// \brief If type starts with GAUSSIAN, the mean of the distribution
         /// from which we sample when adding noise.
         protected: double mean;
@@ -132,6 +144,9 @@ namespace gazebo
         /// \biref If type starts with GAUSSIAN, the correlation time of the
         /// process from which the dynamic bias will be driven.
         private: double dynamicBiasCorrTime;
+
+        /// \brief Noise::Apply calls ApplyBatch.
+        private: friend class Noise;
     };
 
     /// \class GaussianNoiseModel
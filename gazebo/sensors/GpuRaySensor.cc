@@ -745,6 +745,9 @@ bool GpuRaySensor::UpdateImpl(const bool /*_force*/)
     }
   }
 
+  auto noise = this->noises.find(GPU_RAY_NOISE);
+  this->dataPtr->noisyIndices.clear();
+
   auto dataIter = this->dataPtr->laserCam->LaserDataBegin();
   auto dataEnd = this->dataPtr->laserCam->LaserDataEnd();
   for (int i = 0; dataIter != dataEnd; ++dataIter, ++i)
@@ -762,11 +765,9 @@ bool GpuRaySensor::UpdateImpl(const bool /*_force*/)
     {
       range = -ignition::math::INF_D;
     }
-    else if (this->noises.find(GPU_RAY_NOISE) != this->noises.end())
+    else if (noise != this->noises.end() && !ignition::math::isnan(range))
     {
-      range = this->noises[GPU_RAY_NOISE]->Apply(range);
-      range = ignition::math::clamp(range,
-          this->dataPtr->rangeMin, this->dataPtr->rangeMax);
+      this->dataPtr->noisyIndices.push_back(i);
     }
 
     range = ignition::math::isnan(range) ? this->dataPtr->rangeMax : range;
@@ -774,6 +775,24 @@ bool GpuRaySensor::UpdateImpl(const bool /*_force*/)
     scan->set_intensities(i, intensity);
   }
 
+  // Apply noise to the ranges within limits, all at once
+  if (!this->dataPtr->noisyIndices.empty())
+  {
+    const std::vector<int> &indices = this->dataPtr->noisyIndices;
+    std::vector<double> &ranges = this->dataPtr->noisyRanges;
+    ranges.resize(indices.size());
+    for (size_t k = 0; k < indices.size(); ++k)
+      ranges[k] = scan->ranges(indices[k]);
+
+    noise->second->Apply(ranges.data(), ranges.size());
+
+    for (size_t k = 0; k < indices.size(); ++k)
+    {
+      scan->set_ranges(indices[k], ignition::math::clamp(ranges[k],
+          this->dataPtr->rangeMin, this->dataPtr->rangeMax));
+    }
+  }
+
   if (this->dataPtr->scanPub && this->dataPtr->scanPub->HasConnections())
     this->dataPtr->scanPub->Publish(this->dataPtr->laserMsg);
 
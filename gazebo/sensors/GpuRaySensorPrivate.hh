@@ -19,6 +19,7 @@
 
 #include <limits>
 #include <mutex>
+#include <vector>
 #include <sdf/sdf.hh>
 
 #include "gazebo/rendering/RenderTypes.hh"
@@ -79,6 +80,13 @@ namespace gazebo
       /// \brief Laser message to publish data.
       public: msgs::LaserScanStamped laserMsg;
 
+      /// \brief Indices of the ranges of the last scan that noise is
+      /// applied to.
+      public: std::vector<int> noisyIndices;
+
+      /// \brief Ranges that noise is applied to, in one batch.
+      public: std::vector<double> noisyRanges;
+
       /// \brief Parent entity of gpu ray sensor
       public: physics::EntityPtr parentEntity;
 
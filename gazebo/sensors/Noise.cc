@@ -15,16 +15,66 @@
  *
 */
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <typeinfo>
+
 #include <boost/function.hpp>
+#include <ignition/math/Helpers.hh>
+#include <ignition/math/Rand.hh>
+
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
 
 #include "gazebo/sensors/GaussianNoiseModel.hh"
 #include "gazebo/sensors/Noise.hh"
+#include "gazebo/sensors/NoisePrivate.hh"
 
 using namespace gazebo;
 using namespace sensors;
 
+namespace
+{
+  /// \brief Number of normal sample pairs generated per pass of
+  /// Noise::AddNormal.
+  const size_t kNormalPairs = 64;
+
+  //////////////////////////////////////////////////
+  /// \brief Philox4x32-10 block of a counter based random generator, from
+  /// Salmon et al., "Parallel random numbers: as easy as 1, 2, 3", 2011.
+  /// \param[in,out] _x Counter in, random bits out.
+  /// \param[in] _key Key of the stream.
+  inline void Philox(uint32_t _x[4], const uint64_t _key)
+  {
+    uint32_t k0 = static_cast<uint32_t>(_key);
+    uint32_t k1 = static_cast<uint32_t>(_key >> 32);
+    for (int round = 0; round < 10; ++round)
+    {
+      const uint64_t p0 = static_cast<uint64_t>(0xD2511F53u) * _x[0];
+      const uint64_t p1 = static_cast<uint64_t>(0xCD9E8D57u) * _x[2];
+      const uint32_t x0 = static_cast<uint32_t>(p1 >> 32) ^ _x[1] ^ k0;
+      const uint32_t x2 = static_cast<uint32_t>(p0 >> 32) ^ _x[3] ^ k1;
+      _x[1] = static_cast<uint32_t>(p1);
+      _x[3] = static_cast<uint32_t>(p0);
+      _x[0] = x0;
+      _x[2] = x2;
+      k0 += 0x9E3779B9u;
+      k1 += 0xBB67AE85u;
+    }
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Convert 64 random bits to a double in [0, 1).
+  /// \param[in] _hi High bits.
+  /// \param[in] _lo Low bits.
+  /// \return Uniform sample with 53 random bits.
+  inline double Uniform(const uint32_t _hi, const uint32_t _lo)
+  {
+    return ((_hi >> 5) * 67108864.0 + (_lo >> 6)) * (1.0 / 9007199254740992.0);
+  }
+}
+
 //////////////////////////////////////////////////
 NoisePtr NoiseFactory::NewNoiseModel(sdf::ElementPtr _sdf,
     const std::string &_sensorType)
@@ -73,8 +123,15 @@ NoisePtr NoiseFactory::NewNoiseModel(sdf::ElementPtr _sdf,
 
 //////////////////////////////////////////////////
 Noise::Noise(NoiseType _type)
-  : type(_type)
+  : type(_type), dataPtr(new NoisePrivate)
 {
+  const int32_t low = std::numeric_limits<int32_t>::min();
+  const int32_t high = std::numeric_limits<int32_t>::max();
+  uint64_t stream = static_cast<uint32_t>(
+      ignition::math::Rand::IntUniform(low, high));
+  stream = (stream << 32) | static_cast<uint32_t>(
+      ignition::math::Rand::IntUniform(low, high));
+  this->dataPtr->stream = stream;
 }
 
 //////////////////////////////////////////////////
@@ -124,6 +181,104 @@ double Noise::ApplyImpl(double _in, double /*_dt*/)
   return _in;
 }
 
+//////////////////////////////////////////////////
+void Noise::Apply(double *_data, const size_t _count, const double _dt)
+{
+  if (this->type == NONE || _count == 0)
+    return;
+  else if (this->type == CUSTOM)
+  {
+    for (size_t i = 0; i < _count; ++i)
+      _data[i] = this->Apply(_data[i], _dt);
+  }
+  // Only the exact type has a batch path: a class deriving from
+  // GaussianNoiseModel may override ApplyImpl.
+  else if (typeid(*this) == typeid(GaussianNoiseModel))
+  {
+    static_cast<GaussianNoiseModel *>(this)->ApplyBatch(_data, _count, _dt);
+  }
+  else
+  {
+    for (size_t i = 0; i < _count; ++i)
+      _data[i] = this->ApplyImpl(_data[i], _dt);
+  }
+}
+
+//////////////////////////////////////////////////
+void Noise::SetStream(const uint64_t _stream)
+{
+  this->dataPtr->stream = _stream;
+  this->dataPtr->counter = 0;
+}
+
+//////////////////////////////////////////////////
+uint64_t Noise::Stream() const
+{
+  return this->dataPtr->stream;
+}
+
+//////////////////////////////////////////////////
+void Noise::AddNormal(double *_data, const size_t _count,
+    const double _mean, const double _stdDev)
+{
+  // Box-Muller transform, each block of the generator gives a pair of
+  // samples. The generator and the transform run in separate loops
+  // without branches, which compilers can vectorize.
+  double radius[kNormalPairs];
+  double angle[kNormalPairs];
+
+  size_t done = 0;
+  while (done < _count)
+  {
+    const size_t count = std::min(_count - done, 2 * kNormalPairs);
+    const size_t pairs = (count + 1) / 2;
+
+    for (size_t i = 0; i < pairs; ++i)
+    {
+      const uint64_t c = this->dataPtr->counter + i;
+      uint32_t x[4] = {static_cast<uint32_t>(c),
+          static_cast<uint32_t>(c >> 32), 0u, 0u};
+      Philox(x, this->dataPtr->stream);
+
+      // In (0, 1], so the logarithm is finite
+      const double u1 = 1.0 - Uniform(x[0], x[1]);
+      const double u2 = Uniform(x[2], x[3]);
+      radius[i] = _stdDev * std::sqrt(-2.0 * std::log(u1));
+      angle[i] = 2.0 * IGN_PI * u2;
+    }
+    this->dataPtr->counter += pairs;
+
+    double *data = _data + done;
+    for (size_t i = 0; i < count / 2; ++i)
+    {
+      data[2 * i] += _mean + radius[i] * std::cos(angle[i]);
+      data[2 * i + 1] += _mean + radius[i] * std::sin(angle[i]);
+    }
+    if (count % 2)
+      data[count - 1] += _mean + radius[pairs - 1] * std::cos(angle[pairs - 1]);
+
+    done += count;
+  }
+}
+
+//////////////////////////////////////////////////
+double Noise::SampleNormal(const double _mean, const double _stdDev)
+{
+  double sample = 0.0;
+  this->AddNormal(&sample, 1, _mean, _stdDev);
+  return sample;
+}
+
+//////////////////////////////////////////////////
+double Noise::SampleUniform()
+{
+  uint32_t x[4] = {static_cast<uint32_t>(this->dataPtr->counter),
+      static_cast<uint32_t>(this->dataPtr->counter >> 32), 0u, 0u};
+  Philox(x, this->dataPtr->stream);
+  ++this->dataPtr->counter;
+  return Uniform(x[0], x[1]);
+}
+
 //////////////////////////////////////////////////
 Noise::NoiseType Noise::GetNoiseType() const
 {
@@ -18,6 +18,8 @@
 #ifndef _GAZEBO_NOISE_HH_
 #define _GAZEBO_NOISE_HH_
 
+#include <cstdint>
+#include <memory>
 #include <vector>
 #include <string>
 
@@ -32,6 +34,9 @@ namespace gazebo
 {
   namespace sensors
   {
+    // Forward declarations
+    class NoisePrivate;
+
     /// \addtogroup gazebo_sensors
     /// \{
 
@@ -52,6 +57,13 @@ namespace gazebo
 
     /// \class Noise Noise.hh
     /// \brief Noise models for sensor output signals.
+    ///
+    /// Each noise model draws its random samples from its own stream of a
+    /// counter based generator (Philox4x32-10). The stream is picked from
+    /// the global random generator, see ignition::math::Rand::Seed, when the
+    /// noise model is created, or set with SetStream. With a fixed seed, the
+    /// samples of a sensor only depend on the order in which sensors are
+    /// created and on its own calls, not on how sensor threads interleave.
     class GZ_SENSORS_VISIBLE Noise
     {
       /// \brief Which noise types we support
@@ -88,6 +100,25 @@ namespace gazebo
       /// \return Data with noise applied.
       public: virtual double ApplyImpl(double _in, double _dt = 0.0);
 
+      /// \brief Apply noise to a batch of values, in place. The values are
+      /// samples taken at the same time, e.g. the ranges of a scan, so a
+      /// time varying noise model advances by _dt once for the batch.
+      /// GaussianNoiseModel draws the whole batch at once, other noise
+      /// models apply ApplyImpl to each value.
+      /// \param[in,out] _data Values.
+      /// \param[in] _count Number of values.
+      /// \param[in] _dt Time since the previous batch, in seconds.
+      public: void Apply(double *_data, const size_t _count,
+                  const double _dt = 0.0);
+
+      /// \brief Set the random stream of this noise model, and restart it.
+      /// \param[in] _stream Stream identifier.
+      public: void SetStream(const uint64_t _stream);
+
+      /// \brief Get the random stream of this noise model.
+      /// \return Stream identifier.
+      public: uint64_t Stream() const;
+
       /// \brief Finalize the noise model
       public: virtual void Fini();
 
@@ -123,6 +154,27 @@ namespace gazebo
       /// \param[in] _out Output stream
       public: virtual void Print(std::ostream &_out) const;
 
+      /// \brief Add samples of a normal distribution to a batch of values,
+      /// from the random stream of this noise model.
+      /// \param[in,out] _data Values.
+      /// \param[in] _count Number of values.
+      /// \param[in] _mean Mean of the distribution.
+      /// \param[in] _stdDev Standard deviation of the distribution.
+      protected: void AddNormal(double *_data, const size_t _count,
+                     const double _mean, const double _stdDev);
+
+      /// \brief Draw a sample of a normal distribution from the random
+      /// stream of this noise model.
+      /// \param[in] _mean Mean of the distribution.
+      /// \param[in] _stdDev Standard deviation of the distribution.
+      /// \return The sample.
+      protected: double SampleNormal(const double _mean, const double _stdDev);
+
+      /// \brief Draw a sample of the uniform distribution in [0, 1) from the
+      /// random stream of this noise model.
+      /// \return The sample.
+      protected: double SampleUniform();
+
       /// \brief Which type of noise we're applying
       private: NoiseType type;
 
@@ -134,6 +186,10 @@ namespace gazebo
 
       /// \brief Callback function for applying custom noise to sensor data.
       private: std::function<double (double, double)> customNoiseCallbackTime;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<NoisePrivate> dataPtr;
     };
     /// \}
   }
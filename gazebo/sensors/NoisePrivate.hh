@@ -0,0 +1,38 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef _GAZEBO_SENSORS_NOISE_PRIVATE_HH_
+#define _GAZEBO_SENSORS_NOISE_PRIVATE_HH_
+
+#include <cstdint>
+
+namespace gazebo
+{
+  namespace sensors
+  {
+    /// \internal
+    /// \brief Noise private data
+    class NoisePrivate
+    {
+      /// \brief Random stream, the key of the generator.
+      public: uint64_t stream = 0;
+
+      /// \brief Number of blocks drawn from the random stream.
+      public: uint64_t counter = 0;
+    };
+  }
+}
+#endif
@@ -23,6 +23,10 @@
 #include <boost/accumulators/statistics/variance.hpp>
 #include <boost/bind.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 #include <ignition/math/Rand.hh>
 
 #include "gazebo/sensors/Noise.hh"
@@ -373,6 +377,132 @@ TEST_F(NoiseTest, OnApplyNoise)
   }
 }
 
+/// \brief Gaussian noise model that overrides ApplyImpl.
+class OffsetNoiseModel : public sensors::GaussianNoiseModel
+{
+  // Documentation inherited.
+  public: double ApplyImpl(double _in, double /*_dt*/)
+  {
+    return _in + 1.0;
+  }
+};
+
+//////////////////////////////////////////////////
+// Test noise applied to batches of values
+TEST_F(NoiseTest, ApplyBatch)
+{
+  const unsigned int count = 100001;
+
+  // No noise
+  {
+    sensors::NoisePtr noise = sensors::NoiseFactory::NewNoiseModel(
+        NoiseSdf("none", 0, 0, 0, 0, 0));
+    std::vector<double> values(count, 42.0);
+    noise->Apply(values.data(), values.size());
+    for (auto const &value : values)
+      ASSERT_DOUBLE_EQ(42.0, value);
+  }
+
+  // Custom noise goes through the callback
+  {
+    sensors::NoisePtr noise(new sensors::Noise(sensors::Noise::CUSTOM));
+    noise->SetCustomNoiseCallback(boost::bind(&OnApplyCustomNoise, _1));
+    std::vector<double> values = {1.0, 2.0, 3.0};
+    noise->Apply(values.data(), values.size());
+    EXPECT_DOUBLE_EQ(2.0, values[0]);
+    EXPECT_DOUBLE_EQ(4.0, values[1]);
+    EXPECT_DOUBLE_EQ(6.0, values[2]);
+  }
+
+  // Gaussian noise, with the same statistics as the scalar version
+  {
+    const double mean = 10.0;
+    const double stddev = 5.0;
+    sensors::NoisePtr noise = sensors::NoiseFactory::NewNoiseModel(
+        NoiseSdf("gaussian", mean, stddev, 100.0, 0.0, 0));
+    sensors::GaussianNoiseModelPtr gaussianNoise =
+      std::dynamic_pointer_cast<sensors::GaussianNoiseModel>(noise);
+    ASSERT_TRUE(gaussianNoise != nullptr);
+
+    std::vector<double> values(count, 42.0);
+    noise->Apply(values.data(), values.size());
+
+    boost::accumulators::accumulator_set<double,
+      boost::accumulators::stats<boost::accumulators::tag::mean,
+                                 boost::accumulators::tag::variance > > acc;
+    for (auto const &value : values)
+      acc(value);
+
+    double sampleStdDev = g_sigma*stddev / sqrt(count);
+    EXPECT_NEAR(boost::accumulators::mean(acc),
+        42.0 + mean + gaussianNoise->GetBias(), sampleStdDev);
+
+    double variance = stddev*stddev;
+    double sampleVariance2 = 2 * variance*variance / (count - 1);
+    EXPECT_NEAR(boost::accumulators::variance(acc),
+                variance, g_sigma*sqrt(sampleVariance2));
+  }
+
+  // Quantized
+  {
+    const double precision = 0.3;
+    sensors::NoisePtr noise = sensors::NoiseFactory::NewNoiseModel(
+        NoiseSdf("gaussian", 0.0, 1.0, 0.0, 0.0, precision));
+    std::vector<double> values(1000, 0.0);
+    noise->Apply(values.data(), values.size());
+    for (auto const &value : values)
+      ASSERT_DOUBLE_EQ(std::round(value / precision) * precision, value);
+  }
+
+  // A class deriving from GaussianNoiseModel keeps its ApplyImpl
+  {
+    sensors::NoisePtr noise(new OffsetNoiseModel());
+    noise->Load(NoiseSdf("gaussian", 0.0, 1.0, 0.0, 0.0, 0));
+    std::vector<double> values = {1.0, 2.0, 3.0};
+    noise->Apply(values.data(), values.size());
+    EXPECT_DOUBLE_EQ(2.0, values[0]);
+    EXPECT_DOUBLE_EQ(3.0, values[1]);
+    EXPECT_DOUBLE_EQ(4.0, values[2]);
+  }
+}
+
+//////////////////////////////////////////////////
+// Test that each noise model draws from its own stream
+TEST_F(NoiseTest, Streams)
+{
+  sensors::NoisePtr noise1 = sensors::NoiseFactory::NewNoiseModel(
+      NoiseSdf("gaussian", 0.0, 1.0, 0.0, 0.0, 0));
+  sensors::NoisePtr noise2 = sensors::NoiseFactory::NewNoiseModel(
+      NoiseSdf("gaussian", 0.0, 1.0, 0.0, 0.0, 0));
+  EXPECT_NE(noise1->Stream(), noise2->Stream());
+
+  // The same stream gives the same samples, whatever else is drawn from
+  // other streams or from the global generator in between
+  noise1->SetStream(1234u);
+  noise2->SetStream(1234u);
+  EXPECT_EQ(1234u, noise1->Stream());
+
+  std::vector<double> values1(1000, 0.0);
+  std::vector<double> values2(1000, 0.0);
+  noise1->Apply(values1.data(), values1.size());
+  ignition::math::Rand::DblNormal(0, 1);
+  noise2->Apply(values2.data(), values2.size());
+  EXPECT_EQ(values1, values2);
+  EXPECT_DOUBLE_EQ(noise1->Apply(0.0), noise2->Apply(0.0));
+
+  // Restarting a stream repeats it
+  noise2->SetStream(1234u);
+  std::vector<double> values3(1000, 0.0);
+  noise2->Apply(values3.data(), values3.size());
+  EXPECT_EQ(values1, values3);
+
+  // Another stream differs
+  noise2->SetStream(4321u);
+  std::fill(values3.begin(), values3.end(), 0.0);
+  noise2->Apply(values3.data(), values3.size());
+  EXPECT_NE(values1, values3);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -417,6 +417,10 @@ bool RaySensor::UpdateImpl(const bool /*_force*/)
   bool interp =
     ((rayCount != rangeCount) || (verticalRayCount != verticalRangeCount));
 
+  // currently supports only one noise model per laser sensor
+  auto noise = this->noises.find(RAY_NOISE);
+  this->dataPtr->noisyIndices.clear();
+
   // interpolate in vertical direction
   for (unsigned int j = 0; j < verticalRangeCount; ++j)
   {
@@ -487,19 +491,35 @@ bool RaySensor::UpdateImpl(const bool /*_force*/)
       {
         range = -ignition::math::INF_D;
       }
-      else if (this->noises.find(RAY_NOISE) !=
-               this->noises.end())
+      else if (noise != this->noises.end())
       {
-        // currently supports only one noise model per laser sensor
-        range = this->noises[RAY_NOISE]->Apply(range);
-        range = ignition::math::clamp(range,
-            this->RangeMin(), this->RangeMax());
+        this->dataPtr->noisyIndices.push_back(scan->ranges_size());
       }
 
       scan->add_ranges(range);
       scan->add_intensities(intensity);
     }
   }
+
+  // Apply noise to the ranges within limits, all at once
+  if (!this->dataPtr->noisyIndices.empty())
+  {
+    const std::vector<int> &indices = this->dataPtr->noisyIndices;
+    std::vector<double> &ranges = this->dataPtr->noisyRanges;
+    ranges.resize(indices.size());
+    for (size_t k = 0; k < indices.size(); ++k)
+      ranges[k] = scan->ranges(indices[k]);
+
+    noise->second->Apply(ranges.data(), ranges.size());
+
+    const double rangeMin = this->RangeMin();
+    const double rangeMax = this->RangeMax();
+    for (size_t k = 0; k < indices.size(); ++k)
+    {
+      scan->set_ranges(indices[k],
+          ignition::math::clamp(ranges[k], rangeMin, rangeMax));
+    }
+  }
   IGN_PROFILE_END();
 
   IGN_PROFILE_BEGIN("Publish");
@@ -18,6 +18,7 @@
 #define _GAZEBO_SENSORS_RAYSENSOR_PRIVATE_HH_
 
 #include <mutex>
+#include <vector>
 
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
@@ -48,6 +49,13 @@ namespace gazebo
 
       /// \brief Laser message.
       public: msgs::LaserScanStamped laserMsg;
+
+      /// \brief Indices of the ranges of the last scan that noise is
+      /// applied to.
+      public: std::vector<int> noisyIndices;
+
+      /// \brief Ranges that noise is applied to, in one batch.
+      public: std::vector<double> noisyRanges;
     };
   }
 }
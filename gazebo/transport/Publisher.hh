@@ -101,6 +101,16 @@ namespace gazebo
               void Publish(M _message, bool _block = false)
               { this->PublishImpl(_message, _block); }
 
+      /// \brief Publish a message without copying it. The publisher keeps a
+      /// reference to the message until it has been sent, and subscribers in
+      /// this process receive the same message, so it must not be modified
+      /// after the call. A message whose use count is back to one may be
+      /// reused.
+      /// \param[in] _message Message to be published
+      /// \param[in] _block Whether to block until the message is actually
+      /// written into the local message buffer, and SendMessage() is called.
+      public: void PublishShared(MessagePtr _message, bool _block = false);
+
       /// \brief Get the number of outgoing messages
       /// \return The number of outgoing messages
       public: unsigned int GetOutgoingCount() const;
@@ -147,6 +157,19 @@ namespace gazebo
       private: void PublishImpl(const google::protobuf::Message &_message,
                                 bool _block);
 
+      /// \brief Check that a message can be published, and apply the
+      /// throttling rate.
+      /// \param[in] _message Message to be published.
+      /// \return True if the message must be queued.
+      private: bool PrePublish(const google::protobuf::Message &_message);
+
+      /// \brief Queue a message for publication.
+      /// \param[in] _message Message to be published, owned by the
+      /// publisher from now on.
+      /// \param[in] _block Whether to block until the message is actually
+      /// written out.
+      private: void Enqueue(MessagePtr _message, bool _block);
+
       /// \brief Callback when a publish is completed
       /// \param[in] _id ID associated with the publication.
       private: void OnPublishComplete(uint32_t _id);
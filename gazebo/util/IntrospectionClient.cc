@@ -96,6 +96,14 @@ std::set<std::string> IntrospectionClient::Managers() const
 bool IntrospectionClient::NewFilter(const std::string &_managerId,
     const std::set<std::string> &_newItems, std::string &_filterId,
     std::string &_newTopic) const
+{
+  return this->NewFilter(_managerId, _newItems, 1u, _filterId, _newTopic);
+}
+
+//////////////////////////////////////////////////
+bool IntrospectionClient::NewFilter(const std::string &_managerId,
+    const std::set<std::string> &_newItems, const unsigned int _decimation,
+    std::string &_filterId, std::string &_newTopic) const
 {
   if (_newItems.empty())
   {
@@ -117,6 +125,15 @@ bool IntrospectionClient::NewFilter(const std::string &_managerId,
     nextParam->mutable_value()->set_string_value(itemName);
   }
 
+  // Only sent when needed, for compatibility with older managers.
+  if (_decimation > 1)
+  {
+    auto nextParam = req.add_param();
+    nextParam->set_name("decimation");
+    nextParam->mutable_value()->set_type(gazebo::msgs::Any::INT32);
+    nextParam->mutable_value()->set_int_value(_decimation);
+  }
+
   // Request the service.
   auto service = "/introspection/" + _managerId + "/filter_new";
   if (!this->dataPtr->node.Request(service, req,
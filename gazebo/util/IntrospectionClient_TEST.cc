@@ -15,8 +15,10 @@
  *
 */
 
+#include <mutex>
 #include <set>
 #include <string>
+#include <vector>
 #include <ignition/transport.hh>
 #include <gtest/gtest.h>
 #include "gazebo/common/Exception.hh"
@@ -510,6 +512,99 @@ TEST_F(IntrospectionClientTest, Exception)
   EXPECT_TRUE(this->manager->Unregister("item4"));
 }
 
+/////////////////////////////////////////////////
+TEST_F(IntrospectionClientTest, Decimation)
+{
+  // A numeric item sampled on every update and an item that isn't.
+  int counter = 0;
+  std::function<int()> func1 = [&counter]()
+  {
+    return ++counter;
+  };
+  std::function<std::string()> func2 = []()
+  {
+    return std::string("test_string");
+  };
+  EXPECT_TRUE(this->manager->Register<int>("item4", func1));
+  EXPECT_TRUE(this->manager->Register<std::string>("item5", func2));
+
+  // Invalid decimation
+  gazebo::msgs::Param_V req;
+  gazebo::msgs::GzString rep;
+  bool result;
+  auto param = req.add_param();
+  param->set_name("item");
+  param->mutable_value()->set_type(gazebo::msgs::Any::STRING);
+  param->mutable_value()->set_string_value("item4");
+  param = req.add_param();
+  param->set_name("decimation");
+  param->mutable_value()->set_type(gazebo::msgs::Any::INT32);
+  param->mutable_value()->set_int_value(0);
+  ignition::transport::Node node;
+  EXPECT_TRUE(node.Request("/introspection/" + this->managerId +
+      "/filter_new", req, 1000u, rep, result));
+  EXPECT_FALSE(result);
+
+  // Decimation above the limit
+  req.mutable_param(1)->mutable_value()->set_int_value(1001);
+  EXPECT_TRUE(node.Request("/introspection/" + this->managerId +
+      "/filter_new", req, 1000u, rep, result));
+  EXPECT_FALSE(result);
+
+  // Publish every 3 updates.
+  std::set<std::string> items = {"item4", "item5"};
+  std::string filterId;
+  std::string topic;
+  EXPECT_TRUE(this->client.NewFilter(this->managerId, items, 3u, filterId,
+      topic));
+
+  std::mutex mutex;
+  std::vector<gazebo::msgs::Param_V> received;
+  std::function<void(const gazebo::msgs::Param_V&)> subCb =
+    [&mutex, &received](const gazebo::msgs::Param_V &_msg)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      received.push_back(_msg);
+    };
+  EXPECT_TRUE(node.Subscribe(topic, subCb));
+
+  for (int i = 0; i < 5; ++i)
+    this->manager->Update();
+
+  // Wait for asynchronous comms
+  for (int i = 0; i < 10; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!received.empty())
+      break;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(1u, received.size());
+
+    // Three samples of item4, oldest first, and the last value of item5.
+    auto const &msg = received.front();
+    ASSERT_EQ(4, msg.param_size());
+    for (int i = 0; i < 3; ++i)
+    {
+      EXPECT_EQ("item4", msg.param(i).name());
+      EXPECT_EQ(gazebo::msgs::Any::INT32, msg.param(i).value().type());
+      EXPECT_EQ(i + 1, msg.param(i).value().int_value());
+    }
+    EXPECT_EQ("item5", msg.param(3).name());
+    EXPECT_EQ("test_string", msg.param(3).value().string_value());
+  }
+
+  // Each update samples item4 once.
+  EXPECT_EQ(5, counter);
+
+  EXPECT_TRUE(this->client.RemoveFilter(this->managerId, filterId));
+  EXPECT_TRUE(this->manager->Unregister("item4"));
+  EXPECT_TRUE(this->manager->Unregister("item5"));
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
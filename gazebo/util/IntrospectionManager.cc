@@ -14,7 +14,9 @@
  * limitations under the License.
  *
  */
+#include <algorithm>
 #include <functional>
+#include <memory>
 #include <set>
 #include <string>
 #include <ignition/math/Rand.hh>
@@ -32,6 +34,11 @@
 using namespace gazebo;
 using namespace util;
 
+/// \brief Largest decimation accepted for a filter. Every sample taken
+/// between two publications is buffered, so this bounds the memory used by
+/// a single filter and the size of its messages.
+static const unsigned int g_maxDecimation = 1000u;
+
 //////////////////////////////////////////////////
 IntrospectionManager::IntrospectionManager()
   : dataPtr(new IntrospectionManagerPrivate)
@@ -104,7 +111,8 @@ bool IntrospectionManager::Register(const std::string &_item,
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
   // Sanity check: Make sure that nobody has registered the same item before.
-  if (this->dataPtr->allItems.find(_item) != this->dataPtr->allItems.end())
+  if (this->dataPtr->allItemsKeys.find(_item) !=
+      this->dataPtr->allItemsKeys.end())
   {
     gzwarn << "Item [" << _item << "] already registered" << std::endl;
     return false;
@@ -115,6 +123,58 @@ bool IntrospectionManager::Register(const std::string &_item,
 
   this->dataPtr->itemsUpdated = true;
 
+  if (this->dataPtr->observedItems.find(_item) !=
+      this->dataPtr->observedItems.end())
+  {
+    this->RebuildPlan();
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool IntrospectionManager::RegisterSampled(const std::string &_item,
+    const std::function<double()> &_cb, const msgs::Any::ValueType _type)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  // Sanity check: Make sure that nobody has registered the same item before.
+  if (this->dataPtr->allItemsKeys.find(_item) !=
+      this->dataPtr->allItemsKeys.end())
+  {
+    gzwarn << "Item [" << _item << "] already registered" << std::endl;
+    return false;
+  }
+
+  // Reuse the slot of an unregistered item if possible.
+  unsigned int slot;
+  if (this->dataPtr->freeSlots.empty())
+  {
+    slot = this->dataPtr->slots.size();
+    this->dataPtr->slots.emplace_back();
+  }
+  else
+  {
+    slot = this->dataPtr->freeSlots.back();
+    this->dataPtr->freeSlots.pop_back();
+  }
+
+  auto &sampledItem = this->dataPtr->slots[slot];
+  sampledItem.name = _item;
+  sampledItem.cb = _cb;
+  sampledItem.type = _type;
+
+  this->dataPtr->allItemsKeys.insert(_item);
+  this->dataPtr->slotIndex[_item] = slot;
+
+  this->dataPtr->itemsUpdated = true;
+
+  if (this->dataPtr->observedItems.find(_item) !=
+      this->dataPtr->observedItems.end())
+  {
+    this->RebuildPlan();
+  }
+
   return true;
 }
 
@@ -124,7 +184,8 @@ bool IntrospectionManager::Unregister(const std::string &_item)
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
   // Sanity check: Make sure that the item has been previously registered.
-  if (this->dataPtr->allItems.find(_item) == this->dataPtr->allItems.end())
+  if (this->dataPtr->allItemsKeys.find(_item) ==
+      this->dataPtr->allItemsKeys.end())
   {
     gzwarn << "Item [" << _item << "] is not registered" << std::endl;
     return false;
@@ -134,8 +195,23 @@ bool IntrospectionManager::Unregister(const std::string &_item)
   this->dataPtr->allItemsKeys.erase(_item);
   this->dataPtr->allItems.erase(_item);
 
+  // Release its slot.
+  auto slotIter = this->dataPtr->slotIndex.find(_item);
+  if (slotIter != this->dataPtr->slotIndex.end())
+  {
+    this->dataPtr->slots[slotIter->second] = SampledItem();
+    this->dataPtr->freeSlots.push_back(slotIter->second);
+    this->dataPtr->slotIndex.erase(slotIter);
+  }
+
   this->dataPtr->itemsUpdated = true;
 
+  if (this->dataPtr->observedItems.find(_item) !=
+      this->dataPtr->observedItems.end())
+  {
+    this->RebuildPlan();
+  }
+
   return true;
 }
 
@@ -145,7 +221,11 @@ void IntrospectionManager::Clear()
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   this->dataPtr->allItemsKeys.clear();
   this->dataPtr->allItems.clear();
+  this->dataPtr->slots.clear();
+  this->dataPtr->slotIndex.clear();
+  this->dataPtr->freeSlots.clear();
   this->dataPtr->itemsUpdated = true;
+  this->RebuildPlan();
 }
 
 //////////////////////////////////////////////////
@@ -164,110 +244,181 @@ std::set<std::string> IntrospectionManager::Items() const
 //////////////////////////////////////////////////
 void IntrospectionManager::Update()
 {
-  std::map<std::string, IntrospectionFilter> filtersCopy;
-  std::map<std::string, ObservedItem> observedItemsCopy;
-  std::map<std::string, std::function <gazebo::msgs::Any ()>> usedItemsCopy;
-
-  {
-    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-
-    filtersCopy = this->dataPtr->filters;
-    observedItemsCopy = this->dataPtr->observedItems;
-
-    for (const auto &observedItem: this->dataPtr->observedItems)
+  // The plan only changes when items or filters do, so the common case
+  // doesn't lock, copy or allocate anything.
+  auto plan = std::atomic_load(&this->dataPtr->plan);
+  if (plan)
+  {
+    // Sample the numeric items into the next row of the ring buffer.
+    const size_t columnCount = plan->columns.size();
+    const size_t row = (plan->updates % plan->rows) * columnCount;
+    ++plan->updates;
+    for (size_t c = 0; c < columnCount; ++c)
     {
-      auto &item = observedItem.first;
-      // Sanity check: Make sure that someone registered this item.
-      if (this->dataPtr->allItemsKeys.count(item) == 0)
+      try
       {
-        continue;
+        plan->samples[row + c] = plan->columns[c]();
+        plan->valid[row + c] = true;
+      }
+      catch(...)
+      {
+        gzerr << "Exception caught calling user callback" << std::endl;
+        plan->valid[row + c] = false;
       }
-
-      usedItemsCopy[item] = this->dataPtr->allItems[item];
     }
 
-    for (auto& filter: filtersCopy)
+    for (auto &filter : plan->filters)
     {
-      for (auto const &item : filter.second.items)
+      if (plan->updates % filter.decimation != 0)
+        continue;
+
+      // Clearing the message keeps its params allocated for reuse.
+      auto &nextMsg = filter.msg;
+      nextMsg.Clear();
+
+      for (auto const &entry : filter.entries)
       {
-        // Sanity check: Make sure that someone registered this item.
-        if (this->dataPtr->allItemsKeys.count(item) == 0)
+        if (entry.column >= 0)
         {
+          // Every sample taken since the last publication, oldest first.
+          for (auto k = plan->updates - filter.decimation;
+               k < plan->updates; ++k)
+          {
+            const size_t index = (k % plan->rows) * columnCount +
+                static_cast<size_t>(entry.column);
+            if (!plan->valid[index])
+              continue;
+
+            auto nextParam = nextMsg.add_param();
+            nextParam->set_name(entry.name);
+            auto value = nextParam->mutable_value();
+            value->set_type(entry.type);
+            if (entry.type == gazebo::msgs::Any::INT32)
+              value->set_int_value(static_cast<int>(plan->samples[index]));
+            else if (entry.type == gazebo::msgs::Any::BOOLEAN)
+              value->set_bool_value(plan->samples[index] != 0.0);
+            else
+              value->set_double_value(plan->samples[index]);
+          }
           continue;
         }
-        usedItemsCopy[item] = this->dataPtr->allItems[item];
-      }
-    }
-  }
 
-  for (auto &observedItem : observedItemsCopy)
-  {
-    auto &item = observedItem.first;
-    auto itemIter = usedItemsCopy.find(item);
+        // Other items are only read when a filter publishes them.
+        auto &item = plan->items[entry.item];
+        if (item.updatedAt != plan->updates)
+        {
+          item.updatedAt = plan->updates;
+          try
+          {
+            item.lastValue = item.cb();
+          }
+          catch(...)
+          {
+            gzerr << "Exception caught calling user callback" << std::endl;
+            item.lastValue.Clear();
+          }
+        }
 
-    // Sanity check: Make sure that we can update the item.
-    if (itemIter == usedItemsCopy.end())
-      continue;
+        // Sanity check: Make sure that the value was updated.
+        // (e.g.: an exception was not raised).
+        if (item.lastValue.type() == gazebo::msgs::Any::NONE)
+          continue;
 
-    try
-    {
-      // Update the values of the items under observation.
-      gazebo::msgs::Any value = itemIter->second();
-      auto &lastValue = observedItem.second.lastValue;
-      lastValue.CopyFrom(value);
-    }
-    catch(...)
-    {
-      gzerr << "Exception caught calling user callback" << std::endl;
-      continue;
+        auto nextParam = nextMsg.add_param();
+        nextParam->set_name(entry.name);
+        nextParam->mutable_value()->CopyFrom(item.lastValue);
+      }
+
+      // Sanity check: Make sure that we have at least one item updated.
+      if (nextMsg.param_size() == 0)
+        continue;
+
+      // Publish the update for this filter.
+      if (!filter.pub.Publish(nextMsg))
+      {
+        gzerr << "Error publishing update for topic [" << filter.topic << "]"
+          << std::endl;
+      }
     }
   }
 
-  // Prepare the next message to be sent in each filter.
-  for (auto &filter : filtersCopy)
-  {
-    // First of all, clear the old message.
-    auto &nextMsg = filter.second.msg;
-    nextMsg.Clear();
+  this->NotifyUpdates();
+}
 
-    // Insert the last value of each item under observation for this filter.
-    for (auto const &item : filter.second.items)
-    {
-      // Sanity check: Make sure that someone registered this item.
-      if (usedItemsCopy.find(item) == usedItemsCopy.end())
-        continue;
+//////////////////////////////////////////////////
+void IntrospectionManager::RebuildPlan()
+{
+  if (this->dataPtr->filters.empty())
+  {
+    std::atomic_store(&this->dataPtr->plan,
+        std::shared_ptr<IntrospectionPlan>());
+    return;
+  }
 
-      // Sanity check: Make sure that the value was updated.
-      // (e.g.: an exception was not raised).
-      auto &lastValue = observedItemsCopy[item].lastValue;
-      if (lastValue.type() == gazebo::msgs::Any::NONE)
-        continue;
+  auto plan = std::make_shared<IntrospectionPlan>();
 
-      auto nextParam = nextMsg.add_param();
-      nextParam->set_name(item);
-      nextParam->mutable_value()->CopyFrom(lastValue);
-    }
+  // Each observed item is read once per update, whatever the number of
+  // filters observing it.
+  std::map<std::string, unsigned int> columns;
+  std::map<std::string, unsigned int> items;
 
-    // Sanity check: Make sure that we have at least one item updated.
-    if (nextMsg.param_size() == 0)
+  for (auto const &filter : this->dataPtr->filters)
+  {
+    std::string topicName = this->dataPtr->prefix + "filter/" + filter.first;
+    auto pubIter = this->dataPtr->filterPubs.find(topicName);
+    if (pubIter == this->dataPtr->filterPubs.end())
       continue;
 
-    // Publish the update for this filter.
-    std::string topicName = this->dataPtr->prefix + "filter/" + filter.first;
+    plan->filters.emplace_back();
+    auto &planFilter = plan->filters.back();
+    planFilter.pub = pubIter->second;
+    planFilter.topic = topicName;
+    planFilter.decimation = filter.second.decimation;
+    plan->rows = std::max(plan->rows, planFilter.decimation);
 
+    for (auto const &item : filter.second.items)
     {
-      std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-      if (this->dataPtr->filterPubs.find(topicName) ==
-          this->dataPtr->filterPubs.end() ||
-          !this->dataPtr->filterPubs[topicName].Publish(nextMsg))
+      PlanEntry entry;
+      entry.name = item;
+
+      auto slotIter = this->dataPtr->slotIndex.find(item);
+      if (slotIter != this->dataPtr->slotIndex.end())
       {
-        gzerr << "Error publishing update for topic [" << topicName << "]"
-          << std::endl;
+        auto const &sampledItem = this->dataPtr->slots[slotIter->second];
+        auto column = columns.find(item);
+        if (column == columns.end())
+        {
+          column = columns.emplace(item, plan->columns.size()).first;
+          plan->columns.push_back(sampledItem.cb);
+        }
+        entry.column = column->second;
+        entry.type = sampledItem.type;
+      }
+      else
+      {
+        // Sanity check: Make sure that someone registered this item.
+        auto itemIter = this->dataPtr->allItems.find(item);
+        if (itemIter == this->dataPtr->allItems.end())
+          continue;
+
+        auto planItem = items.find(item);
+        if (planItem == items.end())
+        {
+          planItem = items.emplace(item, plan->items.size()).first;
+          plan->items.emplace_back();
+          plan->items.back().cb = itemIter->second;
+        }
+        entry.item = planItem->second;
       }
+
+      planFilter.entries.push_back(entry);
     }
   }
 
-  this->NotifyUpdates();
+  plan->samples.resize(plan->rows * plan->columns.size());
+  plan->valid.resize(plan->samples.size(), false);
+
+  std::atomic_store(&this->dataPtr->plan, plan);
 }
 
 //////////////////////////////////////////////////
@@ -298,7 +449,7 @@ void IntrospectionManager::NotifyUpdates()
 
 //////////////////////////////////////////////////
 bool IntrospectionManager::NewFilterImpl(const std::set<std::string> &_newItems,
-    std::string &_filterId)
+    std::string &_filterId, const unsigned int _decimation)
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
@@ -331,11 +482,15 @@ bool IntrospectionManager::NewFilterImpl(const std::set<std::string> &_newItems,
 
   // Add the items to the new filter.
   this->dataPtr->filters[_filterId].items = _newItems;
+  this->dataPtr->filters[_filterId].decimation =
+      std::min(std::max(1u, _decimation), g_maxDecimation);
 
   // Register the new filter in the list of observed items.
   for (auto const &item : _newItems)
     this->dataPtr->observedItems[item].filters.emplace(_filterId);
 
+  this->RebuildPlan();
+
   return true;
 }
 
@@ -393,6 +548,8 @@ bool IntrospectionManager::UpdateFilterImpl(const std::string &_filterId,
     }
   }
 
+  this->RebuildPlan();
+
   return true;
 }
 
@@ -441,6 +598,8 @@ bool IntrospectionManager::RemoveFilterImpl(const std::string &_filterId)
       this->dataPtr->observedItems.erase(oldItem);
   }
 
+  this->RebuildPlan();
+
   return true;
 }
 
@@ -459,11 +618,28 @@ bool IntrospectionManager::NewFilter(const gazebo::msgs::Param_V &_req,
   }
 
   std::set<std::string> requestedItems;
+  unsigned int decimation = 1;
 
   // Store the new filter.
   for (auto i = 0; i < _req.param_size(); ++i)
   {
     auto param = _req.param(i);
+    if (param.name() == "decimation")
+    {
+      if (param.value().type() != gazebo::msgs::Any::INT32 ||
+          param.value().int_value() < 1 ||
+          static_cast<unsigned int>(param.value().int_value()) >
+            g_maxDecimation)
+      {
+        gzwarn << "Expected a 'decimation' parameter with an INT32 value "
+               << "between 1 and " << g_maxDecimation
+               << ". Ignoring request." << std::endl;
+        return false;
+      }
+      decimation = param.value().int_value();
+      continue;
+    }
+
     if (!this->ValidateParameter(param, {"item"}))
     {
       gzwarn << "Invalid parameter[" << param.name() << "] "
@@ -475,8 +651,16 @@ bool IntrospectionManager::NewFilter(const gazebo::msgs::Param_V &_req,
     requestedItems.emplace(item);
   }
 
+  // Sanity check: Make sure that there is at least one item.
+  if (requestedItems.empty())
+  {
+    gzwarn << "Filter request with empty list of items." << std::endl;
+    gzwarn << "Ignoring request." << std::endl;
+    return false;
+  }
+
   std::string topicName;
-  if (!this->NewFilterImpl(requestedItems, topicName))
+  if (!this->NewFilterImpl(requestedItems, topicName, decimation))
   {
     gzwarn << "Ignoring request." << std::endl;
     return false;
@@ -578,12 +762,12 @@ bool IntrospectionManager::Items(const gazebo::msgs::Empty &/*_req*/,
 {
   {
     std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-    for (auto const &item : this->dataPtr->allItems)
+    for (auto const &item : this->dataPtr->allItemsKeys)
     {
       auto nextParam = _rep.add_param();
       nextParam->set_name("item");
       nextParam->mutable_value()->set_type(gazebo::msgs::Any::STRING);
-      nextParam->mutable_value()->set_string_value(item.first);
+      nextParam->mutable_value()->set_string_value(item);
     }
   }
   return true;
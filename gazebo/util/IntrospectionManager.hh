@@ -21,6 +21,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <type_traits>
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/SingletonT.hh"
 #include "gazebo/msgs/any.pb.h"
@@ -58,16 +59,16 @@ namespace gazebo
       /// \param[in] _cb Callback used to get the last update for this item.
       /// \result True when the registration succeed or false otherwise
       /// (item already existing).
+      /// Items of type double, int and bool get a numeric slot, and are
+      /// sampled without creating messages until a filter publishes them.
       public: template<typename T>
       bool Register(const std::string &_item,
                     const std::function<T()> &_cb)
       {
-        auto func = [=]()
-        {
-          return msgs::ConvertAny(_cb());
-        };
-
-        return this->Register(_item, func);
+        return this->RegisterTyped<T>(_item, _cb,
+            std::integral_constant<bool, std::is_same<T, double>::value ||
+                std::is_same<T, int>::value ||
+                std::is_same<T, bool>::value>());
       }
 
       /// \brief Unregister an existing item from the introspection manager.
@@ -86,7 +87,10 @@ namespace gazebo
       /// \brief Update all the items under observation and publish updates
       /// through all the topics. The message received in the update will
       /// contain the name and latest values of all the items specified
-      /// in the filter.
+      /// in the filter. A filter with a decimation of N publishes every N
+      /// updates, with the N samples of each numeric item in order.
+      /// This function doesn't lock the manager and must not be called
+      /// from more than one thread at a time.
       /// If there are changes in the items list since the last update,
       /// a new message is published under the topic
       /// "/introspection/<manager_id>/items_update".
@@ -111,6 +115,54 @@ namespace gazebo
       private: bool Register(const std::string &_item,
                              const std::function <gazebo::msgs::Any()> &_cb);
 
+      /// \brief Register a new numeric item in a slot.
+      /// \param[in] _item New item. E.g.: /default/world/joint1/position
+      /// \param[in] _cb Callback used to get the last update for this item.
+      /// \param[in] _type Type of the published value: DOUBLE, INT32 or
+      /// BOOLEAN.
+      /// \result True when the registration succeed or false otherwise
+      /// (item already existing).
+      private: bool RegisterSampled(const std::string &_item,
+                                    const std::function<double()> &_cb,
+                                    const msgs::Any::ValueType _type);
+
+      /// \brief Register an item of a type stored in a slot.
+      /// \param[in] _item New item.
+      /// \param[in] _cb Callback used to get the last update for this item.
+      /// \result True when the registration succeed.
+      private: template<typename T>
+      bool RegisterTyped(const std::string &_item,
+                         const std::function<T()> &_cb, std::true_type)
+      {
+        auto func = [=]()
+        {
+          return static_cast<double>(_cb());
+        };
+        return this->RegisterSampled(_item, func,
+            msgs::ConvertAny(T()).type());
+      }
+
+      /// \brief Register an item of a type converted to a message on every
+      /// update.
+      /// \param[in] _item New item.
+      /// \param[in] _cb Callback used to get the last update for this item.
+      /// \result True when the registration succeed.
+      private: template<typename T>
+      bool RegisterTyped(const std::string &_item,
+                         const std::function<T()> &_cb, std::false_type)
+      {
+        auto func = [=]()
+        {
+          return msgs::ConvertAny(_cb());
+        };
+
+        return this->Register(_item, func);
+      }
+
+      /// \brief Build a new plan from the registered items and filters, and
+      /// make it the one used by Update. Must be called with the mutex held.
+      private: void RebuildPlan();
+
       /// \brief Create a new filter for observing item updates. This function
       /// will create a new topic for sending periodic updates of the items
       /// specified in the filter.
@@ -119,9 +171,13 @@ namespace gazebo
       /// for future filter updates or for removing it. After the filter
       /// creation, a client should subscribe to the topic
       /// /introspection/filter/<filter_id> for receiving updates.
+      /// \param[in] _decimation Number of updates between two publications.
+      /// Every sample of a numeric item taken in between is published.
+      /// Values are clamped to the range [1, 1000].
       /// \return True if the filter was successfully created or false otherwise
       private: bool NewFilterImpl(const std::set<std::string> &_newItems,
-                                  std::string &_filterId);
+                                  std::string &_filterId,
+                                  const unsigned int _decimation = 1);
 
       /// \brief Update an existing filter with a different set of items.
       /// \param[in] _filterId ID of the filter to update.
@@ -139,6 +195,9 @@ namespace gazebo
       /// \param[in] _req Input parameter of the service request. The service
       /// expects a collection of one or more parameters with name "item" and a
       /// value of type STRING containing the name of the item to observe.
+      /// An optional parameter with name "decimation" and a value of type
+      /// INT32 between 1 and 1000 sets the number of updates between two
+      /// publications.
       /// \param[out] _rep Output parameter of the service request. It contains
       /// the filter ID created.
       /// \return True when the operation succeed or false
@@ -17,11 +17,14 @@
 #ifndef GAZEBO_UTIL_INTROSPECTION_MANAGER_PRIVATE_HH_
 #define GAZEBO_UTIL_INTROSPECTION_MANAGER_PRIVATE_HH_
 
+#include <cstdint>
 #include <functional>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <string>
+#include <vector>
 #include <ignition/transport.hh>
 #include "gazebo/msgs/any.pb.h"
 #include "gazebo/msgs/param_v.pb.h"
@@ -37,21 +40,110 @@ namespace gazebo
       /// \brief Items observed by this filter.
       std::set<std::string> items;
 
-      /// \brief Message containing the next update. A message is a collection
-      /// of items and values.
-      msgs::Param_V msg;
+      /// \brief Number of updates between two publications of this filter.
+      unsigned int decimation = 1;
     };
 
-    /// \brief Todo.
+    /// \brief An item with at least one active observer.
     struct ObservedItem
     {
-      /// \brief ToDo.
-      gazebo::msgs::Any lastValue;
-
-      /// \brief ToDo.
+      /// \brief Filters that contain the item.
       std::set<std::string> filters;
     };
 
+    /// \brief A numeric item stored in a slot. Its value is sampled into
+    /// a preallocated buffer instead of being converted to a message.
+    struct SampledItem
+    {
+      /// \brief Item name, empty when the slot is free.
+      std::string name;
+
+      /// \brief Callback used to get the last value of the item.
+      std::function<double()> cb;
+
+      /// \brief Type of the value published: DOUBLE, INT32 or BOOLEAN.
+      msgs::Any::ValueType type = msgs::Any::DOUBLE;
+    };
+
+    /// \brief An item of a plan that is not sampled into a slot.
+    struct PlanItem
+    {
+      /// \brief Callback used to get the last value of the item.
+      std::function<msgs::Any()> cb;
+
+      /// \brief Last value of the item, NONE when the callback failed.
+      msgs::Any lastValue;
+
+      /// \brief Update count of the last value.
+      uint64_t updatedAt = 0;
+    };
+
+    /// \brief An item published by a plan filter.
+    struct PlanEntry
+    {
+      /// \brief Item name.
+      std::string name;
+
+      /// \brief Column of the item in the sample buffer, or -1 when the item
+      /// is not sampled.
+      int column = -1;
+
+      /// \brief Index of the item in IntrospectionPlan::items when it is not
+      /// sampled.
+      unsigned int item = 0;
+
+      /// \brief Type of the value published.
+      msgs::Any::ValueType type = msgs::Any::NONE;
+    };
+
+    /// \brief A filter of a plan.
+    struct PlanFilter
+    {
+      /// \brief Publisher of the filter topic.
+      ignition::transport::Node::Publisher pub;
+
+      /// \brief Topic of the filter.
+      std::string topic;
+
+      /// \brief Number of updates between two publications.
+      unsigned int decimation = 1;
+
+      /// \brief Registered items observed by this filter, sorted by name.
+      std::vector<PlanEntry> entries;
+
+      /// \brief Message reused for every publication.
+      msgs::Param_V msg;
+    };
+
+    /// \brief Everything needed to update the observed items, built every
+    /// time items or filters change. The buffers are only written by
+    /// IntrospectionManager::Update.
+    struct IntrospectionPlan
+    {
+      /// \brief Callbacks of the sampled items, one per column.
+      std::vector<std::function<double()>> columns;
+
+      /// \brief Ring buffer of samples, with one row of columns.size()
+      /// values per update.
+      std::vector<double> samples;
+
+      /// \brief Whether each sample was read without errors.
+      std::vector<char> valid;
+
+      /// \brief Number of rows in the ring buffer, the largest decimation
+      /// of all filters.
+      unsigned int rows = 1;
+
+      /// \brief Number of updates done with this plan.
+      uint64_t updates = 0;
+
+      /// \brief Observed items that are not sampled.
+      std::vector<PlanItem> items;
+
+      /// \brief Active filters.
+      std::vector<PlanFilter> filters;
+    };
+
     /// \brief Private data for the IntrospectionManager class.
     class IntrospectionManagerPrivate
     {
@@ -68,6 +160,15 @@ namespace gazebo
       public: std::map<std::string, std::function <gazebo::msgs::Any ()>>
           allItems;
 
+      /// \brief Slots of the sampled items, indexed by slot number.
+      public: std::vector<SampledItem> slots;
+
+      /// \brief Slot number of each sampled item, indexed by name.
+      public: std::map<std::string, unsigned int> slotIndex;
+
+      /// \brief Slots released by unregistered items.
+      public: std::vector<unsigned int> freeSlots;
+
       /// \brief Set of all registered items names.
       /// This is a convenience/performance enhancement for retreving
       /// registered keys.
@@ -82,6 +183,10 @@ namespace gazebo
       /// \brief Mutex to make this class thread-safe.
       public: mutable std::mutex mutex;
 
+      /// \brief Current plan, replaced with std::atomic_store so Update
+      /// doesn't need the mutex.
+      public: std::shared_ptr<IntrospectionPlan> plan;
+
       /// \brief Node used for communications.
       public: ignition::transport::Node node;
 
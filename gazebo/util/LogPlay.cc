@@ -728,15 +728,28 @@ bool LogPlayPrivate::ChunkData(
     gzthrow("Encoding missing for a chunk in log file[" + this->filename + "]");
   }
 
-  if (this->encoding == "txt")
-    _data = _xml->GetText();
-  else if (this->encoding == "bz2")
+  if (!LogPlay::DecodeChunk(this->encoding, _xml->GetText(), _data))
+  {
+    gzerr << "Invalid encoding[" << this->encoding << "] in log file["
+      << this->filename << "]\n";
+    return false;
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool LogPlay::DecodeChunk(const std::string &_encoding,
+    const std::string &_encoded, std::string &_data)
+{
+  if (_encoding == "txt")
+    _data = _encoded;
+  else if (_encoding == "bz2")
   {
-    std::string data = _xml->GetText();
     std::string buffer;
 
     // Decode the base64 string
-    buffer = Base64Decode(data);
+    buffer = Base64Decode(_encoded);
 
     // Decompress the bz2 data
     {
@@ -749,13 +762,12 @@ bool LogPlayPrivate::ChunkData(
       _data += '\0';
     }
   }
-  else if (this->encoding == "zlib")
+  else if (_encoding == "zlib")
   {
-    std::string data = _xml->GetText();
     std::string buffer;
 
     // Decode the base64 string
-    buffer = Base64Decode(data);
+    buffer = Base64Decode(_encoded);
 
     // Decompress the zlib data
     {
@@ -769,15 +781,33 @@ bool LogPlayPrivate::ChunkData(
     }
   }
   else
-  {
-    gzerr << "Invalid encoding[" << this->encoding << "] in log file["
-      << this->filename << "]\n";
     return false;
-  }
 
   return true;
 }
 
+/////////////////////////////////////////////////
+unsigned int LogPlay::VisitChunks(const std::function<bool(
+    const std::string &_encoding, const std::string &_encoded)> &_cb) const
+{
+  unsigned int count = 0;
+  if (!this->dataPtr->logStartXml)
+    return count;
+
+  for (auto xml = this->dataPtr->logStartXml->FirstChildElement("chunk");
+       xml; xml = xml->NextSiblingElement("chunk"))
+  {
+    const char *encoding = xml->Attribute("encoding");
+    const char *text = xml->GetText();
+
+    ++count;
+    if (!_cb(encoding ? encoding : "", text ? text : ""))
+      break;
+  }
+
+  return count;
+}
+
 /////////////////////////////////////////////////
 std::string LogPlay::Encoding() const
 {
@@ -17,6 +17,7 @@
 #ifndef _GAZEBO_UTIL_LOGPLAY_HH_
 #define _GAZEBO_UTIL_LOGPLAY_HH_
 
+#include <functional>
 #include <memory>
 #include <string>
 
@@ -140,6 +141,26 @@ namespace gazebo
       /// \return True if the _index was valid.
       public: bool Chunk(const unsigned int _index, std::string &_data) const;
 
+      /// \brief Visit the chunks of the open log file in order, without
+      /// decoding them. Unlike Chunk, this doesn't change the current
+      /// position and doesn't rescan the file for every chunk. The encoded
+      /// data can be decoded later, from any thread, with DecodeChunk.
+      /// \param[in] _cb Function called with the encoding and the encoded
+      /// data of each chunk. Return false to stop visiting chunks.
+      /// \return Number of chunks visited.
+      public: unsigned int VisitChunks(const std::function<bool(
+                  const std::string &_encoding,
+                  const std::string &_encoded)> &_cb) const;
+
+      /// \brief Decode the data of a chunk. This function is thread-safe.
+      /// \param[in] _encoding Encoding of the chunk: txt, bz2 or zlib.
+      /// \param[in] _encoded Data of the chunk, as stored in the log file.
+      /// \param[out] _data Decoded data.
+      /// \return False if the encoding is not valid.
+      public: static bool DecodeChunk(const std::string &_encoding,
+                                      const std::string &_encoded,
+                                      std::string &_data);
+
       /// \brief Get the type of encoding used for current chunck in the
       /// open log file.
       /// \return The type of encoding. An empty string will be returned if
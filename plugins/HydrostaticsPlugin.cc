@@ -0,0 +1,857 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <ignition/math/Matrix3.hh>
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "ignition/common/Profiler.hh"
+#include "gazebo/common/Assert.hh"
+#include "gazebo/common/CommonIface.hh"
+#include "gazebo/common/Events.hh"
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshManager.hh"
+#include "gazebo/physics/physics.hh"
+#include "plugins/HydrostaticsPlugin.hh"
+
+using namespace gazebo;
+
+GZ_REGISTER_WORLD_PLUGIN(HydrostaticsPlugin)
+
+namespace gazebo
+{
+  /// \brief A sinusoidal deep water wave.
+  struct HydrostaticsWave
+  {
+    /// \brief Amplitude in meters.
+    double amplitude = 0;
+
+    /// \brief Wave number in rad/m.
+    double k = 0;
+
+    /// \brief Angular frequency in rad/s.
+    double omega = 0;
+
+    /// \brief Unit direction of travel.
+    double dirX = 1;
+
+    /// \brief Unit direction of travel.
+    double dirY = 0;
+
+    /// \brief Phase in radians.
+    double phase = 0;
+  };
+
+  /// \brief A closed triangle mesh, with its vertices stored by coordinate.
+  struct HydrostaticsMesh
+  {
+    /// \brief Vertex X coordinates.
+    std::vector<double> x;
+
+    /// \brief Vertex Y coordinates.
+    std::vector<double> y;
+
+    /// \brief Vertex Z coordinates.
+    std::vector<double> z;
+
+    /// \brief Vertex indices, three per triangle, counter clockwise when
+    /// seen from outside.
+    std::vector<uint32_t> triangles;
+  };
+
+  /// \brief A floating link and its range in the batched arrays.
+  struct HydrostaticsLink
+  {
+    /// \brief The link.
+    physics::LinkPtr link;
+
+    /// \brief First vertex in the batched arrays.
+    uint32_t firstVertex = 0;
+
+    /// \brief Number of vertices.
+    uint32_t vertexCount = 0;
+
+    /// \brief First triangle index in the batched arrays.
+    uint32_t firstIndex = 0;
+
+    /// \brief Number of triangle indices.
+    uint32_t indexCount = 0;
+  };
+
+  /// \brief State of a link shared by all of its triangles.
+  struct HydrostaticsContext
+  {
+    /// \brief Fluid density times gravity.
+    double pressure = 0;
+
+    /// \brief Linear drag coefficient.
+    double linearDrag = 0;
+
+    /// \brief Quadratic drag coefficient.
+    double quadraticDrag = 0;
+
+    /// \brief Center of gravity of the link.
+    ignition::math::Vector3d cog;
+
+    /// \brief Linear velocity of the center of gravity.
+    ignition::math::Vector3d vel;
+
+    /// \brief Angular velocity of the link.
+    ignition::math::Vector3d angVel;
+  };
+
+  /// \brief Private data for the HydrostaticsPlugin class
+  class HydrostaticsPluginPrivate
+  {
+    /// \brief Find the floating links, build the meshes of new links and
+    /// lay them out in the batched arrays.
+    public: void Rebuild();
+
+    /// \brief Lay out the floating links of a model and of its nested
+    /// models.
+    /// \param[in] _model The model.
+    /// \param[in] _selected True if an enclosing model was named in the
+    /// plugin parameters.
+    /// \param[in,out] _meshesInUse Meshes of the links laid out so far, by
+    /// link id.
+    public: void AddModel(const physics::ModelPtr &_model,
+                const bool _selected,
+                std::unordered_map<uint32_t, HydrostaticsMesh> &_meshesInUse);
+
+    /// \brief Check whether models were inserted or removed since the
+    /// last rebuild. Nested models are inserted and removed with their
+    /// top level model, so only top level models are compared.
+    /// \return True if the models of the world changed.
+    public: bool ModelsChanged() const;
+
+    /// \brief Build the mesh of a link in the link frame.
+    /// \param[in] _link The link.
+    /// \param[out] _mesh The mesh.
+    /// \return True if the link has at least one supported collision.
+    public: bool BuildLinkMesh(const physics::LinkPtr &_link,
+                               HydrostaticsMesh &_mesh) const;
+
+    /// \brief Pointer to the world.
+    public: physics::WorldPtr world;
+
+    /// \brief Name of the world.
+    public: std::string worldName;
+
+    /// \brief Connection to World Update events.
+    public: event::ConnectionPtr updateConnection;
+
+    /// \brief Density of the fluid in kg/m^3.
+    public: double fluidDensity = 999.1026;
+
+    /// \brief Height of the calm surface.
+    public: double waterLevel = 0;
+
+    /// \brief Linear drag coefficient.
+    public: double linearDrag = 0;
+
+    /// \brief Quadratic drag coefficient.
+    public: double quadraticDrag = 0;
+
+    /// \brief Grid cells used to simplify meshes.
+    public: unsigned int meshCells = 16;
+
+    /// \brief Waves of the surface.
+    public: std::vector<HydrostaticsWave> waves;
+
+    /// \brief Names of the floating models, empty for all of them.
+    public: std::set<std::string> modelNames;
+
+    /// \brief Ids of the models in the world at the last rebuild, in world
+    /// order. Ids are never reused, so a model removed and another inserted
+    /// in the same step are told apart.
+    public: std::vector<uint32_t> modelIds;
+
+    /// \brief Meshes of the links, by link id.
+    public: std::unordered_map<uint32_t, HydrostaticsMesh> meshes;
+
+    /// \brief Floating links.
+    public: std::vector<HydrostaticsLink> links;
+
+    /// \brief Vertices of all links in their link frame.
+    public: HydrostaticsMesh local;
+
+    /// \brief Vertex X coordinates in the world frame.
+    public: std::vector<double> worldX;
+
+    /// \brief Vertex Y coordinates in the world frame.
+    public: std::vector<double> worldY;
+
+    /// \brief Vertex Z coordinates in the world frame.
+    public: std::vector<double> worldZ;
+
+    /// \brief Depth of each vertex below the surface, negative above it.
+    public: std::vector<double> depth;
+  };
+}
+
+namespace
+{
+  /// \brief Add a quad as two triangles.
+  /// \param[in] _a First corner.
+  /// \param[in] _b Second corner.
+  /// \param[in] _c Third corner.
+  /// \param[in] _d Fourth corner.
+  /// \param[out] _mesh Mesh to add to.
+  void AddQuad(const uint32_t _a, const uint32_t _b, const uint32_t _c,
+      const uint32_t _d, HydrostaticsMesh &_mesh)
+  {
+    _mesh.triangles.insert(_mesh.triangles.end(), {_a, _b, _c, _a, _c, _d});
+  }
+
+  /// \brief Add a vertex.
+  /// \param[in] _p Position.
+  /// \param[out] _mesh Mesh to add to.
+  /// \return Index of the vertex.
+  uint32_t AddVertex(const ignition::math::Vector3d &_p,
+      HydrostaticsMesh &_mesh)
+  {
+    _mesh.x.push_back(_p.X());
+    _mesh.y.push_back(_p.Y());
+    _mesh.z.push_back(_p.Z());
+    return static_cast<uint32_t>(_mesh.x.size() - 1);
+  }
+
+  /// \brief Add a box centered on the origin.
+  /// \param[in] _size Size of the box.
+  /// \param[out] _mesh Mesh to add to.
+  void AddBox(const ignition::math::Vector3d &_size, HydrostaticsMesh &_mesh)
+  {
+    // Corner i has its x, y and z on the positive side for bits 0, 1 and 2
+    uint32_t first = static_cast<uint32_t>(_mesh.x.size());
+    for (int i = 0; i < 8; ++i)
+    {
+      AddVertex(0.5 * ignition::math::Vector3d(
+          (i & 1) ? _size.X() : -_size.X(),
+          (i & 2) ? _size.Y() : -_size.Y(),
+          (i & 4) ? _size.Z() : -_size.Z()), _mesh);
+    }
+
+    const uint32_t faces[6][4] = {
+        {0, 2, 3, 1}, {4, 5, 7, 6}, {0, 1, 5, 4},
+        {2, 6, 7, 3}, {0, 4, 6, 2}, {1, 3, 7, 5}};
+    for (auto const &f : faces)
+      AddQuad(first + f[0], first + f[1], first + f[2], first + f[3], _mesh);
+  }
+
+  /// \brief Add the side and caps of a ring of vertices going around Z.
+  /// \param[in] _top Index of the top pole.
+  /// \param[in] _bottom Index of the bottom pole.
+  /// \param[in] _firstRing Index of the first vertex of the top ring.
+  /// \param[in] _rings Number of rings, from top to bottom.
+  /// \param[in] _segments Number of vertices per ring.
+  /// \param[out] _mesh Mesh to add to.
+  void AddRings(const uint32_t _top, const uint32_t _bottom,
+      const uint32_t _firstRing, const uint32_t _rings,
+      const uint32_t _segments, HydrostaticsMesh &_mesh)
+  {
+    auto vertex = [&](const uint32_t _ring, const uint32_t _segment)
+    {
+      return _firstRing + _ring * _segments + _segment % _segments;
+    };
+
+    for (uint32_t j = 0; j < _segments; ++j)
+    {
+      _mesh.triangles.insert(_mesh.triangles.end(),
+          {_top, vertex(0, j), vertex(0, j + 1)});
+      for (uint32_t i = 0; i + 1 < _rings; ++i)
+      {
+        AddQuad(vertex(i, j), vertex(i + 1, j), vertex(i + 1, j + 1),
+            vertex(i, j + 1), _mesh);
+      }
+      _mesh.triangles.insert(_mesh.triangles.end(),
+          {_bottom, vertex(_rings - 1, j + 1), vertex(_rings - 1, j)});
+    }
+  }
+
+  /// \brief Add a sphere centered on the origin.
+  /// \param[in] _radius Radius.
+  /// \param[out] _mesh Mesh to add to.
+  void AddSphere(const double _radius, HydrostaticsMesh &_mesh)
+  {
+    const uint32_t rings = 8;
+    const uint32_t segments = 12;
+    uint32_t top = AddVertex(ignition::math::Vector3d(0, 0, _radius), _mesh);
+    uint32_t bottom =
+        AddVertex(ignition::math::Vector3d(0, 0, -_radius), _mesh);
+    uint32_t first = static_cast<uint32_t>(_mesh.x.size());
+    for (uint32_t i = 1; i < rings; ++i)
+    {
+      const double theta = IGN_PI * i / rings;
+      for (uint32_t j = 0; j < segments; ++j)
+      {
+        const double phi = 2 * IGN_PI * j / segments;
+        AddVertex(_radius * ignition::math::Vector3d(
+            std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi),
+            std::cos(theta)), _mesh);
+      }
+    }
+    AddRings(top, bottom, first, rings - 1, segments, _mesh);
+  }
+
+  /// \brief Add a cylinder along Z centered on the origin.
+  /// \param[in] _radius Radius.
+  /// \param[in] _length Length.
+  /// \param[out] _mesh Mesh to add to.
+  void AddCylinder(const double _radius, const double _length,
+      HydrostaticsMesh &_mesh)
+  {
+    const uint32_t segments = 16;
+    uint32_t top =
+        AddVertex(ignition::math::Vector3d(0, 0, 0.5 * _length), _mesh);
+    uint32_t bottom =
+        AddVertex(ignition::math::Vector3d(0, 0, -0.5 * _length), _mesh);
+    uint32_t first = static_cast<uint32_t>(_mesh.x.size());
+    for (double z : {0.5 * _length, -0.5 * _length})
+    {
+      for (uint32_t j = 0; j < segments; ++j)
+      {
+        const double phi = 2 * IGN_PI * j / segments;
+        AddVertex(ignition::math::Vector3d(_radius * std::cos(phi),
+            _radius * std::sin(phi), z), _mesh);
+      }
+    }
+    AddRings(top, bottom, first, 2, segments, _mesh);
+  }
+
+  /// \brief Add a mesh, simplified by merging the vertices that fall in
+  /// the same cell of a grid over its bounding box.
+  /// \param[in] _mesh Mesh to add.
+  /// \param[in] _scale Scale of the mesh.
+  /// \param[in] _cells Number of grid cells along each axis.
+  /// \param[out] _out Mesh to add to.
+  void AddMesh(const common::Mesh &_mesh,
+      const ignition::math::Vector3d &_scale, const unsigned int _cells,
+      HydrostaticsMesh &_out)
+  {
+    ignition::math::Vector3d min = _mesh.Min() * _scale;
+    ignition::math::Vector3d max = _mesh.Max() * _scale;
+    ignition::math::Vector3d cell = (max - min) / _cells;
+    for (int a = 0; a < 3; ++a)
+      cell[a] = std::max(std::abs(cell[a]), 1e-9);
+
+    // Sum of the vertices in each cell
+    std::map<uint64_t, std::pair<ignition::math::Vector3d, int>> clusters;
+    auto key = [&](const ignition::math::Vector3d &_p)
+    {
+      uint64_t k = 0;
+      for (int a = 0; a < 3; ++a)
+      {
+        uint64_t c = static_cast<uint64_t>(std::min<double>(_cells - 1,
+            std::max(0.0, std::floor((_p[a] - std::min(min[a], max[a])) /
+            cell[a]))));
+        k = (k << 21) | c;
+      }
+      return k;
+    };
+
+    std::vector<uint64_t> keys;
+    std::vector<uint32_t> triangles;
+    for (unsigned int s = 0; s < _mesh.GetSubMeshCount(); ++s)
+    {
+      const common::SubMesh *subMesh = _mesh.GetSubMesh(s);
+      if (subMesh->GetPrimitiveType() != common::SubMesh::TRIANGLES)
+        continue;
+
+      const uint32_t offset = static_cast<uint32_t>(keys.size());
+      for (unsigned int i = 0; i < subMesh->GetVertexCount(); ++i)
+      {
+        ignition::math::Vector3d p = subMesh->Vertex(i) * _scale;
+        keys.push_back(key(p));
+        auto &cluster = clusters[keys.back()];
+        cluster.first += p;
+        ++cluster.second;
+      }
+      for (unsigned int i = 0; i + 2 < subMesh->GetIndexCount(); i += 3)
+      {
+        for (unsigned int v = 0; v < 3; ++v)
+          triangles.push_back(offset + subMesh->GetIndex(i + v));
+      }
+    }
+
+    // One vertex per cell, at the average of its vertices
+    std::map<uint64_t, uint32_t> indices;
+    for (auto const &cluster : clusters)
+    {
+      indices[cluster.first] = AddVertex(
+          cluster.second.first / cluster.second.second, _out);
+    }
+
+    // Keep the triangles whose corners are in different cells
+    for (size_t t = 0; t + 2 < triangles.size(); t += 3)
+    {
+      if (triangles[t] >= keys.size() || triangles[t + 1] >= keys.size() ||
+          triangles[t + 2] >= keys.size())
+      {
+        continue;
+      }
+
+      const uint32_t a = indices[keys[triangles[t]]];
+      const uint32_t b = indices[keys[triangles[t + 1]]];
+      const uint32_t c = indices[keys[triangles[t + 2]]];
+      if (a != b && b != c && a != c)
+        _out.triangles.insert(_out.triangles.end(), {a, b, c});
+    }
+  }
+
+  /// \brief Add the force of a submerged triangle.
+  /// \param[in] _a First corner.
+  /// \param[in] _ha Depth of the first corner.
+  /// \param[in] _b Second corner.
+  /// \param[in] _hb Depth of the second corner.
+  /// \param[in] _c Third corner.
+  /// \param[in] _hc Depth of the third corner.
+  /// \param[in] _ctx State of the link.
+  /// \param[in,out] _force Force on the link.
+  /// \param[in,out] _torque Torque on the link about its center of gravity.
+  void AddSubmerged(const ignition::math::Vector3d &_a, const double _ha,
+      const ignition::math::Vector3d &_b, const double _hb,
+      const ignition::math::Vector3d &_c, const double _hc,
+      const HydrostaticsContext &_ctx, ignition::math::Vector3d &_force,
+      ignition::math::Vector3d &_torque)
+  {
+    // Outward normal scaled by the area
+    const ignition::math::Vector3d area = 0.5 * (_b - _a).Cross(_c - _a);
+    const double areaLength = area.Length();
+    if (areaLength < 1e-12)
+      return;
+
+    // The pressure varies linearly over the triangle, so the force is the
+    // pressure at the centroid times the area
+    const ignition::math::Vector3d center = (_a + _b + _c) / 3.0;
+    const double depth = (_ha + _hb + _hc) / 3.0;
+    ignition::math::Vector3d force = -_ctx.pressure * depth * area;
+
+    // Drag on the faces moving against the water
+    const ignition::math::Vector3d r = center - _ctx.cog;
+    const ignition::math::Vector3d normal = area / areaLength;
+    const double speed = (_ctx.vel + _ctx.angVel.Cross(r)).Dot(normal);
+    if (speed > 0)
+    {
+      force -= (_ctx.linearDrag * speed +
+          _ctx.quadraticDrag * speed * speed) * areaLength * normal;
+    }
+
+    _force += force;
+    _torque += r.Cross(force);
+  }
+
+  /// \brief Clip a triangle against the water surface and add the force on
+  /// its submerged part.
+  /// \param[in] _p Corners.
+  /// \param[in] _h Depths of the corners.
+  /// \param[in] _ctx State of the link.
+  /// \param[in,out] _force Force on the link.
+  /// \param[in,out] _torque Torque on the link about its center of gravity.
+  void AddTriangle(const ignition::math::Vector3d _p[3], const double _h[3],
+      const HydrostaticsContext &_ctx, ignition::math::Vector3d &_force,
+      ignition::math::Vector3d &_torque)
+  {
+    const int submerged = (_h[0] > 0) + (_h[1] > 0) + (_h[2] > 0);
+    if (submerged == 0)
+      return;
+
+    if (submerged == 3)
+    {
+      AddSubmerged(_p[0], _h[0], _p[1], _h[1], _p[2], _h[2], _ctx, _force,
+          _torque);
+      return;
+    }
+
+    // Walk the edges, keeping the submerged corners and the points where
+    // edges cross the surface. The polygon has 3 or 4 corners.
+    ignition::math::Vector3d poly[4];
+    double depth[4];
+    int n = 0;
+    for (int i = 0; i < 3; ++i)
+    {
+      const int j = (i + 1) % 3;
+      if (_h[i] > 0)
+      {
+        poly[n] = _p[i];
+        depth[n++] = _h[i];
+      }
+      if ((_h[i] > 0) != (_h[j] > 0))
+      {
+        poly[n] = _p[i] + (_p[j] - _p[i]) * (_h[i] / (_h[i] - _h[j]));
+        depth[n++] = 0;
+      }
+    }
+
+    for (int i = 1; i + 1 < n; ++i)
+    {
+      AddSubmerged(poly[0], depth[0], poly[i], depth[i], poly[i + 1],
+          depth[i + 1], _ctx, _force, _torque);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+bool HydrostaticsPluginPrivate::BuildLinkMesh(const physics::LinkPtr &_link,
+    HydrostaticsMesh &_mesh) const
+{
+  for (auto const &collision : _link->GetCollisions())
+  {
+    physics::ShapePtr shape = collision->GetShape();
+    const size_t first = _mesh.x.size();
+    if (shape->HasType(physics::Base::BOX_SHAPE))
+    {
+      AddBox(boost::static_pointer_cast<physics::BoxShape>(shape)->Size(),
+          _mesh);
+    }
+    else if (shape->HasType(physics::Base::SPHERE_SHAPE))
+    {
+      AddSphere(boost::static_pointer_cast<physics::SphereShape>(
+          shape)->GetRadius(), _mesh);
+    }
+    else if (shape->HasType(physics::Base::CYLINDER_SHAPE))
+    {
+      auto cylinder = boost::static_pointer_cast<physics::CylinderShape>(shape);
+      AddCylinder(cylinder->GetRadius(), cylinder->GetLength(), _mesh);
+    }
+    else if (shape->HasType(physics::Base::MESH_SHAPE))
+    {
+      auto meshShape = boost::static_pointer_cast<physics::MeshShape>(shape);
+      const common::Mesh *mesh = common::MeshManager::Instance()->Load(
+          common::find_file(meshShape->GetMeshURI()));
+      if (!mesh)
+      {
+        gzwarn << "Unable to load mesh [" << meshShape->GetMeshURI()
+               << "] of collision [" << collision->GetScopedName()
+               << "], it will not float" << std::endl;
+        continue;
+      }
+      AddMesh(*mesh, meshShape->Size(), this->meshCells, _mesh);
+    }
+    else
+    {
+      continue;
+    }
+
+    // Move the new vertices to the link frame
+    const ignition::math::Pose3d pose = collision->RelativePose();
+    for (size_t i = first; i < _mesh.x.size(); ++i)
+    {
+      ignition::math::Vector3d p = pose.CoordPositionAdd(
+          ignition::math::Vector3d(_mesh.x[i], _mesh.y[i], _mesh.z[i]));
+      _mesh.x[i] = p.X();
+      _mesh.y[i] = p.Y();
+      _mesh.z[i] = p.Z();
+    }
+  }
+
+  return !_mesh.triangles.empty();
+}
+
+/////////////////////////////////////////////////
+bool HydrostaticsPluginPrivate::ModelsChanged() const
+{
+  const unsigned int count = this->world->ModelCount();
+  if (count != this->modelIds.size())
+    return true;
+
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    if (this->world->ModelByIndex(i)->GetId() != this->modelIds[i])
+      return true;
+  }
+  return false;
+}
+
+/////////////////////////////////////////////////
+void HydrostaticsPluginPrivate::AddModel(const physics::ModelPtr &_model,
+    const bool _selected,
+    std::unordered_map<uint32_t, HydrostaticsMesh> &_meshesInUse)
+{
+  if (_model->IsStatic())
+    return;
+
+  const bool selected = _selected || this->modelNames.empty() ||
+      this->modelNames.count(_model->GetName()) > 0;
+
+  for (auto const &nested : _model->NestedModels())
+    this->AddModel(nested, selected, _meshesInUse);
+
+  if (!selected)
+    return;
+
+  for (auto const &link : _model->GetLinks())
+  {
+    const uint32_t id = link->GetId();
+    auto it = this->meshes.find(id);
+    if (it != this->meshes.end())
+    {
+      _meshesInUse[id] = std::move(it->second);
+    }
+    else
+    {
+      HydrostaticsMesh mesh;
+      if (!this->BuildLinkMesh(link, mesh))
+        continue;
+      _meshesInUse[id] = std::move(mesh);
+    }
+    const HydrostaticsMesh &mesh = _meshesInUse[id];
+
+    HydrostaticsLink floating;
+    floating.link = link;
+    floating.firstVertex = static_cast<uint32_t>(this->local.x.size());
+    floating.vertexCount = static_cast<uint32_t>(mesh.x.size());
+    floating.firstIndex = static_cast<uint32_t>(
+        this->local.triangles.size());
+    floating.indexCount = static_cast<uint32_t>(mesh.triangles.size());
+    this->links.push_back(floating);
+
+    this->local.x.insert(this->local.x.end(), mesh.x.begin(), mesh.x.end());
+    this->local.y.insert(this->local.y.end(), mesh.y.begin(), mesh.y.end());
+    this->local.z.insert(this->local.z.end(), mesh.z.begin(), mesh.z.end());
+    for (auto const index : mesh.triangles)
+      this->local.triangles.push_back(floating.firstVertex + index);
+  }
+}
+
+/////////////////////////////////////////////////
+void HydrostaticsPluginPrivate::Rebuild()
+{
+  this->modelIds.clear();
+  this->links.clear();
+  this->local = HydrostaticsMesh();
+
+  std::unordered_map<uint32_t, HydrostaticsMesh> meshesInUse;
+  for (auto const &model : this->world->Models())
+  {
+    this->modelIds.push_back(model->GetId());
+    this->AddModel(model, false, meshesInUse);
+  }
+  this->meshes.swap(meshesInUse);
+
+  const size_t vertices = this->local.x.size();
+  this->worldX.resize(vertices);
+  this->worldY.resize(vertices);
+  this->worldZ.resize(vertices);
+  this->depth.resize(vertices);
+}
+
+/////////////////////////////////////////////////
+HydrostaticsPlugin::HydrostaticsPlugin()
+  : dataPtr(new HydrostaticsPluginPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+HydrostaticsPlugin::~HydrostaticsPlugin()
+{
+  this->dataPtr->updateConnection.reset();
+}
+
+/////////////////////////////////////////////////
+void HydrostaticsPlugin::Load(physics::WorldPtr _world, sdf::ElementPtr _sdf)
+{
+  GZ_ASSERT(_world != nullptr, "Received NULL world pointer");
+  GZ_ASSERT(_sdf != nullptr, "Received NULL SDF pointer");
+  this->dataPtr->world = _world;
+  this->dataPtr->worldName = _world->Name();
+
+  if (_sdf->HasElement("fluid_density"))
+    this->dataPtr->fluidDensity = _sdf->Get<double>("fluid_density");
+  if (_sdf->HasElement("water_level"))
+    this->dataPtr->waterLevel = _sdf->Get<double>("water_level");
+  if (_sdf->HasElement("linear_drag"))
+    this->dataPtr->linearDrag = _sdf->Get<double>("linear_drag");
+  if (_sdf->HasElement("quadratic_drag"))
+    this->dataPtr->quadraticDrag = _sdf->Get<double>("quadratic_drag");
+  if (_sdf->HasElement("mesh_cells"))
+  {
+    this->dataPtr->meshCells =
+        std::max(1u, _sdf->Get<unsigned int>("mesh_cells"));
+  }
+
+  const double gravity = _world->Gravity().Length();
+  for (sdf::ElementPtr waveElem = _sdf->HasElement("wave") ?
+       _sdf->GetElement("wave") : nullptr; waveElem;
+       waveElem = waveElem->GetNextElement("wave"))
+  {
+    const double wavelength = waveElem->Get<double>("wavelength");
+    if (wavelength <= 0)
+    {
+      gzwarn << "Nonpositive wavelength in HydrostaticsPlugin, "
+             << "skipping wave" << std::endl;
+      continue;
+    }
+
+    HydrostaticsWave wave;
+    wave.amplitude = waveElem->Get<double>("amplitude");
+    wave.k = 2 * IGN_PI / wavelength;
+    wave.omega = std::sqrt(gravity * wave.k);
+    if (waveElem->HasElement("direction"))
+    {
+      ignition::math::Vector2d dir =
+          waveElem->Get<ignition::math::Vector2d>("direction");
+      if (dir.Length() > 0)
+      {
+        dir.Normalize();
+        wave.dirX = dir.X();
+        wave.dirY = dir.Y();
+      }
+    }
+    if (waveElem->HasElement("phase"))
+      wave.phase = waveElem->Get<double>("phase");
+    this->dataPtr->waves.push_back(wave);
+  }
+
+  for (sdf::ElementPtr modelElem = _sdf->HasElement("model") ?
+       _sdf->GetElement("model") : nullptr; modelElem;
+       modelElem = modelElem->GetNextElement("model"))
+  {
+    this->dataPtr->modelNames.insert(modelElem->Get<std::string>());
+  }
+
+  this->dataPtr->updateConnection = event::Events::ConnectWorldUpdateBegin(
+      std::bind(&HydrostaticsPlugin::OnUpdate, this, std::placeholders::_1));
+}
+
+/////////////////////////////////////////////////
+double HydrostaticsPlugin::WaterHeight(const double _x, const double _y,
+    const double _time) const
+{
+  double height = this->dataPtr->waterLevel;
+  for (auto const &wave : this->dataPtr->waves)
+  {
+    height += wave.amplitude * std::sin(
+        wave.k * (wave.dirX * _x + wave.dirY * _y) - wave.omega * _time +
+        wave.phase);
+  }
+  return height;
+}
+
+/////////////////////////////////////////////////
+unsigned int HydrostaticsPlugin::FloatingLinkCount() const
+{
+  return static_cast<unsigned int>(this->dataPtr->links.size());
+}
+
+/////////////////////////////////////////////////
+void HydrostaticsPlugin::OnUpdate(const common::UpdateInfo &_info)
+{
+  auto &d = *this->dataPtr;
+
+  // World Update events are global, and worlds in a WorldBatch are
+  // stepped in parallel, so only update for the world of the plugin.
+  if (_info.worldName != d.worldName)
+    return;
+
+  IGN_PROFILE("HydrostaticsPlugin::OnUpdate");
+
+  if (d.ModelsChanged())
+    d.Rebuild();
+
+  if (d.links.empty())
+    return;
+
+  IGN_PROFILE_BEGIN("Transform");
+  // Move the vertices of every link to the world frame. The arrays are
+  // contiguous so that the compiler can vectorize the loops.
+  for (auto const &floating : d.links)
+  {
+    const ignition::math::Pose3d pose = floating.link->WorldPose();
+    const ignition::math::Matrix3d rot(pose.Rot());
+    const double px = pose.Pos().X();
+    const double py = pose.Pos().Y();
+    const double pz = pose.Pos().Z();
+
+    const double *lx = d.local.x.data() + floating.firstVertex;
+    const double *ly = d.local.y.data() + floating.firstVertex;
+    const double *lz = d.local.z.data() + floating.firstVertex;
+    double *wx = d.worldX.data() + floating.firstVertex;
+    double *wy = d.worldY.data() + floating.firstVertex;
+    double *wz = d.worldZ.data() + floating.firstVertex;
+    for (uint32_t i = 0; i < floating.vertexCount; ++i)
+    {
+      wx[i] = rot(0, 0) * lx[i] + rot(0, 1) * ly[i] + rot(0, 2) * lz[i] + px;
+      wy[i] = rot(1, 0) * lx[i] + rot(1, 1) * ly[i] + rot(1, 2) * lz[i] + py;
+      wz[i] = rot(2, 0) * lx[i] + rot(2, 1) * ly[i] + rot(2, 2) * lz[i] + pz;
+    }
+  }
+  IGN_PROFILE_END();
+
+  IGN_PROFILE_BEGIN("Surface");
+  // Depth of every vertex below the surface
+  const size_t vertices = d.depth.size();
+  const double time = d.world->SimTime().Double();
+  for (size_t i = 0; i < vertices; ++i)
+    d.depth[i] = d.waterLevel - d.worldZ[i];
+  for (auto const &wave : d.waves)
+  {
+    const double kx = wave.k * wave.dirX;
+    const double ky = wave.k * wave.dirY;
+    const double phase = wave.phase - wave.omega * time;
+    for (size_t i = 0; i < vertices; ++i)
+    {
+      d.depth[i] += wave.amplitude *
+          std::sin(kx * d.worldX[i] + ky * d.worldY[i] + phase);
+    }
+  }
+  IGN_PROFILE_END();
+
+  IGN_PROFILE_BEGIN("Forces");
+  HydrostaticsContext ctx;
+  ctx.pressure = d.fluidDensity * d.world->Gravity().Length();
+  ctx.linearDrag = d.linearDrag;
+  ctx.quadraticDrag = d.quadraticDrag;
+  for (auto const &floating : d.links)
+  {
+    const double *h = d.depth.data() + floating.firstVertex;
+    if (*std::max_element(h, h + floating.vertexCount) <= 0)
+      continue;
+
+    ctx.cog = floating.link->WorldCoGPose().Pos();
+    ctx.vel = floating.link->WorldCoGLinearVel();
+    ctx.angVel = floating.link->WorldAngularVel();
+
+    ignition::math::Vector3d force;
+    ignition::math::Vector3d torque;
+    const uint32_t *index = d.local.triangles.data() + floating.firstIndex;
+    for (uint32_t t = 0; t < floating.indexCount; t += 3)
+    {
+      ignition::math::Vector3d p[3];
+      double depth[3];
+      for (int v = 0; v < 3; ++v)
+      {
+        const uint32_t i = index[t + v];
+        p[v].Set(d.worldX[i], d.worldY[i], d.worldZ[i]);
+        depth[v] = d.depth[i];
+      }
+      AddTriangle(p, depth, ctx, force, torque);
+    }
+
+    floating.link->AddForce(force);
+    floating.link->AddTorque(torque);
+  }
+  IGN_PROFILE_END();
+}
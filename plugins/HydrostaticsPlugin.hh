@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PLUGINS_HYDROSTATICSPLUGIN_HH_
+#define GAZEBO_PLUGINS_HYDROSTATICSPLUGIN_HH_
+
+#include <memory>
+
+#include "gazebo/common/Plugin.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  // Forward declare private data class.
+  class HydrostaticsPluginPrivate;
+
+  /// \brief A world plugin that applies buoyancy and drag to floating
+  /// models, from the part of their collision shapes under a water surface.
+  ///
+  /// When a model is found, the collisions of each of its links, including
+  /// the links of its nested models, are turned into a closed triangle mesh
+  /// in the link frame. Boxes, spheres and cylinders are tessellated, and
+  /// meshes are simplified by clustering their vertices on a grid. Other
+  /// shapes are ignored.
+  ///
+  /// Every step, the triangles of all the floating links are moved to the
+  /// world frame and clipped against the water surface in a single pass.
+  /// Each submerged triangle receives the hydrostatic pressure at its
+  /// depth, which adds up to the buoyancy of the submerged volume, and a
+  /// drag force along its normal when it moves against the water.
+  ///
+  /// The water surface is horizontal, with gravity along -Z, and may carry
+  /// a sum of sinusoidal deep water waves.
+  ///
+  /// All SDF parameters are optional:
+  /// <fluid_density> Density of the fluid in kg/m^3, defaults to 999.1026.
+  /// <water_level>   Height of the calm surface in meters, defaults to 0.
+  /// <linear_drag>   Drag per unit of area and normal speed, in N.s/m^3,
+  ///                 defaults to 0.
+  /// <quadratic_drag> Drag per unit of area and squared normal speed, in
+  ///                 N.s^2/m^4, defaults to 0.
+  /// <mesh_cells>    Number of grid cells along each axis used to simplify
+  ///                 mesh collisions, defaults to 16.
+  /// <wave>          A wave, may be repeated:
+  ///   <amplitude>   Amplitude in meters.
+  ///   <wavelength>  Wavelength in meters.
+  ///   <direction>   Direction of travel in the XY plane, defaults to 1 0.
+  ///   <phase>       Phase in radians, defaults to 0.
+  /// <model>         Name of a floating model, may be repeated. Nested
+  ///                 models can be named too. When none is given, every
+  ///                 non static model floats.
+  ///
+  /// Example:
+  /// <plugin name="hydrostatics" filename="libHydrostaticsPlugin.so">
+  ///   <linear_drag>20</linear_drag>
+  ///   <quadratic_drag>200</quadratic_drag>
+  ///   <wave>
+  ///     <amplitude>0.3</amplitude>
+  ///     <wavelength>12</wavelength>
+  ///   </wave>
+  /// </plugin>
+  class GZ_PLUGIN_VISIBLE HydrostaticsPlugin : public WorldPlugin
+  {
+    /// \brief Constructor.
+    public: HydrostaticsPlugin();
+
+    /// \brief Destructor.
+    public: virtual ~HydrostaticsPlugin();
+
+    // Documentation inherited
+    public: virtual void Load(physics::WorldPtr _world, sdf::ElementPtr _sdf);
+
+    /// \brief Get the height of the water surface.
+    /// \param[in] _x X coordinate in the world frame.
+    /// \param[in] _y Y coordinate in the world frame.
+    /// \param[in] _time Simulation time in seconds.
+    /// \return Height of the surface in the world frame.
+    public: double WaterHeight(const double _x, const double _y,
+                               const double _time) const;
+
+    /// \brief Get the number of links currently floating.
+    /// \return Number of links.
+    public: unsigned int FloatingLinkCount() const;
+
+    /// \brief Callback for World Update events.
+    /// \param[in] _info Update information of the world being updated.
+    private: void OnUpdate(const common::UpdateInfo &_info);
+
+    /// \brief Pointer to private data.
+    private: std::unique_ptr<HydrostaticsPluginPrivate> dataPtr;
+  };
+}
+#endif
@@ -17,7 +17,10 @@
 
 #include <algorithm>
 #include <functional>
+#include <map>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include <ignition/common/Profiler.hh>
 #include <ignition/math/Pose3.hh>
@@ -32,6 +35,468 @@ using namespace gazebo;
 
 GZ_REGISTER_MODEL_PLUGIN(LiftDragPlugin)
 
+namespace gazebo
+{
+  /// \brief A group of lifting surfaces evaluated together. Surface
+  /// parameters, link states and results are stored by component in flat
+  /// arrays, so that every surface is evaluated in one pass.
+  class LiftDragBatch
+  {
+    /// \brief Get the batch shared by the surfaces of a world, creating
+    /// it if needed.
+    /// \param[in] _world The world.
+    /// \return The batch of the world.
+    public: static std::shared_ptr<LiftDragBatch> Shared(
+                const physics::WorldPtr &_world);
+
+    /// \brief Add a surface.
+    /// \param[in] _surface Surface to add, must have a link.
+    public: void Add(LiftDragPlugin *_surface);
+
+    /// \brief Remove a surface.
+    /// \param[in] _surface Surface to remove.
+    public: void Remove(LiftDragPlugin *_surface);
+
+    /// \brief Evaluate and apply the forces of all surfaces.
+    public: void Update();
+
+    /// \brief Update the batch if it belongs to the world being updated.
+    /// \param[in] _info Update information of the world.
+    private: void OnWorldUpdate(const common::UpdateInfo &_info);
+
+    /// \brief Group the surfaces by link and size the arrays.
+    private: void Rebuild();
+
+    /// \brief Copy the parameters of the surfaces into the arrays.
+    private: void CopyParameters();
+
+    /// \brief Read the state of the links and of the control joints.
+    private: void Gather();
+
+    /// \brief Compute the force of every surface.
+    private: void Evaluate();
+
+    /// \brief Apply the summed wrench of every link.
+    private: void Apply();
+
+    /// \brief Connection to World Update events, for shared batches.
+    private: event::ConnectionPtr updateConnection;
+
+    /// \brief Name of the world of a shared batch.
+    private: std::string worldName;
+
+    /// \brief Protects the list of surfaces.
+    private: std::mutex mutex;
+
+    /// \brief Surfaces in the batch.
+    private: std::vector<LiftDragPlugin *> surfaces;
+
+    /// \brief True when surfaces were added or removed.
+    private: bool dirty = false;
+
+    /// \brief Distinct links of the surfaces.
+    private: std::vector<physics::LinkPtr> links;
+
+    /// \brief Index in links of each surface.
+    private: std::vector<size_t> surfaceLink;
+
+    /// \brief Parameters of each surface, see LiftDragPlugin.
+    private: std::vector<double> alpha0, cla, cda, alphaStall, claStall,
+                 cdaStall, area, rho, controlJointRadToCL;
+
+    /// \brief Center of pressure of each surface in the link frame.
+    private: std::vector<double> cpX, cpY, cpZ;
+
+    /// \brief Forward and upward vectors of each surface in the link
+    /// frame.
+    private: std::vector<double> forwardX, forwardY, forwardZ,
+                 upwardX, upwardY, upwardZ;
+
+    /// \brief Whether each surface is radially symmetric.
+    private: std::vector<char> radialSymmetry;
+
+    /// \brief Velocity of each center of pressure in the world frame.
+    private: std::vector<double> velX, velY, velZ;
+
+    /// \brief Moment arm from the center of gravity to the center of
+    /// pressure of each surface, in the world frame.
+    private: std::vector<double> armX, armY, armZ;
+
+    /// \brief Forward and upward vectors in the world frame.
+    private: std::vector<double> forwardIX, forwardIY, forwardIZ,
+                 upwardIX, upwardIY, upwardIZ;
+
+    /// \brief Lift coefficient added by the control joint of each surface.
+    private: std::vector<double> controlCL;
+
+    /// \brief Force of each surface in the world frame.
+    private: std::vector<double> forceX, forceY, forceZ;
+
+    /// \brief Angle of attack and sweep of each surface.
+    private: std::vector<double> alpha, sweep;
+
+    /// \brief Whether each surface was evaluated in the last update.
+    /// Surfaces that move too slowly are skipped, and keep the angle of
+    /// attack and sweep of their last evaluation.
+    private: std::vector<char> evaluated;
+  };
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<LiftDragBatch> LiftDragBatch::Shared(
+    const physics::WorldPtr &_world)
+{
+  static std::mutex registryMutex;
+  static std::map<const physics::World *, std::weak_ptr<LiftDragBatch>>
+      registry;
+
+  std::lock_guard<std::mutex> lock(registryMutex);
+
+  // Forget the batches of removed worlds, whose address may be reused
+  for (auto it = registry.begin(); it != registry.end();)
+  {
+    if (it->second.expired())
+      it = registry.erase(it);
+    else
+      ++it;
+  }
+
+  std::shared_ptr<LiftDragBatch> batch = registry[_world.get()].lock();
+  if (!batch)
+  {
+    batch = std::make_shared<LiftDragBatch>();
+    batch->worldName = _world->Name();
+    batch->updateConnection = event::Events::ConnectWorldUpdateBegin(
+        std::bind(&LiftDragBatch::OnWorldUpdate, batch.get(),
+        std::placeholders::_1));
+    registry[_world.get()] = batch;
+  }
+  return batch;
+}
+
+/////////////////////////////////////////////////
+void LiftDragBatch::OnWorldUpdate(const common::UpdateInfo &_info)
+{
+  // World Update events are global, and worlds in a WorldBatch are
+  // stepped in parallel, so only the world of the batch updates it.
+  if (_info.worldName == this->worldName)
+    this->Update();
+}
+
+/////////////////////////////////////////////////
+void LiftDragBatch::Add(LiftDragPlugin *_surface)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->surfaces.push_back(_surface);
+  this->dirty = true;
+}
+
+/////////////////////////////////////////////////
+void LiftDragBatch::Remove(LiftDragPlugin *_surface)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->surfaces.erase(std::remove(this->surfaces.begin(),
+      this->surfaces.end(), _surface), this->surfaces.end());
+  this->dirty = true;
+}
+
+/////////////////////////////////////////////////
+void LiftDragBatch::Rebuild()
+{
+  // Surfaces of the same link are next to each other
+  std::stable_sort(this->surfaces.begin(), this->surfaces.end(),
+      [](const LiftDragPlugin *_a, const LiftDragPlugin *_b)
+      {
+        return _a->link.get() < _b->link.get();
+      });
+
+  const size_t n = this->surfaces.size();
+  this->links.clear();
+  this->surfaceLink.resize(n);
+  for (auto *v : {&this->alpha0, &this->cla, &this->cda, &this->alphaStall,
+       &this->claStall, &this->cdaStall, &this->area, &this->rho,
+       &this->controlJointRadToCL, &this->cpX, &this->cpY, &this->cpZ,
+       &this->forwardX, &this->forwardY, &this->forwardZ, &this->upwardX,
+       &this->upwardY, &this->upwardZ, &this->velX, &this->velY, &this->velZ,
+       &this->armX, &this->armY, &this->armZ, &this->forwardIX,
+       &this->forwardIY, &this->forwardIZ, &this->upwardIX, &this->upwardIY,
+       &this->upwardIZ, &this->controlCL, &this->forceX, &this->forceY,
+       &this->forceZ, &this->alpha, &this->sweep})
+  {
+    v->resize(n);
+  }
+  this->radialSymmetry.resize(n);
+  this->evaluated.resize(n);
+
+  for (size_t i = 0; i < n; ++i)
+  {
+    const LiftDragPlugin *s = this->surfaces[i];
+    if (this->links.empty() || this->links.back() != s->link)
+      this->links.push_back(s->link);
+    this->surfaceLink[i] = this->links.size() - 1;
+  }
+}
+
+/////////////////////////////////////////////////
+void LiftDragBatch::CopyParameters()
+{
+  // Surfaces may change their parameters at any time, as they would
+  // between two calls to LiftDragPlugin::OnUpdate.
+  const size_t n = this->surfaces.size();
+  for (size_t i = 0; i < n; ++i)
+  {
+    const LiftDragPlugin *s = this->surfaces[i];
+    this->alpha0[i] = s->alpha0;
+    this->cla[i] = s->cla;
+    this->cda[i] = s->cda;
+    this->alphaStall[i] = s->alphaStall;
+    this->claStall[i] = s->claStall;
+    this->cdaStall[i] = s->cdaStall;
+    this->area[i] = s->area;
+    this->rho[i] = s->rho;
+    this->controlJointRadToCL[i] = s->controlJointRadToCL;
+    this->cpX[i] = s->cp.X();
+    this->cpY[i] = s->cp.Y();
+    this->cpZ[i] = s->cp.Z();
+    this->forwardX[i] = s->forward.X();
+    this->forwardY[i] = s->forward.Y();
+    this->forwardZ[i] = s->forward.Z();
+    this->upwardX[i] = s->upward.X();
+    this->upwardY[i] = s->upward.Y();
+    this->upwardZ[i] = s->upward.Z();
+    this->radialSymmetry[i] = s->radialSymmetry;
+  }
+}
+
+/////////////////////////////////////////////////
+void LiftDragBatch::Gather()
+{
+  size_t i = 0;
+  for (size_t l = 0; l < this->links.size(); ++l)
+  {
+    const physics::LinkPtr &link = this->links[l];
+    const ignition::math::Quaterniond rot = link->WorldPose().Rot();
+    const ignition::math::Vector3d cog = link->GetInertial()->CoG();
+    const ignition::math::Vector3d cogVel = link->WorldCoGLinearVel();
+    const ignition::math::Vector3d angVel = link->WorldAngularVel();
+
+    for (; i < this->surfaceLink.size() && this->surfaceLink[i] == l; ++i)
+    {
+      const ignition::math::Vector3d arm = rot.RotateVector(
+          ignition::math::Vector3d(this->cpX[i], this->cpY[i], this->cpZ[i])
+          - cog);
+      const ignition::math::Vector3d vel = cogVel + angVel.Cross(arm);
+      const ignition::math::Vector3d forwardI = rot.RotateVector(
+          ignition::math::Vector3d(this->forwardX[i], this->forwardY[i],
+          this->forwardZ[i]));
+      const ignition::math::Vector3d upwardI = rot.RotateVector(
+          ignition::math::Vector3d(this->upwardX[i], this->upwardY[i],
+          this->upwardZ[i]));
+
+      this->armX[i] = arm.X();
+      this->armY[i] = arm.Y();
+      this->armZ[i] = arm.Z();
+      this->velX[i] = vel.X();
+      this->velY[i] = vel.Y();
+      this->velZ[i] = vel.Z();
+      this->forwardIX[i] = forwardI.X();
+      this->forwardIY[i] = forwardI.Y();
+      this->forwardIZ[i] = forwardI.Z();
+      this->upwardIX[i] = upwardI.X();
+      this->upwardIY[i] = upwardI.Y();
+      this->upwardIZ[i] = upwardI.Z();
+
+      const physics::JointPtr &joint = this->surfaces[i]->controlJoint;
+      this->controlCL[i] = joint ?
+          this->controlJointRadToCL[i] * joint->Position(0) : 0.0;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void LiftDragBatch::Evaluate()
+{
+  const double minRatio = -1.0;
+  const double maxRatio = 1.0;
+
+  const size_t n = this->surfaces.size();
+  for (size_t i = 0; i < n; ++i)
+  {
+    // linear velocity at cp in inertial frame
+    const ignition::math::Vector3d vel(
+        this->velX[i], this->velY[i], this->velZ[i]);
+    const double speed = vel.Length();
+    if (speed <= 0.01)
+    {
+      this->forceX[i] = this->forceY[i] = this->forceZ[i] = 0.0;
+      this->evaluated[i] = false;
+      continue;
+    }
+    this->evaluated[i] = true;
+    const ignition::math::Vector3d velI = vel / speed;
+
+    const ignition::math::Vector3d forwardI(
+        this->forwardIX[i], this->forwardIY[i], this->forwardIZ[i]);
+    ignition::math::Vector3d upwardI(
+        this->upwardIX[i], this->upwardIY[i], this->upwardIZ[i]);
+    if (this->radialSymmetry[i])
+    {
+      // use inflow velocity to determine upward direction
+      // which is the component of inflow perpendicular to forward direction.
+      upwardI = forwardI.Cross(forwardI.Cross(velI)).Normalize();
+    }
+
+    // spanwiseI: a vector normal to lift-drag-plane in inertial frame
+    ignition::math::Vector3d spanwiseI = forwardI.Cross(upwardI).Normalize();
+
+    // check sweep (angle between velI and lift-drag-plane)
+    const double sinSweepAngle = ignition::math::clamp(
+        spanwiseI.Dot(velI), minRatio, maxRatio);
+
+    // get cos from trig identity, asin is already within +/-90 deg
+    const double cosSweepAngle = 1.0 - sinSweepAngle * sinSweepAngle;
+    this->sweep[i] = asin(sinSweepAngle);
+
+    // removing spanwise velocity from vel gives the velocity in the
+    // lift-drag plane, the angle of attack is measured in that plane
+    const ignition::math::Vector3d velInLDPlane =
+        vel - vel.Dot(spanwiseI) * velI;
+
+    // get direction of drag
+    ignition::math::Vector3d dragDirection = -velInLDPlane;
+    dragDirection.Normalize();
+
+    // get direction of lift
+    ignition::math::Vector3d liftI = spanwiseI.Cross(velInLDPlane);
+    liftI.Normalize();
+
+    // angle between upwardI and liftI, both unit vectors
+    const double cosAlpha =
+        ignition::math::clamp(liftI.Dot(upwardI), minRatio, maxRatio);
+
+    // if forwardI is in the same direction as lift, alpha is positive.
+    double a = liftI.Dot(forwardI) >= 0.0 ?
+        this->alpha0[i] + acos(cosAlpha) : this->alpha0[i] - acos(cosAlpha);
+
+    // normalize to within +/-90 deg
+    while (fabs(a) > 0.5 * M_PI)
+      a = a > 0 ? a - M_PI : a + M_PI;
+    this->alpha[i] = a;
+
+    // compute dynamic pressure
+    const double speedInLDPlane = velInLDPlane.Length();
+    const double q = 0.5 * this->rho[i] * speedInLDPlane * speedInLDPlane;
+
+    // compute cl and cd at cp, check for stall, correct for sweep
+    const double stall = this->alphaStall[i];
+    double cl;
+    double cd;
+    if (a > stall)
+    {
+      // make sure cl is still great than 0
+      cl = std::max(0.0, (this->cla[i] * stall +
+          this->claStall[i] * (a - stall)) * cosSweepAngle);
+      cd = (this->cda[i] * stall +
+          this->cdaStall[i] * (a - stall)) * cosSweepAngle;
+    }
+    else if (a < -stall)
+    {
+      // make sure cl is still less than 0
+      cl = std::min(0.0, (-this->cla[i] * stall +
+          this->claStall[i] * (a + stall)) * cosSweepAngle);
+      cd = (-this->cda[i] * stall +
+          this->cdaStall[i] * (a + stall)) * cosSweepAngle;
+    }
+    else
+    {
+      cl = this->cla[i] * a * cosSweepAngle;
+      cd = this->cda[i] * a * cosSweepAngle;
+    }
+
+    // modify cl per control joint value
+    /// \TODO: also change cm and cd
+    cl += this->controlCL[i];
+
+    // make sure drag is positive
+    cd = fabs(cd);
+
+    // lift and drag at cp
+    const ignition::math::Vector3d lift = cl * q * this->area[i] * liftI;
+    const ignition::math::Vector3d drag =
+        cd * q * this->area[i] * dragDirection;
+
+    /// \TODO: implement cm, the pitching moment needs testing
+
+    // Correct for nan or inf
+    ignition::math::Vector3d force = lift + drag;
+    force.Correct();
+    this->forceX[i] = force.X();
+    this->forceY[i] = force.Y();
+    this->forceZ[i] = force.Z();
+  }
+}
+
+/////////////////////////////////////////////////
+void LiftDragBatch::Apply()
+{
+  size_t i = 0;
+  for (size_t l = 0; l < this->links.size(); ++l)
+  {
+    // The force of a surface at its cp is the same force at the center of
+    // gravity plus the torque of its moment arm
+    ignition::math::Vector3d force;
+    ignition::math::Vector3d torque;
+    for (; i < this->surfaceLink.size() && this->surfaceLink[i] == l; ++i)
+    {
+      const ignition::math::Vector3d f(
+          this->forceX[i], this->forceY[i], this->forceZ[i]);
+      force += f;
+      torque += ignition::math::Vector3d(
+          this->armX[i], this->armY[i], this->armZ[i]).Cross(f);
+    }
+
+    if (force != ignition::math::Vector3d::Zero)
+    {
+      this->links[l]->AddForce(force);
+      this->links[l]->AddTorque(torque);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void LiftDragBatch::Update()
+{
+  IGN_PROFILE("LiftDragBatch::Update");
+  std::lock_guard<std::mutex> lock(this->mutex);
+  if (this->dirty)
+  {
+    this->Rebuild();
+    this->dirty = false;
+  }
+
+  this->CopyParameters();
+
+  IGN_PROFILE_BEGIN("Gather");
+  this->Gather();
+  IGN_PROFILE_END();
+
+  IGN_PROFILE_BEGIN("Evaluate");
+  this->Evaluate();
+  IGN_PROFILE_END();
+
+  for (size_t i = 0; i < this->surfaces.size(); ++i)
+  {
+    if (!this->evaluated[i])
+      continue;
+    this->surfaces[i]->alpha = this->alpha[i];
+    this->surfaces[i]->sweep = this->sweep[i];
+  }
+
+  IGN_PROFILE_BEGIN("Apply");
+  this->Apply();
+  IGN_PROFILE_END();
+}
+
 /////////////////////////////////////////////////
 LiftDragPlugin::LiftDragPlugin() : cla(1.0), cda(0.01), cma(0.01), rho(1.2041)
 {
@@ -61,6 +526,9 @@ LiftDragPlugin::LiftDragPlugin() : cla(1.0), cda(0.01), cma(0.01), rho(1.2041)
 /////////////////////////////////////////////////
 LiftDragPlugin::~LiftDragPlugin()
 {
+  this->updateConnection.reset();
+  if (this->batch)
+    this->batch->Remove(this);
 }
 
 /////////////////////////////////////////////////
@@ -139,11 +607,6 @@ void LiftDragPlugin::Load(physics::ModelPtr _model,
       gzerr << "Link with name[" << linkName << "] not found. "
         << "The LiftDragPlugin will not generate forces\n";
     }
-    else
-    {
-      this->updateConnection = event::Events::ConnectWorldUpdateBegin(
-          std::bind(&LiftDragPlugin::OnUpdate, this));
-    }
   }
 
   if (_sdf->HasElement("control_joint_name"))
@@ -158,6 +621,21 @@ void LiftDragPlugin::Load(physics::ModelPtr _model,
 
   if (_sdf->HasElement("control_joint_rad_to_cl"))
     this->controlJointRadToCL = _sdf->Get<double>("control_joint_rad_to_cl");
+
+  if (!this->link)
+    return;
+
+  // Evaluate this surface along with the others of the world, or on its own
+  if (_sdf->HasElement("batched") && _sdf->Get<bool>("batched"))
+  {
+    this->batch = LiftDragBatch::Shared(this->world);
+    this->batch->Add(this);
+  }
+  else
+  {
+    this->updateConnection = event::Events::ConnectWorldUpdateBegin(
+        std::bind(&LiftDragPlugin::OnUpdate, this));
+  }
 }
 
 /////////////////////////////////////////////////
@@ -17,6 +17,7 @@
 #ifndef GAZEBO_PLUGINS_LIFTDRAGPLUGIN_HH_
 #define GAZEBO_PLUGINS_LIFTDRAGPLUGIN_HH_
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -28,9 +29,23 @@
 
 namespace gazebo
 {
+  // Forward declare the group of surfaces evaluated together.
+  class LiftDragBatch;
+
   /// \brief A plugin that simulates lift and drag.
+  ///
+  /// By default, each surface is evaluated on its own from OnUpdate. Set
+  /// <batched> to true to evaluate it together with the other batched
+  /// surfaces of its world once per step: link states are read once per
+  /// link, lift and drag are computed for every surface in a single pass,
+  /// and the resulting wrenches are applied once per link. OnUpdate is not
+  /// called for batched surfaces, so subclasses that override it should
+  /// leave <batched> unset.
   class GZ_PLUGIN_VISIBLE LiftDragPlugin : public ModelPlugin
   {
+    /// \brief The batch reads the parameters of its surfaces.
+    friend class LiftDragBatch;
+
     /// \brief Constructor.
     public: LiftDragPlugin();
 
@@ -136,6 +151,10 @@ namespace gazebo
 
     /// \brief SDF for this plugin;
     protected: sdf::ElementPtr sdf;
+
+    /// \brief Group of surfaces this one is evaluated with, shared by the
+    /// world. Null when the surface is not batched.
+    private: std::shared_ptr<LiftDragBatch> batch;
   };
 }
 #endif
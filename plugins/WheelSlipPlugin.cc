@@ -14,8 +14,14 @@
  * limitations under the License.
  *
 */
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+
+#include <algorithm>
 #include <map>
 #include <mutex>
+#include <string>
+#include <vector>
 
 #include <ignition/common/Profiler.hh>
 
@@ -51,6 +57,8 @@ namespace gazebo
     typedef boost::weak_ptr<physics::ODESurfaceParams> ODESurfaceParamsWeakPtr;
   }
 
+  class WheelSlipFleet;
+
   class WheelSlipPluginPrivate
   {
     public: class LinkSurfaceParams
@@ -85,6 +93,21 @@ namespace gazebo
       public: transport::PublisherPtr slipPub;
     };
 
+    /// \brief Compute the slip of a wheel.
+    /// \param[in] _modelRot Orientation of the parent model in the world.
+    /// \param[in] _link Wheel link.
+    /// \param[in] _params Wheel parameters.
+    /// \param[out] _slip Slip velocities, as documented in
+    /// WheelSlipPlugin::GetSlips.
+    /// \param[out] _spinAngularVelocity Link angular velocity about the
+    /// joint axis.
+    /// \return False if the wheel joint no longer exists.
+    public: bool Slip(const ignition::math::Quaterniond &_modelRot,
+                      const physics::LinkPtr &_link,
+                      const LinkSurfaceParams &_params,
+                      ignition::math::Vector3d &_slip,
+                      double &_spinAngularVelocity) const;
+
     /// \brief Initial gravity direction in parent model frame.
     public: ignition::math::Vector3d initialGravityDirection;
 
@@ -110,16 +133,307 @@ namespace gazebo
     /// \todo: Transition to ignition-transport in gazebo8.
     public: transport::SubscriberPtr longitudinalComplianceSub;
 
-    /// \brief Pointer to the update event connection
-    public: event::ConnectionPtr updateConnection;
+    /// \brief Fleet that updates the wheels.
+    public: std::shared_ptr<WheelSlipFleet> fleet;
+  };
+
+  /// \brief Wheels of all the WheelSlipPlugin instances of a world, updated
+  /// together once per update of that world. The wheels are kept in a flat
+  /// list, so their states are read and their slip parameters written in a
+  /// single pass, which is split across threads for large fleets.
+  class WheelSlipFleet
+  {
+    /// \brief A wheel of the fleet.
+    public: class Wheel
+    {
+      /// \brief Plugin that owns the wheel.
+      public: WheelSlipPluginPrivate *plugin = nullptr;
+
+      /// \brief Index of the plugin in plugins.
+      public: size_t pluginIndex = 0;
+
+      /// \brief Wheel link.
+      public: physics::LinkWeakPtr link;
+
+      /// \brief Wheel parameters, owned by the plugin.
+      public: WheelSlipPluginPrivate::LinkSurfaceParams *params = nullptr;
+
+      /// \brief Slip computed in the last update.
+      public: ignition::math::Vector3d slip;
+
+      /// \brief True if the slip was computed in the last update.
+      public: bool valid = false;
+    };
+
+    /// \brief Get the fleet shared by the plugins of a world, creating it
+    /// if needed. It lives as long as a plugin holds it.
+    /// \param[in] _world The world.
+    /// \return The fleet of the world.
+    public: static std::shared_ptr<WheelSlipFleet> Shared(
+                const physics::WorldPtr &_world);
+
+    /// \brief Add the wheels of a plugin. Its wheels must not change
+    /// afterwards.
+    /// \param[in] _plugin Plugin data.
+    public: void Add(WheelSlipPluginPrivate *_plugin);
+
+    /// \brief Remove the wheels of a plugin.
+    /// \param[in] _plugin Plugin data.
+    public: void Remove(WheelSlipPluginPrivate *_plugin);
+
+    /// \brief Update the slip parameters of all the wheels and publish
+    /// their slips.
+    public: void Update();
+
+    /// \brief Update the fleet if it belongs to the world being updated.
+    /// \param[in] _info Update information of the world.
+    private: void OnWorldUpdate(const common::UpdateInfo &_info);
+
+    /// \brief Rebuild the list of wheels from the plugins.
+    private: void Rebuild();
+
+    /// \brief Protects the members below.
+    private: std::mutex mutex;
+
+    /// \brief Plugins of the fleet.
+    private: std::vector<WheelSlipPluginPrivate *> plugins;
+
+    /// \brief Wheels of all the plugins, grouped by plugin.
+    private: std::vector<Wheel> wheels;
+
+    /// \brief Orientation of the parent model of each plugin, read once
+    /// per update.
+    private: std::vector<ignition::math::Quaterniond> modelRots;
+
+    /// \brief Name of the world of the fleet.
+    private: std::string worldName;
+
+    /// \brief Pointer to the update event connection.
+    private: event::ConnectionPtr updateConnection;
   };
 }
 
 using namespace gazebo;
 
+/// \brief Smallest fleet whose wheels are updated in parallel.
+static const size_t g_parallelWheelCount = 64;
+
 // Register the plugin
 GZ_REGISTER_MODEL_PLUGIN(WheelSlipPlugin)
 
+/////////////////////////////////////////////////
+bool WheelSlipPluginPrivate::Slip(
+    const ignition::math::Quaterniond &_modelRot,
+    const physics::LinkPtr &_link, const LinkSurfaceParams &_params,
+    ignition::math::Vector3d &_slip, double &_spinAngularVelocity) const
+{
+  auto joint = _params.joint.lock();
+  if (!joint)
+    return false;
+
+  // Compute wheel velocity in parent model frame
+  auto wheelWorldLinearVel = _link->WorldLinearVel();
+  auto wheelModelLinearVel = _modelRot.RotateVectorReverse(wheelWorldLinearVel);
+  // Compute wheel spin axis in parent model frame
+  auto jointAxis = joint->GlobalAxis(0);
+  auto wheelWorldAxis = jointAxis.Normalized();
+  auto wheelModelAxis = _modelRot.RotateVectorReverse(wheelWorldAxis);
+  // Estimate longitudinal direction as cross product of initial gravity
+  // direction with wheel spin axis.
+  auto longitudinalModelAxis =
+      this->initialGravityDirection.Cross(wheelModelAxis);
+
+  double spinSpeed = _params.wheelRadius * joint->GetVelocity(0);
+  double lateralSpeed = wheelModelAxis.Dot(wheelModelLinearVel);
+  double longitudinalSpeed = longitudinalModelAxis.Dot(wheelModelLinearVel);
+
+  _slip.X(longitudinalSpeed - spinSpeed);
+  _slip.Y(lateralSpeed);
+  _slip.Z(spinSpeed);
+
+  // get link angular velocity parallel to joint axis
+  _spinAngularVelocity = _link->WorldAngularVel().Dot(jointAxis);
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<WheelSlipFleet> WheelSlipFleet::Shared(
+    const physics::WorldPtr &_world)
+{
+  static std::mutex registryMutex;
+  static std::map<const physics::World *, std::weak_ptr<WheelSlipFleet>>
+      registry;
+
+  std::lock_guard<std::mutex> lock(registryMutex);
+
+  // Forget the fleets of removed worlds, whose address may be reused
+  for (auto it = registry.begin(); it != registry.end();)
+  {
+    if (it->second.expired())
+      it = registry.erase(it);
+    else
+      ++it;
+  }
+
+  std::shared_ptr<WheelSlipFleet> fleet = registry[_world.get()].lock();
+  if (!fleet)
+  {
+    fleet = std::make_shared<WheelSlipFleet>();
+    fleet->worldName = _world->Name();
+    fleet->updateConnection = event::Events::ConnectWorldUpdateBegin(
+        std::bind(&WheelSlipFleet::OnWorldUpdate, fleet.get(),
+        std::placeholders::_1));
+    registry[_world.get()] = fleet;
+  }
+  return fleet;
+}
+
+/////////////////////////////////////////////////
+void WheelSlipFleet::OnWorldUpdate(const common::UpdateInfo &_info)
+{
+  // World Update events are global, and worlds in a WorldBatch are
+  // stepped in parallel, so only the world of the fleet updates it.
+  if (_info.worldName == this->worldName)
+    this->Update();
+}
+
+/////////////////////////////////////////////////
+void WheelSlipFleet::Add(WheelSlipPluginPrivate *_plugin)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->plugins.push_back(_plugin);
+  this->Rebuild();
+}
+
+/////////////////////////////////////////////////
+void WheelSlipFleet::Remove(WheelSlipPluginPrivate *_plugin)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->plugins.erase(
+      std::remove(this->plugins.begin(), this->plugins.end(), _plugin),
+      this->plugins.end());
+  this->Rebuild();
+}
+
+/////////////////////////////////////////////////
+void WheelSlipFleet::Rebuild()
+{
+  this->wheels.clear();
+  for (size_t i = 0; i < this->plugins.size(); ++i)
+  {
+    for (auto &linkSurface : this->plugins[i]->mapLinkSurfaceParams)
+    {
+      Wheel wheel;
+      wheel.plugin = this->plugins[i];
+      wheel.pluginIndex = i;
+      wheel.link = linkSurface.first;
+      wheel.params = &linkSurface.second;
+      this->wheels.push_back(wheel);
+    }
+  }
+  this->modelRots.resize(this->plugins.size());
+}
+
+/////////////////////////////////////////////////
+void WheelSlipFleet::Update()
+{
+  IGN_PROFILE("WheelSlipFleet::Update");
+  IGN_PROFILE_BEGIN("Update");
+  std::lock_guard<std::mutex> lock(this->mutex);
+
+  // Lock the data of every plugin for the whole pass, and read each model
+  // pose once.
+  std::vector<std::unique_lock<std::mutex>> pluginLocks;
+  pluginLocks.reserve(this->plugins.size());
+  for (size_t i = 0; i < this->plugins.size(); ++i)
+  {
+    pluginLocks.emplace_back(this->plugins[i]->mutex);
+    auto model = this->plugins[i]->model.lock();
+    this->modelRots[i] = model ? model->WorldPose().Rot() :
+        ignition::math::Quaterniond::Identity;
+  }
+
+  auto updateWheel = [this](Wheel &_wheel)
+  {
+    _wheel.valid = false;
+    auto link = _wheel.link.lock();
+    if (!link)
+      return;
+
+    const auto &params = *_wheel.params;
+    auto surface = params.surface.lock();
+    double spinAngularVelocity;
+    if (!_wheel.plugin->Slip(this->modelRots[_wheel.pluginIndex], link,
+        params, _wheel.slip, spinAngularVelocity))
+    {
+      // Without its joint the wheel doesn't spin, so it doesn't slip.
+      if (surface)
+      {
+        surface->slip1 = 0;
+        surface->slip2 = 0;
+      }
+      return;
+    }
+    _wheel.valid = true;
+
+    if (surface)
+    {
+      // As discussed in WheelSlipPlugin.hh, the ODE slip1 and slip2
+      // parameters have units of inverse viscous damping:
+      // [linear velocity / force] or [m / s / N].
+      // Since the slip compliance parameters supplied to the plugin
+      // are unitless, they must be scaled by a linear speed and force
+      // magnitude before being passed to ODE.
+      // The force is taken from a user-defined constant that should roughly
+      // match the steady-state normal force at the wheel.
+      // The linear speed is computed dynamically at each time step as
+      // radius * spin angular velocity.
+      // This choice of linear speed corresponds to the denominator of
+      // the slip ratio during acceleration (see equation (1) in
+      // Yoshida, Hamano 2002 DOI 10.1109/ROBOT.2002.1013712
+      // "Motion dynamics of a rover with slip-based traction model").
+      // The acceleration form is more well-behaved numerically at low-speed
+      // and when the vehicle is at rest than the braking form,
+      // so it is used for both slip directions.
+      double speed = params.wheelRadius * std::abs(spinAngularVelocity);
+      surface->slip1 = speed / params.wheelNormalForce *
+          params.slipComplianceLateral;
+      surface->slip2 = speed / params.wheelNormalForce *
+          params.slipComplianceLongitudinal;
+    }
+  };
+
+  // Physics doesn't step during world update begin, and each wheel only
+  // reads its own link and joint and writes its own surface.
+  auto &wheels = this->wheels;
+  if (wheels.size() >= g_parallelWheelCount)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, wheels.size()),
+        [&wheels, &updateWheel](const tbb::blocked_range<size_t> &_r)
+        {
+          for (size_t i = _r.begin(); i != _r.end(); ++i)
+            updateWheel(wheels[i]);
+        });
+  }
+  else
+  {
+    for (auto &wheel : wheels)
+      updateWheel(wheel);
+  }
+  pluginLocks.clear();
+
+  // Serializing a message per wheel dominates the cost of large fleets, so
+  // slips are only published to topics that have subscribers.
+  for (const auto &wheel : wheels)
+  {
+    const auto &slipPub = wheel.params->slipPub;
+    if (wheel.valid && slipPub && slipPub->HasConnections())
+      slipPub->Publish(msgs::Convert(wheel.slip));
+  }
+  IGN_PROFILE_END();
+}
+
 /////////////////////////////////////////////////
 WheelSlipPlugin::WheelSlipPlugin()
   : dataPtr(new WheelSlipPluginPrivate)
@@ -129,12 +443,18 @@ WheelSlipPlugin::WheelSlipPlugin()
 /////////////////////////////////////////////////
 WheelSlipPlugin::~WheelSlipPlugin()
 {
+  if (this->dataPtr->fleet)
+    this->dataPtr->fleet->Remove(this->dataPtr.get());
 }
 
 /////////////////////////////////////////////////
 void WheelSlipPlugin::Fini()
 {
-  this->dataPtr->updateConnection.reset();
+  if (this->dataPtr->fleet)
+  {
+    this->dataPtr->fleet->Remove(this->dataPtr.get());
+    this->dataPtr->fleet.reset();
+  }
 
   this->dataPtr->lateralComplianceSub.reset();
   this->dataPtr->longitudinalComplianceSub.reset();
@@ -347,9 +667,18 @@ void WheelSlipPlugin::Load(physics::ModelPtr _model, sdf::ElementPtr _sdf)
       "~/" + _model->GetName() + "/wheel_slip/longitudinal_compliance",
       &WheelSlipPlugin::OnLongitudinalCompliance, this);
 
-  // Connect to the update event
-  this->dataPtr->updateConnection = event::Events::ConnectWorldUpdateBegin(
-      std::bind(&WheelSlipPlugin::Update, this));
+  // Update with the wheels of the other plugins of the world
+  this->dataPtr->fleet = WheelSlipFleet::Shared(world);
+  this->dataPtr->fleet->Add(this->dataPtr.get());
+}
+
+/////////////////////////////////////////////////
+void WheelSlipPlugin::Update()
+{
+  // The fleet updates the wheels of every plugin of the world together,
+  // from its own world update connection.
+  if (this->dataPtr->fleet)
+    this->dataPtr->fleet->Update();
 }
 
 /////////////////////////////////////////////////
@@ -368,7 +697,7 @@ void WheelSlipPlugin::GetSlips(
     gzerr << "Parent model does not exist" << std::endl;
     return;
   }
-  auto modelWorldPose = model->WorldPose();
+  auto modelWorldRot = model->WorldPose().Rot();
 
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   for (const auto &linkSurface : this->dataPtr->mapLinkSurfaceParams)
@@ -376,35 +705,14 @@ void WheelSlipPlugin::GetSlips(
     auto link = linkSurface.first.lock();
     if (!link)
       continue;
-    auto params = linkSurface.second;
-
-    // Compute wheel velocity in parent model frame
-    auto wheelWorldLinearVel = link->WorldLinearVel();
-    auto wheelModelLinearVel =
-        modelWorldPose.Rot().RotateVectorReverse(wheelWorldLinearVel);
-    // Compute wheel spin axis in parent model frame
-    auto joint = params.joint.lock();
-    if (!joint)
-      continue;
-    auto wheelWorldAxis = joint->GlobalAxis(0).Normalized();
-    auto wheelModelAxis =
-        modelWorldPose.Rot().RotateVectorReverse(wheelWorldAxis);
-    // Estimate longitudinal direction as cross product of initial gravity
-    // direction with wheel spin axis.
-    auto longitudinalModelAxis =
-        this->dataPtr->initialGravityDirection.Cross(wheelModelAxis);
-
-    double spinSpeed = params.wheelRadius * joint->GetVelocity(0);
-    double lateralSpeed = wheelModelAxis.Dot(wheelModelLinearVel);
-    double longitudinalSpeed = longitudinalModelAxis.Dot(wheelModelLinearVel);
 
     ignition::math::Vector3d slip;
-    slip.X(longitudinalSpeed - spinSpeed);
-    slip.Y(lateralSpeed);
-    slip.Z(spinSpeed);
-
-    auto name = link->GetName();
-    _out[name] = slip;
+    double spinAngularVelocity;
+    if (this->dataPtr->Slip(modelWorldRot, link, linkSurface.second, slip,
+        spinAngularVelocity))
+    {
+      _out[link->GetName()] = slip;
+    }
   }
 }
 
@@ -453,71 +761,3 @@ void WheelSlipPlugin::SetSlipComplianceLongitudinal(const double _compliance)
     linkSurface.second.slipComplianceLongitudinal = _compliance;
   }
 }
-
-/////////////////////////////////////////////////
-void WheelSlipPlugin::Update()
-{
-  IGN_PROFILE("WheelSlipPlugin::OnUpdate");
-  IGN_PROFILE_BEGIN("Update");
-  // Get slip data so it can be published later
-  std::map<std::string, ignition::math::Vector3d> slips;
-  this->GetSlips(slips);
-
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-  for (const auto &linkSurface : this->dataPtr->mapLinkSurfaceParams)
-  {
-    const auto &params = linkSurface.second;
-
-    // get user-defined normal force constant
-    double force = params.wheelNormalForce;
-
-    // get link angular velocity parallel to joint axis
-    ignition::math::Vector3d wheelAngularVelocity;
-    auto link = linkSurface.first.lock();
-    if (link)
-      wheelAngularVelocity = link->WorldAngularVel();
-
-    ignition::math::Vector3d jointAxis;
-    auto joint = params.joint.lock();
-    if (joint)
-      jointAxis = joint->GlobalAxis(0);
-
-    double spinAngularVelocity = wheelAngularVelocity.Dot(jointAxis);
-
-    auto surface = params.surface.lock();
-    if (surface)
-    {
-      // As discussed in WheelSlipPlugin.hh, the ODE slip1 and slip2
-      // parameters have units of inverse viscous damping:
-      // [linear velocity / force] or [m / s / N].
-      // Since the slip compliance parameters supplied to the plugin
-      // are unitless, they must be scaled by a linear speed and force
-      // magnitude before being passed to ODE.
-      // The force is taken from a user-defined constant that should roughly
-      // match the steady-state normal force at the wheel.
-      // The linear speed is computed dynamically at each time step as
-      // radius * spin angular velocity.
-      // This choice of linear speed corresponds to the denominator of
-      // the slip ratio during acceleration (see equation (1) in
-      // Yoshida, Hamano 2002 DOI 10.1109/ROBOT.2002.1013712
-      // "Motion dynamics of a rover with slip-based traction model").
-      // The acceleration form is more well-behaved numerically at low-speed
-      // and when the vehicle is at rest than the braking form,
-      // so it is used for both slip directions.
-      double speed = params.wheelRadius * std::abs(spinAngularVelocity);
-      surface->slip1 = speed / force * params.slipComplianceLateral;
-      surface->slip2 = speed / force * params.slipComplianceLongitudinal;
-    }
-
-    // Try to publish slip data for this wheel
-    if (link)
-    {
-      msgs::Vector3d msg;
-      auto name = link->GetName();
-      msg = msgs::Convert(slips[name]);
-      if (params.slipPub)
-        params.slipPub->Publish(msg);
-    }
-  }
-  IGN_PROFILE_END();
-}
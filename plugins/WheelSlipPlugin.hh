@@ -51,6 +51,10 @@ namespace gazebo
   /// parameter specified below in order to match the units of the ODE
   /// slip parameters.
   ///
+  /// The wheels of all the instances of this plugin are updated together,
+  /// in parallel for large fleets, and the slip of each wheel is only
+  /// published while its topic has subscribers.
+  ///
   /// A graphical interpretation of these parameters is provided below
   /// for a positive value of slip compliance.
   /// The horizontal axis corresponds to the slip ratio at the wheel,
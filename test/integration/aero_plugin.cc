@@ -33,6 +33,12 @@ class JointLiftDragPluginTest : public ServerFixture,
   /// Measure / verify force torques against analytical answers.
   /// \param[in] _physicsEngine Type of physics engine to use.
   public: void LiftDragPlugin1(const std::string &_physicsEngine);
+
+  /// \brief Load a world with two copies of a model with lifting
+  /// surfaces, one batched and one not, and check that they get the same
+  /// forces.
+  /// \param[in] _physicsEngine Type of physics engine to use.
+  public: void LiftDragBatched(const std::string &_physicsEngine);
 };
 
 /////////////////////////////////////////////////
@@ -133,11 +139,82 @@ void JointLiftDragPluginTest::LiftDragPlugin1(const std::string &_physicsEngine)
   }
 }
 
+/////////////////////////////////////////////////
+void JointLiftDragPluginTest::LiftDragBatched(const std::string &_physicsEngine)
+{
+  if (_physicsEngine != "ode")
+  {
+    gzlog << "this test works for ode only for now (Link::AddForce)"
+          << " missing for other engines.\n";
+    return;
+  }
+
+  Load("worlds/lift_drag_batched.world", true, _physicsEngine);
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  physics::ModelPtr unbatched = world->ModelByName("unbatched");
+  ASSERT_TRUE(unbatched != NULL);
+  physics::ModelPtr batched = world->ModelByName("batched");
+  ASSERT_TRUE(batched != NULL);
+
+  physics::LinkPtr unbatchedBody = unbatched->GetLink("body");
+  physics::LinkPtr batchedBody = batched->GetLink("body");
+  ASSERT_TRUE(unbatchedBody != NULL);
+  ASSERT_TRUE(batchedBody != NULL);
+
+  // Both models are pushed the same way, so they fly the same way as long
+  // as their surfaces get the same forces.
+  for (unsigned int i = 0; i < 2000; ++i)
+  {
+    world->Step(1);
+    unbatchedBody->AddForce(ignition::math::Vector3d(-1, 0, 0));
+    batchedBody->AddForce(ignition::math::Vector3d(-1, 0, 0));
+
+    if (i % 100 != 99)
+      continue;
+
+    EXPECT_NEAR(unbatchedBody->WorldLinearVel().X(),
+        batchedBody->WorldLinearVel().X(), TOL);
+
+    for (const std::string wing : {"wing_1", "wing_2"})
+    {
+      physics::JointWrench unbatchedWrench =
+          unbatched->GetJoint(wing + "_joint")->GetForceTorque(0);
+      physics::JointWrench batchedWrench =
+          batched->GetJoint(wing + "_joint")->GetForceTorque(0);
+      EXPECT_NEAR(unbatchedWrench.body2Force.X(),
+          batchedWrench.body2Force.X(), 1e-4);
+      EXPECT_NEAR(unbatchedWrench.body2Force.Y(),
+          batchedWrench.body2Force.Y(), 1e-4);
+      EXPECT_NEAR(unbatchedWrench.body2Force.Z(),
+          batchedWrench.body2Force.Z(), 1e-4);
+      EXPECT_NEAR(unbatchedWrench.body2Torque.X(),
+          batchedWrench.body2Torque.X(), 1e-4);
+      EXPECT_NEAR(unbatchedWrench.body2Torque.Y(),
+          batchedWrench.body2Torque.Y(), 1e-4);
+      EXPECT_NEAR(unbatchedWrench.body2Torque.Z(),
+          batchedWrench.body2Torque.Z(), 1e-4);
+    }
+  }
+
+  // The surfaces did generate forces
+  EXPECT_LT(batchedBody->WorldLinearVel().X(), -0.1);
+}
+
+/////////////////////////////////////////////////
 TEST_P(JointLiftDragPluginTest, LiftDragPlugin1)
 {
   LiftDragPlugin1(GetParam());
 }
 
+/////////////////////////////////////////////////
+TEST_P(JointLiftDragPluginTest, LiftDragBatched)
+{
+  LiftDragBatched(GetParam());
+}
+
 INSTANTIATE_TEST_CASE_P(PhysicsEngines, JointLiftDragPluginTest,
                         PHYSICS_ENGINE_VALUES,);  // NOLINT
 
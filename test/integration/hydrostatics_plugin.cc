@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class HydrostaticsPluginTest : public ServerFixture
+{
+};
+
+/////////////////////////////////////////////////
+TEST_F(HydrostaticsPluginTest, Float)
+{
+  Load("test/worlds/hydrostatics_plugin.world", true);
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::ModelPtr box = world->ModelByName("box");
+  ASSERT_TRUE(box != nullptr);
+  physics::ModelPtr sphere = world->ModelByName("sphere");
+  ASSERT_TRUE(sphere != nullptr);
+  physics::ModelPtr dryBox = world->ModelByName("dry_box");
+  ASSERT_TRUE(dryBox != nullptr);
+  physics::ModelPtr raft = world->ModelByName("raft");
+  ASSERT_TRUE(raft != nullptr);
+  ASSERT_EQ(1u, raft->NestedModels().size());
+  physics::ModelPtr hull = raft->NestedModels().front();
+
+  world->Step(5000);
+
+  // The box is half as dense as water and floats half submerged, upright
+  EXPECT_NEAR(box->WorldPose().Pos().Z(), 0.0, 0.02);
+  EXPECT_NEAR(box->WorldPose().Rot().Euler().X(), 0.0, 0.02);
+  EXPECT_NEAR(box->WorldPose().Rot().Euler().Y(), 0.0, 0.02);
+  EXPECT_NEAR(box->WorldLinearVel().Length(), 0.0, 0.02);
+
+  // The sphere is denser than water and sinks, slowed down by drag
+  EXPECT_LT(sphere->WorldPose().Pos().Z(), -1.0);
+  EXPECT_GT(sphere->WorldLinearVel().Z(), -world->Gravity().Length());
+
+  // The box that is not listed falls freely
+  EXPECT_LT(dryBox->WorldPose().Pos().Z(), -10.0);
+
+  // The links of nested models of a listed model float too
+  EXPECT_NEAR(hull->WorldPose().Pos().Z(), 0.0, 0.02);
+
+  // Replace the sphere by a light one without stepping, which keeps the
+  // number of models. The new sphere must float.
+  world->RemoveModel("sphere");
+  SpawnSphere("sphere", ignition::math::Vector3d(4, 0, 2),
+      ignition::math::Vector3d::Zero);
+  sphere = world->ModelByName("sphere");
+  ASSERT_TRUE(sphere != nullptr);
+
+  world->Step(2000);
+  EXPECT_GT(sphere->WorldPose().Pos().Z(), -1.0);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
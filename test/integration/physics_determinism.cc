@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <string>
+#include <vector>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class PhysicsDeterminismTest : public ServerFixture,
+                               public testing::WithParamInterface<const char*>
+{
+  /// \brief Step a world one iteration at a time and hash its complete
+  /// state after every step.
+  /// \param[in] _world World to step.
+  /// \param[in] _steps Number of steps to take.
+  /// \return One hash per step.
+  public: std::vector<uint64_t> StateHashes(physics::WorldPtr _world,
+              const unsigned int _steps);
+
+  /// \brief Check that a world produces the same per step state hashes on
+  /// repeated runs and with every number of island threads, while the
+  /// engine is in deterministic mode.
+  /// \param[in] _worldFile World to load.
+  public: void Reproducible(const std::string &_worldFile);
+};
+
+/////////////////////////////////////////////////
+/// \brief 64 bit FNV-1a hash of a byte buffer.
+/// \param[in] _data Buffer to hash.
+/// \return Hash of the buffer.
+uint64_t Fnv1a(const std::vector<uint8_t> &_data)
+{
+  uint64_t hash = 14695981039346656037ULL;
+  for (const uint8_t byte : _data)
+  {
+    hash ^= byte;
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+/////////////////////////////////////////////////
+/// \brief Index of the first differing hash, or the length of the shorter
+/// sequence if one is a prefix of the other.
+size_t FirstMismatch(const std::vector<uint64_t> &_a,
+    const std::vector<uint64_t> &_b)
+{
+  size_t i = 0;
+  while (i < _a.size() && i < _b.size() && _a[i] == _b[i])
+    ++i;
+  return i;
+}
+
+/////////////////////////////////////////////////
+std::vector<uint64_t> PhysicsDeterminismTest::StateHashes(
+    physics::WorldPtr _world, const unsigned int _steps)
+{
+  std::vector<uint64_t> hashes;
+  hashes.reserve(_steps);
+
+  std::vector<uint8_t> state;
+  for (unsigned int i = 0; i < _steps; ++i)
+  {
+    _world->StepBatch(1);
+
+    state.clear();
+    if (!_world->SaveSnapshot(state))
+    {
+      ADD_FAILURE() << "Unable to save a snapshot at step " << i;
+      break;
+    }
+    hashes.push_back(Fnv1a(state));
+  }
+  return hashes;
+}
+
+/////////////////////////////////////////////////
+void PhysicsDeterminismTest::Reproducible(const std::string &_worldFile)
+{
+  Load(_worldFile, true, "ode");
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+
+  EXPECT_FALSE(boost::any_cast<bool>(physics->GetParam("deterministic")));
+  EXPECT_TRUE(physics->SetParam("deterministic", true));
+  EXPECT_TRUE(boost::any_cast<bool>(physics->GetParam("deterministic")));
+  physics->SetSeed(1234u);
+
+  // Parallel paths that depend on thread scheduling are refused
+  EXPECT_FALSE(physics->SetParam("thread_position_correction", true));
+  EXPECT_FALSE(boost::any_cast<bool>(
+        physics->GetParam("thread_position_correction")));
+
+  std::vector<uint8_t> initial;
+  ASSERT_TRUE(world->SaveSnapshot(initial));
+
+  const unsigned int steps = 1000;
+  const std::vector<uint64_t> reference = this->StateHashes(world, steps);
+  ASSERT_EQ(steps, reference.size());
+
+  // The state must actually evolve, otherwise the comparisons are moot
+  EXPECT_NE(reference.front(), reference.back());
+
+  // Same process, same settings
+  ASSERT_TRUE(world->RestoreSnapshot(initial));
+  std::vector<uint64_t> hashes = this->StateHashes(world, steps);
+  EXPECT_EQ(steps, FirstMismatch(reference, hashes)) << "repeated run";
+
+  // Every island thread count
+  for (const int threads : {1, 2, 4, 8})
+  {
+    EXPECT_TRUE(physics->SetParam("island_threads", threads));
+    ASSERT_TRUE(world->RestoreSnapshot(initial));
+    hashes = this->StateHashes(world, steps);
+    EXPECT_EQ(steps, FirstMismatch(reference, hashes))
+      << "island_threads " << threads;
+  }
+  EXPECT_TRUE(physics->SetParam("island_threads", 0));
+
+  // Enabling deterministic mode turns threaded position correction off
+  EXPECT_TRUE(physics->SetParam("deterministic", false));
+  EXPECT_TRUE(physics->SetParam("thread_position_correction", true));
+  EXPECT_TRUE(physics->SetParam("deterministic", true));
+  EXPECT_FALSE(boost::any_cast<bool>(
+        physics->GetParam("thread_position_correction")));
+}
+
+/////////////////////////////////////////////////
+TEST_P(PhysicsDeterminismTest, Reproducible)
+{
+  Reproducible(GetParam());
+}
+
+INSTANTIATE_TEST_CASE_P(Worlds, PhysicsDeterminismTest,
+    ::testing::Values("worlds/shapes.world",
+                      "worlds/revolute_joint_test_with_large_gap.world",
+                      "worlds/dual_pr2.world"));
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
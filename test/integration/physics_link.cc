@@ -75,6 +75,10 @@ class PhysicsLinkTest : public ServerFixture,
   /// \brief Test velocity setting functions.
   /// \param[in] _physicsEngine Type of physics engine to use.
   public: void SetVelocity(const std::string &_physicsEngine);
+
+  /// \brief Test that world kinematics follow the link pose and inertial.
+  /// \param[in] _physicsEngine Type of physics engine to use.
+  public: void WorldKinematics(const std::string &_physicsEngine);
 };
 
 /////////////////////////////////////////////////
@@ -820,6 +824,80 @@ void PhysicsLinkTest::SetVelocity(const std::string &_physicsEngine)
   EXPECT_NEAR(rpy.Z(), 0.0, g_tolerance);
 }
 
+/////////////////////////////////////////////////
+void PhysicsLinkTest::WorldKinematics(const std::string &_physicsEngine)
+{
+  Load("worlds/blank.world", true, _physicsEngine);
+  auto world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  world->SetGravity(ignition::math::Vector3d(0, 0, -1));
+
+  msgs::Model msgModel;
+  msgModel.set_name("box");
+  msgs::AddBoxLink(msgModel, 10.0, ignition::math::Vector3d(1, 4, 9));
+  msgs::Set(msgModel.mutable_pose(), ignition::math::Pose3d(0, 0, 5, 0, 0, 0));
+  auto model = this->SpawnModel(msgModel);
+  ASSERT_TRUE(model != NULL);
+  auto link = model->GetLink();
+  ASSERT_TRUE(link != NULL);
+
+  // Compare with values computed from the link pose and inertial
+  auto expectKinematics = [&link]()
+  {
+    auto inertial = link->GetInertial();
+    ignition::math::Pose3d pose = link->WorldPose();
+    pose.Pos() += pose.Rot().RotateVector(inertial->CoG());
+    EXPECT_EQ(pose, link->WorldCoGPose());
+    EXPECT_EQ(inertial->Pose() + link->WorldPose(),
+        link->WorldInertialPose());
+    EXPECT_EQ(inertial->MOI(ignition::math::Pose3d(inertial->Pose().Pos(),
+        link->WorldPose().Rot().Inverse())), link->WorldInertiaMatrix());
+  };
+
+  expectKinematics();
+  const ignition::math::Matrix3d moi = link->WorldInertiaMatrix();
+
+  // Moving the link without notification
+  link->SetWorldPose(ignition::math::Pose3d(1, 2, 3, 0, 0, IGN_PI / 2),
+      false, false);
+  expectKinematics();
+  EXPECT_NE(moi, link->WorldInertiaMatrix());
+
+  // Moving the link with notification
+  link->SetWorldPose(ignition::math::Pose3d(4, 5, 6, 0.1, 0.2, 0.3));
+  expectKinematics();
+
+  // Changing the inertial
+  link->GetInertial()->SetCoG(ignition::math::Vector3d(0.5, 0, 0));
+  link->UpdateMass();
+  expectKinematics();
+
+  // Changing the inertial without updating the mass
+  link->GetInertial()->SetCoG(ignition::math::Vector3d(0, 0.5, 0));
+  link->GetInertial()->SetMass(20.0);
+  expectKinematics();
+
+  // Stepping
+  world->Step(10);
+  expectKinematics();
+
+  // Changes after the step fills the cache
+  link->GetInertial()->SetCoG(ignition::math::Vector3d(0, 0, 0.5));
+  expectKinematics();
+  world->Step(1);
+  link->SetWorldPose(ignition::math::Pose3d(0, 0, 5, 0.3, 0.2, 0.1),
+      false, false);
+  expectKinematics();
+
+  // Filling the cache by hand
+  link->CacheWorldKinematics();
+  expectKinematics();
+  link->GetInertial()->SetMass(5.0);
+  link->GetInertial()->SetIXX(2.0);
+  expectKinematics();
+}
+
 /////////////////////////////////////////////////
 TEST_P(PhysicsLinkTest, AddForce)
 {
@@ -856,6 +934,12 @@ TEST_P(PhysicsLinkTest, SetVelocity)
   SetVelocity(GetParam());
 }
 
+/////////////////////////////////////////////////
+TEST_P(PhysicsLinkTest, WorldKinematics)
+{
+  WorldKinematics(GetParam());
+}
+
 INSTANTIATE_TEST_CASE_P(PhysicsEngines, PhysicsLinkTest,
                         PHYSICS_ENGINE_VALUES,);  // NOLINT
 
@@ -121,6 +121,51 @@ TEST_P(PhysicsTest, DropTest)
 INSTANTIATE_TEST_CASE_P(WorldStepSolvers, PhysicsTest,
                         WORLD_STEP_SOLVERS,);  // NOLINT
 
+#ifdef HAVE_SIMBODY
+class SimbodyFixedStepTest : public ServerFixture
+{
+};
+
+////////////////////////////////////////////////////////////////////////
+// In fixed step mode, Simbody takes exactly one semi-explicit Euler step
+// of max_step_size per world step.
+TEST_F(SimbodyFixedStepTest, FreeFall)
+{
+  Load("worlds/empty.world", true, "simbody");
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != NULL);
+  EXPECT_TRUE(physics->SetParam("fixed_step", true));
+  EXPECT_TRUE(physics->SetParam("max_step_size", 0.002));
+  const double dt = physics->GetMaxStepSize();
+  EXPECT_DOUBLE_EQ(0.002, dt);
+
+  SpawnSphere("sphere", ignition::math::Vector3d(0, 0, 100),
+      ignition::math::Vector3d::Zero);
+  physics::ModelPtr model = world->ModelByName("sphere");
+  ASSERT_TRUE(model != NULL);
+
+  const double g = world->Gravity().Z();
+  double z = model->WorldPose().Pos().Z();
+  double v = 0.0;
+  for (int i = 0; i < 500; ++i)
+  {
+    const double simTime = world->SimTime().Double();
+    world->Step(1);
+    EXPECT_NEAR(world->SimTime().Double() - simTime, dt, 1e-12);
+
+    // The velocity is updated first and the position uses the new one.
+    // With error control on, Simbody would pick its own internal steps.
+    v += dt * g;
+    z += dt * v;
+    EXPECT_NEAR(model->WorldLinearVel().Z(), v, 1e-9);
+    EXPECT_NEAR(model->WorldPose().Pos().Z(), z, 1e-9);
+  }
+}
+#endif
+
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
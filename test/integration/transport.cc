@@ -186,6 +186,50 @@ TEST_F(TransportTest, DirectPublish)
   ASSERT_GT(timeout, 0) << "Not received a message in 10 seconds";
 }
 
+/////////////////////////////////////////////////
+boost::shared_ptr<msgs::GzString const> g_sharedMsg;
+void ReceiveSharedMsg(ConstGzStringPtr &_msg)
+{
+  g_sharedMsg = _msg;
+}
+
+/////////////////////////////////////////////////
+// Publish a message without copying it
+TEST_F(TransportTest, PublishShared)
+{
+  Load("worlds/empty.world");
+
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+
+  transport::PublisherPtr pub = node->Advertise<msgs::GzString>("~/shared");
+  transport::SubscriberPtr sub = node->Subscribe("~/shared",
+      &ReceiveSharedMsg);
+
+  boost::shared_ptr<msgs::GzString> msg(new msgs::GzString);
+  msg->set_data("shared");
+  pub->PublishShared(msg, true);
+
+  int timeout = 1000;
+  while (!g_sharedMsg && --timeout > 0)
+    common::Time::MSleep(10);
+  ASSERT_GT(timeout, 0) << "Not received a message in 10 seconds";
+
+  // Local subscribers receive the published message itself
+  EXPECT_EQ(g_sharedMsg.get(), msg.get());
+  EXPECT_EQ(g_sharedMsg->data(), "shared");
+  EXPECT_EQ(pub->GetPrevMsgPtr().get(), msg.get());
+
+  // Null and uninitialized messages are not published
+  g_sharedMsg.reset();
+  pub->PublishShared(transport::MessagePtr(), true);
+  pub->PublishShared(boost::shared_ptr<msgs::GzString>(
+      new msgs::GzString), true);
+  common::Time::MSleep(100);
+  EXPECT_FALSE(g_sharedMsg);
+  EXPECT_EQ(pub->GetPrevMsgPtr().get(), msg.get());
+}
+
 /////////////////////////////////////////////////
 void SinglePub()
 {
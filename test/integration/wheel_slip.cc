@@ -14,6 +14,12 @@
  * limitations under the License.
  *
 */
+#include <atomic>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
 #include "gazebo/test/ServerFixture.hh"
 #include "gazebo/physics/physics.hh"
 #include "gazebo/physics/ode/ODESurfaceParams.hh"
@@ -611,6 +617,172 @@ TEST_F(WheelSlipTest, TricyclesUphill)
   }
 }
 
+/// \brief Number of slip messages received.
+static std::atomic<unsigned int> g_slipCount(0);
+
+/////////////////////////////////////////////////
+void OnSlip(ConstVector3dPtr &/*_msg*/)
+{
+  ++g_slipCount;
+}
+
+/////////////////////////////////////////////////
+// The wheels of both tricycles are updated together. Each surface gets the
+// compliance of its own plugin, and slips are published to subscribers.
+TEST_F(WheelSlipTest, Fleet)
+{
+  Load("worlds/trisphere_cycle_wheel_slip.world", true);
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_NE(world, nullptr);
+
+  std::vector<physics::ODESurfaceParamsPtr> surfaces[2];
+  for (unsigned int i = 0; i < 2; ++i)
+  {
+    physics::ModelPtr model =
+        world->ModelByName("trisphere_cycle_slip" + std::to_string(i));
+    ASSERT_NE(nullptr, model);
+
+    auto jc = model->GetJointController();
+    jc->SetVelocityPID(model->GetScopedName() + "::wheel_rear_left_spin",
+        common::PID(9, 0, 0));
+    jc->SetVelocityTarget(model->GetScopedName() + "::wheel_rear_left_spin",
+        6.0);
+
+    for (const auto &name : {"wheel_front", "wheel_rear_left"})
+    {
+      physics::LinkPtr wheel = model->GetLink(name);
+      ASSERT_NE(nullptr, wheel);
+      auto surface = boost::dynamic_pointer_cast<physics::ODESurfaceParams>(
+          wheel->GetCollisions().front()->GetSurface());
+      ASSERT_NE(nullptr, surface);
+      surfaces[i].push_back(surface);
+    }
+  }
+
+  g_slipCount = 0;
+  transport::SubscriberPtr slipSub = this->node->Subscribe(
+      "~/trisphere_cycle_slip1/wheel_slip/wheel_rear_left", OnSlip);
+
+  world->Step(500);
+
+  // Zero compliance allows no slip, while a unit compliance scales with
+  // the spin speed of the driven wheel.
+  for (const auto &surface : surfaces[0])
+  {
+    EXPECT_DOUBLE_EQ(surface->slip1, 0.0);
+    EXPECT_DOUBLE_EQ(surface->slip2, 0.0);
+  }
+  EXPECT_GT(surfaces[1][1]->slip1, 0.0);
+  EXPECT_DOUBLE_EQ(surfaces[1][1]->slip1, surfaces[1][1]->slip2);
+
+  for (int i = 0; i < 50 && g_slipCount == 0; ++i)
+    common::Time::MSleep(10);
+  EXPECT_GT(g_slipCount, 0u);
+}
+
+/////////////////////////////////////////////////
+// A fleet of 64 wheels or more is updated in parallel. Each surface must
+// get the slip parameters computed one wheel at a time from the state the
+// world had before the step.
+TEST_F(WheelSlipTest, ParallelFleet)
+{
+  Load("worlds/trisphere_cycle_wheel_slip.world", true);
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_NE(world, nullptr);
+
+  // Copies of the tricycle with unit compliance, 66 wheels in total
+  const unsigned int modelCount = 22;
+  physics::ModelPtr original = world->ModelByName("trisphere_cycle_slip1");
+  ASSERT_NE(nullptr, original);
+  for (unsigned int i = 2; i < modelCount; ++i)
+  {
+    sdf::ElementPtr modelSdf = original->GetSDF()->Clone();
+    modelSdf->GetAttribute("name")->Set(
+        "trisphere_cycle_slip" + std::to_string(i));
+    modelSdf->GetElement("pose")->Set(
+        ignition::math::Pose3d(0, 2.0 * i, 0, 0, 0, 0));
+
+    std::ostringstream modelStr;
+    modelStr << "<sdf version='" << SDF_VERSION << "'>"
+             << modelSdf->ToString("") << "</sdf>";
+    SpawnSDF(modelStr.str());
+  }
+
+  /// \brief A wheel and what the plugin knows about it.
+  struct Wheel
+  {
+    physics::LinkPtr link;
+    physics::JointPtr joint;
+    physics::ODESurfaceParamsPtr surface;
+    double radius;
+    double normalForce;
+  };
+  std::vector<Wheel> wheels;
+
+  for (unsigned int i = 1; i < modelCount; ++i)
+  {
+    physics::ModelPtr model =
+        world->ModelByName("trisphere_cycle_slip" + std::to_string(i));
+    ASSERT_NE(nullptr, model);
+
+    // Drive the models at different speeds
+    auto jc = model->GetJointController();
+    jc->SetVelocityPID(model->GetScopedName() + "::wheel_rear_left_spin",
+        common::PID(9, 0, 0));
+    jc->SetVelocityTarget(model->GetScopedName() + "::wheel_rear_left_spin",
+        2.0 + 0.2 * i);
+
+    for (const auto &name :
+        {"wheel_front", "wheel_rear_left", "wheel_rear_right"})
+    {
+      Wheel wheel;
+      wheel.link = model->GetLink(name);
+      ASSERT_NE(nullptr, wheel.link);
+      ASSERT_EQ(1u, wheel.link->GetParentJoints().size());
+      wheel.joint = wheel.link->GetParentJoints().front();
+      auto collision = wheel.link->GetCollisions().front();
+      wheel.surface = boost::dynamic_pointer_cast<physics::ODESurfaceParams>(
+          collision->GetSurface());
+      ASSERT_NE(nullptr, wheel.surface);
+      auto sphere = boost::dynamic_pointer_cast<physics::SphereShape>(
+          collision->GetShape());
+      ASSERT_NE(nullptr, sphere);
+      wheel.radius = sphere->GetRadius();
+      wheel.normalForce = std::string(name) == "wheel_front" ? 77 : 32;
+      wheels.push_back(wheel);
+    }
+  }
+  // With the three wheels of trisphere_cycle_slip0 the fleet is parallel
+  EXPECT_EQ(3u * (modelCount - 1), wheels.size());
+  EXPECT_GE(wheels.size() + 3, 64u);
+
+  for (unsigned int step = 0; step < 300; ++step)
+  {
+    // Serial reference, with unit compliance
+    std::vector<double> expected(wheels.size());
+    for (size_t i = 0; i < wheels.size(); ++i)
+    {
+      const auto &wheel = wheels[i];
+      const double spin = wheel.link->WorldAngularVel().Dot(
+          wheel.joint->GlobalAxis(0));
+      expected[i] = wheel.radius * std::abs(spin) / wheel.normalForce;
+    }
+
+    world->Step(1);
+
+    for (size_t i = 0; i < wheels.size(); ++i)
+    {
+      ASSERT_DOUBLE_EQ(expected[i], wheels[i].surface->slip1) << i;
+      ASSERT_DOUBLE_EQ(expected[i], wheels[i].surface->slip2) << i;
+    }
+  }
+
+  // The driven wheels spin, so the comparison isn't trivially zero
+  EXPECT_GT(wheels[1].surface->slip1, 0.0);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "gazebo/msgs/PoseStream.hh"
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class WorldCompactPosesTest : public ServerFixture
+{
+  /// \brief Compact pose frame callback.
+  /// \param[in] _msg Frame.
+  public: void OnFrame(ConstCompactPosesPtr &_msg)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    msgs::PosesStamped poses;
+    if (!this->decoder.Decode(*_msg, poses))
+      return;
+
+    ++this->frames;
+    if (_msg->is_keyframe())
+      ++this->keyframes;
+    for (int i = 0; i < poses.pose_size(); ++i)
+    {
+      this->poses[poses.pose(i).id()] = msgs::ConvertIgn(poses.pose(i));
+      if (poses.pose(i).has_name())
+        this->names[poses.pose(i).id()] = poses.pose(i).name();
+    }
+  }
+
+  /// \brief Dictionary callback.
+  /// \param[in] _msg Dictionary.
+  public: void OnDictionary(ConstPoseDictionaryPtr &_msg)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->decoder.SetDictionary(*_msg);
+  }
+
+  /// \brief Protects the members below.
+  public: std::mutex mutex;
+
+  /// \brief Stream decoder.
+  public: msgs::PoseStreamDecoder decoder;
+
+  /// \brief Latest decoded pose per entity id.
+  public: std::map<uint32_t, ignition::math::Pose3d> poses;
+
+  /// \brief Decoded entity names per id.
+  public: std::map<uint32_t, std::string> names;
+
+  /// \brief Number of decoded frames.
+  public: unsigned int frames = 0;
+
+  /// \brief Number of decoded keyframes.
+  public: unsigned int keyframes = 0;
+};
+
+/////////////////////////////////////////////////
+TEST_F(WorldCompactPosesTest, Stream)
+{
+  this->Load("worlds/shapes.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::ModelPtr box = world->ModelByName("box");
+  ASSERT_TRUE(box != nullptr);
+  box->SetWorldPose(ignition::math::Pose3d(0, 0, 3, 0, 0, 0));
+
+  transport::NodePtr node(new transport::Node());
+  node->Init("default");
+  transport::SubscriberPtr dictionarySub = node->Subscribe(
+      "~/pose/compact/dictionary", &WorldCompactPosesTest::OnDictionary,
+      this, true);
+  transport::SubscriberPtr frameSub = node->Subscribe(
+      "~/pose/compact/info", &WorldCompactPosesTest::OnFrame, this);
+
+  // Let the box fall until a few frames arrived
+  world->SetPaused(false);
+  for (int i = 0; i < 100; ++i)
+  {
+    common::Time::MSleep(50);
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->frames > 20)
+      break;
+  }
+  world->SetPaused(true);
+
+  // Wait for the frames in flight, then for the next keyframe
+  common::Time::MSleep(500);
+  world->Step(1);
+  common::Time::MSleep(200);
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  EXPECT_GT(this->frames, 20u);
+  EXPECT_GT(this->keyframes, 0u);
+
+  // Names are resolved through the dictionary
+  ASSERT_TRUE(this->names.count(box->GetId()) > 0);
+  EXPECT_EQ(box->GetScopedName(), this->names[box->GetId()]);
+
+  // The decoded pose matches the world within the stream's resolution
+  ASSERT_TRUE(this->poses.count(box->GetId()) > 0);
+  EXPECT_LT(box->WorldPose().Pos().Z(), 3.0);
+  EXPECT_NEAR(box->WorldPose().Pos().Distance(
+        this->poses[box->GetId()].Pos()), 0.0, 1e-3);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -34,14 +34,16 @@ namespace gazebo
   {
     namespace memory
     {
-      /// \brief Parse the /proc/meminfo and return the value corresponding to
-      ///        key given.
-      /// \param[in] _key string represent keys in meminfo ended with a colon
-      ///        example: "MemFree:"
-      uint64_t ParseProcMeminfo(const std::string &_key)
+      /// \brief Parse a /proc file of "key: value" lines and return the
+      ///        value corresponding to the key given.
+      /// \param[in] _file Path of the file, example: "/proc/self/status"
+      /// \param[in] _key string represent keys in the file ended with a
+      ///        colon, example: "VmRSS:"
+      uint64_t ParseProcFile(const std::string &_file,
+                             const std::string &_key)
       {
           std::string token;
-          std::ifstream file("/proc/meminfo");
+          std::ifstream file(_file);
           while (file >> token)
           {
               if (token == _key)
@@ -58,6 +60,15 @@ namespace gazebo
           return 0;  // nothing found
       }
 
+      /// \brief Parse the /proc/meminfo and return the value corresponding to
+      ///        key given.
+      /// \param[in] _key string represent keys in meminfo ended with a colon
+      ///        example: "MemFree:"
+      uint64_t ParseProcMeminfo(const std::string &_key)
+      {
+          return ParseProcFile("/proc/meminfo", _key);
+      }
+
       /// \brief Get the RAM memory available at the moment
       /// \return RAM ammount in Megabytes
       uint64_t GetMemoryAvailable()
@@ -72,6 +83,20 @@ namespace gazebo
           return ParseProcMeminfo("MemTotal:") / 1024;
       }
 
+      /// \brief Get the RAM memory used by this process at the moment
+      /// \return RAM ammount in Megabytes
+      uint64_t GetProcessMemory()
+      {
+          return ParseProcFile("/proc/self/status", "VmRSS:") / 1024;
+      }
+
+      /// \brief Get the most RAM memory used by this process so far
+      /// \return RAM ammount in Megabytes
+      uint64_t GetPeakProcessMemory()
+      {
+          return ParseProcFile("/proc/self/status", "VmHWM:") / 1024;
+      }
+
       typedef uint64_t megabyte;
 
       /// \brief Check if a given ammount of RAM is available at the system
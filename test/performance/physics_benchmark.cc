@@ -0,0 +1,690 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+// Measures physics throughput for canonical scenes, engines, solver
+// iterations and DART collision detectors. Every run reports its real time
+// factor, step time percentiles and memory as gtest properties, and as a
+// CSV row appended to the file named by GAZEBO_BENCHMARK_OUTPUT. When
+// GAZEBO_BENCHMARK_BASELINE names a CSV file of a previous run, runs slower
+// than the baseline by more than GAZEBO_BENCHMARK_TOLERANCE (default 0.25)
+// fail.
+//
+// By default every run is short, so the whole matrix fits in the ctest
+// timeout; the numbers are then only a smoke test. For meaningful
+// measurements, set GAZEBO_BENCHMARK_STEPS to the number of measured steps,
+// e.g. 2000, which also lets the scenes settle for longer before measuring.
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+#include "gazebo/test/helper_physics_generator.hh"
+#include "test/performance/RAMLibrary.hh"
+#include "test_config.h"
+
+using namespace gazebo;
+
+/// \brief Engine, scene, solver iterations, zero for the engine default,
+/// and collision detector, empty for the engine default.
+typedef std::tuple<const char *, const char *, int, const char *>
+    BenchmarkParam;
+
+/// \brief Columns of the CSV output.
+static const char *kCsvHeader = "engine,scene,iters,bodies,steps,rtf,"
+    "step_p50_ms,step_p90_ms,step_p99_ms,step_max_ms,rss_mb,peak_rss_mb";
+
+/// \brief Result of a run.
+struct BenchmarkResult
+{
+  /// \brief Number of dynamic links.
+  unsigned int bodies = 0;
+
+  /// \brief Number of measured steps.
+  unsigned int steps = 0;
+
+  /// \brief Simulation time over wall time.
+  double rtf = 0;
+
+  /// \brief Median step time, in milliseconds.
+  double p50 = 0;
+
+  /// \brief 90th percentile of the step time, in milliseconds.
+  double p90 = 0;
+
+  /// \brief 99th percentile of the step time, in milliseconds.
+  double p99 = 0;
+
+  /// \brief Longest step time, in milliseconds.
+  double max = 0;
+
+  /// \brief Resident memory at the end of the run, in megabytes.
+  uint64_t rss = 0;
+
+  /// \brief Peak resident memory of the process, in megabytes.
+  uint64_t peakRss = 0;
+};
+
+class PhysicsBenchmark : public ServerFixture,
+                         public ::testing::WithParamInterface<BenchmarkParam>
+{
+  /// \brief Load a generated world, run it and report the results.
+  /// \param[in] _physicsEngine Physics engine.
+  /// \param[in] _scene Scene name.
+  /// \param[in] _iters Solver iterations, zero for the engine default.
+  /// \param[in] _collisionDetector Value of the collision_detector
+  /// parameter, or "fcl_primitive" for FCL with analytic primitive shapes.
+  /// Empty for the engine default.
+  public: void Run(const std::string &_physicsEngine,
+                   const std::string &_scene, const int _iters,
+                   const std::string &_collisionDetector);
+
+  /// \brief SDF of a world with the given models.
+  /// \param[in] _models SDF of the models.
+  /// \param[in] _groundPlane True to add a ground plane.
+  /// \return World SDF.
+  private: static std::string World(const std::string &_models,
+                                    const bool _groundPlane = true);
+
+  /// \brief SDF of a link with one geometry, and the inertia of a box,
+  /// sphere or cylinder.
+  /// \param[in] _name Link name.
+  /// \param[in] _pose Link pose.
+  /// \param[in] _shape "box", "sphere", "cylinder" or "mesh". Meshes use
+  /// the test box mesh and the inertia of a box.
+  /// \param[in] _size Box or mesh size, sphere radius in X, cylinder
+  /// radius in X and length in Z.
+  /// \param[in] _mass Link mass.
+  /// \return Link SDF.
+  private: static std::string Link(const std::string &_name,
+               const ignition::math::Pose3d &_pose, const std::string &_shape,
+               const ignition::math::Vector3d &_size, const double _mass);
+
+  /// \brief SDF of a geometry.
+  /// \param[in] _shape See Link.
+  /// \param[in] _size See Link.
+  /// \return Geometry SDF.
+  private: static std::string Geometry(const std::string &_shape,
+               const ignition::math::Vector3d &_size);
+
+  /// \brief Stacks of boxes.
+  /// \return World SDF.
+  private: static std::string BoxStacks();
+
+  /// \brief A thousand boxes, spheres and cylinders dropped on the ground.
+  /// \return World SDF.
+  private: static std::string Rubble();
+
+  /// \brief Serial arms swinging under gravity.
+  /// \return World SDF.
+  private: static std::string ArticulatedArms();
+
+  /// \brief Vehicles with a row of road wheels on each side, driving on
+  /// a heightmap.
+  /// \return World SDF.
+  private: static std::string TrackedVehicles();
+
+  /// \brief Boxes and spheres dropped in bins made of triangle meshes.
+  /// \return World SDF.
+  private: static std::string TrimeshBins();
+
+  /// \brief Check the result against the baseline, if any.
+  /// \param[in] _key Engine, scene and iterations columns.
+  /// \param[in] _result Result of the run.
+  private: void CheckBaseline(const std::string &_key,
+                              const BenchmarkResult &_result);
+
+  /// \brief Wall time at the start of the current step.
+  private: common::Time stepStart;
+
+  /// \brief Wall time of each measured step, in milliseconds.
+  private: std::vector<double> stepTimes;
+
+  /// \brief True while steps are measured.
+  private: bool measuring = false;
+
+  /// \brief Wheel joints driven in the tracked vehicle scene.
+  private: std::vector<std::pair<physics::JointPtr, double>> drives;
+
+  /// \brief Path of the generated world file.
+  private: boost::filesystem::path worldPath;
+};
+
+/////////////////////////////////////////////////
+std::string PhysicsBenchmark::World(const std::string &_models,
+    const bool _groundPlane)
+{
+  std::ostringstream sdf;
+  sdf << "<?xml version='1.0' ?>"
+      << "<sdf version='1.6'>"
+      << "<world name='default'>"
+      << "<physics type='ode'>"
+      << "  <max_step_size>0.001</max_step_size>"
+      << "  <real_time_update_rate>0</real_time_update_rate>"
+      << "</physics>"
+      << "<gravity>0 0 -9.8</gravity>";
+  if (_groundPlane)
+  {
+    sdf << "<model name='ground_plane'>"
+        << "  <static>true</static>"
+        << "  <link name='link'>"
+        << "    <collision name='collision'>"
+        << "      <geometry>"
+        << "        <plane><normal>0 0 1</normal><size>200 200</size></plane>"
+        << "      </geometry>"
+        << "    </collision>"
+        << "  </link>"
+        << "</model>";
+  }
+  sdf << _models << "</world></sdf>";
+  return sdf.str();
+}
+
+/////////////////////////////////////////////////
+std::string PhysicsBenchmark::Geometry(const std::string &_shape,
+    const ignition::math::Vector3d &_size)
+{
+  std::ostringstream sdf;
+  sdf << "<geometry>";
+  if (_shape == "sphere")
+  {
+    sdf << "<sphere><radius>" << _size.X() << "</radius></sphere>";
+  }
+  else if (_shape == "cylinder")
+  {
+    sdf << "<cylinder><radius>" << _size.X() << "</radius>"
+        << "<length>" << _size.Z() << "</length></cylinder>";
+  }
+  else if (_shape == "mesh")
+  {
+    // The test mesh is a cube of side 2
+    sdf << "<mesh><uri>" << TEST_PATH << "/data/box.dae</uri>"
+        << "<scale>" << _size * 0.5 << "</scale></mesh>";
+  }
+  else
+  {
+    sdf << "<box><size>" << _size << "</size></box>";
+  }
+  sdf << "</geometry>";
+  return sdf.str();
+}
+
+/////////////////////////////////////////////////
+std::string PhysicsBenchmark::Link(const std::string &_name,
+    const ignition::math::Pose3d &_pose, const std::string &_shape,
+    const ignition::math::Vector3d &_size, const double _mass)
+{
+  ignition::math::Vector3d inertia;
+  if (_shape == "sphere")
+  {
+    inertia.Set(1, 1, 1);
+    inertia *= 0.4 * _mass * _size.X() * _size.X();
+  }
+  else if (_shape == "cylinder")
+  {
+    const double r2 = _size.X() * _size.X();
+    const double ixx = _mass * (3 * r2 + _size.Z() * _size.Z()) / 12.0;
+    inertia.Set(ixx, ixx, 0.5 * _mass * r2);
+  }
+  else
+  {
+    const ignition::math::Vector3d s2 = _size * _size;
+    inertia.Set(s2.Y() + s2.Z(), s2.X() + s2.Z(), s2.X() + s2.Y());
+    inertia *= _mass / 12.0;
+  }
+
+  std::ostringstream sdf;
+  sdf << "<link name='" << _name << "'>"
+      << "  <pose>" << _pose << "</pose>"
+      << "  <inertial>"
+      << "    <mass>" << _mass << "</mass>"
+      << "    <inertia>"
+      << "      <ixx>" << inertia.X() << "</ixx>"
+      << "      <iyy>" << inertia.Y() << "</iyy>"
+      << "      <izz>" << inertia.Z() << "</izz>"
+      << "      <ixy>0</ixy><ixz>0</ixz><iyz>0</iyz>"
+      << "    </inertia>"
+      << "  </inertial>"
+      << "  <collision name='collision'>"
+      << Geometry(_shape, _size)
+      << "  </collision>"
+      << "</link>";
+  return sdf.str();
+}
+
+/////////////////////////////////////////////////
+std::string PhysicsBenchmark::BoxStacks()
+{
+  std::ostringstream sdf;
+  for (int s = 0; s < 4; ++s)
+  {
+    for (int i = 0; i < 10; ++i)
+    {
+      sdf << "<model name='box_" << s << "_" << i << "'>"
+          << Link("link", ignition::math::Pose3d(2.0 * s, 0, 0.25 + 0.501 * i,
+                 0, 0, 0), "box", ignition::math::Vector3d(0.5, 0.5, 0.5), 1.0)
+          << "</model>";
+    }
+  }
+  return World(sdf.str());
+}
+
+/////////////////////////////////////////////////
+std::string PhysicsBenchmark::Rubble()
+{
+  const char *shapes[] = {"box", "sphere", "cylinder"};
+  std::ostringstream sdf;
+  int n = 0;
+  for (int z = 0; z < 10; ++z)
+  {
+    for (int y = 0; y < 10; ++y)
+    {
+      for (int x = 0; x < 10; ++x, ++n)
+      {
+        const std::string shape = shapes[n % 3];
+        ignition::math::Vector3d size(0.2 + 0.01 * (n % 7),
+            0.15 + 0.01 * (n % 5), 0.2);
+        if (shape != "box")
+          size.X(0.5 * size.X());
+        sdf << "<model name='rubble_" << n << "'>"
+            << Link("link", ignition::math::Pose3d(0.5 * x - 2.25,
+                   0.5 * y - 2.25, 0.3 + 0.5 * z, 0.1 * n, 0.2 * n, 0.3 * n),
+                   shape, size, 0.5)
+            << "</model>";
+      }
+    }
+  }
+  return World(sdf.str());
+}
+
+/////////////////////////////////////////////////
+std::string PhysicsBenchmark::ArticulatedArms()
+{
+  std::ostringstream sdf;
+  for (int a = 0; a < 8; ++a)
+  {
+    sdf << "<model name='arm_" << a << "'>"
+        << "<pose>" << 3.0 * (a % 4) << " " << 4.0 * (a / 4) << " 3 0 0 "
+        << 0.7 * a << "</pose>"
+        << Link("link_0", ignition::math::Pose3d::Zero, "box",
+               ignition::math::Vector3d(0.2, 0.2, 0.2), 2.0)
+        << "<joint name='fixed' type='fixed'>"
+        << "  <parent>world</parent><child>link_0</child>"
+        << "</joint>";
+    for (int i = 1; i <= 6; ++i)
+    {
+      sdf << Link("link_" + std::to_string(i),
+                 ignition::math::Pose3d(0.4 * i - 0.1, 0, 0, 0, 0, 0), "box",
+                 ignition::math::Vector3d(0.4, 0.08, 0.08), 0.5)
+          << "<joint name='joint_" << i << "' type='revolute'>"
+          << "  <pose>-0.2 0 0 0 0 0</pose>"
+          << "  <parent>link_" << i - 1 << "</parent>"
+          << "  <child>link_" << i << "</child>"
+          << "  <axis><xyz>" << (i % 2 ? "0 1 0" : "0 0 1") << "</xyz></axis>"
+          << "</joint>";
+    }
+    sdf << "</model>";
+  }
+  return World(sdf.str());
+}
+
+/////////////////////////////////////////////////
+std::string PhysicsBenchmark::TrackedVehicles()
+{
+  std::ostringstream sdf;
+  sdf << "<model name='heightmap'>"
+      << "  <static>true</static>"
+      << "  <link name='link'>"
+      << "    <collision name='collision'>"
+      << "      <geometry>"
+      << "        <heightmap>"
+      << "          <uri>file://media/materials/textures/heightmap_bowl.png"
+      << "</uri>"
+      << "          <size>129 129 10</size>"
+      << "          <pos>0 0 0</pos>"
+      << "        </heightmap>"
+      << "      </geometry>"
+      << "    </collision>"
+      << "  </link>"
+      << "</model>";
+
+  for (int v = 0; v < 4; ++v)
+  {
+    sdf << "<model name='vehicle_" << v << "'>"
+        << "<pose>" << (v % 2 ? 8 : -8) << " " << (v / 2 ? 8 : -8)
+        << " 11 0 0 " << 1.57 * v << "</pose>"
+        << Link("chassis", ignition::math::Pose3d::Zero, "box",
+               ignition::math::Vector3d(1.4, 0.8, 0.3), 20.0);
+    for (int side = 0; side < 2; ++side)
+    {
+      for (int w = 0; w < 4; ++w)
+      {
+        const std::string name = "wheel_" + std::to_string(side) + "_" +
+            std::to_string(w);
+        sdf << Link(name, ignition::math::Pose3d(0.36 * w - 0.54,
+                   side ? 0.5 : -0.5, -0.15, IGN_PI_2, 0, 0), "cylinder",
+                   ignition::math::Vector3d(0.17, 0, 0.12), 1.0)
+            << "<joint name='" << name << "' type='revolute'>"
+            << "  <parent>chassis</parent><child>" << name << "</child>"
+            << "  <axis><xyz>0 0 1</xyz></axis>"
+            << "</joint>";
+      }
+    }
+    sdf << "</model>";
+  }
+  return World(sdf.str(), false);
+}
+
+/////////////////////////////////////////////////
+std::string PhysicsBenchmark::TrimeshBins()
+{
+  std::ostringstream sdf;
+  for (int b = 0; b < 2; ++b)
+  {
+    // Floor and four walls of 2 x 2 x 1 meters
+    sdf << "<model name='bin_" << b << "'>"
+        << "<static>true</static>"
+        << "<pose>" << 3.0 * b << " 0 0 0 0 0</pose>"
+        << "<link name='link'>";
+    const ignition::math::Pose3d poses[] = {
+        {0, 0, 0.05, 0, 0, 0}, {1.0, 0, 0.5, 0, 0, 0},
+        {-1.0, 0, 0.5, 0, 0, 0}, {0, 1.0, 0.5, 0, 0, 0},
+        {0, -1.0, 0.5, 0, 0, 0}};
+    const ignition::math::Vector3d sizes[] = {
+        {2.1, 2.1, 0.1}, {0.1, 2.1, 1.0}, {0.1, 2.1, 1.0}, {2.1, 0.1, 1.0},
+        {2.1, 0.1, 1.0}};
+    for (int i = 0; i < 5; ++i)
+    {
+      sdf << "<collision name='wall_" << i << "'>"
+          << "  <pose>" << poses[i] << "</pose>"
+          << Geometry("mesh", sizes[i])
+          << "</collision>";
+    }
+    sdf << "</link></model>";
+
+    int n = 0;
+    for (int z = 0; z < 2; ++z)
+    {
+      for (int y = 0; y < 5; ++y)
+      {
+        for (int x = 0; x < 5; ++x, ++n)
+        {
+          const bool mesh = n % 2 == 0;
+          sdf << "<model name='item_" << b << "_" << n << "'>"
+              << Link("link", ignition::math::Pose3d(3.0 * b + 0.3 * x - 0.6,
+                     0.3 * y - 0.6, 1.2 + 0.3 * z, 0.3 * n, 0.2 * n, 0),
+                     mesh ? "mesh" : "sphere",
+                     mesh ? ignition::math::Vector3d(0.15, 0.15, 0.15) :
+                            ignition::math::Vector3d(0.08, 0, 0), 0.3)
+              << "</model>";
+        }
+      }
+    }
+  }
+  return World(sdf.str());
+}
+
+/////////////////////////////////////////////////
+void PhysicsBenchmark::CheckBaseline(const std::string &_key,
+    const BenchmarkResult &_result)
+{
+  const char *baseline = std::getenv("GAZEBO_BENCHMARK_BASELINE");
+  if (!baseline)
+    return;
+
+  double tolerance = 0.25;
+  const char *toleranceEnv = std::getenv("GAZEBO_BENCHMARK_TOLERANCE");
+  if (toleranceEnv)
+    tolerance = std::atof(toleranceEnv);
+
+  // The last row of the baseline with the same engine, scene and iterations
+  std::ifstream in(baseline);
+  std::string line;
+  double baselineRtf = -1;
+  while (std::getline(in, line))
+  {
+    if (line.compare(0, _key.size(), _key) != 0)
+      continue;
+
+    // rtf is the third column after the key
+    std::istringstream row(line.substr(_key.size()));
+    std::string column;
+    for (int i = 0; i < 3 && std::getline(row, column, ','); ++i)
+    {
+      if (i == 2)
+        baselineRtf = std::atof(column.c_str());
+    }
+  }
+
+  if (baselineRtf <= 0)
+  {
+    gzwarn << "No baseline for [" << _key << "] in [" << baseline << "]"
+           << std::endl;
+    return;
+  }
+
+  this->RecordProperty("baseline_rtf", std::to_string(baselineRtf));
+  EXPECT_GE(_result.rtf, baselineRtf * (1.0 - tolerance))
+      << "Real time factor regressed for [" << _key << "]";
+}
+
+/////////////////////////////////////////////////
+void PhysicsBenchmark::Run(const std::string &_physicsEngine,
+    const std::string &_scene, const int _iters,
+    const std::string &_collisionDetector)
+{
+  std::string world;
+  if (_scene == "box_stacks")
+    world = BoxStacks();
+  else if (_scene == "rubble")
+    world = Rubble();
+  else if (_scene == "articulated_arms")
+    world = ArticulatedArms();
+  else if (_scene == "tracked_heightmap")
+    world = TrackedVehicles();
+  else if (_scene == "trimesh_bins")
+    world = TrimeshBins();
+  ASSERT_FALSE(world.empty()) << "Unknown scene [" << _scene << "]";
+
+  if (_scene == "tracked_heightmap" && _physicsEngine == "simbody")
+  {
+    gzerr << "Aborting benchmark for simbody, "
+          << "SimbodyHeightmapShape is not implemented." << std::endl;
+    return;
+  }
+
+  this->worldPath = boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("physics_benchmark-%%%%-%%%%.world");
+  {
+    std::ofstream out(this->worldPath.string());
+    out << world;
+  }
+  this->Load(this->worldPath.string(), true, _physicsEngine);
+  boost::filesystem::remove(this->worldPath);
+
+  physics::WorldPtr w = physics::get_world("default");
+  ASSERT_TRUE(w != nullptr);
+  physics::PhysicsEnginePtr physics = w->Physics();
+  ASSERT_TRUE(physics != nullptr);
+  ASSERT_EQ(_physicsEngine, physics->GetType());
+
+  if (_iters > 0 && !physics->SetParam("iters", _iters))
+  {
+    gzerr << "Aborting benchmark, " << _physicsEngine
+          << " has no solver iterations parameter." << std::endl;
+    return;
+  }
+
+  if (!_collisionDetector.empty())
+  {
+    const bool primitive = _collisionDetector == "fcl_primitive";
+    if ((primitive &&
+        !physics->SetParam("fcl_primitive_shape", std::string("primitive"))) ||
+        !physics->SetParam("collision_detector",
+        primitive ? std::string("fcl") : _collisionDetector))
+    {
+      gzerr << "Aborting benchmark, collision detector ["
+            << _collisionDetector << "] is not available in "
+            << _physicsEngine << "." << std::endl;
+      return;
+    }
+  }
+
+  BenchmarkResult result;
+  for (auto const &model : w->Models())
+  {
+    if (model->IsStatic())
+      continue;
+    result.bodies += model->GetLinks().size();
+    for (auto const &joint : model->GetJoints())
+    {
+      if (joint->GetName().compare(0, 6, "wheel_") == 0)
+      {
+        const bool left = joint->GetName()[6] == '1';
+        this->drives.push_back(std::make_pair(joint, left ? 3.0 : 2.0));
+      }
+    }
+  }
+
+  // Time the world update, including the physics step
+  auto begin = event::Events::ConnectWorldUpdateBegin(
+      [this](const common::UpdateInfo &)
+      {
+        for (auto const &drive : this->drives)
+          drive.first->SetForce(0, drive.second);
+        this->stepStart = common::Time::GetWallTime();
+      });
+  auto end = event::Events::ConnectWorldUpdateEnd(
+      [this]()
+      {
+        if (this->measuring)
+        {
+          this->stepTimes.push_back(
+              (common::Time::GetWallTime() - this->stepStart).Double() * 1e3);
+        }
+      });
+
+  unsigned int settleSteps = 50;
+  result.steps = 100;
+  const char *stepsEnv = std::getenv("GAZEBO_BENCHMARK_STEPS");
+  if (stepsEnv && std::atoi(stepsEnv) > 0)
+  {
+    settleSteps = 500;
+    result.steps = static_cast<unsigned int>(std::atoi(stepsEnv));
+  }
+
+  // Let the scene settle
+  w->Step(settleSteps);
+
+  this->stepTimes.reserve(result.steps);
+  this->measuring = true;
+  const common::Time simStart = w->SimTime();
+  const common::Time wallStart = common::Time::GetWallTime();
+  w->Step(result.steps);
+  const common::Time wallTime = common::Time::GetWallTime() - wallStart;
+  const common::Time simTime = w->SimTime() - simStart;
+  this->measuring = false;
+  begin.reset();
+  end.reset();
+
+  ASSERT_FALSE(this->stepTimes.empty());
+  std::sort(this->stepTimes.begin(), this->stepTimes.end());
+  auto percentile = [this](const double _p)
+  {
+    const size_t index = std::min(this->stepTimes.size() - 1,
+        static_cast<size_t>(_p * this->stepTimes.size()));
+    return this->stepTimes[index];
+  };
+  result.rtf = simTime.Double() / std::max(wallTime.Double(), 1e-9);
+  result.p50 = percentile(0.5);
+  result.p90 = percentile(0.9);
+  result.p99 = percentile(0.99);
+  result.max = this->stepTimes.back();
+  result.rss = test::memory::GetProcessMemory();
+  result.peakRss = test::memory::GetPeakProcessMemory();
+
+  this->RecordProperty("bodies", std::to_string(result.bodies));
+  this->RecordProperty("steps", std::to_string(result.steps));
+  this->RecordProperty("rtf", std::to_string(result.rtf));
+  this->RecordProperty("step_p50_ms", std::to_string(result.p50));
+  this->RecordProperty("step_p90_ms", std::to_string(result.p90));
+  this->RecordProperty("step_p99_ms", std::to_string(result.p99));
+  this->RecordProperty("step_max_ms", std::to_string(result.max));
+  this->RecordProperty("rss_mb", std::to_string(result.rss));
+  this->RecordProperty("peak_rss_mb", std::to_string(result.peakRss));
+
+  std::ostringstream key;
+  key << _physicsEngine
+      << (_collisionDetector.empty() ? "" : ":" + _collisionDetector)
+      << "," << _scene << "," << _iters << ",";
+  std::ostringstream row;
+  row << key.str() << result.bodies << "," << result.steps << ","
+      << result.rtf << "," << result.p50 << "," << result.p90 << ","
+      << result.p99 << "," << result.max << "," << result.rss << ","
+      << result.peakRss;
+  gzmsg << kCsvHeader << "\n" << row.str() << std::endl;
+
+  const char *output = std::getenv("GAZEBO_BENCHMARK_OUTPUT");
+  if (output)
+  {
+    const bool exists = boost::filesystem::exists(output);
+    std::ofstream out(output, std::ios::app);
+    if (!exists)
+      out << kCsvHeader << "\n";
+    out << row.str() << "\n";
+  }
+
+  this->CheckBaseline(key.str(), result);
+}
+
+/////////////////////////////////////////////////
+TEST_P(PhysicsBenchmark, Throughput)
+{
+  this->Run(std::get<0>(GetParam()), std::get<1>(GetParam()),
+      std::get<2>(GetParam()), std::get<3>(GetParam()));
+}
+
+INSTANTIATE_TEST_CASE_P(PhysicsEngines, PhysicsBenchmark,
+  ::testing::Combine(PHYSICS_ENGINE_VALUES,
+  ::testing::Values("box_stacks", "rubble", "articulated_arms",
+                    "tracked_heightmap", "trimesh_bins"),
+  ::testing::Values(0, 100), ::testing::Values("")),);  // NOLINT
+
+#ifdef HAVE_DART
+// Collision detectors of DART on the contact heavy scenes. The engine
+// column of these runs reads dart:<detector>.
+INSTANTIATE_TEST_CASE_P(DARTCollisionDetectors, PhysicsBenchmark,
+  ::testing::Combine(::testing::Values("dart"),
+  ::testing::Values("rubble", "trimesh_bins"),
+  ::testing::Values(0),
+  ::testing::Values("fcl", "fcl_primitive", "bullet", "dart")),);  // NOLINT
+#endif
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
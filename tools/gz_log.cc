@@ -14,6 +14,22 @@
  * limitations under the License.
  *
 */
+#include <gazebo/gazebo_config.h>
+
+#ifndef USE_EXTERNAL_TINYXML2
+#include <gazebo/tinyxml2.h>
+#else
+#include <tinyxml2.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <thread>
+#include <utility>
+
 #include <boost/algorithm/string.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/date_time/posix_time/posix_time_io.hpp>
@@ -591,6 +607,244 @@ std::string StateFilter::Filter(const std::string &_stateString)
   return result.str();
 }
 
+/////////////////////////////////////////////////
+/// \brief Find the child element with a given tag and name attribute.
+/// \param[in] _parent Parent element.
+/// \param[in] _tag Tag of the child.
+/// \param[in] _name Value of the name attribute of the child.
+/// \return The child, or null if not found.
+static tinyxml2::XMLElement *NamedChild(tinyxml2::XMLElement *_parent,
+    const char *_tag, const std::string &_name)
+{
+  for (auto xml = _parent->FirstChildElement(_tag); xml;
+       xml = xml->NextSiblingElement(_tag))
+  {
+    const char *name = xml->Attribute("name");
+    if (name && _name == name)
+      return xml;
+  }
+  return nullptr;
+}
+
+/////////////////////////////////////////////////
+/// \brief Parse a number in a list of space separated numbers.
+/// \param[in] _text The list of numbers.
+/// \param[in] _index Index of the number.
+/// \return The number, or NaN if the list is too short.
+static double NthValue(const char *_text, const unsigned int _index)
+{
+  double value = std::numeric_limits<double>::quiet_NaN();
+  const char *start = _text;
+  for (unsigned int i = 0; i <= _index; ++i)
+  {
+    char *end;
+    value = std::strtod(start, &end);
+    if (end == start)
+      return std::numeric_limits<double>::quiet_NaN();
+    start = end;
+  }
+  return value;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the value of a field in a state.
+/// \param[in] _state The <state> element.
+/// \param[in] _field The field.
+/// \return The value, or NaN if the state doesn't contain the field.
+static double FieldValue(tinyxml2::XMLElement *_state,
+    const ColumnField &_field)
+{
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+
+  tinyxml2::XMLElement *xml = _state;
+  for (auto const &model : _field.models)
+  {
+    xml = NamedChild(xml, "model", model);
+    if (!xml)
+      return nan;
+  }
+
+  unsigned int index = _field.index;
+  if (_field.kind == "pose")
+  {
+    xml = xml->FirstChildElement("pose");
+  }
+  else if (_field.kind == "link")
+  {
+    xml = NamedChild(xml, "link", _field.name);
+    if (xml)
+      xml = xml->FirstChildElement(_field.part.c_str());
+  }
+  else
+  {
+    xml = NamedChild(xml, "joint", _field.name);
+    if (!xml)
+      return nan;
+
+    auto angle = xml->FirstChildElement("angle");
+    while (angle && angle->UnsignedAttribute("axis") != _field.index)
+      angle = angle->NextSiblingElement("angle");
+    xml = angle;
+    index = 0;
+  }
+
+  if (!xml || !xml->GetText())
+    return nan;
+
+  return NthValue(xml->GetText(), index);
+}
+
+/////////////////////////////////////////////////
+bool ColumnFilter::Init(const std::string &_fields)
+{
+  const std::vector<std::string> elements =
+      {"x", "y", "z", "roll", "pitch", "yaw"};
+  const std::vector<std::string> linkParts =
+      {"pose", "velocity", "acceleration", "wrench"};
+
+  this->fields.clear();
+  this->columns = {"sim_time"};
+
+  std::vector<std::string> fieldStrs;
+  boost::split(fieldStrs, _fields, boost::is_any_of(","));
+  for (auto fieldStr : fieldStrs)
+  {
+    boost::trim(fieldStr);
+    if (fieldStr.empty())
+      continue;
+
+    std::vector<std::string> parts;
+    boost::split(parts, fieldStr, boost::is_any_of("/"));
+
+    ColumnField field;
+    std::string element;
+    bool valid = parts.size() >= 3 && !parts[0].empty();
+    if (valid)
+    {
+      // Split the nested model names.
+      size_t start = 0;
+      size_t end;
+      while ((end = parts[0].find("::", start)) != std::string::npos)
+      {
+        field.models.push_back(parts[0].substr(start, end - start));
+        start = end + 2;
+      }
+      field.models.push_back(parts[0].substr(start));
+
+      field.kind = parts[1];
+      if (field.kind == "pose" && parts.size() == 3)
+      {
+        element = parts[2];
+      }
+      else if (field.kind == "link" && parts.size() == 5)
+      {
+        field.name = parts[2];
+        field.part = parts[3];
+        element = parts[4];
+        valid = std::find(linkParts.begin(), linkParts.end(), field.part) !=
+            linkParts.end();
+      }
+      else if (field.kind == "joint" && parts.size() == 4)
+      {
+        field.name = parts[2];
+        valid = !parts[3].empty() &&
+            parts[3].find_first_not_of("0123456789") == std::string::npos;
+        if (valid)
+          field.index = std::stoul(parts[3]);
+      }
+      else
+        valid = false;
+    }
+
+    if (valid && !element.empty())
+    {
+      auto elementIter = std::find(elements.begin(), elements.end(),
+          element);
+      valid = elementIter != elements.end();
+      field.index = elementIter - elements.begin();
+    }
+
+    if (!valid)
+    {
+      std::cerr << "Invalid field[" << fieldStr << "]. Use "
+        << "<model>/pose/<element>, "
+        << "<model>/link/<link>/<pose|velocity|acceleration|wrench>/<element>"
+        << " or <model>/joint/<joint>/<axis>, where <element> is one of "
+        << "(x,y,z,roll,pitch,yaw).\n";
+      return false;
+    }
+
+    this->fields.push_back(field);
+    this->columns.push_back(fieldStr);
+  }
+
+  if (this->fields.empty())
+  {
+    std::cerr << "No fields specified.\n";
+    return false;
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+const std::vector<std::string> &ColumnFilter::Columns() const
+{
+  return this->columns;
+}
+
+/////////////////////////////////////////////////
+unsigned int ColumnFilter::Filter(const std::string &_chunk,
+    std::vector<double> &_values) const
+{
+  const std::string startFrame = "<sdf ";
+  const std::string endFrame = "</sdf>";
+  const size_t columnCount = this->columns.size();
+
+  // Values of each state, one state after the other.
+  std::vector<double> rows;
+
+  tinyxml2::XMLDocument doc;
+  auto from = _chunk.find(startFrame);
+  while (from != std::string::npos)
+  {
+    auto to = _chunk.find(endFrame, from);
+    if (to == std::string::npos)
+      break;
+    to += endFrame.size();
+
+    // Skip frames that aren't states, such as the world description.
+    doc.Clear();
+    if (doc.Parse(_chunk.c_str() + from, to - from) == tinyxml2::XML_SUCCESS)
+    {
+      auto state = doc.FirstChildElement("sdf");
+      if (state)
+        state = state->FirstChildElement("state");
+      auto simTime = state ? state->FirstChildElement("sim_time") : nullptr;
+      if (simTime && simTime->GetText())
+      {
+        rows.push_back(NthValue(simTime->GetText(), 0) +
+            NthValue(simTime->GetText(), 1) * 1e-9);
+        for (auto const &field : this->fields)
+          rows.push_back(FieldValue(state, field));
+      }
+    }
+
+    from = _chunk.find(startFrame, to);
+  }
+
+  // Store the values column by column.
+  const size_t rowCount = rows.size() / columnCount;
+  _values.resize(rows.size());
+  for (size_t r = 0; r < rowCount; ++r)
+  {
+    for (size_t c = 0; c < columnCount; ++c)
+      _values[c * rowCount + r] = rows[r * columnCount + c];
+  }
+
+  return rowCount;
+}
+
 /////////////////////////////////////////////////
 LogCommand::LogCommand()
   : Command("log", "Introspects and manipulates Gazebo log files.")
@@ -622,7 +876,19 @@ LogCommand::LogCommand()
      "Valid in conjunction with the output command. See also the "
      "--output argument.")
     ("filter", po::value<std::string>(),
-     "Filter output. Valid only with the echo, step, and output commands");
+     "Filter output. Valid only with the echo, step, and output commands")
+    ("export,x", po::value<std::string>(),
+     "Export fields of a log file to a binary column file, with a time "
+     "index. The fields are selected with the --fields option.")
+    ("fields", po::value<std::string>(),
+     "Comma separated list of fields to export, each one being "
+     "<model>/pose/<element>, "
+     "<model>/link/<link>/<pose|velocity|acceleration|wrench>/<element> or "
+     "<model>/joint/<joint>/<axis>, where <element> is one of "
+     "(x,y,z,roll,pitch,yaw). Valid only with the export command.")
+    ("threads", po::value<unsigned int>(),
+     "Number of threads used to decode the log file. Defaults to the number "
+     "of cores. Valid only with the export command.");
 }
 
 /////////////////////////////////////////////////
@@ -692,7 +958,25 @@ bool LogCommand::RunImpl()
   g_stateSdf.reset(new sdf::Element);
   sdf::initFile("state.sdf", g_stateSdf);
 
-  if (this->vm.count("output"))
+  if (this->vm.count("export"))
+  {
+    if (!this->vm.count("fields"))
+    {
+      std::cerr << "No fields specified. Use the --fields option.\n";
+      return false;
+    }
+
+    unsigned int threads = this->vm.count("threads") ?
+      this->vm["threads"].as<unsigned int>() :
+      std::thread::hardware_concurrency();
+
+    if (!this->Export(this->vm["export"].as<std::string>(),
+          this->vm["fields"].as<std::string>(), threads))
+    {
+      return false;
+    }
+  }
+  else if (this->vm.count("output"))
   {
     std::string encoding = this->vm.count("encoding") ?
       this->vm["encoding"].as<std::string>() : "";
@@ -892,6 +1176,153 @@ void LogCommand::Output(const std::string &_outFilename,
   outFile.close();
 }
 
+/////////////////////////////////////////////////
+bool LogCommand::Export(const std::string &_outFilename,
+    const std::string &_fields, const unsigned int _threads)
+{
+  ColumnFilter filter;
+  if (!filter.Init(_fields))
+    return false;
+
+  gazebo::util::LogPlay *play = gazebo::util::LogPlay::Instance();
+  if (!play->IsOpen())
+  {
+    std::cerr << "No source log file specified. Use the -f command line "
+      << "argument.\n";
+    return false;
+  }
+
+  std::ofstream outFile(_outFilename, std::fstream::out | std::ios::binary);
+  if (!outFile.is_open())
+  {
+    std::cerr << "Unable to open file[" << _outFilename << "] for writing.\n";
+    return false;
+  }
+
+  auto write = [&outFile](const void *_data, const size_t _size)
+  {
+    outFile.write(static_cast<const char *>(_data), _size);
+  };
+
+  // Header, padded to 8 bytes.
+  const char magic[] = "GZCOLS01";
+  const char padding[8] = {0};
+  const uint32_t columnCount = filter.Columns().size();
+  const uint32_t reserved = 0;
+  write(magic, 8);
+  write(&columnCount, sizeof(columnCount));
+  write(&reserved, sizeof(reserved));
+  for (auto const &column : filter.Columns())
+  {
+    const uint32_t length = column.size();
+    write(&length, sizeof(length));
+    write(column.data(), length);
+  }
+  write(padding, (8 - static_cast<uint64_t>(outFile.tellp()) % 8) % 8);
+
+  // Time index entry of a row group.
+  struct RowGroup
+  {
+    uint64_t offset;
+    uint64_t rows;
+    double start;
+    double end;
+  };
+  std::vector<RowGroup> index;
+
+  // Chunks are read in batches, decoded and filtered in parallel, and then
+  // written in order.
+  const unsigned int threads = std::max(1u, _threads);
+  const size_t batchSize = threads * 4;
+  std::vector<std::pair<std::string, std::string>> batch;
+  std::vector<std::vector<double>> values(batchSize);
+  std::vector<unsigned int> rows(batchSize);
+  std::atomic<unsigned int> invalidChunks(0);
+
+  auto flush = [&]()
+  {
+    std::atomic<size_t> next(0);
+    auto work = [&]()
+    {
+      std::string data;
+      for (size_t i = next++; i < batch.size(); i = next++)
+      {
+        rows[i] = 0;
+        if (gazebo::util::LogPlay::DecodeChunk(batch[i].first,
+              batch[i].second, data))
+        {
+          rows[i] = filter.Filter(data, values[i]);
+        }
+        else
+          ++invalidChunks;
+      }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t t = 1; t < std::min<size_t>(threads, batch.size()); ++t)
+      workers.emplace_back(work);
+    work();
+    for (auto &worker : workers)
+      worker.join();
+
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+      if (rows[i] == 0)
+        continue;
+
+      RowGroup group;
+      group.offset = static_cast<uint64_t>(outFile.tellp());
+      group.rows = rows[i];
+      group.start = values[i][0];
+      group.end = values[i][rows[i] - 1];
+      write(&group.rows, sizeof(group.rows));
+      write(values[i].data(), values[i].size() * sizeof(double));
+      index.push_back(group);
+    }
+
+    batch.clear();
+  };
+
+  play->VisitChunks([&](const std::string &_encoding,
+                        const std::string &_encoded)
+  {
+    batch.emplace_back(_encoding, _encoded);
+    if (batch.size() >= batchSize)
+      flush();
+    return true;
+  });
+  flush();
+
+  if (invalidChunks > 0)
+  {
+    std::cerr << "Skipped " << invalidChunks << " chunks with an invalid "
+      << "encoding.\n";
+  }
+
+  // Time index and trailer.
+  const uint64_t indexOffset = static_cast<uint64_t>(outFile.tellp());
+  for (auto const &group : index)
+  {
+    write(&group.offset, sizeof(group.offset));
+    write(&group.rows, sizeof(group.rows));
+    write(&group.start, sizeof(group.start));
+    write(&group.end, sizeof(group.end));
+  }
+  const uint64_t groupCount = index.size();
+  write(&groupCount, sizeof(groupCount));
+  write(&indexOffset, sizeof(indexOffset));
+  write(magic, 8);
+
+  outFile.close();
+  if (!outFile)
+  {
+    std::cerr << "Error writing file[" << _outFilename << "].\n";
+    return false;
+  }
+
+  return true;
+}
+
 /////////////////////////////////////////////////
 void LogCommand::Echo(const std::string &_filter, bool _raw,
     const std::string &_stamp, double _hz)
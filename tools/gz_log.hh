@@ -19,6 +19,7 @@
 
 #include <string>
 #include <list>
+#include <vector>
 
 #include <gazebo/physics/WorldState.hh>
 #include "gz.hh"
@@ -187,6 +188,61 @@ namespace gazebo
     private: gazebo::common::Time prevTime;
   };
 
+  /// \brief A field of the states selected by a ColumnFilter.
+  class ColumnField
+  {
+    /// \brief Names of the model and its parent models, outermost first.
+    public: std::vector<std::string> models;
+
+    /// \brief Kind of field: "pose", "link" or "joint".
+    public: std::string kind;
+
+    /// \brief Name of the link or joint.
+    public: std::string name;
+
+    /// \brief Link part: "pose", "velocity", "acceleration" or "wrench".
+    public: std::string part;
+
+    /// \brief Index of the value in the part, or joint axis.
+    public: unsigned int index = 0;
+  };
+
+  /// \brief Extract numeric fields of the states in a log chunk into
+  /// columns. It reads the state XML directly, without loading a
+  /// WorldState, so several chunks can be filtered at the same time.
+  class ColumnFilter
+  {
+    /// \brief Initialize the filter.
+    /// \param[in] _fields Comma separated list of fields. Each field is
+    /// one of:
+    ///   <model>/pose/<element>
+    ///   <model>/link/<link>/<pose|velocity|acceleration|wrench>/<element>
+    ///   <model>/joint/<joint>/<axis>
+    /// where <element> is x, y, z, roll, pitch or yaw, and nested models
+    /// are written as parent::child.
+    /// \return False if a field is not valid.
+    public: bool Init(const std::string &_fields);
+
+    /// \brief Get the names of the columns. The first one is the
+    /// simulation time in seconds, followed by one column per field.
+    /// \return Column names.
+    public: const std::vector<std::string> &Columns() const;
+
+    /// \brief Extract the fields of all the states in a decoded chunk.
+    /// Fields missing from a state are NaN.
+    /// \param[in] _chunk Decoded chunk data.
+    /// \param[out] _values Values of each column, one column after the other.
+    /// \return Number of states found in the chunk.
+    public: unsigned int Filter(const std::string &_chunk,
+                std::vector<double> &_values) const;
+
+    /// \brief Selected fields.
+    private: std::vector<ColumnField> fields;
+
+    /// \brief Column names.
+    private: std::vector<std::string> columns;
+  };
+
   /// \brief Log command
   class LogCommand : public Command
   {
@@ -222,6 +278,26 @@ namespace gazebo
                  const std::string &_stamp, const double _hz,
                  const std::string &_encoding = "");
 
+    /// \brief Export fields of a log file to a column file. Chunks are
+    /// decoded and filtered in parallel.
+    ///
+    /// The file stores 64 bit values in native byte order, aligned to 8
+    /// bytes so it can be memory mapped:
+    ///   "GZCOLS01", uint32 column count, uint32 0
+    ///   For each column: uint32 name length, name, padded to 8 bytes.
+    ///   Row groups, one per log chunk: uint64 row count, followed by the
+    ///   values of each column. The first column is the simulation time.
+    ///   Time index, for each row group: uint64 offset, uint64 row count,
+    ///   double first time, double last time.
+    ///   uint64 row group count, uint64 offset of the time index,
+    ///   "GZCOLS01".
+    /// \param[in] _outFilename Output filename.
+    /// \param[in] _fields Fields to export, see ColumnFilter::Init.
+    /// \param[in] _threads Number of threads.
+    /// \return True on success.
+    private: bool Export(const std::string &_outFilename,
+                 const std::string &_fields, const unsigned int _threads);
+
     /// \brief Dump the contents of a log file to screen
     /// \param[in] _filter Filter string
     /// \param[in] _raw True to output data without xml formatting.
@@ -24,7 +24,11 @@
 #include <sdf/sdf_config.h>
 
 #include <stdio.h>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
 #include <string>
+#include <vector>
 
 // This header file isn't needed if shasums are used
 // #include "test/data/pr2_state_log_expected.h"
@@ -474,6 +478,110 @@ TEST(gz_log, Output)
 #endif
 }
 
+/////////////////////////////////////////////////
+/// Check that 'gz log -x' writes the selected fields in columns
+TEST(gz_log, Export)
+{
+  std::ostringstream newFileStream, stream;
+  newFileStream << "/tmp/__gz_log_export" << std::this_thread::get_id()
+    << ".gzcol";
+
+  stream << GZ_LOG_PATH + " -f " << PROJECT_SOURCE_PATH
+    << "/test/data/pr2_state.log -x " << newFileStream.str()
+    << " --threads 2 --fields pr2/pose/z,pr2/joint/torso_lift_joint/0,"
+    << "pr2/link/base_footprint/velocity/z,pr2/joint/missing/0";
+  custom_exec(stream.str());
+
+  std::ifstream file(newFileStream.str(), std::ios::binary);
+  ASSERT_TRUE(file.is_open());
+
+  auto read = [&file](void *_data, const size_t _size)
+  {
+    file.read(static_cast<char *>(_data), _size);
+  };
+
+  // Header
+  char magic[9] = {0};
+  read(magic, 8);
+  EXPECT_EQ(std::string("GZCOLS01"), magic);
+  uint32_t columnCount = 0;
+  uint32_t reserved = 1;
+  read(&columnCount, sizeof(columnCount));
+  read(&reserved, sizeof(reserved));
+  ASSERT_EQ(5u, columnCount);
+  EXPECT_EQ(0u, reserved);
+
+  std::vector<std::string> columns;
+  for (uint32_t i = 0; i < columnCount; ++i)
+  {
+    uint32_t length = 0;
+    read(&length, sizeof(length));
+    std::string name(length, ' ');
+    read(&name[0], length);
+    columns.push_back(name);
+  }
+  EXPECT_EQ("sim_time", columns[0]);
+  EXPECT_EQ("pr2/joint/torso_lift_joint/0", columns[2]);
+
+  // Trailer
+  uint64_t groupCount = 0;
+  uint64_t indexOffset = 0;
+  file.seekg(-24, std::ios::end);
+  read(&groupCount, sizeof(groupCount));
+  read(&indexOffset, sizeof(indexOffset));
+  read(magic, 8);
+  EXPECT_EQ(std::string("GZCOLS01"), magic);
+  EXPECT_EQ(0u, indexOffset % 8);
+
+  // The world description has no state, each of the two other chunks has
+  // one state.
+  ASSERT_EQ(2u, groupCount);
+  uint64_t offset = 0;
+  uint64_t rows = 0;
+  double start = 0;
+  double end = 0;
+  file.seekg(indexOffset);
+  read(&offset, sizeof(offset));
+  read(&rows, sizeof(rows));
+  read(&start, sizeof(start));
+  read(&end, sizeof(end));
+  EXPECT_EQ(0u, offset % 8);
+  EXPECT_EQ(1u, rows);
+  EXPECT_NEAR(0.021343973, start, 1e-9);
+  EXPECT_DOUBLE_EQ(start, end);
+
+  // First row group
+  double values[5];
+  file.seekg(offset);
+  read(&rows, sizeof(rows));
+  read(values, sizeof(values));
+  EXPECT_EQ(1u, rows);
+  EXPECT_DOUBLE_EQ(start, values[0]);
+  EXPECT_DOUBLE_EQ(-8e-06, values[1]);
+  EXPECT_DOUBLE_EQ(1.41007e-06, values[2]);
+  EXPECT_DOUBLE_EQ(-0.007966, values[3]);
+  EXPECT_TRUE(std::isnan(values[4]));
+
+  // Second row group
+  read(&rows, sizeof(rows));
+  read(values, sizeof(values));
+  EXPECT_EQ(1u, rows);
+  EXPECT_NEAR(0.028958235, values[0], 1e-9);
+  EXPECT_DOUBLE_EQ(-1.5e-05, values[1]);
+  EXPECT_TRUE(std::isnan(values[4]));
+
+  file.close();
+  std::remove(newFileStream.str().c_str());
+
+  // Invalid fields
+  std::ostringstream stream2;
+  stream2 << GZ_LOG_PATH + " -f " << PROJECT_SOURCE_PATH
+    << "/test/data/pr2_state.log -x " << newFileStream.str()
+    << " --fields pr2/pose/w";
+  custom_exec(stream2.str());
+  EXPECT_FALSE(std::ifstream(newFileStream.str()).is_open());
+}
+
 /////////////////////////////////////////////////
 /// Main
 int main(int argc, char **argv)